@@ -8,6 +8,7 @@
 #include "InnoEngine/Layer.h"
 #include "InnoEngine/graphics/OrthographicCamera.h"
 #include "InnoEngine/utility/Profiler.h"
+#include "InnoEngine/utility/JobSystem.h"
 #include "InnoEngine/graphics/RenderCommandBuffer.h"
 #include "InnoEngine/graphics/Renderer.h"
 #include "InnoEngine/graphics/Shader.h"
@@ -15,6 +16,7 @@
 #include "InnoEngine/InputSystem.h"
 #include "InnoEngine/graphics/DefaultCameraController.h"
 #include "InnoEngine/graphics/RenderContext.h"
+#include "InnoEngine/graphics/DebugDraw.h"
 
 namespace InnoEngine
 {
@@ -24,6 +26,7 @@ namespace InnoEngine
     {
         if ( m_Renderer )
             m_Renderer->wait_for_gpu_idle();
+        m_JobSystem.reset();    // jobs may still reference assets
         m_DebugLayer.reset();
         m_AssetManager.reset();
         m_Renderer.reset();
@@ -39,6 +42,10 @@ namespace InnoEngine
         for ( auto layer : m_LayerStack )
             layer->render( m_FrameTimingInfo.InterpolationFactor, m_Renderer.get() );
 
+#ifdef IE_ENABLE_DEBUG_DRAW
+        m_DebugDraw->submit( m_Renderer.get() );
+#endif
+
         // always last and top most
         if ( m_DebugUIEnabled )
             m_DebugLayer->render( m_FrameTimingInfo.InterpolationFactor, m_Renderer.get() );
@@ -49,24 +56,43 @@ namespace InnoEngine
     void Application::run_async()
     {
         while ( m_MustQuit.load( std::memory_order_relaxed ) == false ) {
+            ProfileScoped  update_thread( ProfilePoint::UpdateThreadTotal );
+            const uint64_t frame_start = get_tick_count();
 
-            {    // hold mutex while the async update is doing work
+            {    // take over the input and events the main thread collected in the meantime
+                ProfileScoped                update_thread_stall( ProfilePoint::UpdateThreadStall );
                 std::unique_lock<std::mutex> ulock( m_AsyncMutex );
-                m_AsyncThreadWaiting.wait( ulock, [ this ]() { return m_SyncComplete; } );
+                update_thread_stall.stop();
+                synchronize();
+            }
 
-                ProfileScoped update_thread( ProfilePoint::UpdateThreadTotal );
+            for ( const auto& event : m_EventBuffer.get_consumer_data() )
+                handle_event( event );
 
-                for ( const auto& event : m_EventBuffer.get_consumer_data() )
-                    handle_event( event );
+            // never waits for the render thread, render_layers publishes the frame into a free buffer
+            // frames the render thread doesn't pick up in time get replaced by newer ones
+            create_update();
+            render_layers();
 
-                create_update();
-                render_layers();
+            notify_frame_available();
 
-                m_SyncComplete        = false;
-                m_AsyncThreadFinished = true;
+            // the optional limit keeps the update thread from spinning through frames nobody will see
+            const uint64_t frame_ticks = m_AsyncFrameTicks.load( std::memory_order_relaxed );
+            if ( frame_ticks != 0 ) {
+                const uint64_t elapsed_ticks = get_tick_count() - frame_start;
+                if ( elapsed_ticks < frame_ticks )
+                    SDL_DelayPrecise( ( frame_ticks - elapsed_ticks ) * SDL_NS_PER_SECOND / TicksPerSecond );
             }
-            m_MainThreadWaiting.notify_one();
         }
+        notify_frame_available();
+    }
+
+    void Application::notify_frame_available()
+    {
+        {    // pass through the mutex so the render thread cant miss the notification between its check and its wait
+            std::unique_lock<std::mutex> ulock( m_AsyncMutex );
+        }
+        m_FrameAvailable.notify_one();
     }
 
     void Application::on_shutdown()
@@ -90,6 +116,9 @@ namespace InnoEngine
         Result result = Result::Fail;
         // create the core systems
         try {
+            auto job_system_optional = JobSystem::create();
+            m_JobSystem              = std::move( job_system_optional.value() );
+
             auto asset_manager_optional = AssetManager::create( appParams.AssetDirectory, appParams.AsyncAssetLoading );
             m_AssetManager              = std::move( asset_manager_optional.value() );
 
@@ -105,6 +134,11 @@ namespace InnoEngine
             auto input_system_opt = InputSystem::create();
             m_InputSystem         = std::move( input_system_opt.value() );
 
+#ifdef IE_ENABLE_DEBUG_DRAW
+            auto debug_draw_opt = DebugDraw::create();
+            m_DebugDraw         = std::move( debug_draw_opt.value() );
+#endif
+
             m_FullscreenDefaultViewport = Viewport( 0, 0, static_cast<float>( m_Window->get_client_width() ), static_cast<float>( m_Window->get_client_height() ) );
 
             m_DefaultCamera = OrthographicCamera::create( { m_FullscreenDefaultViewport.Width, m_FullscreenDefaultViewport.Height } );
@@ -131,6 +165,7 @@ namespace InnoEngine
 
             set_simulation_target_frequency( appParams.SimulationFrequency );
             m_MultiThreaded = appParams.RunAsync;
+            set_async_frame_limit( appParams.AsyncFrameLimit );
 
             result = on_init();
 
@@ -176,15 +211,15 @@ namespace InnoEngine
             }
             else {
                 {
-                    ProfileScoped wait_and_sync( ProfilePoint::WaitAndSynchronize );
+                    ProfileScoped render_thread_stall( ProfilePoint::RenderThreadStall );
 
-                    // hold mutex while we are synchronising data with the async thread
+                    // only wait when the update thread hasnt finished a new frame yet
                     std::unique_lock<std::mutex> ulock( m_AsyncMutex );
-                    m_MainThreadWaiting.wait( ulock, [ this ]() { return m_AsyncThreadFinished; } );
-                    synchronize();
+                    m_FrameAvailable.wait( ulock, [ this ]() { return m_Renderer->has_new_frame() || m_MustQuit.load( std::memory_order_relaxed ); } );
                 }
-                m_AsyncThreadWaiting.notify_one();
-                m_Renderer->render();
+
+                if ( m_Renderer->synchronize() )
+                    m_Renderer->render();
             }
 
             m_Profiler->stop( ProfilePoint::MainThreadTotal );
@@ -206,6 +241,11 @@ namespace InnoEngine
         m_FrameTimingInfo.DeltaTicks               = updateFrequency > 0 ? TicksPerSecond / updateFrequency : 0;
     }
 
+    void Application::set_async_frame_limit( int framesPerSecond )
+    {
+        m_AsyncFrameTicks.store( framesPerSecond > 0 ? TicksPerSecond / framesPerSecond : 0, std::memory_order_relaxed );
+    }
+
     const FrameTimingInfo& Application::get_frame_timings() const
     {
         return m_FrameTimingInfo;
@@ -237,6 +277,15 @@ namespace InnoEngine
         IE_ASSERT( m_DebugLayer != nullptr );
         IE_LOG_DEBUG( "Debug UI {}", enabled ? "enabled" : "disabled" );
         m_DebugUIEnabled = enabled;
+
+        // events were not passed on while it was disabled, and the renderer dropped its draw data
+        m_DebugLayer->request_rebuild();
+    }
+
+    void Application::set_debugui_refresh_rate( uint32_t rebuilds_per_second )
+    {
+        IE_ASSERT( m_DebugLayer != nullptr );
+        m_DebugLayer->set_refresh_rate( rebuilds_per_second );
     }
 
     bool Application::running_mutithreaded() const
@@ -360,18 +409,19 @@ namespace InnoEngine
         m_InputSystem->synchronize();
         m_EventBuffer.swap();
         m_EventBuffer.get_producer_data().clear();
-        m_Renderer->synchronize();
 
         update_profiledata();
 
         on_synchronize();
-
-        m_SyncComplete        = true;
-        m_AsyncThreadFinished = false;
     }
 
     void Application::poll_events()
     {
+        // the update thread takes over input and events at any time, not only between frames
+        std::unique_lock<std::mutex> ulock( m_AsyncMutex, std::defer_lock );
+        if ( m_MultiThreaded )
+            ulock.lock();
+
         SDL_Event event;
         while ( SDL_PollEvent( &event ) != 0 ) {
 
@@ -440,6 +490,10 @@ namespace InnoEngine
     void Application::update( double delta_time )
     {
         ProfileScoped layer_update( ProfilePoint::LayerUpdate );
+#ifdef IE_ENABLE_DEBUG_DRAW
+        m_DebugDraw->next_update();
+#endif
+
         for ( auto& cam_controller : m_CameraControllers )
             cam_controller->update( delta_time );
 
@@ -463,6 +517,8 @@ namespace InnoEngine
         coreapi.m_Renderer     = m_Renderer.get();
         coreapi.m_Profiler     = m_Profiler.get();
         coreapi.m_Input        = m_InputSystem.get();
+        coreapi.m_DebugDraw    = m_DebugDraw.get();
+        coreapi.m_JobSystem    = m_JobSystem.get();
     }
 
     void Application::update_profiledata()
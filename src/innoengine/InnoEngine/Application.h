@@ -19,9 +19,12 @@ namespace InnoEngine
     class AssetManager;
     class Camera;
     class Layer;
+    class DebugUI;
     class InputSystem;
     class CameraController;
     class RenderContext;
+    class DebugDraw;
+    class JobSystem;
 
     struct FrameTimingInfo
     {
@@ -40,6 +43,7 @@ namespace InnoEngine
         int                    SimulationFrequency = 60;
         bool                   EnableVSync         = true;
         bool                   RunAsync            = false;    // create a separate thread for layer processing
+        int                    AsyncFrameLimit     = 0;        // frames per second the update thread produces at most when running async, 0 for no limit
         std::filesystem::path  AssetDirectory;
         bool                   AsyncAssetLoading = false;
     };
@@ -54,6 +58,7 @@ namespace InnoEngine
         Result run();
 
         void                   set_simulation_target_frequency( int updatesPerSecond );
+        void                   set_async_frame_limit( int framesPerSecond );    // 0 lets the update thread run ahead freely
         const FrameTimingInfo& get_frame_timings() const;
 
         Window*       get_window() const;
@@ -61,6 +66,7 @@ namespace InnoEngine
         AssetManager* get_assetmanager() const;
 
         void enable_debugui( bool enable );
+        void set_debugui_refresh_rate( uint32_t rebuilds_per_second );    // 0 rebuilds the debug ui every frame
         bool running_mutithreaded() const;
 
         void raise_critical_error( std::string msg );
@@ -87,7 +93,7 @@ namespace InnoEngine
         virtual Result on_init()                                    = 0;
         virtual void   on_shutdown()                                = 0;
 
-        // Only relevant if application is running async
+        // Only relevant if application is running async, called on the update thread while the main thread cant poll events
         // All data sharing between the threads has to be in here
         virtual void on_synchronize();
 
@@ -100,6 +106,7 @@ namespace InnoEngine
         void render_layers();
 
         void run_async();
+        void notify_frame_available();
 
         void publish_coreapi();
         void update_profiledata();
@@ -111,6 +118,8 @@ namespace InnoEngine
         Own<AssetManager> m_AssetManager;
         Own<Profiler>     m_Profiler;
         Own<InputSystem>  m_InputSystem;
+        Own<DebugDraw>    m_DebugDraw;    // only with IE_ENABLE_DEBUG_DRAW
+        Own<JobSystem>    m_JobSystem;
 
         std::vector<Ref<Camera>>           m_Cameras;
         std::vector<Ref<CameraController>> m_CameraControllers;
@@ -124,17 +133,15 @@ namespace InnoEngine
         bool                    m_MultiThreaded = false;
         std::thread             m_AsyncApplicationThread;
         std::mutex              m_AsyncMutex;
-        std::condition_variable m_AsyncThreadWaiting;
-        std::condition_variable m_MainThreadWaiting;
-        bool                    m_AsyncThreadFinished = false;
-        bool                    m_SyncComplete        = true;
+        std::condition_variable m_FrameAvailable;
+        std::atomic<uint64_t>   m_AsyncFrameTicks = 0;    // minimum ticks between two frames of the update thread, 0 without limit
 
         // buffered events for async handling
         DoubleBuffered<std::vector<SDL_Event>> m_EventBuffer;
 
         std::vector<Layer*> m_LayerStack;
         // keep debuglayer seperate and always topmost
-        Own<Layer>          m_DebugLayer;
+        Own<DebugUI>        m_DebugLayer;
         bool                m_DebugUIEnabled = false;
 
         std::array<float, static_cast<int>( ProfilePoint::Count )> m_ProfileData = {};
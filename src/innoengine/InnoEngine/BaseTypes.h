@@ -6,8 +6,10 @@ namespace DXSM = DirectX::SimpleMath;
 
 #include "InnoEngine/utility/Log.h"
 
+#include <atomic>
 #include <cstdint>
 #include <memory>
+#include <new>
 #include <source_location>
 
 namespace InnoEngine
@@ -44,6 +46,22 @@ namespace InnoEngine
         RotationOrigin,
     };
 
+    // how the segments of a polyline get connected
+    enum class LineJoin
+    {
+        Miter = 0,    // falls back to bevel for very sharp angles
+        Bevel,
+        Round,
+    };
+
+    // shape of the ends of an open polyline
+    enum class LineCap
+    {
+        Butt = 0,    // ends exactly at the end point
+        Square,      // extends by half the thickness
+        Round,
+    };
+
     // transform the given coordinates and origin to a origin in the middle for the shaders
     constexpr const DXSM::Vector2 origin_transform( Origin origin, const DXSM::Vector2& position, const DXSM::Vector2& size, const DXSM::Vector2& rotation_origin = { 0.5f, 0.5f } )
     {
@@ -137,6 +155,75 @@ namespace InnoEngine
 #pragma warning( pop )
     };
 
+    // Lock free handoff between exactly one producer and one consumer thread.
+    // The producer always has a free slot to write into and never waits for the consumer, the consumer
+    // always gets the most recently published slot. Published slots nobody acquired in time get dropped.
+    template <typename T>
+    class TripleBuffered
+    {
+    public:
+        T& get_producer_data()
+        {
+            return m_Slots[ m_ProducerIndex ].Data;
+        }
+
+        const T& get_consumer_data() const
+        {
+            return m_Slots[ m_ConsumerIndex ].Data;
+        }
+
+        // producer: hand the written slot over and continue with the one it replaces
+        void publish()
+        {
+            uint8_t previous = m_Latest.exchange( static_cast<uint8_t>( m_ProducerIndex | FreshFlag ), std::memory_order_acq_rel );
+            if ( previous & FreshFlag )
+                m_DroppedCount.fetch_add( 1, std::memory_order_relaxed );
+
+            m_ProducerIndex = previous & IndexMask;
+        }
+
+        // consumer: switch to the latest published slot, returns false when nothing new got published
+        bool acquire_latest()
+        {
+            if ( has_new_data() == false )
+                return false;
+
+            uint8_t previous = m_Latest.exchange( m_ConsumerIndex, std::memory_order_acq_rel );
+            m_ConsumerIndex  = previous & IndexMask;
+            return true;
+        }
+
+        bool has_new_data() const
+        {
+            return m_Latest.load( std::memory_order_acquire ) & FreshFlag;
+        }
+
+        uint64_t get_dropped_count() const
+        {
+            return m_DroppedCount.load( std::memory_order_relaxed );
+        }
+
+    private:
+        static constexpr uint8_t IndexMask = 0x3;
+        static constexpr uint8_t FreshFlag = 0x4;
+
+        // force it to align to cache lines to prevent false sharing
+#pragma warning( push )
+#pragma warning( disable :4324 )
+        struct alignas( std::hardware_destructive_interference_size ) Slot
+        {
+            T Data;
+        };
+
+        Slot m_Slots[ 3 ];
+
+        alignas( std::hardware_destructive_interference_size ) uint8_t m_ProducerIndex = 0;
+        alignas( std::hardware_destructive_interference_size ) uint8_t m_ConsumerIndex = 1;
+        alignas( std::hardware_destructive_interference_size ) std::atomic<uint8_t> m_Latest = 2;    // slot index | FreshFlag
+        std::atomic<uint64_t> m_DroppedCount = 0;
+#pragma warning( pop )
+    };
+
     using RenderCommandBufferIndexType                                     = uint32_t;
     constexpr RenderCommandBufferIndexType InvalidRenderCommandBufferIndex = ( std::numeric_limits<uint32_t>::max )();
 
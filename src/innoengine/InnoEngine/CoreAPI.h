@@ -8,6 +8,8 @@ namespace InnoEngine
     class GPURenderer;
     class Profiler;
     class InputSystem;
+    class DebugDraw;
+    class JobSystem;
 
     class CoreAPI
     {
@@ -57,12 +59,27 @@ namespace InnoEngine
             return get_instance().m_Input;
         }
 
+        static JobSystem* get_jobsystem()
+        {
+            IE_ASSERT( get_instance().m_JobSystem != nullptr );
+            return get_instance().m_JobSystem;
+        }
+
+        // only available with IE_ENABLE_DEBUG_DRAW
+        static DebugDraw* get_debugdraw()
+        {
+            IE_ASSERT( get_instance().m_DebugDraw != nullptr );
+            return get_instance().m_DebugDraw;
+        }
+
     private:
         Application*  m_App          = nullptr;
         AssetManager* m_AssetManager = nullptr;
         GPURenderer*  m_Renderer     = nullptr;
         Profiler*     m_Profiler     = nullptr;
         InputSystem*  m_Input        = nullptr;
+        DebugDraw*    m_DebugDraw    = nullptr;
+        JobSystem*    m_JobSystem    = nullptr;
     };
 
 }    // namespace InnoEngine
@@ -31,6 +31,15 @@ namespace InnoEngine
     void DebugUI::render( float interp_factor, GPURenderer* renderer )
     {
         (void)interp_factor;
+
+        const uint64_t now = SDL_GetTicksNS();
+        if ( m_RebuildRequested == false && m_RefreshRate != 0 && now - m_LastRebuild < SDL_NS_PER_SECOND / m_RefreshRate ) {
+            renderer->replay_imgui_draw_data();
+            return;
+        }
+        m_RebuildRequested = false;
+        m_LastRebuild      = now;
+
         imgui_begin_frame();
 
         set_style();
@@ -48,6 +57,7 @@ namespace InnoEngine
                 if ( ImGui::BeginTabItem( "Overview" ) ) {
                     ImGui::Text( "Driver: %s", renderer->get_devicedriver(), app->get_fps() );
                     ImGui::Text( "VSync: %s", renderer->vsync_enabled() ? "Enabled" : "Disabled" );
+                    ImGui::Text( "GPU Culling: %s", renderer->gpu_culling_enabled() ? "Enabled" : "Disabled" );
 
                     ImGui::Text( "FPS: %.0f", app->get_fps() );
                     ImGui::Text( "Frame Time: %.2f ms", app->get_timing( ProfilePoint::MainThreadTotal ) * 1000 );
@@ -63,6 +73,23 @@ namespace InnoEngine
                     ImGui::Text( "Pipeline commands: %u", render_stats.TotalCommands );
                     ImGui::Text( "Command buffer size : %.2f MB", static_cast<float>( render_stats.TotalBufferSize ) / 1024 / 1024 );
                     ImGui::Text( "SDL draw calls : %u", render_stats.TotalDrawCalls );
+                    if ( app->running_mutithreaded() ) {
+                        ImGui::Text( "Dropped frames : %llu", static_cast<unsigned long long>( renderer->get_dropped_frame_count() ) );
+                    }
+
+                    ImGui::NewLine();
+                    ImGui::Text( "Sprite GPU buffers : %.2f MB (peak %.2f MB)",
+                                 static_cast<float>( render_stats.SpriteGPUBufferSize ) / 1024 / 1024,
+                                 static_cast<float>( render_stats.SpriteGPUBufferPeakSize ) / 1024 / 1024 );
+                    ImGui::Text( "Primitive GPU buffers : %.2f MB (peak %.2f MB)",
+                                 static_cast<float>( render_stats.PrimitivesGPUBufferSize ) / 1024 / 1024,
+                                 static_cast<float>( render_stats.PrimitivesGPUBufferPeakSize ) / 1024 / 1024 );
+                    ImGui::Text( "Font GPU buffers : %.2f MB (peak %.2f MB)",
+                                 static_cast<float>( render_stats.FontGPUBufferSize ) / 1024 / 1024,
+                                 static_cast<float>( render_stats.FontGPUBufferPeakSize ) / 1024 / 1024 );
+                    ImGui::Text( "Tilemap GPU buffers : %.2f MB", static_cast<float>( render_stats.TilemapGPUBufferSize ) / 1024 / 1024 );
+                    ImGui::Text( "Particle GPU buffers : %.2f MB", static_cast<float>( render_stats.ParticleGPUBufferSize ) / 1024 / 1024 );
+                    ImGui::Text( "Text layouts : %zu cached, %zu laid out", render_stats.TextLayoutCacheHits, render_stats.TextLayoutCacheMisses );
                     ImGui::EndTabItem();
                 }
 
@@ -129,9 +156,9 @@ namespace InnoEngine
                             ImGui::TableNextColumn();
 
                             ImGui::Unindent();
-                            ImGui::Text( "Wait and Sync:" );
+                            ImGui::Text( "Wait for frame:" );
                             ImGui::TableNextColumn();
-                            ImGui::Text( "%.2f ms", app->get_timing( ProfilePoint::WaitAndSynchronize ) * 1000 );
+                            ImGui::Text( "%.2f ms", app->get_timing( ProfilePoint::RenderThreadStall ) * 1000 );
                             ImGui::TableNextColumn();
 
                             ImGui::Separator();
@@ -143,6 +170,11 @@ namespace InnoEngine
                             ImGui::TableNextColumn();
 
                             ImGui::Indent();
+                            ImGui::Text( "Wait for sync:" );
+                            ImGui::TableNextColumn();
+                            ImGui::Text( "%.2f ms", app->get_timing( ProfilePoint::UpdateThreadStall ) * 1000 );
+                            ImGui::TableNextColumn();
+
                             ImGui::Text( "Layers:" );
                             ImGui::TableNextColumn();
                             ImGui::Text( "%.2f ms", ( app->get_timing( ProfilePoint::LayerUpdate ) + app->get_timing( ProfilePoint::LayerRender ) ) * 1000 );
@@ -194,27 +226,50 @@ namespace InnoEngine
         ImGui_ImplSDL3_ProcessEvent( &event );
 
         if ( event.type == SDL_EVENT_KEY_DOWN ) {
-            if ( event.key.scancode == SDL_SCANCODE_GRAVE )
-                m_open = !m_open;
+            if ( event.key.scancode == SDL_SCANCODE_GRAVE ) {
+                m_open             = !m_open;
+                m_RebuildRequested = true;
+            }
         }
 
+        // everything the overlay reacts to shows up with the next frame, not the next rebuild
         switch ( event.type ) {
         case SDL_EVENT_MOUSE_MOTION:
         case SDL_EVENT_MOUSE_WHEEL:
         case SDL_EVENT_MOUSE_BUTTON_DOWN:
         case SDL_EVENT_MOUSE_BUTTON_UP:
-            if ( ImGui::GetIO().WantCaptureMouse )
+            if ( ImGui::GetIO().WantCaptureMouse ) {
+                m_RebuildRequested = true;
                 return true;
+            }
             break;
         case SDL_EVENT_TEXT_INPUT:
         case SDL_EVENT_KEY_DOWN:
         case SDL_EVENT_KEY_UP:
-            if ( ImGui::GetIO().WantCaptureKeyboard )
+            if ( ImGui::GetIO().WantCaptureKeyboard ) {
+                m_RebuildRequested = true;
                 return true;
+            }
+            break;
+        case SDL_EVENT_WINDOW_RESIZED:
+        case SDL_EVENT_WINDOW_PIXEL_SIZE_CHANGED:
+            m_RebuildRequested = true;
+            break;
         }
         return false;
     }
 
+    void DebugUI::set_refresh_rate( uint32_t rebuilds_per_second )
+    {
+        m_RefreshRate = rebuilds_per_second;
+        request_rebuild();
+    }
+
+    void DebugUI::request_rebuild()
+    {
+        m_RebuildRequested = true;
+    }
+
     void DebugUI::set_style()
     {
         ImGuiStyle& style  = ImGui::GetStyle();
@@ -26,6 +26,11 @@ namespace InnoEngine
         void render( float interpFactor, GPURenderer* pRenderer ) override;
         bool handle_event( const SDL_Event& pEvent ) override;
 
+        // the overlay is rebuilt this many times per second and drawn again from the uploaded data in between
+        // input on the overlay and resizes rebuild it right away, 0 rebuilds every frame
+        void set_refresh_rate( uint32_t rebuilds_per_second );
+        void request_rebuild();    // with the next render, e.g. after it was not drawn for a while
+
     private:
         void set_style();
 
@@ -33,6 +38,11 @@ namespace InnoEngine
         void imgui_end_frame( GPURenderer* pRenderer );
 
     private:
-        bool m_open = false;
+        static constexpr uint32_t DefaultRefreshRate = 10;
+
+        bool     m_open             = false;
+        uint32_t m_RefreshRate      = DefaultRefreshRate;
+        uint64_t m_LastRebuild      = 0;       // SDL_GetTicksNS
+        bool     m_RebuildRequested = true;
     };
 }    // namespace InnoEngine
@@ -0,0 +1,169 @@
+#include "InnoEngine/iepch.h"
+#include "InnoEngine/graphics/DebugDraw.h"
+
+#include "InnoEngine/graphics/Renderer.h"
+
+#include "SDL3/SDL_timer.h"
+
+namespace InnoEngine
+{
+    namespace
+    {
+        constexpr float ArrowHeadAngle = DirectX::XM_PI / 6.0f;
+    }    // namespace
+
+    auto DebugDraw::create() -> std::optional<Own<DebugDraw>>
+    {
+        return Own<DebugDraw>( new DebugDraw() );
+    }
+
+    void DebugDraw::add_line( RenderContextHandle context, const DXSM::Vector2& start, const DXSM::Vector2& end, const DXSM::Color& color, DebugLifetime lifetime, float thickness )
+    {
+        get_context_shapes( context ).Lines.push_back( { start, end, color, thickness, make_lifetime( lifetime ) } );
+    }
+
+    void DebugDraw::add_arrow( RenderContextHandle context, const DXSM::Vector2& start, const DXSM::Vector2& end, const DXSM::Color& color, DebugLifetime lifetime, float thickness )
+    {
+        const DXSM::Vector2 delta  = end - start;
+        const float         length = delta.Length();
+        if ( length <= 0.0f )
+            return;
+
+        add_line( context, start, end, color, lifetime, thickness );
+
+        // two lines for the head, rotated back from the tip
+        const float         head_length = std::min( length * 0.3f, 8.0f + thickness * 2.0f );
+        const DXSM::Vector2 back        = -delta / length * head_length;
+        const float         c           = std::cos( ArrowHeadAngle );
+        const float         s           = std::sin( ArrowHeadAngle );
+        add_line( context, end, end + DXSM::Vector2( back.x * c - back.y * s, back.x * s + back.y * c ), color, lifetime, thickness );
+        add_line( context, end, end + DXSM::Vector2( back.x * c + back.y * s, -back.x * s + back.y * c ), color, lifetime, thickness );
+    }
+
+    void DebugDraw::add_circle( RenderContextHandle context, const DXSM::Vector2& center, float radius, const DXSM::Color& color, DebugLifetime lifetime, float thickness )
+    {
+        get_context_shapes( context ).Circles.push_back( { center, radius, thickness, color, make_lifetime( lifetime ) } );
+    }
+
+    void DebugDraw::add_rect( RenderContextHandle context, const DXSM::Vector2& min, const DXSM::Vector2& max, const DXSM::Color& color, DebugLifetime lifetime, float thickness )
+    {
+        get_context_shapes( context ).Rects.push_back( { min, max, color, thickness, make_lifetime( lifetime ) } );
+    }
+
+    void DebugDraw::add_point( RenderContextHandle context, const DXSM::Vector2& position, const DXSM::Color& color, DebugLifetime lifetime, float size )
+    {
+        add_circle( context, position, size * 0.5f, color, lifetime, 0.0f );
+    }
+
+    void DebugDraw::next_update()
+    {
+        auto until_update = []( const auto& shape ) { return shape.Remaining.UntilUpdate; };
+        for ( ContextShapes& shapes : m_Contexts ) {
+            std::erase_if( shapes.Lines, until_update );
+            std::erase_if( shapes.Circles, until_update );
+            std::erase_if( shapes.Rects, until_update );
+        }
+    }
+
+    void DebugDraw::submit( GPURenderer* renderer )
+    {
+        IE_ASSERT( renderer != nullptr );
+
+        const uint64_t now             = SDL_GetTicksNS();
+        const float    elapsed_seconds = m_LastSubmitTicks == 0 ? 0.0f : static_cast<float>( static_cast<double>( now - m_LastSubmitTicks ) / SDL_NS_PER_SECOND );
+        m_LastSubmitTicks              = now;
+
+        // on top of everything the layers have drawn
+        const uint16_t previous_layer = RenderContext::get_current_depth_layer();
+        RenderContext::use_specific_depth_layer( std::numeric_limits<uint16_t>::max() );
+
+        for ( ContextShapes& shapes : m_Contexts ) {
+            if ( shapes.Lines.empty() && shapes.Circles.empty() && shapes.Rects.empty() )
+                continue;
+
+            // recorded into the commands the context already has this frame, acquiring it again would add a second pass
+            // shapes of a context nobody acquired this frame wait for the next one
+            const RenderContext* render_ctx = renderer->get_acquired_rendercontext( shapes.Context );
+            if ( render_ctx == nullptr )
+                continue;
+
+            for ( const Line& line : shapes.Lines ) {
+                render_ctx->add_line( line.Start, line.End, line.Color, line.Thickness );
+            }
+
+            for ( const Circle& circle : shapes.Circles ) {
+                // the circle pipeline takes thickness and fade relative to the radius
+                const float radius    = std::max( circle.Radius, 0.001f );
+                const float thickness = circle.Thickness <= 0.0f ? 1.0f : std::min( circle.Thickness / radius, 1.0f );
+                render_ctx->add_circle( circle.Center, radius, circle.Color, thickness, std::min( 1.0f / radius, 0.5f ) );
+            }
+
+            for ( const Rect& rect : shapes.Rects ) {
+                if ( rect.Thickness <= 0.0f ) {
+                    render_ctx->add_quad( rect.Min, Origin::BottomLeft, rect.Max - rect.Min, rect.Color );
+                    continue;
+                }
+
+                const std::vector<DXSM::Vector2> corners = { rect.Min, { rect.Max.x, rect.Min.y }, rect.Max, { rect.Min.x, rect.Max.y } };
+                render_ctx->add_polyline( corners, rect.Color, rect.Thickness, LineJoin::Miter, LineCap::Butt, true );
+            }
+
+            remove_expired( shapes.Lines, elapsed_seconds );
+            remove_expired( shapes.Circles, elapsed_seconds );
+            remove_expired( shapes.Rects, elapsed_seconds );
+        }
+
+        RenderContext::use_specific_depth_layer( previous_layer );
+    }
+
+    void DebugDraw::clear()
+    {
+        for ( ContextShapes& shapes : m_Contexts ) {
+            shapes.Lines.clear();
+            shapes.Circles.clear();
+            shapes.Rects.clear();
+        }
+    }
+
+    size_t DebugDraw::get_shape_count() const
+    {
+        size_t count = 0;
+        for ( const ContextShapes& shapes : m_Contexts ) {
+            count += shapes.Lines.size() + shapes.Circles.size() + shapes.Rects.size();
+        }
+        return count;
+    }
+
+    DebugDraw::ContextShapes& DebugDraw::get_context_shapes( RenderContextHandle context )
+    {
+        // only a handful of contexts, a linear search is fine
+        for ( ContextShapes& shapes : m_Contexts ) {
+            if ( shapes.Context == context )
+                return shapes;
+        }
+
+        ContextShapes& shapes = m_Contexts.emplace_back();
+        shapes.Context        = context;
+        return shapes;
+    }
+
+    DebugDraw::Lifetime DebugDraw::make_lifetime( DebugLifetime lifetime )
+    {
+        const bool until_update = lifetime.Seconds <= 0.0f && lifetime.Frames == 0;
+        return { lifetime.Seconds, std::max( lifetime.Frames, 1u ), until_update };
+    }
+
+    template <typename T>
+    void DebugDraw::remove_expired( std::vector<T>& shapes, float elapsed_seconds )
+    {
+        std::erase_if( shapes, [ elapsed_seconds ]( T& shape ) {
+            if ( shape.Remaining.UntilUpdate )
+                return false;
+
+            shape.Remaining.Seconds -= elapsed_seconds;
+            if ( shape.Remaining.Frames > 0 )
+                --shape.Remaining.Frames;
+            return shape.Remaining.Frames == 0 && shape.Remaining.Seconds <= 0.0f;
+        } );
+    }
+}    // namespace InnoEngine
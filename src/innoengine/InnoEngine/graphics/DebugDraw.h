@@ -0,0 +1,152 @@
+#pragma once
+#include "InnoEngine/BaseTypes.h"
+#include "InnoEngine/CoreAPI.h"
+#include "InnoEngine/graphics/RenderContext.h"
+
+#include <optional>
+#include <vector>
+
+#ifdef _DEBUG
+    #define IE_ENABLE_DEBUG_DRAW
+#endif
+
+namespace InnoEngine
+{
+    class GPURenderer;
+
+    // a shape stays until its seconds have passed and it was drawn in at least the given amount of frames
+    // without either it stays until the next simulation step, so shapes added every update don't flicker
+    // when more frames than simulation steps get rendered
+    struct DebugLifetime
+    {
+        float    Seconds = 0.0f;
+        uint32_t Frames  = 0;
+
+        static constexpr DebugLifetime seconds( float seconds ) { return { seconds, 1 }; }
+        static constexpr DebugLifetime frames( uint32_t frames ) { return { 0.0f, frames }; }
+        static constexpr DebugLifetime next_update() { return { 0.0f, 0 }; }
+    };
+
+    // retained shapes for debugging, only to be used from the update thread like the layers
+    // use the IE_DEBUG_ macros, they compile to nothing without IE_ENABLE_DEBUG_DRAW
+    class DebugDraw
+    {
+        DebugDraw() = default;
+
+    public:
+        static auto create() -> std::optional<Own<DebugDraw>>;
+
+        void add_line( RenderContextHandle  context,
+                       const DXSM::Vector2& start,
+                       const DXSM::Vector2& end,
+                       const DXSM::Color&   color,
+                       DebugLifetime        lifetime  = {},
+                       float                thickness = 1.0f );
+
+        void add_arrow( RenderContextHandle  context,
+                        const DXSM::Vector2& start,
+                        const DXSM::Vector2& end,
+                        const DXSM::Color&   color,
+                        DebugLifetime        lifetime  = {},
+                        float                thickness = 1.0f );
+
+        void add_circle( RenderContextHandle  context,
+                         const DXSM::Vector2& center,
+                         float                radius,
+                         const DXSM::Color&   color,
+                         DebugLifetime        lifetime  = {},
+                         float                thickness = 1.0f );    // 0 fills the circle
+
+        void add_rect( RenderContextHandle  context,
+                       const DXSM::Vector2& min,
+                       const DXSM::Vector2& max,
+                       const DXSM::Color&   color,
+                       DebugLifetime        lifetime  = {},
+                       float                thickness = 1.0f );    // 0 fills the rect
+
+        void add_point( RenderContextHandle  context,
+                        const DXSM::Vector2& position,
+                        const DXSM::Color&   color,
+                        DebugLifetime        lifetime = {},
+                        float                size     = 4.0f );
+
+        // drops the shapes living until the next simulation step, called by the application before the layers update
+        void next_update();
+
+        // draws the shapes on top of the contexts the layers acquired this frame and drops the expired ones
+        // called by the application after the layers
+        void submit( GPURenderer* renderer );
+        void clear();
+
+        size_t get_shape_count() const;
+
+    private:
+        struct Lifetime
+        {
+            float    Seconds;
+            uint32_t Frames;
+            bool     UntilUpdate;
+        };
+
+        struct Line
+        {
+            DXSM::Vector2 Start;
+            DXSM::Vector2 End;
+            DXSM::Color   Color;
+            float         Thickness;
+            Lifetime      Remaining;
+        };
+
+        struct Circle
+        {
+            DXSM::Vector2 Center;
+            float         Radius;
+            float         Thickness;
+            DXSM::Color   Color;
+            Lifetime      Remaining;
+        };
+
+        struct Rect
+        {
+            DXSM::Vector2 Min;
+            DXSM::Vector2 Max;
+            DXSM::Color   Color;
+            float         Thickness;
+            Lifetime      Remaining;
+        };
+
+        // every context keeps its shapes in contiguous arrays, so it gets submitted in one go
+        struct ContextShapes
+        {
+            RenderContextHandle Context;
+            std::vector<Line>   Lines;
+            std::vector<Circle> Circles;
+            std::vector<Rect>   Rects;
+        };
+
+        ContextShapes& get_context_shapes( RenderContextHandle context );
+
+        static Lifetime make_lifetime( DebugLifetime lifetime );
+
+        template <typename T>
+        static void remove_expired( std::vector<T>& shapes, float elapsed_seconds );
+
+    private:
+        std::vector<ContextShapes> m_Contexts;
+        uint64_t                   m_LastSubmitTicks = 0;
+    };
+}    // namespace InnoEngine
+
+#ifdef IE_ENABLE_DEBUG_DRAW
+    #define IE_DEBUG_LINE( ... )   InnoEngine::CoreAPI::get_debugdraw()->add_line( __VA_ARGS__ )
+    #define IE_DEBUG_ARROW( ... )  InnoEngine::CoreAPI::get_debugdraw()->add_arrow( __VA_ARGS__ )
+    #define IE_DEBUG_CIRCLE( ... ) InnoEngine::CoreAPI::get_debugdraw()->add_circle( __VA_ARGS__ )
+    #define IE_DEBUG_RECT( ... )   InnoEngine::CoreAPI::get_debugdraw()->add_rect( __VA_ARGS__ )
+    #define IE_DEBUG_POINT( ... )  InnoEngine::CoreAPI::get_debugdraw()->add_point( __VA_ARGS__ )
+#else
+    #define IE_DEBUG_LINE( ... )
+    #define IE_DEBUG_ARROW( ... )
+    #define IE_DEBUG_CIRCLE( ... )
+    #define IE_DEBUG_RECT( ... )
+    #define IE_DEBUG_POINT( ... )
+#endif
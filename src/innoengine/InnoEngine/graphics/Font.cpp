@@ -8,12 +8,283 @@
 #include "InnoEngine/graphics/Texture2D.h"
 
 #include "InnoEngine/graphics/MSDFData.h"
+#include "InnoEngine/graphics/GlyphAtlas.h"
+#include "InnoEngine/utility/Hash.h"
+#include "InnoEngine/utility/MappedFile.h"
+#include "InnoEngine/utility/JobSystem.h"
+#include "InnoEngine/CoreAPI.h"
 
 namespace InnoEngine
 {
+    // shared with the generation jobs, so it outlives a font that gets unloaded early
+    struct FontAtlasBake
+    {
+        Own<MappedFile>            FontFile;    // only until the glyphs are loaded
+        std::filesystem::path      FontPath;
+        std::filesystem::path      CachePath;
+        uint64_t                   FontHash = 0;
+        Ref<MSDFData>              Data     = std::make_shared<MSDFData>();
+        std::vector<GlyphGeometry> Geometry;
+        std::vector<uint8_t>       Pixels;    // rgb, bottom row first
+        uint32_t                   Width  = 0;
+        uint32_t                   Height = 0;
+
+        std::atomic<uint32_t>  RemainingJobs = 0;
+        std::atomic<FontState> State         = FontState::Loading;
+    };
+
+    namespace
+    {
+        constexpr std::string_view FontCacheExtension = ".msdfcache";
+        constexpr uint32_t         FontCacheMagic     = 0x43464549;    // "IEFC"
+        constexpr uint32_t         FontCacheVersion   = 2;
+
+        // generation parameters, everything in here has to end up in get_generation_hash
+        constexpr msdf_atlas::unicode_t FirstCodepoint = 0x20;
+        constexpr msdf_atlas::unicode_t EndCodepoint   = 0xFF;
+        constexpr double                MaxCornerAngle = 3.0;
+        constexpr double                MinimumScale   = 24.0;
+        constexpr double                MiterLimit     = 1.0;
+
+        struct FontCacheHeader
+        {
+            uint32_t    Magic            = 0;
+            uint32_t    Version          = 0;
+            uint64_t    FontHash         = 0;
+            uint64_t    ParameterHash    = 0;
+            MSDFMetrics Metrics          = {};
+            uint32_t    GlyphCount       = 0;
+            uint32_t    KerningPairCount = 0;
+            uint32_t    AtlasWidth       = 0;
+            uint32_t    AtlasHeight      = 0;
+        };
+        // followed by the glyphs, the kerning pairs and the rgb pixels
+
+        uint64_t get_generation_hash( const MSDFData& msdf_data )
+        {
+            uint64_t hash = fnv1a_value( msdf_data.Range );
+            hash          = fnv1a_value( msdf_data.Scale, hash );
+            hash          = fnv1a_value( FirstCodepoint, hash );
+            hash          = fnv1a_value( EndCodepoint, hash );
+            hash          = fnv1a_value( MaxCornerAngle, hash );
+            hash          = fnv1a_value( MinimumScale, hash );
+            hash          = fnv1a_value( MiterLimit, hash );
+            hash          = fnv1a_value( sizeof( MSDFGlyph ), hash );
+            return fnv1a_value( sizeof( MSDFKerningPair ), hash );
+        }
+
+        void write_cache( const std::filesystem::path& cache_path, uint64_t font_hash, const MSDFData& msdf_data, const void* pixels, uint32_t width, uint32_t height )
+        {
+            FontCacheHeader header  = {};
+            header.Magic            = FontCacheMagic;
+            header.Version          = FontCacheVersion;
+            header.FontHash         = font_hash;
+            header.ParameterHash    = get_generation_hash( msdf_data );
+            header.Metrics          = msdf_data.Metrics;
+            header.GlyphCount       = static_cast<uint32_t>( msdf_data.Glyphs.size() );
+            header.KerningPairCount = static_cast<uint32_t>( msdf_data.KerningPairs.size() );
+            header.AtlasWidth       = width;
+            header.AtlasHeight      = height;
+
+            // write to a temporary file first, so an interrupted write never leaves a broken cache behind
+            std::filesystem::path temp_path = cache_path;
+            temp_path += ".tmp";
+
+            {
+                std::ofstream file( temp_path, std::ios::binary | std::ios::trunc );
+                file.write( reinterpret_cast<const char*>( &header ), sizeof( header ) );
+                file.write( reinterpret_cast<const char*>( msdf_data.Glyphs.data() ), msdf_data.Glyphs.size() * sizeof( MSDFGlyph ) );
+                file.write( reinterpret_cast<const char*>( msdf_data.KerningPairs.data() ), msdf_data.KerningPairs.size() * sizeof( MSDFKerningPair ) );
+                file.write( static_cast<const char*>( pixels ), static_cast<std::streamsize>( width ) * height * 3 );
+
+                if ( file.good() == false ) {
+                    IE_LOG_WARNING( "Writing font cache \"{}\" failed", cache_path.string() );
+                    file.close();
+                    std::error_code error;
+                    std::filesystem::remove( temp_path, error );
+                    return;
+                }
+            }
+
+            std::error_code error;
+            std::filesystem::rename( temp_path, cache_path, error );
+            if ( error )
+                IE_LOG_WARNING( "Writing font cache \"{}\" failed: {}", cache_path.string(), error.message() );
+        }
+
+        // loads the charset and packs the atlas, the pixels get generated by bake_glyphs afterwards
+        bool prepare_bake( FontAtlasBake& bake )
+        {
+            msdfgen::FreetypeHandle* freetype = msdfgen::initializeFreetype();
+            IE_ASSERT( freetype != nullptr );
+
+            msdfgen::FontHandle* font = msdfgen::loadFontData( freetype, reinterpret_cast<const msdfgen::byte*>( bake.FontFile->data() ), static_cast<int>( bake.FontFile->size() ) );
+            if ( font == nullptr ) {
+                msdfgen::deinitializeFreetype( freetype );
+                return false;
+            }
+
+            // FontGeometry is a helper class that loads a set of glyphs from a single font.
+            // It can also be used to get additional font metrics, kerning information, etc.
+            FontGeometry font_geometry( &bake.Geometry );
+
+            msdf_atlas::Charset charset;
+            for ( msdf_atlas::unicode_t c = FirstCodepoint; c < EndCodepoint; ++c ) {
+                charset.add( c );
+            }
+
+            font_geometry.loadCharset( font, 1.0, charset );
+
+            // the shapes are copied into the geometry, the font is not needed anymore
+            msdfgen::destroyFont( font );
+            msdfgen::deinitializeFreetype( freetype );
+            bake.FontFile.reset();
+
+            if ( bake.Geometry.empty() )
+                return false;
+
+            // Apply MSDF edge coloring. See edge-coloring.h for other coloring strategies.
+            for ( GlyphGeometry& glyph : bake.Geometry )
+                glyph.edgeColoring( &msdfgen::edgeColoringInkTrap, MaxCornerAngle, 0 );
+
+            // TightAtlasPacker class computes the layout of the atlas.
+            TightAtlasPacker packer;
+
+            // Set atlas parameters:
+            // setDimensions or setDimensionsConstraint to find the best value
+            packer.setDimensionsConstraint( DimensionsConstraint::SQUARE );
+
+            // setScale for a fixed size or setMinimumScale to use the largest that fits
+            packer.setMinimumScale( MinimumScale );
+
+            // setPixelRange or setUnitRange
+            MSDFData& msdf_data = *bake.Data;
+            packer.setPixelRange( msdf_data.Range );
+            packer.setMiterLimit( MiterLimit );
+            packer.setScale( msdf_data.Scale );
+
+            // Compute atlas layout - pack glyphs
+            packer.pack( bake.Geometry.data(), static_cast<int>( bake.Geometry.size() ) );
+
+            // Get final atlas dimensions
+            int width = 0, height = 0;
+            packer.getDimensions( width, height );
+            if ( width <= 0 || height <= 0 )
+                return false;
+
+            bake.Width  = static_cast<uint32_t>( width );
+            bake.Height = static_cast<uint32_t>( height );
+            bake.Pixels.assign( static_cast<size_t>( width ) * height * 3, 0 );
+
+            // copy everything we need for typesetting into our own data, so it can be cached
+            const msdfgen::FontMetrics& metrics = font_geometry.getMetrics();
+            msdf_data.Metrics.LineHeight        = static_cast<float>( metrics.lineHeight );
+            msdf_data.Metrics.AscenderY         = static_cast<float>( metrics.ascenderY );
+            msdf_data.Metrics.DescenderY        = static_cast<float>( metrics.descenderY );
+
+            std::unordered_map<int, msdf_atlas::unicode_t> index_to_codepoint;
+
+            msdf_data.Glyphs.clear();
+            msdf_data.Glyphs.reserve( bake.Geometry.size() );
+            for ( const GlyphGeometry& geometry : bake.Geometry ) {
+                MSDFGlyph& glyph = msdf_data.Glyphs.emplace_back();
+                glyph.Codepoint  = geometry.getCodepoint();
+                glyph.Advance    = static_cast<float>( geometry.getAdvance() );
+
+                double l, b, r, t;
+                geometry.getQuadPlaneBounds( l, b, r, t );
+                glyph.PlaneBounds = DXSM::Vector4( static_cast<float>( l ), static_cast<float>( b ), static_cast<float>( r ), static_cast<float>( t ) );
+                geometry.getQuadAtlasBounds( l, b, r, t );
+                glyph.AtlasBounds = DXSM::Vector4( static_cast<float>( l ), static_cast<float>( b ), static_cast<float>( r ), static_cast<float>( t ) );
+
+                index_to_codepoint[ geometry.getIndex() ] = glyph.Codepoint;
+            }
+            std::sort( msdf_data.Glyphs.begin(), msdf_data.Glyphs.end(), []( const MSDFGlyph& a, const MSDFGlyph& b ) { return a.Codepoint < b.Codepoint; } );
+
+            // msdf keys the kerning by glyph index, we need it by codepoint
+            msdf_data.KerningPairs.clear();
+            for ( const auto& [ indices, kerning ] : font_geometry.getKerning() ) {
+                auto first  = index_to_codepoint.find( indices.first );
+                auto second = index_to_codepoint.find( indices.second );
+                if ( first == index_to_codepoint.end() || second == index_to_codepoint.end() )
+                    continue;
+
+                msdf_data.KerningPairs.push_back( { first->second, second->second, static_cast<float>( kerning ) } );
+            }
+            return true;
+        }
+
+        // the boxes of the glyphs never overlap, so every job writes its own part of the atlas
+        void bake_glyphs( FontAtlasBake& bake, size_t first, size_t end )
+        {
+            const GeneratorAttributes attributes;
+            for ( size_t i = first; i < end; ++i ) {
+                const GlyphGeometry& geometry = bake.Geometry[ i ];
+
+                int box_x, box_y, box_width, box_height;
+                geometry.getBoxRect( box_x, box_y, box_width, box_height );
+                if ( geometry.isWhitespace() || box_width <= 0 || box_height <= 0 )
+                    continue;
+
+                msdfgen::Bitmap<float, 3> bitmap( box_width, box_height );
+                msdfGenerator( bitmap, geometry, attributes );
+
+                // same row order as the bitmap, bottom row first
+                for ( int y = 0; y < box_height; ++y ) {
+                    uint8_t* write = bake.Pixels.data() + ( static_cast<size_t>( box_y + y ) * bake.Width + box_x ) * 3;
+                    for ( int x = 0; x < box_width; ++x ) {
+                        const float* pixel = bitmap( x, y );
+                        *write++           = msdfgen::pixelFloatToByte( pixel[ 0 ] );
+                        *write++           = msdfgen::pixelFloatToByte( pixel[ 1 ] );
+                        *write++           = msdfgen::pixelFloatToByte( pixel[ 2 ] );
+                    }
+                }
+            }
+        }
+
+        void finish_bake( FontAtlasBake& bake )
+        {
+            write_cache( bake.CachePath, bake.FontHash, *bake.Data, bake.Pixels.data(), bake.Width, bake.Height );
+            bake.State.store( FontState::Ready, std::memory_order_release );
+        }
+
+        // splits the glyphs over the workers of the job system, one job per worker
+        void run_bake( const Ref<FontAtlasBake>& bake, JobSystem* job_system )
+        {
+            if ( prepare_bake( *bake ) == false ) {
+                bake->State.store( FontState::Failed, std::memory_order_release );
+                return;
+            }
+
+            const size_t   glyph_count = bake->Geometry.size();
+            const uint32_t job_count   = static_cast<uint32_t>( std::min<size_t>( job_system->get_thread_count(), glyph_count ) );
+            if ( job_count <= 1 ) {
+                bake_glyphs( *bake, 0, glyph_count );
+                finish_bake( *bake );
+                return;
+            }
+
+            bake->RemainingJobs.store( job_count, std::memory_order_relaxed );
+            for ( uint32_t i = 0; i < job_count; ++i ) {
+                const size_t first = glyph_count * i / job_count;
+                const size_t end   = glyph_count * ( i + 1 ) / job_count;
+                job_system->submit( [ bake, first, end ] {
+                    bake_glyphs( *bake, first, end );
+
+                    // the last job publishes the atlas
+                    if ( bake->RemainingJobs.fetch_sub( 1, std::memory_order_acq_rel ) == 1 )
+                        finish_bake( *bake );
+                } );
+            }
+        }
+    }    // namespace
+
+    std::atomic<uint32_t> Font::ms_NextID = 1;
+
     Font::Font()
     {
         m_msdfData = std::make_shared<MSDFData>();
+        m_ID       = ms_NextID.fetch_add( 1, std::memory_order_relaxed );
     }
 
     auto Font::create() -> std::optional<Ref<Font>>
@@ -22,6 +293,21 @@ namespace InnoEngine
         return Ref<Font>();
     }
 
+    uint32_t Font::get_id() const
+    {
+        return m_ID;
+    }
+
+    FontState Font::get_state() const
+    {
+        return m_State.load( std::memory_order_acquire );
+    }
+
+    bool Font::is_ready() const
+    {
+        return get_state() == FontState::Ready;
+    }
+
     Ref<Texture2D> Font::get_atlas_texture() const
     {
         return m_AtlasTexture;
@@ -38,80 +324,56 @@ namespace InnoEngine
         return FontSize / m_msdfData->Scale * m_msdfData->Range;
     }
 
-    DXSM::Vector4 Font::get_aabb( uint32_t size, std::string_view text ) const
+    GlyphStatus Font::find_glyph( char32_t codepoint, MSDFGlyph& glyph ) const
     {
-        DXSM::Vector4 aabb( std::numeric_limits<float>::max(), std::numeric_limits<float>::min(),
-                            std::numeric_limits<float>::min(), std::numeric_limits<float>::max() );
+        IE_ASSERT( m_msdfData != nullptr );
+        if ( const MSDFGlyph* baked_glyph = m_msdfData->get_glyph( codepoint ) ) {
+            glyph = *baked_glyph;
+            return GlyphStatus::Available;
+        }
 
-        const msdf_atlas::FontGeometry* font_geometry       = &m_msdfData->FontGeo;
-        const msdfgen::FontMetrics*     metrics             = &font_geometry->getMetrics();
-        double                          space_glyph_advance = m_msdfData->get_glyph( ' ' )->getAdvance();
-        double                          scale               = 1.0 / ( metrics->ascenderY - metrics->descenderY ) * size;
+        // the baked charset already tried everything below EndCodepoint
+        if ( codepoint < EndCodepoint || m_GlyphAtlas == nullptr )
+            return GlyphStatus::Missing;
 
-        double x = 0.0;
-        double y = 0.0;
+        return m_GlyphAtlas->request_glyph( codepoint, glyph );
+    }
 
-        for ( uint32_t i = 0; i < text.length(); ++i ) {
-            char character = text[ i ];
+    Ref<Texture2D> Font::get_page_texture( uint32_t page ) const
+    {
+        if ( page == 0 )
+            return m_AtlasTexture;
 
-            IE_ASSERT( character != '\0' );
+        IE_ASSERT( m_GlyphAtlas != nullptr );
+        return m_GlyphAtlas->get_page_texture( page );
+    }
 
-            if ( character == '\n' ) {
-                x = 0.0;
-                y += scale * metrics->lineHeight;
-                continue;
-            }
+    uint32_t Font::get_glyph_generation() const
+    {
+        return m_GlyphAtlas ? m_GlyphAtlas->get_generation() : 0;
+    }
 
-            if ( character == ' ' ) {
-                double advance = space_glyph_advance;
-                if ( i < text.length() - 1 ) {
-                    char nextCharacter = text[ i + 1 ];
-                    m_msdfData->get_advance( advance, character, nextCharacter );
-                }
+    void Font::touch_glyph_pages( uint64_t page_mask ) const
+    {
+        if ( m_GlyphAtlas && page_mask > 1 )
+            m_GlyphAtlas->touch_pages( page_mask );
+    }
 
-                x += scale * advance;
-                continue;
-            }
+    void Font::upload_glyphs( SDL_GPUCopyPass* copy_pass, uint64_t frame )
+    {
+        if ( m_Bake )
+            finish_generation();
 
-            if ( character == '\t' ) {
-                x += 4.0 * ( scale * space_glyph_advance );
-                continue;
-            }
+        if ( m_GlyphAtlas )
+            m_GlyphAtlas->upload_pending( copy_pass, frame );
+    }
 
-            const msdf_atlas::GlyphGeometry* glyph = m_msdfData->get_glyph( character );
-            if ( !glyph )
-                glyph = m_msdfData->get_glyph( '?' );
-            if ( !glyph )
-                continue;
-
-            double pl, pb, pr, pt;
-            glyph->getQuadPlaneBounds( pl, pb, pr, pt );
-            float left = static_cast<float>( x + pl * scale );
-            if ( left < aabb.x )
-                aabb.x = left;
-
-            float bottom = static_cast<float>( y + ( pb * scale ) * -1 );
-            if ( bottom > aabb.y )
-                aabb.y = bottom;
-
-            float right = static_cast<float>( x + pr * scale );
-            if ( right > aabb.z )
-                aabb.z = right;
-
-            float top = static_cast<float>( y + ( pt * scale ) * -1 );
-            if ( top < aabb.w )
-                aabb.w = top;
-
-            if ( i < text.length() - 1 ) {
-                double advance       = glyph->getAdvance();
-                char   nextCharacter = text[ i + 1 ];
-                m_msdfData->get_advance( advance, character, nextCharacter );
-                x += scale * advance;
-            }
-        }
-        // aabb.z += aabb.x;
-        // aabb.w += aabb.y;
-        return aabb;
+    DXSM::Vector4 Font::get_aabb( uint32_t size, std::string_view text, const TextLayoutOptions& options ) const
+    {
+        // keeps the allocations around, measuring happens every frame
+        thread_local TextLayout layout;
+        TextLayout::build( *this, size, text, options, layout );
+        return layout.Bounds;
     }
 
     Result Font::load_asset( const std::filesystem::path& full_path )
@@ -120,123 +382,133 @@ namespace InnoEngine
             return Result::AlreadyInitialized;
         }
 
-        msdfgen::FreetypeHandle* freetype = msdfgen::initializeFreetype();
-        IE_ASSERT( freetype != nullptr );
-
-        msdfgen::FontHandle* font = msdfgen::loadFont( freetype, full_path.string().c_str() );
-        IE_ASSERT( font != nullptr );
+        auto font_file = MappedFile::create( full_path );
+        if ( font_file.has_value() == false ) {
+            IE_LOG_ERROR( "Loading font \"{}\" failed: file could not be opened", full_path.string() );
+            return Result::Fail;
+        }
 
-        m_msdfData->FontGeo = FontGeometry( &m_msdfData->GlyphGeo );
+        const uint64_t        font_hash  = fnv1a( font_file.value()->view() );
+        std::filesystem::path cache_path = full_path;
+        cache_path += FontCacheExtension;
 
-        // Load a set of character glyphs:
-        // The second argument can be ignored unless you mix different font sizes in one atlas.
-        // In the last argument, you can specify a charset other than ASCII.
-        // To load specific glyph indices, use loadGlyphs instead.
+        m_Initialized = true;
 
-        msdf_atlas::Charset charset;
-        for ( unsigned char c = 0x20; c < 0xFF; ++c ) {
-            charset.add( c );
+        if ( IE_SUCCESS( load_cache( cache_path, font_hash ) ) ) {
+            IE_LOG_DEBUG( "Loaded font {}", full_path.string() );
+            finish_loading( full_path );
+            return Result::Success;
         }
 
-        m_msdfData->FontGeo.loadCharset( font, 1.0, charset );
-
-        // Apply MSDF edge coloring. See edge-coloring.h for other coloring strategies.
-        const double maxCornerAngle = 3.0;
-        for ( GlyphGeometry& glyph : m_msdfData->GlyphGeo )
-            glyph.edgeColoring( &msdfgen::edgeColoringInkTrap, maxCornerAngle, 0 );
+        // takes seconds, the font stays in the loading state until the renderer picks up the atlas
+        IE_LOG_DEBUG( "Generating atlas for font {}", full_path.string() );
+        generate_atlas( std::move( font_file.value() ), full_path, cache_path, font_hash );
+        return Result::Success;
+    }
 
-        // TightAtlasPacker class computes the layout of the atlas.
-        TightAtlasPacker packer;
+    void Font::generate_atlas( Own<MappedFile> font_file, const std::filesystem::path& font_path, const std::filesystem::path& cache_path, uint64_t font_hash )
+    {
+        m_Bake            = std::make_shared<FontAtlasBake>();
+        m_Bake->FontFile  = std::move( font_file );
+        m_Bake->FontPath  = font_path;
+        m_Bake->CachePath = cache_path;
+        m_Bake->FontHash  = font_hash;
+
+        JobSystem* job_system = CoreAPI::get_jobsystem();
+        job_system->submit( [ bake = m_Bake, job_system ] { run_bake( bake, job_system ); } );
+    }
 
-        // Set atlas parameters:
-        // setDimensions or setDimensionsConstraint to find the best value
-        packer.setDimensionsConstraint( DimensionsConstraint::SQUARE );
+    void Font::finish_generation()
+    {
+        IE_ASSERT( m_Bake != nullptr );
 
-        // setScale for a fixed size or setMinimumScale to use the largest that fits
-        packer.setMinimumScale( 24.0 );
+        const FontState state = m_Bake->State.load( std::memory_order_acquire );
+        if ( state == FontState::Loading )
+            return;
 
-        // setPixelRange or setUnitRange
-        packer.setPixelRange( m_msdfData->Range );
-        packer.setMiterLimit( 1.0 );
-        packer.setScale( m_msdfData->Scale );
+        Ref<FontAtlasBake> bake = std::move( m_Bake );
+        if ( state == FontState::Failed || IE_FAILED( create_atlas_texture( bake->Pixels.data(), bake->Width, bake->Height ) ) ) {
+            IE_LOG_ERROR( "Generating atlas for font \"{}\" failed", bake->FontPath.string() );
+            m_State.store( FontState::Failed, std::memory_order_release );
+            return;
+        }
 
-        // Compute atlas layout - pack glyphs
-        packer.pack( m_msdfData->GlyphGeo.data(), static_cast<int>( m_msdfData->GlyphGeo.size() ) );
+        IE_LOG_DEBUG( "Loaded font {}", bake->FontPath.string() );
+        m_msdfData = bake->Data;
+        finish_loading( bake->FontPath );
+    }
 
-        // Get final atlas dimensions
-        int width = 0, height = 0;
-        packer.getDimensions( width, height );
+    void Font::finish_loading( const std::filesystem::path& font_path )
+    {
+        m_msdfData->build_lookup_tables();
 
-        // The ImmediateAtlasGenerator class facilitates the generation of the atlas bitmap.
-        ImmediateAtlasGenerator<
-            float,                         // pixel type of buffer for individual glyphs depends on generator function
-            3,                             // number of atlas color channels
-            msdfGenerator,                 // function to generate bitmaps for individual glyphs
-            BitmapAtlasStorage<byte, 3>    // class that stores the atlas bitmap
-            // For example, a custom atlas storage class that stores it in VRAM can be used.
-            >
-            generator( width, height );
+        // everything outside of the baked charset gets generated on demand
+        m_GlyphAtlas = GlyphAtlas::create( font_path, m_msdfData->Range, m_msdfData->Scale ).value_or( nullptr );
 
-        // GeneratorAttributes can be modified to change the generator's default settings.
-        GeneratorAttributes attributes;
-        generator.setAttributes( attributes );
-        generator.setThreadCount( 8 );
+        // publishes everything above to the threads that check the state
+        m_State.store( FontState::Ready, std::memory_order_release );
+    }
 
-        // Generate atlas bitmap
-        generator.generate( m_msdfData->GlyphGeo.data(), static_cast<int>( m_msdfData->GlyphGeo.size() ) );
+    Result Font::load_cache( const std::filesystem::path& cache_path, uint64_t font_hash )
+    {
+        auto cache_file = MappedFile::create( cache_path );
+        if ( cache_file.has_value() == false )
+            return Result::Fail;
 
-        // The atlas bitmap can now be retrieved via atlasStorage as a BitmapConstRef.
-        // The glyphs array (or fontGeometry) contains positioning data for typesetting text.
-        auto bmp = static_cast<msdfgen::BitmapConstRef<byte, 3>>( generator.atlasStorage() );
+        std::span<const std::byte> data = cache_file.value()->view();
 
-        TextureSpecifications specs;
-        specs.Width        = width;
-        specs.Height       = height;
-        specs.Format       = TextureFormat::RGBX;
-        specs.EnableMipmap = true;
-        specs.RenderTarget = true;
+        FontCacheHeader header;
+        if ( data.size() < sizeof( header ) ) {
+            IE_LOG_WARNING( "Font cache \"{}\" is invalid", cache_path.string() );
+            return Result::Fail;
+        }
+        std::memcpy( &header, data.data(), sizeof( header ) );
+
+        if ( header.Magic != FontCacheMagic ||
+             header.Version != FontCacheVersion ||
+             header.FontHash != font_hash ||
+             header.ParameterHash != get_generation_hash( *m_msdfData ) ) {
+            IE_LOG_DEBUG( "Font cache \"{}\" is outdated", cache_path.string() );
+            return Result::Fail;
+        }
 
-        m_AtlasTexture = Texture2D::create( specs ).value();
-        Result res     = m_AtlasTexture->load_data( bmp.pixels, bmp.width * bmp.height, SDL_PIXELFORMAT_RGB24 );
+        const size_t glyph_bytes   = header.GlyphCount * sizeof( MSDFGlyph );
+        const size_t kerning_bytes = header.KerningPairCount * sizeof( MSDFKerningPair );
+        const size_t pixel_bytes   = static_cast<size_t>( header.AtlasWidth ) * header.AtlasHeight * 3;
+        if ( data.size() != sizeof( header ) + glyph_bytes + kerning_bytes + pixel_bytes ) {
+            IE_LOG_WARNING( "Font cache \"{}\" is invalid", cache_path.string() );
+            return Result::Fail;
+        }
 
-        // Cleanup
-        msdfgen::destroyFont( font );
-        msdfgen::deinitializeFreetype( freetype );
+        const std::byte* read = data.data() + sizeof( header );
 
-        if ( IE_SUCCESS( res ) ) {
-            IE_LOG_DEBUG( "Loaded font {}", full_path.string() );
-            m_Initialized = true;
+        m_msdfData->Metrics = header.Metrics;
+        m_msdfData->Glyphs.resize( header.GlyphCount );
+        std::memcpy( m_msdfData->Glyphs.data(), read, glyph_bytes );
+        read += glyph_bytes;
 
-            if ( m_msdfData->IsASCII ) {
-                preload_msdf_ascii_data();
-            }
+        m_msdfData->KerningPairs.resize( header.KerningPairCount );
+        std::memcpy( m_msdfData->KerningPairs.data(), read, kerning_bytes );
+        read += kerning_bytes;
 
-            /*
-            // testing
-            SDL_Surface* surface = SDL_CreateSurfaceFrom( width, height, SDL_PixelFormat::SDL_PIXELFORMAT_RGB24, const_cast<void*>( static_cast<const void*>( bmp.pixels ) ), width * 3 );
-            SDL_SaveBMP( surface, std::format( "{}.bmp", full_path.filename().string() ).c_str() );
-            SDL_DestroySurface( surface );
-            */
-        }
-        return res;
+        // the pixels get uploaded straight from the mapping
+        return create_atlas_texture( read, header.AtlasWidth, header.AtlasHeight );
     }
 
-    void Font::preload_msdf_ascii_data()
+    Result Font::create_atlas_texture( const void* pixels, uint32_t width, uint32_t height )
     {
-        IE_ASSERT( m_msdfData != nullptr );
-
-        for ( unsigned char c1 = 0; c1 < 255; ++c1 ) {
-            const msdf_atlas::GlyphGeometry* glyph     = m_msdfData->FontGeo.getGlyph( c1 );
-            m_msdfData->GlyphGeoLookuptableASCII[ c1 ] = glyph;
+        TextureSpecifications specs;
+        specs.Width        = width;
+        specs.Height       = height;
+        specs.Format       = TextureFormat::RGBX;
+        specs.EnableMipmap = true;
+        specs.RenderTarget = true;
 
-            if ( glyph == nullptr )
-                continue;
+        auto texture = Texture2D::create( specs );
+        if ( texture.has_value() == false )
+            return Result::Fail;
 
-            for ( unsigned char c2 = 0; c2 < 255; ++c2 ) {
-                double advance = 0.0;
-                if ( m_msdfData->FontGeo.getAdvance( advance, c1, c2 ) )
-                    m_msdfData->KerningLookupTableASCII[ c1 ][ c2 ] = advance;
-            }
-        }
+        m_AtlasTexture = texture.value();
+        return m_AtlasTexture->load_data( pixels, width * height, SDL_PIXELFORMAT_RGB24 );
     }
 }    // namespace InnoEngine
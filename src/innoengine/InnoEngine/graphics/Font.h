@@ -1,6 +1,9 @@
 #pragma once
+#include "SDL3/SDL_gpu.h"
+
 #include "InnoEngine/BaseTypes.h"
 #include "InnoEngine/Asset.h"
+#include "InnoEngine/graphics/TextLayout.h"
 
 #include <optional>
 #include <string_view>
@@ -8,7 +11,19 @@
 namespace InnoEngine
 {
     class Texture2D;
+    class MappedFile;
+    class GlyphAtlas;
     struct MSDFData;
+    struct MSDFGlyph;
+    struct FontAtlasBake;
+    enum class GlyphStatus;
+
+    enum class FontState : uint8_t
+    {
+        Loading = 0,    // the atlas gets generated in the background, text with the font is skipped
+        Ready,
+        Failed,
+    };
 
     class Font : public Asset<Font>
     {
@@ -22,25 +37,55 @@ namespace InnoEngine
         virtual ~Font() = default;
         static auto create() -> std::optional<Ref<Font>>;
 
+        // never reused, unlike the address of a font
+        uint32_t get_id() const;
+
+        // everything below only works once the font is ready
+        FontState get_state() const;
+        bool      is_ready() const;
+
         Ref<Texture2D> get_atlas_texture() const;
         Ref<MSDFData>     get_msdf_data() const;
 
         float calculate_screen_pix_range( float FontSize ) const;
 
-        // returns the bounding box of the given text
+        // baked glyphs are always available, all others get generated in the background on first use
+        GlyphStatus    find_glyph( char32_t codepoint, MSDFGlyph& glyph ) const;
+        Ref<Texture2D> get_page_texture( uint32_t page ) const;    // see MSDFGlyph::Page
+        uint32_t       get_glyph_generation() const;               // changes whenever generated glyphs were added or evicted
+        void           touch_glyph_pages( uint64_t page_mask ) const;
+
+        // render thread only, frame has to increase once per rendered frame
+        // also picks up the atlas of a font that finished generating
+        void upload_glyphs( SDL_GPUCopyPass* copy_pass, uint64_t frame );
+
+        // returns the bounding box of the given text, relative to the baseline of the first line
         // x == left; y == bottom; z == right; w == top
-        DXSM::Vector4 get_aabb( uint32_t size, std::string_view text ) const;
+        // lays the text out like the renderer does, see TextLayout
+        DXSM::Vector4 get_aabb( uint32_t size, std::string_view text, const TextLayoutOptions& options = {} ) const;
 
     private:
         // Inherited via Asset
         Result load_asset( const std::filesystem::path& full_path ) override;
-        void   preload_msdf_ascii_data();
+
+        // the generated atlas, glyphs and kerning get cached next to the font file
+        Result load_cache( const std::filesystem::path& cache_path, uint64_t font_hash );
+        void   generate_atlas( Own<MappedFile> font_file, const std::filesystem::path& font_path, const std::filesystem::path& cache_path, uint64_t font_hash );
+        void   finish_generation();
+        void   finish_loading( const std::filesystem::path& font_path );
+        Result create_atlas_texture( const void* pixels, uint32_t width, uint32_t height );
 
     private:
-        Ref<Texture2D> m_AtlasTexture;
-        Ref<MSDFData>     m_msdfData;
+        Ref<Texture2D>     m_AtlasTexture;
+        Ref<MSDFData>      m_msdfData;
+        Ref<GlyphAtlas>    m_GlyphAtlas;
+        Ref<FontAtlasBake> m_Bake;    // while the atlas is generated
+
+        bool                   m_Initialized = false;
+        uint32_t               m_ID          = 0;
+        std::atomic<FontState> m_State       = FontState::Loading;
 
-        bool m_Initialized = false;
+        static std::atomic<uint32_t> ms_NextID;
 
         RenderCommandBufferIndexType m_RenderCommandBufferIndex = InvalidRenderCommandBufferIndex;
     };
@@ -4,17 +4,22 @@
 #include "InnoEngine/BaseTypes.h"
 #include "InnoEngine/graphics/GPUDeviceRef.h"
 
+#include <bit>
+
 namespace InnoEngine
 {
+    // Batches get suballocated from a few shared gpu buffers (pages). Page sizes are power of two size classes
+    // and grow geometrically, pages which received no batch for TrimFrameCount frames get released again.
     template <typename BufferLayout, typename BatchCustomData>
     class GPUBatchStorageBuffer
     {
-        GPUBatchStorageBuffer( GPUDeviceRef device, uint32_t batch_size );
+        GPUBatchStorageBuffer( GPUDeviceRef device, uint32_t batch_size, SDL_GPUBufferUsageFlags usage );
 
     public:
         struct BatchData
         {
             SDL_GPUBuffer*  GPUBuffer  = nullptr;
+            uint32_t        Offset     = 0;    // first element of the batch inside GPUBuffer
             uint32_t        Count      = 0;
             BatchCustomData CustomData = {};
         };
@@ -23,7 +28,7 @@ namespace InnoEngine
 
         ~GPUBatchStorageBuffer();
 
-        static auto create( GPUDeviceRef device, uint32_t batch_size ) -> Ref<GPUBatchStorageBuffer>;
+        static auto create( GPUDeviceRef device, uint32_t batch_size, SDL_GPUBufferUsageFlags usage = SDL_GPU_BUFFERUSAGE_GRAPHICS_STORAGE_READ ) -> Ref<GPUBatchStorageBuffer>;
 
         bool             current_batch_full();
         BatchCustomData* upload_and_add_batch( SDL_GPUCopyPass* copy_pass );
@@ -33,33 +38,55 @@ namespace InnoEngine
 
         size_t size() const;
         void   clear();
+        void   end_frame();    // call once per frame, releases pages nobody used for a while
 
         const BatchDataList& get_batchlist() const;
 
         size_t get_current_batch_remaining_size() const;
 
+        size_t get_allocated_bytes() const;    // gpu memory currently held by the pages
+        size_t get_peak_bytes() const;         // highest amount of gpu memory ever held
+
     private:
-        int32_t       find_free_gpubuffer_index();
+        struct Page
+        {
+            SDL_GPUBuffer* Buffer       = nullptr;
+            uint32_t       Capacity     = 0;    // in elements
+            uint32_t       Used         = 0;    // in elements, reset with every clear()
+            uint32_t       UnusedFrames = 0;
+            bool           Cycled       = false;    // only the first upload after a clear() may cycle, later ones would discard the batches before
+        };
+
+        int32_t       allocate_region( uint32_t count, uint32_t* offset );
+        int32_t       create_page( uint32_t min_capacity );
         BufferLayout* map_transferbuffer();
         void          unmap_and_upload_transferbuffer( SDL_GPUCopyPass* copy_pass );
 
     private:
-        GPUDeviceRef                m_Device         = nullptr;
-        SDL_GPUTransferBuffer*      m_TransferBuffer = nullptr;
-        std::vector<SDL_GPUBuffer*> m_GPUBuffer;
-        std::vector<BatchData>      m_Batches;
+        static constexpr uint32_t MinPageBytes   = 64 * 1024;
+        static constexpr uint32_t MaxPageBytes   = 4 * 1024 * 1024;
+        static constexpr uint32_t TrimFrameCount = 300;
+
+        GPUDeviceRef           m_Device         = nullptr;
+        SDL_GPUTransferBuffer* m_TransferBuffer = nullptr;
+        std::vector<Page>      m_Pages;
+        std::vector<BatchData> m_Batches;
 
-        uint32_t m_BatchSize          = 0;
-        int32_t  m_CurrentBatchIndex  = -1;
-        int32_t  m_CurrentBufferIndex = -1;
+        SDL_GPUBufferUsageFlags m_Usage = SDL_GPU_BUFFERUSAGE_GRAPHICS_STORAGE_READ;
+
+        uint32_t m_BatchSize         = 0;
+        int32_t  m_CurrentBatchIndex = -1;
 
         uint32_t      m_CurrentDataCount     = 0;
         BufferLayout* m_CurrentBufferPointer = nullptr;
+
+        size_t m_AllocatedBytes = 0;
+        size_t m_PeakBytes      = 0;
     };
 
     template <typename BufferLayout, typename BatchCustomData>
-    inline GPUBatchStorageBuffer<BufferLayout, BatchCustomData>::GPUBatchStorageBuffer( GPUDeviceRef device, uint32_t batch_size ) :
-        m_Device( device ), m_BatchSize( batch_size )
+    inline GPUBatchStorageBuffer<BufferLayout, BatchCustomData>::GPUBatchStorageBuffer( GPUDeviceRef device, uint32_t batch_size, SDL_GPUBufferUsageFlags usage ) :
+        m_Device( device ), m_Usage( usage ), m_BatchSize( batch_size )
     {
     }
 
@@ -72,20 +99,20 @@ namespace InnoEngine
                 m_TransferBuffer = nullptr;
             }
 
-            for ( auto gpubuffer : m_GPUBuffer ) {
-                SDL_ReleaseGPUBuffer( m_Device, gpubuffer );
+            for ( auto& page : m_Pages ) {
+                SDL_ReleaseGPUBuffer( m_Device, page.Buffer );
             }
-            m_GPUBuffer.clear();
+            m_Pages.clear();
             m_Batches.clear();
             m_Device = nullptr;
         }
     }
 
     template <typename BufferLayout, typename BatchCustomData>
-    inline auto GPUBatchStorageBuffer<BufferLayout, BatchCustomData>::create( GPUDeviceRef device, uint32_t batch_size ) -> Ref<GPUBatchStorageBuffer>
+    inline auto GPUBatchStorageBuffer<BufferLayout, BatchCustomData>::create( GPUDeviceRef device, uint32_t batch_size, SDL_GPUBufferUsageFlags usage ) -> Ref<GPUBatchStorageBuffer>
     {
         Ref<GPUBatchStorageBuffer<BufferLayout, BatchCustomData>> buffer =
-            Ref<GPUBatchStorageBuffer<BufferLayout, BatchCustomData>>( new GPUBatchStorageBuffer<BufferLayout, BatchCustomData>( device, batch_size ) );
+            Ref<GPUBatchStorageBuffer<BufferLayout, BatchCustomData>>( new GPUBatchStorageBuffer<BufferLayout, BatchCustomData>( device, batch_size, usage ) );
 
         SDL_GPUTransferBufferCreateInfo tbufferCreateInfo = {};
         tbufferCreateInfo.usage                           = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
@@ -114,11 +141,10 @@ namespace InnoEngine
             unmap_and_upload_transferbuffer( copy_pass );
         }
 
-        m_CurrentBatchIndex  = static_cast<int32_t>( m_Batches.size() );
-        m_CurrentBufferIndex = find_free_gpubuffer_index();
+        // the gpu region gets assigned on upload, only then the size of the batch is known
+        m_CurrentBatchIndex = static_cast<int32_t>( m_Batches.size() );
 
         BatchData& newbatch = m_Batches.emplace_back();
-        newbatch.GPUBuffer  = m_GPUBuffer[ m_CurrentBufferIndex ];
         newbatch.Count      = 0;
 
         m_CurrentBufferPointer = map_transferbuffer();
@@ -151,9 +177,29 @@ namespace InnoEngine
     inline void GPUBatchStorageBuffer<BufferLayout, BatchCustomData>::clear()
     {
         m_Batches.clear();
-        m_CurrentBatchIndex  = -1;
-        m_CurrentDataCount   = 0;
-        m_CurrentBufferIndex = -1;
+        m_CurrentBatchIndex = -1;
+        m_CurrentDataCount  = 0;
+
+        for ( auto& page : m_Pages ) {
+            page.Used   = 0;
+            page.Cycled = false;
+        }
+    }
+
+    template <typename BufferLayout, typename BatchCustomData>
+    inline void GPUBatchStorageBuffer<BufferLayout, BatchCustomData>::end_frame()
+    {
+        for ( auto it = m_Pages.begin(); it != m_Pages.end(); ) {
+            if ( ++it->UnusedFrames < TrimFrameCount ) {
+                ++it;
+                continue;
+            }
+
+            // still fine when the gpu is using it, sdl defers the destruction
+            SDL_ReleaseGPUBuffer( m_Device, it->Buffer );
+            m_AllocatedBytes -= it->Capacity * sizeof( BufferLayout );
+            it = m_Pages.erase( it );
+        }
     }
 
     template <typename BufferLayout, typename BatchCustomData>
@@ -169,28 +215,70 @@ namespace InnoEngine
     }
 
     template <typename BufferLayout, typename BatchCustomData>
-    inline int32_t GPUBatchStorageBuffer<BufferLayout, BatchCustomData>::find_free_gpubuffer_index()
+    inline size_t GPUBatchStorageBuffer<BufferLayout, BatchCustomData>::get_allocated_bytes() const
     {
-        if ( m_CurrentBufferIndex + 1 < m_GPUBuffer.size() ) {
-            // just return the next one in case it exits
-            return ++m_CurrentBufferIndex;
-        }
-        else {
-            // doesnt exist -> create new and return that
-            SDL_GPUBuffer*& buffer = m_GPUBuffer.emplace_back();
+        return m_AllocatedBytes;
+    }
+
+    template <typename BufferLayout, typename BatchCustomData>
+    inline size_t GPUBatchStorageBuffer<BufferLayout, BatchCustomData>::get_peak_bytes() const
+    {
+        return m_PeakBytes;
+    }
 
-            SDL_GPUBufferCreateInfo createInfo = {};
-            createInfo.usage                   = SDL_GPU_BUFFERUSAGE_GRAPHICS_STORAGE_READ;
-            createInfo.size                    = m_BatchSize * sizeof( BufferLayout );
+    template <typename BufferLayout, typename BatchCustomData>
+    inline int32_t GPUBatchStorageBuffer<BufferLayout, BatchCustomData>::allocate_region( uint32_t count, uint32_t* offset )
+    {
+        int32_t page_index = -1;
 
-            buffer = SDL_CreateGPUBuffer( m_Device, &createInfo );
-            if ( buffer == nullptr ) {
-                // TODO: this needs to be handled better
-                IE_LOG_ERROR( "SDL_CreateGPUBuffer failed : {0}", SDL_GetError() );
-                return -1;
+        // first fit keeps the front pages busy, so the ones at the back run idle and get trimmed after a spike
+        for ( size_t i = 0; i < m_Pages.size(); ++i ) {
+            if ( m_Pages[ i ].Capacity - m_Pages[ i ].Used >= count ) {
+                page_index = static_cast<int32_t>( i );
+                break;
             }
-            return ++m_CurrentBufferIndex;
         }
+
+        if ( page_index == -1 ) {
+            page_index = create_page( count );
+            if ( page_index == -1 )
+                return -1;
+        }
+
+        Page& page        = m_Pages[ page_index ];
+        *offset           = page.Used;
+        page.Used        += count;
+        page.UnusedFrames = 0;
+        return page_index;
+    }
+
+    template <typename BufferLayout, typename BatchCustomData>
+    inline int32_t GPUBatchStorageBuffer<BufferLayout, BatchCustomData>::create_page( uint32_t min_capacity )
+    {
+        // every new page is about as large as all existing ones together
+        size_t bytes = std::max<size_t>( m_AllocatedBytes, MinPageBytes );
+        bytes        = std::min<size_t>( bytes, MaxPageBytes );
+        bytes        = std::max<size_t>( bytes, min_capacity * sizeof( BufferLayout ) );
+        bytes        = std::bit_ceil( bytes );
+
+        Page page;
+        page.Capacity = static_cast<uint32_t>( bytes / sizeof( BufferLayout ) );
+
+        SDL_GPUBufferCreateInfo createInfo = {};
+        createInfo.usage                   = m_Usage;
+        createInfo.size                    = static_cast<uint32_t>( page.Capacity * sizeof( BufferLayout ) );
+
+        page.Buffer = SDL_CreateGPUBuffer( m_Device, &createInfo );
+        if ( page.Buffer == nullptr ) {
+            IE_LOG_ERROR( "SDL_CreateGPUBuffer failed : {0}", SDL_GetError() );
+            return -1;
+        }
+
+        m_AllocatedBytes += createInfo.size;
+        m_PeakBytes       = std::max( m_PeakBytes, m_AllocatedBytes );
+
+        m_Pages.push_back( page );
+        return static_cast<int32_t>( m_Pages.size() - 1 );
     }
 
     template <typename BufferLayout, typename BatchCustomData>
@@ -203,15 +291,32 @@ namespace InnoEngine
     inline void GPUBatchStorageBuffer<BufferLayout, BatchCustomData>::unmap_and_upload_transferbuffer( SDL_GPUCopyPass* copy_pass )
     {
         SDL_UnmapGPUTransferBuffer( m_Device, m_TransferBuffer );
-        SDL_GPUTransferBufferLocation tranferBufferLocation { .transfer_buffer = m_TransferBuffer, .offset = 0 };
-        SDL_GPUBufferRegion           bufferRegion { .buffer = m_GPUBuffer[ m_CurrentBufferIndex ],
-                                                     .offset = 0,
-                                                     .size   = static_cast<uint32_t>( m_CurrentDataCount * sizeof( BufferLayout ) ) };
-        SDL_UploadToGPUBuffer( copy_pass, &tranferBufferLocation, &bufferRegion, true );
-
-        m_Batches[ m_CurrentBatchIndex ].Count = m_CurrentDataCount;
-        m_CurrentBufferPointer                 = nullptr;
-        m_CurrentBatchIndex                    = -1;
-        m_CurrentDataCount                     = 0;
+
+        BatchData& batch = m_Batches[ m_CurrentBatchIndex ];
+
+        uint32_t offset     = 0;
+        int32_t  page_index = allocate_region( m_CurrentDataCount, &offset );
+        if ( page_index != -1 ) {
+            Page& page = m_Pages[ page_index ];
+
+            SDL_GPUTransferBufferLocation tranferBufferLocation { .transfer_buffer = m_TransferBuffer, .offset = 0 };
+            SDL_GPUBufferRegion           bufferRegion { .buffer = page.Buffer,
+                                                         .offset = static_cast<uint32_t>( offset * sizeof( BufferLayout ) ),
+                                                         .size   = static_cast<uint32_t>( m_CurrentDataCount * sizeof( BufferLayout ) ) };
+            SDL_UploadToGPUBuffer( copy_pass, &tranferBufferLocation, &bufferRegion, !page.Cycled );
+            page.Cycled = true;
+
+            batch.GPUBuffer = page.Buffer;
+            batch.Offset    = offset;
+            batch.Count     = m_CurrentDataCount;
+        }
+        else {
+            // TODO: this needs to be handled better
+            m_Batches.pop_back();
+        }
+
+        m_CurrentBufferPointer = nullptr;
+        m_CurrentBatchIndex    = -1;
+        m_CurrentDataCount     = 0;
     }
 }    // namespace InnoEngine
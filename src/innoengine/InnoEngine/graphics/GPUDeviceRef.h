@@ -102,14 +102,15 @@ namespace InnoEngine
         }
 
     private:
+        // copies of an empty ref stay empty
         uint32_t addref()
         {
-            return m_useCount->fetch_add( 1 );
+            return m_useCount != nullptr ? m_useCount->fetch_add( 1 ) : 0;
         }
 
         uint32_t deref()
         {
-            return m_useCount->fetch_sub( 1 );
+            return m_useCount != nullptr ? m_useCount->fetch_sub( 1 ) : 0;
         }
 
     private:
@@ -0,0 +1,353 @@
+#include "InnoEngine/iepch.h"
+#include "InnoEngine/graphics/GlyphAtlas.h"
+
+#include "InnoEngine/graphics/Renderer.h"
+#include "InnoEngine/graphics/Texture2D.h"
+#include "InnoEngine/utility/JobSystem.h"
+
+namespace InnoEngine
+{
+    namespace
+    {
+        // same parameters as the baked atlas of Font
+        constexpr double MaxCornerAngle = 3.0;
+        constexpr double MiterLimit     = 1.0;
+        constexpr int    GlyphPadding   = 1;
+    }    // namespace
+
+    struct GlyphAtlas::Page
+    {
+        Ref<Texture2D>              Texture;
+        msdf_atlas::RectanglePacker Packer        = msdf_atlas::RectanglePacker( PageSize, PageSize );
+        uint64_t                    LastUsedFrame = 0;
+        std::vector<char32_t>       Glyphs;
+    };
+
+    GlyphAtlas::~GlyphAtlas()
+    {
+        if ( m_Font != nullptr )
+            msdfgen::destroyFont( m_Font );
+        if ( m_Freetype != nullptr )
+            msdfgen::deinitializeFreetype( m_Freetype );
+    }
+
+    auto GlyphAtlas::create( const std::filesystem::path& font_path, float range, float scale ) -> std::optional<Ref<GlyphAtlas>>
+    {
+        Ref<GlyphAtlas> atlas = Ref<GlyphAtlas>( new GlyphAtlas );
+        atlas->m_FontPath     = font_path;
+        atlas->m_Range        = range;
+        atlas->m_Scale        = scale;
+        return atlas;
+    }
+
+    GlyphStatus GlyphAtlas::request_glyph( char32_t codepoint, MSDFGlyph& glyph )
+    {
+        std::lock_guard lguard( m_Mutex );
+
+        auto it = m_Glyphs.find( codepoint );
+        if ( it != m_Glyphs.end() ) {
+            glyph = it->second;
+            if ( glyph.Page >= FirstPage )
+                m_Pages[ glyph.Page - FirstPage ]->LastUsedFrame = m_CurrentFrame;
+            return GlyphStatus::Available;
+        }
+
+        if ( m_Missing.contains( codepoint ) )
+            return GlyphStatus::Missing;
+
+        if ( m_Queued.insert( codepoint ).second ) {
+            CoreAPI::get_jobsystem()->submit( [ atlas = shared_from_this(), codepoint ] { atlas->generate_glyph( codepoint ); } );
+        }
+        return GlyphStatus::Pending;
+    }
+
+    void GlyphAtlas::touch_pages( uint64_t page_mask )
+    {
+        std::lock_guard lguard( m_Mutex );
+        for ( uint32_t page = 0; page < m_Pages.size(); ++page ) {
+            if ( page_mask & ( 1ull << ( page + FirstPage ) ) )
+                m_Pages[ page ]->LastUsedFrame = m_CurrentFrame;
+        }
+    }
+
+    void GlyphAtlas::upload_pending( SDL_GPUCopyPass* copy_pass, uint64_t frame )
+    {
+        IE_ASSERT( copy_pass != nullptr );
+        std::lock_guard lguard( m_Mutex );
+
+        m_CurrentFrame = frame;
+        if ( m_Finished.empty() )
+            return;
+
+        if ( m_Device == nullptr )
+            m_Device = CoreAPI::get_gpurenderer()->get_gpudevice();
+
+        struct Upload
+        {
+            const GeneratedGlyph* Source;
+            uint32_t              Page;
+            int                   X;
+            int                   Y;
+        };
+
+        // place all glyphs first, the pixels go through a single transfer buffer
+        std::vector<Upload>         uploads;
+        std::vector<GeneratedGlyph> retry;
+        uint32_t                    transfer_size = 0;
+        for ( const GeneratedGlyph& generated : m_Finished ) {
+            if ( generated.Width == 0 || generated.Height == 0 ) {
+                m_Glyphs[ generated.Glyph.Codepoint ] = generated.Glyph;    // whitespace, nothing to upload
+                continue;
+            }
+
+            int                     x    = 0;
+            int                     y    = 0;
+            std::optional<uint32_t> page = allocate( generated.Width, generated.Height, x, y );
+            if ( page.has_value() == false ) {
+                retry.push_back( generated );    // every page was drawn in this or the previous frame
+                continue;
+            }
+
+            uploads.push_back( { &generated, page.value(), x, y } );
+            transfer_size += generated.Width * generated.Height * 4;
+        }
+
+        if ( uploads.empty() == false ) {
+            SDL_GPUTransferBufferCreateInfo transfer_info = {};
+            transfer_info.usage                           = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
+            transfer_info.size                            = transfer_size;
+
+            SDL_GPUTransferBuffer* transfer_buffer = SDL_CreateGPUTransferBuffer( m_Device, &transfer_info );
+            uint8_t*               transfer_data   = transfer_buffer ? static_cast<uint8_t*>( SDL_MapGPUTransferBuffer( m_Device, transfer_buffer, false ) ) : nullptr;
+            if ( transfer_data == nullptr ) {
+                IE_LOG_ERROR( "Uploading glyphs failed: {}", SDL_GetError() );
+                if ( transfer_buffer )
+                    SDL_ReleaseGPUTransferBuffer( m_Device, transfer_buffer );
+
+                // the glyphs get requested again
+                for ( const Upload& upload : uploads )
+                    m_Queued.erase( upload.Source->Glyph.Codepoint );
+                m_Finished = std::move( retry );
+                return;
+            }
+
+            uint32_t offset = 0;
+            for ( const Upload& upload : uploads ) {
+                const GeneratedGlyph& generated = *upload.Source;
+                const uint32_t        pixels    = generated.Width * generated.Height;
+                TextureBase::copy_pixels_from_surface( transfer_data + offset, SDL_GPU_TEXTUREFORMAT_R8G8B8A8_UNORM, generated.Pixels.data(), SDL_PIXELFORMAT_RGB24, pixels );
+
+                SDL_GPUTextureTransferInfo texture_transfer_info = {};
+                texture_transfer_info.transfer_buffer            = transfer_buffer;
+                texture_transfer_info.offset                     = offset;
+                texture_transfer_info.pixels_per_row             = generated.Width;
+
+                SDL_GPUTextureRegion texture_region = {};
+                texture_region.texture              = m_Pages[ upload.Page ]->Texture->get_sdltexture();
+                texture_region.x                    = upload.X;
+                texture_region.y                    = upload.Y;
+                texture_region.w                    = generated.Width;
+                texture_region.h                    = generated.Height;
+                texture_region.d                    = 1;
+
+                SDL_UploadToGPUTexture( copy_pass, &texture_transfer_info, &texture_region, false );
+                offset += pixels * 4;
+
+                MSDFGlyph glyph = generated.Glyph;
+                glyph.Page      = upload.Page + FirstPage;
+
+                const float x = static_cast<float>( upload.X );
+                const float y = static_cast<float>( upload.Y );
+                glyph.AtlasBounds += DXSM::Vector4( x, y, x, y );
+
+                m_Glyphs[ glyph.Codepoint ] = glyph;
+                m_Pages[ upload.Page ]->Glyphs.push_back( glyph.Codepoint );
+            }
+
+            SDL_UnmapGPUTransferBuffer( m_Device, transfer_buffer );
+            SDL_ReleaseGPUTransferBuffer( m_Device, transfer_buffer );    // released once the copy pass is done
+        }
+
+        for ( const Upload& upload : uploads )
+            m_Queued.erase( upload.Source->Glyph.Codepoint );
+        for ( const GeneratedGlyph& generated : m_Finished ) {
+            if ( generated.Width == 0 || generated.Height == 0 )
+                m_Queued.erase( generated.Glyph.Codepoint );
+        }
+
+        m_Finished = std::move( retry );
+        m_Generation.fetch_add( 1, std::memory_order_release );
+    }
+
+    Ref<Texture2D> GlyphAtlas::get_page_texture( uint32_t page ) const
+    {
+        std::lock_guard lguard( m_Mutex );
+        IE_ASSERT( page >= FirstPage && page - FirstPage < m_Pages.size() );
+        return m_Pages[ page - FirstPage ]->Texture;
+    }
+
+    size_t GlyphAtlas::get_page_count() const
+    {
+        std::lock_guard lguard( m_Mutex );
+        return m_Pages.size();
+    }
+
+    uint32_t GlyphAtlas::get_generation() const
+    {
+        return m_Generation.load( std::memory_order_acquire );
+    }
+
+    void GlyphAtlas::generate_glyph( char32_t codepoint )
+    {
+        std::vector<GlyphGeometry> glyph_geometry;
+        {
+            std::lock_guard lguard( m_FontMutex );
+            if ( open_font() ) {
+                // load through FontGeometry so the glyph gets the same scale as the baked ones
+                FontGeometry        font_geometry( &glyph_geometry );
+                msdf_atlas::Charset charset;
+                charset.add( codepoint );
+                font_geometry.loadCharset( m_Font, 1.0, charset, true, false );
+            }
+        }
+
+        if ( glyph_geometry.empty() ) {
+            std::lock_guard lguard( m_Mutex );
+            m_Queued.erase( codepoint );
+            m_Missing.insert( codepoint );
+            m_Generation.fetch_add( 1, std::memory_order_release );
+            return;
+        }
+
+        GlyphGeometry& geometry = glyph_geometry.front();
+        geometry.edgeColoring( &msdfgen::edgeColoringInkTrap, MaxCornerAngle, 0 );
+        geometry.wrapBox( m_Scale, m_Range / m_Scale, MiterLimit );
+        geometry.placeBox( 0, 0 );
+
+        GeneratedGlyph generated;
+        generated.Glyph.Codepoint = codepoint;
+        generated.Glyph.Advance   = static_cast<float>( geometry.getAdvance() );
+
+        double l, b, r, t;
+        geometry.getQuadPlaneBounds( l, b, r, t );
+        generated.Glyph.PlaneBounds = DXSM::Vector4( static_cast<float>( l ), static_cast<float>( b ), static_cast<float>( r ), static_cast<float>( t ) );
+        geometry.getQuadAtlasBounds( l, b, r, t );
+        generated.Glyph.AtlasBounds = DXSM::Vector4( static_cast<float>( l ), static_cast<float>( b ), static_cast<float>( r ), static_cast<float>( t ) );
+
+        int box_x, box_y, box_width, box_height;
+        geometry.getBoxRect( box_x, box_y, box_width, box_height );
+
+        if ( geometry.isWhitespace() == false && box_width > 0 && box_height > 0 ) {
+            msdfgen::Bitmap<float, 3> bitmap( box_width, box_height );
+            msdfGenerator( bitmap, geometry, GeneratorAttributes() );
+
+            generated.Width  = static_cast<uint32_t>( box_width );
+            generated.Height = static_cast<uint32_t>( box_height );
+            generated.Pixels.resize( static_cast<size_t>( box_width ) * box_height * 3 );
+
+            uint8_t* write = generated.Pixels.data();
+            for ( int y = 0; y < box_height; ++y ) {
+                for ( int x = 0; x < box_width; ++x ) {
+                    const float* pixel = bitmap( x, y );
+                    *write++           = msdfgen::pixelFloatToByte( pixel[ 0 ] );
+                    *write++           = msdfgen::pixelFloatToByte( pixel[ 1 ] );
+                    *write++           = msdfgen::pixelFloatToByte( pixel[ 2 ] );
+                }
+            }
+        }
+
+        std::lock_guard lguard( m_Mutex );
+        m_Finished.push_back( std::move( generated ) );
+    }
+
+    bool GlyphAtlas::open_font()
+    {
+        if ( m_Font != nullptr )
+            return true;
+        if ( m_FontFailed )
+            return false;
+
+        m_Freetype = msdfgen::initializeFreetype();
+        if ( m_Freetype != nullptr )
+            m_Font = msdfgen::loadFont( m_Freetype, m_FontPath.string().c_str() );
+
+        if ( m_Font == nullptr ) {
+            IE_LOG_ERROR( "Opening font \"{}\" for glyph generation failed", m_FontPath.string() );
+            m_FontFailed = true;
+            return false;
+        }
+        return true;
+    }
+
+    std::optional<uint32_t> GlyphAtlas::allocate( uint32_t width, uint32_t height, int& x, int& y )
+    {
+        if ( width + GlyphPadding > PageSize || height + GlyphPadding > PageSize )
+            return std::nullopt;
+
+        msdf_atlas::Rectangle rect = { -1, -1, static_cast<int>( width ) + GlyphPadding, static_cast<int>( height ) + GlyphPadding };
+
+        // a page written to in this frame never gets evicted in the same frame
+        for ( uint32_t page = 0; page < m_Pages.size(); ++page ) {
+            m_Pages[ page ]->Packer.pack( &rect, 1 );
+            if ( rect.x >= 0 ) {
+                x                              = rect.x;
+                y                              = rect.y;
+                m_Pages[ page ]->LastUsedFrame = m_CurrentFrame;
+                return page;
+            }
+        }
+
+        std::optional<uint32_t> page;
+        if ( m_Pages.size() < MaxPages ) {
+            TextureSpecifications specs = {};
+            specs.Width                 = PageSize;
+            specs.Height                = PageSize;
+            specs.Format                = TextureFormat::RGBX;
+
+            auto texture = Texture2D::create( specs );
+            if ( texture.has_value() ) {
+                m_Pages.push_back( std::make_unique<Page>() );
+                m_Pages.back()->Texture = texture.value();
+                page                    = static_cast<uint32_t>( m_Pages.size() - 1 );
+            }
+        }
+
+        if ( page.has_value() == false )
+            page = evict_least_recently_used_page();
+
+        if ( page.has_value() == false )
+            return std::nullopt;
+
+        m_Pages[ page.value() ]->Packer.pack( &rect, 1 );
+        IE_ASSERT( rect.x >= 0 );
+        x                                      = rect.x;
+        y                                      = rect.y;
+        m_Pages[ page.value() ]->LastUsedFrame = m_CurrentFrame;
+        return page;
+    }
+
+    std::optional<uint32_t> GlyphAtlas::evict_least_recently_used_page()
+    {
+        // uploads happen before the text of the frame touches its pages,
+        // so a page drawn every frame still carries the previous frame here and must not be evicted either
+        std::optional<uint32_t> oldest;
+        for ( uint32_t page = 0; page < m_Pages.size(); ++page ) {
+            const uint64_t last_used = m_Pages[ page ]->LastUsedFrame;
+            if ( last_used + 1 < m_CurrentFrame && ( oldest.has_value() == false || last_used < m_Pages[ oldest.value() ]->LastUsedFrame ) )
+                oldest = page;
+        }
+
+        if ( oldest.has_value() == false )
+            return std::nullopt;
+
+        Page& page = *m_Pages[ oldest.value() ];
+        for ( char32_t codepoint : page.Glyphs )
+            m_Glyphs.erase( codepoint );
+
+        IE_LOG_DEBUG( "Evicted glyph page {} with {} glyphs", oldest.value(), page.Glyphs.size() );
+        page.Glyphs.clear();
+        page.Packer = msdf_atlas::RectanglePacker( PageSize, PageSize );
+        m_Generation.fetch_add( 1, std::memory_order_release );
+        return oldest;
+    }
+}    // namespace InnoEngine
@@ -0,0 +1,95 @@
+#pragma once
+#include "SDL3/SDL_gpu.h"
+
+#include "InnoEngine/BaseTypes.h"
+#include "InnoEngine/graphics/GPUDeviceRef.h"
+#include "InnoEngine/graphics/MSDFData.h"
+
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace InnoEngine
+{
+    class Texture2D;
+
+    enum class GlyphStatus
+    {
+        Available = 0,
+        Pending,    // gets generated in the background, ask again next frame
+        Missing     // the font has no such glyph
+    };
+
+    // glyphs outside of the baked charset of a font, generated on the job system on first use
+    // and packed into pages which are evicted least recently used first when all of them are full
+    // requests are thread safe, uploads happen on the render thread
+    class GlyphAtlas : public std::enable_shared_from_this<GlyphAtlas>
+    {
+        GlyphAtlas() = default;
+
+    public:
+        ~GlyphAtlas();
+
+        // freetype is only opened once the first glyph is requested
+        static auto create( const std::filesystem::path& font_path, float range, float scale ) -> std::optional<Ref<GlyphAtlas>>;
+
+        // MSDFGlyph::Page of dynamic glyphs starts at FirstPage, page 0 is the baked atlas of the font
+        GlyphStatus request_glyph( char32_t codepoint, MSDFGlyph& glyph );
+        void        touch_pages( uint64_t page_mask );
+
+        // uploads the glyphs which finished since the last call, frame has to increase once per rendered frame
+        void upload_pending( SDL_GPUCopyPass* copy_pass, uint64_t frame );
+
+        Ref<Texture2D> get_page_texture( uint32_t page ) const;
+        size_t         get_page_count() const;
+
+        // changes whenever glyphs were added or removed, layouts of an older generation are outdated
+        uint32_t get_generation() const;
+
+        static constexpr uint32_t FirstPage = 1;
+        static constexpr uint32_t MaxPages  = 8;
+        static constexpr uint32_t PageSize  = 1024;
+
+    private:
+        struct Page;
+
+        struct GeneratedGlyph
+        {
+            MSDFGlyph            Glyph;    // atlas bounds relative to the glyph box
+            uint32_t             Width  = 0;
+            uint32_t             Height = 0;
+            std::vector<uint8_t> Pixels;    // rgb, bottom row first like the baked atlas
+        };
+
+        void generate_glyph( char32_t codepoint );
+        bool open_font();
+
+        std::optional<uint32_t> allocate( uint32_t width, uint32_t height, int& x, int& y );
+        std::optional<uint32_t> evict_least_recently_used_page();
+
+    private:
+        std::filesystem::path m_FontPath;
+        float                 m_Range = 0.0f;
+        float                 m_Scale = 0.0f;
+
+        // freetype is not thread safe, only one job loads glyph shapes at a time
+        std::mutex               m_FontMutex;
+        msdfgen::FreetypeHandle* m_Freetype   = nullptr;
+        msdfgen::FontHandle*     m_Font       = nullptr;
+        bool                     m_FontFailed = false;
+
+        mutable std::mutex                      m_Mutex;
+        std::unordered_map<char32_t, MSDFGlyph> m_Glyphs;
+        std::unordered_set<char32_t>            m_Queued;
+        std::unordered_set<char32_t>            m_Missing;
+        std::vector<GeneratedGlyph>             m_Finished;
+        std::vector<Own<Page>>                  m_Pages;
+        uint64_t                                m_CurrentFrame = 0;
+        std::atomic<uint32_t>                   m_Generation   = 0;
+
+        GPUDeviceRef m_Device = nullptr;
+    };
+}    // namespace InnoEngine
@@ -0,0 +1,107 @@
+#include "InnoEngine/graphics/KerningTable.h"
+#include <gtest/gtest.h>
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <string>
+
+namespace InnoEngine
+{
+    TEST( KerningTableTest, lookup )
+    {
+        const std::array<MSDFKerningPair, 5> pairs = { { { 'A', 'V', -0.08f }, { 'T', 'o', -0.05f }, { 0x4E2D, 0x6587, 0.01f }, { 'L', 0x2019, -0.1f }, { 0xC4, 0xFD, -0.02f } } };
+
+        KerningTable table;
+        table.build( pairs );
+
+        EXPECT_EQ( table.size(), 5u );
+        EXPECT_FLOAT_EQ( table.get_kerning( 'A', 'V' ), -0.08f );
+        EXPECT_FLOAT_EQ( table.get_kerning( 'T', 'o' ), -0.05f );
+        EXPECT_FLOAT_EQ( table.get_kerning( 0x4E2D, 0x6587 ), 0.01f );
+        EXPECT_FLOAT_EQ( table.get_kerning( 'L', 0x2019 ), -0.1f );
+        EXPECT_FLOAT_EQ( table.get_kerning( 0xC4, 0xFD ), -0.02f );
+        EXPECT_FLOAT_EQ( table.get_kerning( 'L', 'T' ), 0.0f );
+        EXPECT_FLOAT_EQ( table.get_kerning( 'V', 'A' ), 0.0f );
+        EXPECT_FLOAT_EQ( table.get_kerning( 'A', 'W' ), 0.0f );
+        EXPECT_FLOAT_EQ( table.get_kerning( 0x1F600, 'A' ), 0.0f );
+    }
+
+    TEST( KerningTableTest, hasKerning )
+    {
+        const std::array<MSDFKerningPair, 2> pairs = { { { 'A', 'V', -0.08f }, { 'L', 'T', 0.0f } } };
+
+        KerningTable table;
+        table.build( pairs );
+
+        EXPECT_TRUE( table.has_kerning( 'A' ) );
+        EXPECT_FALSE( table.has_kerning( 'L' ) );    // zero pairs are dropped
+        EXPECT_FALSE( table.has_kerning( 'V' ) );
+        EXPECT_EQ( table.size(), 1u );
+    }
+
+    TEST( KerningTableTest, lastDuplicateWins )
+    {
+        const std::array<MSDFKerningPair, 3> pairs = { { { 'A', 'V', -0.08f }, { 'T', 'o', -0.05f }, { 'A', 'V', -0.1f } } };
+
+        KerningTable table;
+        table.build( pairs );
+
+        EXPECT_EQ( table.size(), 2u );
+        EXPECT_FLOAT_EQ( table.get_kerning( 'A', 'V' ), -0.1f );
+
+        table.clear();
+        EXPECT_EQ( table.size(), 0u );
+        EXPECT_FLOAT_EQ( table.get_kerning( 'A', 'V' ), 0.0f );
+    }
+
+    // compares against the dense ascii table the fonts used before, run with --gtest_also_run_disabled_tests
+    TEST( KerningTableTest, DISABLED_benchmarkAgainstDenseTable )
+    {
+        std::vector<MSDFKerningPair> pairs;
+        for ( uint32_t first = 0x20; first < 0x7F; first += 3 ) {
+            for ( uint32_t second = 0x20; second < 0x7F; second += 5 )
+                pairs.push_back( { first, second, -0.01f * static_cast<float>( second % 7 + 1 ) } );
+        }
+
+        KerningTable table;
+        table.build( pairs );
+
+        auto dense = std::make_unique<std::array<std::array<double, 255>, 255>>();
+        for ( auto& row : *dense )
+            row.fill( 0.0 );
+        for ( const MSDFKerningPair& pair : pairs )
+            ( *dense )[ pair.First ][ pair.Second ] = pair.Kerning;
+
+        std::string text;
+        for ( size_t i = 0; text.size() < 1 << 20; ++i )
+            text += static_cast<char>( 0x20 + ( i * 7919 ) % 0x5F );
+
+        constexpr int Iterations = 20;
+        using Clock              = std::chrono::steady_clock;
+
+        double dense_sum = 0.0;
+        auto   start     = Clock::now();
+        for ( int i = 0; i < Iterations; ++i ) {
+            for ( size_t c = 0; c + 1 < text.size(); ++c )
+                dense_sum += ( *dense )[ static_cast<unsigned char>( text[ c ] ) ][ static_cast<unsigned char>( text[ c + 1 ] ) ];
+        }
+        const auto dense_time = Clock::now() - start;
+
+        double compact_sum = 0.0;
+        start              = Clock::now();
+        for ( int i = 0; i < Iterations; ++i ) {
+            for ( size_t c = 0; c + 1 < text.size(); ++c )
+                compact_sum += table.get_kerning( static_cast<unsigned char>( text[ c ] ), static_cast<unsigned char>( text[ c + 1 ] ) );
+        }
+        const auto compact_time = Clock::now() - start;
+
+        EXPECT_NEAR( dense_sum, compact_sum, 1e-3 * std::abs( dense_sum ) );
+
+        using Milliseconds = std::chrono::duration<double, std::milli>;
+        std::printf( "dense:   %8.2f ms %8zu bytes\n", Milliseconds( dense_time ).count(), sizeof( *dense ) );
+        std::printf( "compact: %8.2f ms %8zu bytes (%zu pairs)\n", Milliseconds( compact_time ).count(), table.get_memory_bytes(), table.size() );
+    }
+}    // namespace InnoEngine
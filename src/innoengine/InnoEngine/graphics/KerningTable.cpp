@@ -0,0 +1,74 @@
+#include "InnoEngine/iepch.h"
+#include "InnoEngine/graphics/KerningTable.h"
+
+namespace InnoEngine
+{
+    void KerningTable::build( std::span<const MSDFKerningPair> pairs )
+    {
+        clear();
+
+        std::vector<MSDFKerningPair> sorted;
+        sorted.reserve( pairs.size() );
+        for ( const MSDFKerningPair& pair : pairs ) {
+            if ( pair.Kerning != 0.0f )
+                sorted.push_back( pair );
+        }
+
+        // stable, so the last of duplicate pairs wins like it did with a map
+        std::stable_sort( sorted.begin(), sorted.end(), []( const MSDFKerningPair& a, const MSDFKerningPair& b ) { return make_key( a.First, a.Second ) < make_key( b.First, b.Second ); } );
+
+        m_Keys.reserve( sorted.size() );
+        m_Values.reserve( sorted.size() );
+        for ( const MSDFKerningPair& pair : sorted ) {
+            const uint64_t key = make_key( pair.First, pair.Second );
+            if ( m_Keys.empty() == false && m_Keys.back() == key ) {
+                m_Values.back() = pair.Kerning;
+                continue;
+            }
+
+            m_Keys.push_back( key );
+            m_Values.push_back( pair.Kerning );
+
+            const size_t word = pair.First / 64;
+            if ( word >= m_FirstBits.size() )
+                m_FirstBits.resize( word + 1, 0 );
+            m_FirstBits[ word ] |= 1ull << ( pair.First % 64 );
+        }
+
+        for ( size_t i = 0; i < m_Keys.size(); ++i ) {
+            const uint32_t first  = static_cast<uint32_t>( m_Keys[ i ] >> 32 );
+            const uint32_t second = static_cast<uint32_t>( m_Keys[ i ] );
+            if ( first >= DenseRange )
+                break;
+            if ( second >= DenseRange )
+                continue;
+
+            uint32_t& offset = m_DenseRowOffsets[ first ];
+            if ( offset == 0 ) {
+                offset = static_cast<uint32_t>( m_DenseRows.size() );
+                m_DenseRows.resize( m_DenseRows.size() + DenseRange, 0.0f );
+            }
+            m_DenseRows[ offset + second ] = m_Values[ i ];
+        }
+    }
+
+    void KerningTable::clear()
+    {
+        m_Keys.clear();
+        m_Values.clear();
+        m_FirstBits.clear();
+        m_DenseRowOffsets.fill( 0 );
+        m_DenseRows.assign( DenseRange, 0.0f );
+    }
+
+    size_t KerningTable::size() const
+    {
+        return m_Keys.size();
+    }
+
+    size_t KerningTable::get_memory_bytes() const
+    {
+        return m_Keys.capacity() * sizeof( uint64_t ) + m_Values.capacity() * sizeof( float ) + m_FirstBits.capacity() * sizeof( uint64_t )
+             + sizeof( m_DenseRowOffsets ) + m_DenseRows.capacity() * sizeof( float );
+    }
+}    // namespace InnoEngine
@@ -0,0 +1,64 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace InnoEngine
+{
+    struct MSDFKerningPair
+    {
+        uint32_t First   = 0;
+        uint32_t Second  = 0;
+        float    Kerning = 0.0f;
+    };
+
+    // only the non-zero kerning pairs of a font, sorted for a binary search
+    // one bit per first codepoint skips the search for the common case of a glyph without any kerning
+    // latin-1 pairs are looked up in a dense row per first codepoint with kerning instead of searched
+    class KerningTable
+    {
+    public:
+        void build( std::span<const MSDFKerningPair> pairs );
+        void clear();
+
+        bool has_kerning( uint32_t first ) const
+        {
+            const size_t word = first / 64;
+            return word < m_FirstBits.size() && ( m_FirstBits[ word ] >> ( first % 64 ) & 1 ) != 0;
+        }
+
+        float get_kerning( uint32_t first, uint32_t second ) const
+        {
+            if ( first < DenseRange && second < DenseRange )
+                return m_DenseRows[ m_DenseRowOffsets[ first ] + second ];
+
+            if ( has_kerning( first ) == false )
+                return 0.0f;
+
+            const uint64_t key = make_key( first, second );
+            auto           it  = std::lower_bound( m_Keys.begin(), m_Keys.end(), key );
+            return it != m_Keys.end() && *it == key ? m_Values[ it - m_Keys.begin() ] : 0.0f;
+        }
+
+        size_t size() const;
+        size_t get_memory_bytes() const;
+
+    private:
+        static constexpr uint32_t DenseRange = 256;
+
+        static uint64_t make_key( uint32_t first, uint32_t second )
+        {
+            return static_cast<uint64_t>( first ) << 32 | second;
+        }
+
+    private:
+        std::vector<uint64_t> m_Keys;    // first << 32 | second
+        std::vector<float>    m_Values;
+        std::vector<uint64_t> m_FirstBits;
+
+        std::array<uint32_t, DenseRange> m_DenseRowOffsets = {};                                      // into m_DenseRows, 0 without kerning
+        std::vector<float>               m_DenseRows       = std::vector<float>( DenseRange, 0.0f );    // DenseRange values per row, the first one all zero
+    };
+}    // namespace InnoEngine
@@ -11,90 +11,94 @@
 using namespace msdf_atlas;
 #pragma warning( default :4458; default :4505 )
 
+#include "Directxtk/SimpleMath.h"
+namespace DXSM = DirectX::SimpleMath;
+
+#include "InnoEngine/graphics/KerningTable.h"
+
 namespace InnoEngine
 {
+    // the glyph data we need for rendering, owned by us so it can be cached without msdf-atlas-gen
+    struct MSDFGlyph
+    {
+        msdf_atlas::unicode_t Codepoint   = 0;
+        float                 Advance     = 0.0f;
+        DXSM::Vector4         PlaneBounds = {};    // left, bottom, right, top in em
+        DXSM::Vector4         AtlasBounds = {};    // left, bottom, right, top in atlas pixels
+        uint32_t              Page        = 0;     // 0 is the baked atlas, see GlyphAtlas for the others
+    };
+
+    struct MSDFMetrics
+    {
+        float LineHeight = 0.0f;
+        float AscenderY  = 0.0f;
+        float DescenderY = 0.0f;
+    };
+
+    static_assert( std::is_trivially_copyable_v<MSDFGlyph> && std::is_trivially_copyable_v<MSDFKerningPair> && std::is_trivially_copyable_v<MSDFMetrics> );
+
     struct MSDFData
     {
-        const float Range   = 2.0f;
+        const float Range   = 8.0f;    // in atlas pixels, half of it is how far outlines and glows can reach
         const float Scale   = 64.0f;
         bool        IsASCII = true;
 
-        // Storage for glyph geometry and their coordinates in the atlas
-        std::vector<msdf_atlas::GlyphGeometry> GlyphGeo;
+        MSDFMetrics                  Metrics;
+        std::vector<MSDFGlyph>       Glyphs;    // sorted by codepoint
+        std::vector<MSDFKerningPair> KerningPairs;
+
+        // fast lookup tables, filled by build_lookup_tables
+        std::unordered_map<msdf_atlas::unicode_t, const MSDFGlyph*> GlyphLookupTable;
+        KerningTable                                                Kerning;
+
+        // even faster glyph lookup if we are only using ascii characters
+        std::array<const MSDFGlyph*, std::numeric_limits<unsigned char>::max()> GlyphGeoLookuptableASCII;
 
-        // FontGeometry is a helper class that loads a set of glyphs from a single font.
-        // It can also be used to get additional font metrics, kerning information, etc.
-        msdf_atlas::FontGeometry FontGeo;
+        void build_lookup_tables()
+        {
+            GlyphLookupTable.clear();
+            for ( const MSDFGlyph& glyph : Glyphs )
+                GlyphLookupTable[ glyph.Codepoint ] = &glyph;
+
+            Kerning.build( KerningPairs );
 
-        // fast lookup tables because the msdf lib is using ordinary maps for those
-        // speeds it up by about 50%
-        std::unordered_map<msdf_atlas::unicode_t, const msdf_atlas::GlyphGeometry*> GlyphGeoLookupTable;
-        std::unordered_map<uint64_t, double>                                        KerningLookupTable;
+            if ( IsASCII == false )
+                return;
 
-        // even faster lookup tables if we are only using ascii characters
-        // this is an additional 100% faster
-        std::array<const msdf_atlas::GlyphGeometry*, std::numeric_limits<unsigned char>::max()>                              GlyphGeoLookuptableASCII;
-        std::array<std::array<double, std::numeric_limits<unsigned char>::max()>, std::numeric_limits<unsigned char>::max()> KerningLookupTableASCII;
+            for ( unsigned char c = 0; c < 255; ++c ) {
+                auto glyph_it                 = GlyphLookupTable.find( c );
+                GlyphGeoLookuptableASCII[ c ] = glyph_it != GlyphLookupTable.end() ? glyph_it->second : nullptr;
+            }
+        }
 
-        const msdf_atlas::GlyphGeometry* get_glyph( msdf_atlas::unicode_t codepoint )
+        // only knows the baked charset, Font::find_glyph also covers generated glyphs
+        const MSDFGlyph* get_glyph( msdf_atlas::unicode_t codepoint ) const
         {
-            if ( IsASCII ) {
+            if ( IsASCII && codepoint < GlyphGeoLookuptableASCII.size() ) {
                 return GlyphGeoLookuptableASCII[ static_cast<unsigned char>( codepoint ) ];
             }
             else {
-                auto geo_it = GlyphGeoLookupTable.find( codepoint );
-                if ( geo_it != GlyphGeoLookupTable.end() ) {
-                    return geo_it->second;
-                }
-                const msdf_atlas::GlyphGeometry* glyph_geo = FontGeo.getGlyph( codepoint );
-                GlyphGeoLookupTable[ codepoint ]           = glyph_geo;
-                return glyph_geo;
+                auto geo_it = GlyphLookupTable.find( codepoint );
+                return geo_it != GlyphLookupTable.end() ? geo_it->second : nullptr;
             }
         }
 
-        bool get_advance( double& advance, msdf_atlas::unicode_t character, msdf_atlas::unicode_t next_character )
+        // position inside Glyphs, uint32_t max for glyphs which are not baked
+        uint32_t get_glyph_index( msdf_atlas::unicode_t codepoint ) const
         {
-            if ( IsASCII ) {
-                advance = KerningLookupTableASCII[ static_cast<unsigned char>( character ) ][ static_cast<unsigned char>( next_character ) ];
-                return true;
-            }
-            else {
-                union Key
-                {
-                    uint64_t value;
-
-                    struct Pair
-                    {
-                        int index_1;
-                        int index_2;
-                    } pair;
-                };
-
-                const GlyphGeometry* glyph1;
-                const GlyphGeometry* glyph2;
-
-                if ( !( ( glyph1 = get_glyph( character ) ) && ( glyph2 = get_glyph( next_character ) ) ) )
-                    return false;
-                advance = glyph1->getAdvance();
-
-                Key key;
-                key.pair.index_1 = glyph1->getIndex();
-                key.pair.index_2 = glyph2->getIndex();
-
-                auto it = KerningLookupTable.find( key.value );
-                if ( it != KerningLookupTable.end() ) {
-                    advance += it->second;
-                }
-                else {
-                    if ( FontGeo.getAdvance( advance, character, next_character ) == false ) {
-                        return false;
-                    }
-                    else {
-                        KerningLookupTable[ key.value ] = advance - glyph1->getAdvance();
-                    }
-                }
-                return true;
-            }
+            const MSDFGlyph* glyph = get_glyph( codepoint );
+            return glyph != nullptr ? static_cast<uint32_t>( glyph - Glyphs.data() ) : std::numeric_limits<uint32_t>::max();
+        }
+
+        // advance of the glyph including the kerning towards the next one
+        bool get_advance( double& advance, msdf_atlas::unicode_t character, msdf_atlas::unicode_t next_character ) const
+        {
+            const MSDFGlyph* glyph = get_glyph( character );
+            if ( glyph == nullptr )
+                return false;
+
+            advance = static_cast<double>( glyph->Advance ) + Kerning.get_kerning( character, next_character );
+            return true;
         }
     };
 }    // namespace InnoEngine
@@ -0,0 +1,220 @@
+#include "InnoEngine/iepch.h"
+#include "InnoEngine/graphics/ParticleSystem.h"
+
+#include "DirectXPackedVector.h"
+
+namespace InnoEngine
+{
+    namespace
+    {
+        DirectX::XMVECTOR load_lanes( const std::vector<float>& stream, uint32_t index )
+        {
+            return DirectX::XMLoadFloat4( reinterpret_cast<const DirectX::XMFLOAT4*>( &stream[ index ] ) );
+        }
+
+        void store_lanes( std::vector<float>& stream, uint32_t index, DirectX::FXMVECTOR value )
+        {
+            DirectX::XMStoreFloat4( reinterpret_cast<DirectX::XMFLOAT4*>( &stream[ index ] ), value );
+        }
+
+        uint32_t pack_color( DirectX::FXMVECTOR color )
+        {
+            DirectX::PackedVector::XMUBYTEN4 packed;
+            DirectX::PackedVector::XMStoreUByteN4( &packed, color );
+            return packed.v;
+        }
+
+        float random_range( float min, float max )
+        {
+            return min + ( max - min ) * SDL_randf();
+        }
+    }    // namespace
+
+    std::atomic<uint32_t> ParticleSystem::ms_NextID = 1;
+
+    auto ParticleSystem::create( const ParticleSystemSpecifications& specs ) -> std::optional<Ref<ParticleSystem>>
+    {
+        if ( specs.MaxParticles == 0 ) {
+            IE_LOG_ERROR( "Creating particle system failed: {}", "Invalid specifications" );
+            return std::nullopt;
+        }
+
+        Ref<ParticleSystem> system = Ref<ParticleSystem>( new ParticleSystem() );
+        system->m_Specs            = specs;
+        system->m_ID               = ms_NextID.fetch_add( 1, std::memory_order_relaxed );
+
+        if ( specs.Simulation == ParticleSimulation::CPU ) {
+            const uint32_t capacity = ( specs.MaxParticles + 3 ) & ~3u;
+            for ( std::vector<float>* stream : { &system->m_PositionX, &system->m_PositionY, &system->m_VelocityX, &system->m_VelocityY,
+                                                 &system->m_Age, &system->m_InvLifetime, &system->m_SizeStart, &system->m_SizeDelta, &system->m_Size } ) {
+                stream->resize( capacity, 0.0f );
+            }
+            system->m_ColorStart.resize( capacity );
+            system->m_ColorDelta.resize( capacity );
+            system->m_Color.resize( capacity, 0 );
+        }
+        return system;
+    }
+
+    ParticleSystem::EmitterHandle ParticleSystem::add_emitter( const ParticleEmitter& emitter )
+    {
+        m_Emitters.push_back( emitter );
+        m_SpawnAccumulators.push_back( 0.0f );
+        return static_cast<EmitterHandle>( m_Emitters.size() - 1 );
+    }
+
+    ParticleEmitter& ParticleSystem::get_emitter( EmitterHandle handle )
+    {
+        IE_ASSERT( handle < m_Emitters.size() );
+        return m_Emitters[ handle ];
+    }
+
+    void ParticleSystem::emit( const ParticleEmitter& emitter, uint32_t count )
+    {
+        for ( uint32_t i = 0; i < count; ++i ) {
+            spawn( emitter );
+        }
+    }
+
+    void ParticleSystem::update( float delta_time )
+    {
+        m_Time += delta_time;
+
+        // advance the existing particles first, new ones start exactly at their emitter
+        if ( m_Specs.Simulation == ParticleSimulation::CPU ) {
+            simulate( delta_time );
+            remove_dead_particles();
+        }
+
+        for ( size_t i = 0; i < m_Emitters.size(); ++i ) {
+            const ParticleEmitter& emitter = m_Emitters[ i ];
+            if ( emitter.Enabled == false || emitter.SpawnRate <= 0.0f )
+                continue;
+
+            float& accumulator  = m_SpawnAccumulators[ i ];
+            accumulator        += emitter.SpawnRate * delta_time;
+            const float count   = std::floor( accumulator );
+            accumulator        -= count;
+            emit( emitter, static_cast<uint32_t>( count ) );
+        }
+    }
+
+    void ParticleSystem::clear()
+    {
+        // particles already living on the gpu run out on their own
+        m_Count = 0;
+        m_PendingSpawns.clear();
+    }
+
+    uint32_t ParticleSystem::get_particle_count() const
+    {
+        return m_Count;
+    }
+
+    const ParticleSystemSpecifications& ParticleSystem::get_specs() const
+    {
+        return m_Specs;
+    }
+
+    uint32_t ParticleSystem::get_id() const
+    {
+        return m_ID;
+    }
+
+    void ParticleSystem::spawn( const ParticleEmitter& emitter )
+    {
+        const float         angle    = emitter.Direction + ( SDL_randf() - 0.5f ) * emitter.Spread;
+        const float         speed    = random_range( emitter.SpeedMin, emitter.SpeedMax );
+        const float         lifetime = std::max( random_range( emitter.LifetimeMin, emitter.LifetimeMax ), 0.001f );
+        const DXSM::Vector2 position = emitter.Position + emitter.Extent * DXSM::Vector2( SDL_randf() * 2.0f - 1.0f, SDL_randf() * 2.0f - 1.0f );
+        const DXSM::Vector2 velocity = DXSM::Vector2( std::cos( angle ), std::sin( angle ) ) * speed;
+
+        if ( m_Specs.Simulation == ParticleSimulation::GPU ) {
+            m_PendingSpawns.push_back( { position, velocity, 0.0f, lifetime, emitter.SizeStart, emitter.SizeEnd, emitter.ColorStart, emitter.ColorEnd } );
+            ++m_SpawnSequence;
+
+            // the ring buffer on the gpu holds MaxParticles, older pending spawns would get overwritten anyway,
+            // they are dropped in one go once twice as many piled up instead of one by one
+            if ( m_PendingSpawns.size() >= 2 * static_cast<size_t>( m_Specs.MaxParticles ) )
+                m_PendingSpawns.erase( m_PendingSpawns.begin(), m_PendingSpawns.end() - m_Specs.MaxParticles );
+            return;
+        }
+
+        if ( m_Count >= m_Specs.MaxParticles )
+            return;
+
+        const uint32_t i   = m_Count++;
+        m_PositionX[ i ]   = position.x;
+        m_PositionY[ i ]   = position.y;
+        m_VelocityX[ i ]   = velocity.x;
+        m_VelocityY[ i ]   = velocity.y;
+        m_Age[ i ]         = 0.0f;
+        m_InvLifetime[ i ] = 1.0f / lifetime;
+        m_SizeStart[ i ]   = emitter.SizeStart;
+        m_SizeDelta[ i ]   = emitter.SizeEnd - emitter.SizeStart;
+        m_ColorStart[ i ]  = emitter.ColorStart;
+        m_ColorDelta[ i ]  = emitter.ColorEnd - emitter.ColorStart;
+        m_Size[ i ]        = emitter.SizeStart;
+        m_Color[ i ]       = pack_color( emitter.ColorStart );
+    }
+
+    void ParticleSystem::simulate( float delta_time )
+    {
+        using namespace DirectX;
+
+        const XMVECTOR dt        = XMVectorReplicate( delta_time );
+        const XMVECTOR gravity_x = XMVectorReplicate( m_Specs.Gravity.x * delta_time );
+        const XMVECTOR gravity_y = XMVectorReplicate( m_Specs.Gravity.y * delta_time );
+        const XMVECTOR damping   = XMVectorReplicate( std::max( 1.0f - m_Specs.Drag * delta_time, 0.0f ) );
+        const XMVECTOR one       = XMVectorSplatOne();
+
+        // four particles per iteration, the streams are padded so the last lanes may hold stale data
+        for ( uint32_t i = 0; i < m_Count; i += 4 ) {
+            const XMVECTOR velocity_x = XMVectorMultiply( XMVectorAdd( load_lanes( m_VelocityX, i ), gravity_x ), damping );
+            const XMVECTOR velocity_y = XMVectorMultiply( XMVectorAdd( load_lanes( m_VelocityY, i ), gravity_y ), damping );
+            const XMVECTOR age        = XMVectorAdd( load_lanes( m_Age, i ), dt );
+            const XMVECTOR progress   = XMVectorMin( XMVectorMultiply( age, load_lanes( m_InvLifetime, i ) ), one );
+
+            store_lanes( m_VelocityX, i, velocity_x );
+            store_lanes( m_VelocityY, i, velocity_y );
+            store_lanes( m_PositionX, i, XMVectorMultiplyAdd( velocity_x, dt, load_lanes( m_PositionX, i ) ) );
+            store_lanes( m_PositionY, i, XMVectorMultiplyAdd( velocity_y, dt, load_lanes( m_PositionY, i ) ) );
+            store_lanes( m_Age, i, age );
+            store_lanes( m_Size, i, XMVectorMultiplyAdd( load_lanes( m_SizeDelta, i ), progress, load_lanes( m_SizeStart, i ) ) );
+
+            // a color already fills a vector, so blend one particle per lane
+            XMFLOAT4 lane_progress;
+            XMStoreFloat4( &lane_progress, progress );
+            const float lanes[ 4 ] = { lane_progress.x, lane_progress.y, lane_progress.z, lane_progress.w };
+            for ( uint32_t lane = 0; lane < 4; ++lane ) {
+                const XMVECTOR color = XMVectorMultiplyAdd( XMLoadFloat4( &m_ColorDelta[ i + lane ] ), XMVectorReplicate( lanes[ lane ] ), XMLoadFloat4( &m_ColorStart[ i + lane ] ) );
+                m_Color[ i + lane ]  = pack_color( color );
+            }
+        }
+    }
+
+    void ParticleSystem::remove_dead_particles()
+    {
+        // swap the last particle into the gap, the order of particles does not matter
+        for ( uint32_t i = 0; i < m_Count; ) {
+            if ( m_Age[ i ] * m_InvLifetime[ i ] < 1.0f ) {
+                ++i;
+                continue;
+            }
+
+            const uint32_t last = --m_Count;
+            m_PositionX[ i ]    = m_PositionX[ last ];
+            m_PositionY[ i ]    = m_PositionY[ last ];
+            m_VelocityX[ i ]    = m_VelocityX[ last ];
+            m_VelocityY[ i ]    = m_VelocityY[ last ];
+            m_Age[ i ]          = m_Age[ last ];
+            m_InvLifetime[ i ]  = m_InvLifetime[ last ];
+            m_SizeStart[ i ]    = m_SizeStart[ last ];
+            m_SizeDelta[ i ]    = m_SizeDelta[ last ];
+            m_ColorStart[ i ]   = m_ColorStart[ last ];
+            m_ColorDelta[ i ]   = m_ColorDelta[ last ];
+            m_Size[ i ]         = m_Size[ last ];
+            m_Color[ i ]        = m_Color[ last ];
+        }
+    }
+}    // namespace InnoEngine
@@ -0,0 +1,117 @@
+#pragma once
+#include "InnoEngine/BaseTypes.h"
+
+#include <atomic>
+#include <optional>
+#include <vector>
+
+namespace InnoEngine
+{
+    enum class ParticleSimulation
+    {
+        CPU = 0,    // simd kernels in update(), the live particles get copied for the render thread
+        GPU,        // ParticleSimulate.comp keeps the particles on the gpu, only new particles get uploaded
+    };
+
+    struct ParticleSystemSpecifications
+    {
+        uint32_t           MaxParticles = 4096;
+        ParticleSimulation Simulation   = ParticleSimulation::CPU;
+        DXSM::Vector2      Gravity      = { 0.0f, 0.0f };    // in world units per second squared
+        float              Drag         = 0.0f;              // fraction of the velocity lost per second
+    };
+
+    struct ParticleEmitter
+    {
+        DXSM::Vector2 Position    = { 0.0f, 0.0f };
+        DXSM::Vector2 Extent      = { 0.0f, 0.0f };    // particles spawn inside position +- extent
+        float         SpawnRate   = 0.0f;              // particles per second, 0 only emits bursts
+        float         LifetimeMin = 1.0f;              // in seconds
+        float         LifetimeMax = 1.0f;
+        float         SpeedMin    = 0.0f;    // in world units per second
+        float         SpeedMax    = 0.0f;
+        float         Direction   = 0.0f;               // in radians
+        float         Spread      = DirectX::XM_2PI;    // in radians, centered on the direction
+        float         SizeStart   = 1.0f;               // diameter in world units
+        float         SizeEnd     = 1.0f;
+        DXSM::Color   ColorStart  = { 1.0f, 1.0f, 1.0f, 1.0f };
+        DXSM::Color   ColorEnd    = { 1.0f, 1.0f, 1.0f, 0.0f };
+        bool          Enabled     = true;
+    };
+
+    // particles are stored as structure of arrays, update() advances them four at a time
+    // emitters spawn continuously with their spawn rate, emit() spawns bursts
+    class ParticleSystem
+    {
+        friend class RenderContext;
+        friend class Particle2DPipeline;
+
+        ParticleSystem() = default;
+
+    public:
+        using EmitterHandle = uint32_t;
+
+        // state of a single particle in ParticleSimulate.comp
+        struct GPUParticle
+        {
+            DXSM::Vector2 Position;
+            DXSM::Vector2 Velocity;
+            float         Age;
+            float         Lifetime;
+            float         SizeStart;
+            float         SizeEnd;
+            DXSM::Color   ColorStart;
+            DXSM::Color   ColorEnd;
+        };
+
+        static auto create( const ParticleSystemSpecifications& specs ) -> std::optional<Ref<ParticleSystem>>;
+
+        EmitterHandle    add_emitter( const ParticleEmitter& emitter );
+        ParticleEmitter& get_emitter( EmitterHandle handle );
+
+        void emit( const ParticleEmitter& emitter, uint32_t count );
+        void update( float delta_time );
+        void clear();
+
+        uint32_t                            get_particle_count() const;    // only tracked for cpu simulated systems
+        const ParticleSystemSpecifications& get_specs() const;
+        uint32_t                            get_id() const;
+
+    private:
+        void spawn( const ParticleEmitter& emitter );
+        void simulate( float delta_time );
+        void remove_dead_particles();
+
+    private:
+        ParticleSystemSpecifications m_Specs = {};
+        std::vector<ParticleEmitter> m_Emitters;
+        std::vector<float>           m_SpawnAccumulators;    // fractional particles per emitter
+
+        // particle streams, padded to a multiple of four so the kernels never need a scalar tail
+        uint32_t                   m_Count = 0;
+        std::vector<float>         m_PositionX;
+        std::vector<float>         m_PositionY;
+        std::vector<float>         m_VelocityX;
+        std::vector<float>         m_VelocityY;
+        std::vector<float>         m_Age;
+        std::vector<float>         m_InvLifetime;
+        std::vector<float>         m_SizeStart;
+        std::vector<float>         m_SizeDelta;
+        std::vector<DXSM::Vector4> m_ColorStart;
+        std::vector<DXSM::Vector4> m_ColorDelta;
+
+        // render streams, written by simulate()
+        std::vector<float>    m_Size;
+        std::vector<uint32_t> m_Color;    // rgba8
+
+        // gpu simulation, spawns are numbered so a dropped frame can send them again
+        std::vector<GPUParticle> m_PendingSpawns;
+        uint64_t                 m_SpawnSequence  = 0;    // total spawned particles
+        std::atomic<uint64_t>    m_UploadedSpawns = 0;    // written by the render thread
+        float                    m_Time           = 0.0f;
+
+        uint32_t m_ID = 0;
+
+        static std::atomic<uint32_t> ms_NextID;
+    };
+}    // namespace InnoEngine
@@ -3,61 +3,29 @@
 
 namespace InnoEngine
 {
-    RenderCommandBuffer::RenderCommandBuffer()
+    RenderContextCommands& RenderCommandBuffer::acquire_context_commands()
     {
-        RenderContextCommands.resize( 256 );
-        for ( auto& render_ctx_cmd : RenderContextCommands ) {
-            render_ctx_cmd.FontRegister    = &FontRegister;
-            render_ctx_cmd.StringBuffer    = &StringBuffer;
-            render_ctx_cmd.TextureRegister = &TextureRegister;
+        if ( m_ActiveContextCount == m_ContextCommands.size() ) {
+            // heap allocated, rendercontexts keep a pointer to their commands while collecting
+            auto& render_ctx_cmds            = m_ContextCommands.emplace_back( std::make_unique<RenderContextCommands>() );
+            render_ctx_cmds->FontRegister    = &FontRegister;
+            render_ctx_cmds->StringBuffer    = &StringBuffer;
+            render_ctx_cmds->TextureRegister = &TextureRegister;
         }
+
+        return *m_ContextCommands[ m_ActiveContextCount++ ];
     }
 
-    /*
-    RenderCommandBuffer& RenderCommandBuffer::operator=( RenderCommandBuffer& other )
+    const RenderContextCommands& RenderCommandBuffer::get_context_commands( RenderCommandBufferIndexType index ) const
     {
-        if ( this == &other )
-            return *this;
-
-        Clear      = other.Clear;
-        ClearColor = other.ClearColor;
-
-
-        SpriteRenderCommands.resize( other.SpriteRenderCommands.size() );
-        std::memcpy( static_cast<void*>( SpriteRenderCommands.data() ),
-                     static_cast<void*>( other.SpriteRenderCommands.data() ),
-                     other.SpriteRenderCommands.size() * sizeof( Sprite2DPipeline::Command ) );
-
-        QuadRenderCommands.resize( other.QuadRenderCommands.size() );
-        std::memcpy( static_cast<void*>( QuadRenderCommands.data() ),
-                     static_cast<void*>( other.QuadRenderCommands.data() ),
-                     other.QuadRenderCommands.size() * sizeof( Primitive2DPipeline::QuadCommand ) );
-
-        LineRenderCommands.resize( other.LineRenderCommands.size() );
-        std::memcpy( static_cast<void*>( LineRenderCommands.data() ),
-                     static_cast<void*>( other.LineRenderCommands.data() ),
-                     other.LineRenderCommands.size() * sizeof( Primitive2DPipeline::LineCommand ) );
-
-        CircleRenderCommands.resize( other.CircleRenderCommands.size() );
-        std::memcpy( static_cast<void*>( CircleRenderCommands.data() ),
-                     static_cast<void*>( other.CircleRenderCommands.data() ),
-                     other.CircleRenderCommands.size() * sizeof( Primitive2DPipeline::CircleCommand ) );
-
-        ImGuiCommandBuffer = other.ImGuiCommandBuffer;
-
-        FontRenderCommands.resize( other.FontRenderCommands.size() );
-        std::memcpy( static_cast<void*>( FontRenderCommands.data() ),
-                     static_cast<void*>( other.FontRenderCommands.data() ),
-                     other.FontRenderCommands.size() * sizeof( Font2DPipeline::Command ) );
-
-        StringBuffer = other.StringBuffer;
-
-        FontRegister    = other.FontRegister;
-        TextureRegister = other.TextureRegister;
+        IE_ASSERT( index < m_ActiveContextCount );
+        return *m_ContextCommands[ index ];
+    }
 
-        return *this;
+    uint32_t RenderCommandBuffer::get_active_context_count() const
+    {
+        return m_ActiveContextCount;
     }
-    */
 
     void RenderCommandBuffer::clear()
     {
@@ -66,17 +34,27 @@ namespace InnoEngine
 
         RenderContextData.clear();
 
-        // clear the commands but not the rendercontexts itself
-        for ( auto& render_ctx_cmds : RenderContextCommands ) {
+        // clear the commands of the used contexts only, the vectors keep their capacity
+        for ( uint32_t i = 0; i < m_ActiveContextCount; ++i ) {
+            RenderContextCommands& render_ctx_cmds = *m_ContextCommands[ i ];
             render_ctx_cmds.CircleRenderCommands.clear();
+            render_ctx_cmds.PolygonRenderCommands.clear();
+            render_ctx_cmds.ParticleRenderCommands.clear();
             render_ctx_cmds.SpriteRenderCommands.clear();
+            render_ctx_cmds.NineSliceRenderCommands.clear();
+            render_ctx_cmds.TilemapRenderCommands.clear();
             render_ctx_cmds.QuadRenderCommands.clear();
             render_ctx_cmds.LineRenderCommands.clear();
+            render_ctx_cmds.PolylineRenderCommands.clear();
             render_ctx_cmds.FontRenderCommands.clear();
             render_ctx_cmds.SpriteRenderCommandsOpaque.clear();
             render_ctx_cmds.QuadRenderCommandsOpaque.clear();
+            render_ctx_cmds.PolygonRenderCommandsOpaque.clear();
+            render_ctx_cmds.RoundedRectRenderCommands.clear();
+            render_ctx_cmds.ShapeSequence = 0;
         }
-        ImGuiCommandBuffer.RenderCommandLists.clear();
+        m_ActiveContextCount = 0;
+        ImGuiCommandBuffer.clear();
 
         StringBuffer.clear();
 
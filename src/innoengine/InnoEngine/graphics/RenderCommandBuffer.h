@@ -8,6 +8,8 @@
 #include "InnoEngine/graphics/pipelines/Font2DPipeline.h"
 #include "InnoEngine/graphics/pipelines/ImGuiPipeline.h"
 #include "InnoEngine/graphics/pipelines/Primitive2DPipeline.h"
+#include "InnoEngine/graphics/pipelines/Tilemap2DPipeline.h"
+#include "InnoEngine/graphics/pipelines/Particle2DPipeline.h"
 
 #include "InnoEngine/utility/StringArena.h"
 #include "InnoEngine/graphics/Viewport.h"
@@ -26,23 +28,31 @@ namespace InnoEngine
         StringArena* StringBuffer    = nullptr;    // owned by RenderCommandBuffer
         FontList*    FontRegister    = nullptr;    // owned by RenderCommandBuffer
 
-        SpriteCommandBuffer SpriteRenderCommandsOpaque;
-        QuadCommandBuffer   QuadRenderCommandsOpaque;
+        TilemapCommandBuffer TilemapRenderCommands;    // drawn first, together with the opaque commands
+        SpriteCommandBuffer  SpriteRenderCommandsOpaque;
+        QuadCommandBuffer    QuadRenderCommandsOpaque;
+        PolygonCommandBuffer PolygonRenderCommandsOpaque;
 
-        SpriteCommandBuffer SpriteRenderCommands;
-        QuadCommandBuffer   QuadRenderCommands;
-        LineCommandBuffer   LineRenderCommands;
-        CircleCommandBuffer CircleRenderCommands;
-        FontCommandBuffer   FontRenderCommands;
+        SpriteCommandBuffer      SpriteRenderCommands;
+        NineSliceCommandBuffer   NineSliceRenderCommands;
+        QuadCommandBuffer        QuadRenderCommands;
+        LineCommandBuffer        LineRenderCommands;
+        PolylineCommandBuffer    PolylineRenderCommands;
+        CircleCommandBuffer      CircleRenderCommands;
+        PolygonCommandBuffer     PolygonRenderCommands;
+        RoundedRectCommandBuffer RoundedRectRenderCommands;
+        ParticleCommandBuffer    ParticleRenderCommands;
+        FontCommandBuffer        FontRenderCommands;
+
+        uint32_t ShapeSequence = 0;    // submission order of quads, lines, circles and rounded rects
     };
 
     struct RenderCommandBuffer
     {
-        bool        Clear;
+        bool        Clear = false;
         DXSM::Color ClearColor;
 
-        std::vector<RenderContextFrameData> RenderContextData;
-        std::vector<RenderContextCommands>  RenderContextCommands;
+        std::vector<RenderContextFrameData> RenderContextData;    // one entry per acquired rendercontext, same order as the commands
 
         TextureList TextureRegister;    // hold a reference to all texture objects we are going to use this frame
         StringArena StringBuffer;       // arena like container to hold a copy of all strings we are going to render this frame
@@ -50,10 +60,16 @@ namespace InnoEngine
 
         ImGuiPipeline::CommandData ImGuiCommandBuffer;
 
-        RenderCommandBuffer();
-        RenderCommandBuffer& operator=( RenderCommandBuffer& other );
+        RenderContextCommands&       acquire_context_commands();    // reuses the command vectors of earlier frames when possible
+        const RenderContextCommands& get_context_commands( RenderCommandBufferIndexType index ) const;
+        uint32_t                     get_active_context_count() const;
 
         void clear();
+
+    private:
+        // only the first m_ActiveContextCount entries are in use this frame, the rest keep their capacity for later frames
+        std::vector<Own<RenderContextCommands>> m_ContextCommands;
+        uint32_t                                m_ActiveContextCount = 0;
     };
 
 }    // namespace InnoEngine
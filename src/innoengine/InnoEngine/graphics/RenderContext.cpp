@@ -75,6 +75,9 @@ namespace InnoEngine
         cmd.Rotation       = sprite.m_RotationRadians;
         cmd.RotationOrigin = sprite.m_RotationOffset;
         cmd.Color          = sprite.m_Color;
+        cmd.Animation      = sprite.m_PackedAnimation;
+        cmd.FrameRate      = sprite.m_Animation.FrameRate;
+        cmd.AnimationStart = sprite.m_Animation.StartTime;
     }
 
     void RenderContext::add_pixel( const DXSM::Vector2& position, const DXSM::Color& color ) const
@@ -95,6 +98,7 @@ namespace InnoEngine
             cmd.Rotation                  = DirectX::XMConvertToRadians( rotation );
             cmd.RotationOrigin            = rotation_offset;
             cmd.Color                     = color;
+            cmd.Sequence                  = m_RenderCommandBuffer->ShapeSequence++;
         }
         else {
             Primitive2DPipeline::QuadCommand& cmd = m_RenderCommandBuffer->QuadRenderCommands.emplace_back();
@@ -105,6 +109,7 @@ namespace InnoEngine
             cmd.Rotation                  = DirectX::XMConvertToRadians( rotation );
             cmd.RotationOrigin            = rotation_offset;
             cmd.Color                     = color;
+            cmd.Sequence                  = m_RenderCommandBuffer->ShapeSequence++;
         }
     }
 
@@ -119,6 +124,7 @@ namespace InnoEngine
         cmd.Thickness = thickness;
         cmd.EdgeFade  = edge_fade;
         cmd.Color     = color;
+        cmd.Sequence  = m_RenderCommandBuffer->ShapeSequence++;
     }
 
     void RenderContext::add_lines( const std::vector<DXSM::Vector2>& points, const DXSM::Color& color, float thickness, float edge_fade, bool loop ) const
@@ -151,6 +157,73 @@ namespace InnoEngine
         }
     }
 
+    void RenderContext::add_polyline( const std::vector<DXSM::Vector2>& points, const DXSM::Color& color, float thickness, LineJoin join, LineCap cap, bool closed, float edge_fade ) const
+    {
+        IE_ASSERT( m_RenderCommandBuffer != nullptr && m_RenderCommandBufferIndex != InvalidRenderCommandBufferIndex );
+
+        PolylineCommandBuffer& polylines   = m_RenderCommandBuffer->PolylineRenderCommands;
+        const uint32_t         first_point = static_cast<uint32_t>( polylines.Points.size() );
+
+        // duplicated points have no direction, the joins would break
+        for ( const DXSM::Vector2& point : points ) {
+            if ( polylines.Points.size() > first_point && polylines.Points.back() == point )
+                continue;
+
+            if ( polylines.Points.size() - first_point == Primitive2DPipeline::MaxPolylinePoints ) {
+                IE_LOG_WARNING( "Polyline has more than {} points, the rest gets skipped", Primitive2DPipeline::MaxPolylinePoints );
+                break;
+            }
+            polylines.Points.push_back( point );
+        }
+
+        uint32_t point_count = static_cast<uint32_t>( polylines.Points.size() ) - first_point;
+        if ( point_count > 2 && polylines.Points.back() == polylines.Points[ first_point ] ) {
+            polylines.Points.pop_back();
+            --point_count;
+            closed = true;
+        }
+
+        if ( point_count < 2 ) {
+            polylines.Points.resize( first_point );
+            return;
+        }
+
+        Primitive2DPipeline::PolylineCommand& cmd = polylines.Commands.emplace_back();
+        populate_command_base( &cmd );
+        cmd.FirstPoint = first_point;
+        cmd.PointCount = point_count;
+        cmd.Color      = color;
+        cmd.Thickness  = thickness;
+        cmd.EdgeFade   = edge_fade;
+        cmd.Join       = join;
+        cmd.Cap        = cap;
+        cmd.Closed     = closed && point_count > 2;
+    }
+
+    void RenderContext::add_polygon( const std::vector<DXSM::Vector2>& vertices, const DXSM::Color& color ) const
+    {
+        IE_ASSERT( m_RenderCommandBuffer != nullptr && m_RenderCommandBufferIndex != InvalidRenderCommandBufferIndex );
+
+        if ( vertices.size() < 3 )
+            return;
+
+        uint32_t vertex_count = static_cast<uint32_t>( vertices.size() );
+        if ( vertex_count > Primitive2DPipeline::MaxPolygonVertices ) {
+            IE_LOG_WARNING( "Polygon has more than {} vertices, the rest gets skipped", Primitive2DPipeline::MaxPolygonVertices );
+            vertex_count = Primitive2DPipeline::MaxPolygonVertices;
+        }
+
+        PolygonCommandBuffer& polygons = color.A() == 1.0f ? m_RenderCommandBuffer->PolygonRenderCommandsOpaque : m_RenderCommandBuffer->PolygonRenderCommands;
+
+        Primitive2DPipeline::PolygonCommand& cmd = polygons.Commands.emplace_back();
+        populate_command_base( &cmd );
+        cmd.FirstVertex = static_cast<uint32_t>( polygons.Vertices.size() );
+        cmd.VertexCount = vertex_count;
+        cmd.Color       = color;
+
+        polygons.Vertices.insert( polygons.Vertices.end(), vertices.begin(), vertices.begin() + vertex_count );
+    }
+
     void RenderContext::add_circle( const DXSM::Vector2& center_position, float radius, const DXSM::Color& color, float thickness, float edge_fade ) const
     {
         IE_ASSERT( m_RenderCommandBuffer != nullptr && m_RenderCommandBufferIndex != InvalidRenderCommandBufferIndex );
@@ -163,6 +236,23 @@ namespace InnoEngine
         cmd.Radius     = radius;
         cmd.Fade       = edge_fade;
         cmd.Thickness  = thickness;
+        cmd.Sequence   = m_RenderCommandBuffer->ShapeSequence++;
+    }
+
+    void RenderContext::add_rounded_rect( const DXSM::Vector2& position, Origin position_origin, const DXSM::Vector2& size, float corner_radius, const DXSM::Color& color, float thickness, float edge_fade, float rotation ) const
+    {
+        IE_ASSERT( m_RenderCommandBuffer != nullptr && m_RenderCommandBufferIndex != InvalidRenderCommandBufferIndex );
+
+        Primitive2DPipeline::RoundedRectCommand& cmd = m_RenderCommandBuffer->RoundedRectRenderCommands.emplace_back();
+        populate_command_base( &cmd );
+        cmd.Position     = origin_transform( position_origin, position, size, size * 0.5f );
+        cmd.Size         = size;
+        cmd.Color        = color;
+        cmd.CornerRadius = corner_radius;
+        cmd.Thickness    = thickness;
+        cmd.EdgeFade     = edge_fade;
+        cmd.Rotation     = DirectX::XMConvertToRadians( rotation );
+        cmd.Sequence     = m_RenderCommandBuffer->ShapeSequence++;
     }
 
     void RenderContext::add_textured_quad( Ref<Texture2D> texture, const DXSM::Vector4& source_rect, const DXSM::Vector2& position, Origin position_origin, const DXSM::Vector2& scale, float rotation, const DXSM::Vector2& rotation_origin, const DXSM::Color& color ) const
@@ -207,7 +297,118 @@ namespace InnoEngine
         cmd.Color                     = color;
     }
 
+    void RenderContext::add_tilemap( const Ref<Tilemap>& tilemap ) const
+    {
+        IE_ASSERT( tilemap != nullptr );
+        IE_ASSERT( m_RenderCommandBuffer != nullptr && m_RenderCommandBufferIndex != InvalidRenderCommandBufferIndex );
+
+        const Ref<Texture2D>& tileset = tilemap->m_Specs.Tileset;
+        IE_ASSERT( tileset != nullptr );
+        if ( tileset->m_RenderCommandBufferIndex == InvalidRenderCommandBufferIndex )
+            register_texture( tileset );
+
+        TilemapCommandBuffer&       tilemap_cmds = m_RenderCommandBuffer->TilemapRenderCommands;
+        Tilemap2DPipeline::Command& cmd          = tilemap_cmds.Commands.emplace_back();
+        populate_command_base( &cmd );
+        cmd.Map          = tilemap;
+        cmd.TextureIndex = tileset->m_RenderCommandBufferIndex;
+        cmd.Position     = tilemap->m_Position;
+        cmd.Color        = tilemap->m_Color;
+        cmd.UploadOffset = static_cast<uint32_t>( tilemap_cmds.Uploads.size() );
+
+        // every chunk the render thread has no up to date copy of, collected frames might get dropped
+        // so this repeats until the render thread confirmed the upload
+        for ( uint32_t i = 0; i < tilemap->m_Chunks.size(); ++i ) {
+            const Tilemap::Chunk& chunk = tilemap->m_Chunks[ i ];
+            if ( chunk.UploadedRevision.load( std::memory_order_acquire ) == chunk.Revision )
+                continue;
+
+            tilemap_cmds.Uploads.push_back( { i, chunk.Revision, static_cast<uint32_t>( tilemap_cmds.TileData.size() ) } );
+            tilemap_cmds.TileData.insert( tilemap_cmds.TileData.end(), chunk.Tiles.begin(), chunk.Tiles.end() );
+        }
+        cmd.UploadCount = static_cast<uint32_t>( tilemap_cmds.Uploads.size() ) - cmd.UploadOffset;
+    }
+
+    void RenderContext::add_particles( const Ref<ParticleSystem>& particle_system ) const
+    {
+        IE_ASSERT( particle_system != nullptr );
+        IE_ASSERT( m_RenderCommandBuffer != nullptr && m_RenderCommandBufferIndex != InvalidRenderCommandBufferIndex );
+
+        ParticleCommandBuffer&       particle_cmds = m_RenderCommandBuffer->ParticleRenderCommands;
+        Particle2DPipeline::Command& cmd           = particle_cmds.Commands.emplace_back();
+        populate_command_base( &cmd );
+
+        if ( particle_system->m_Specs.Simulation == ParticleSimulation::CPU ) {
+            cmd.DataOffset = static_cast<uint32_t>( particle_cmds.Particles.size() );
+            cmd.DataCount  = particle_system->m_Count;
+            for ( uint32_t i = 0; i < particle_system->m_Count; ++i ) {
+                particle_cmds.Particles.push_back( { { particle_system->m_PositionX[ i ], particle_system->m_PositionY[ i ] },
+                                                     particle_system->m_Size[ i ],
+                                                     particle_system->m_Color[ i ] } );
+            }
+            return;
+        }
+
+        // forget the spawns the render thread confirmed, the rest gets sent again in case the last frame was dropped
+        // only the newest MaxParticles fit into the ring buffer on the gpu
+        std::vector<ParticleSystem::GPUParticle>& pending  = particle_system->m_PendingSpawns;
+        const uint64_t                            uploaded = particle_system->m_UploadedSpawns.load( std::memory_order_acquire );
+        const uint64_t                            first    = particle_system->m_SpawnSequence - pending.size();
+        uint64_t                                  drop     = uploaded > first ? uploaded - first : 0;
+        if ( pending.size() > particle_system->m_Specs.MaxParticles )
+            drop = std::max<uint64_t>( drop, pending.size() - particle_system->m_Specs.MaxParticles );
+        if ( drop > 0 )
+            pending.erase( pending.begin(), pending.begin() + static_cast<ptrdiff_t>( std::min<uint64_t>( drop, pending.size() ) ) );
+
+        cmd.System         = particle_system;
+        cmd.DataOffset     = static_cast<uint32_t>( particle_cmds.Spawns.size() );
+        cmd.DataCount      = static_cast<uint32_t>( pending.size() );
+        cmd.FirstSpawn     = particle_system->m_SpawnSequence - pending.size();
+        cmd.SimulationTime = particle_system->m_Time;
+        particle_cmds.Spawns.insert( particle_cmds.Spawns.end(), pending.begin(), pending.end() );
+    }
+
+    void RenderContext::add_nine_slice( Ref<Texture2D> texture, const DXSM::Vector4& source_rect, const DXSM::Vector4& border, const DXSM::Vector2& position, Origin position_origin, const DXSM::Vector2& size, const DXSM::Color& color, float border_scale ) const
+    {
+        IE_ASSERT( texture != nullptr );
+        IE_ASSERT( m_RenderCommandBuffer != nullptr && m_RenderCommandBufferIndex != InvalidRenderCommandBufferIndex );
+
+        if ( texture->m_RenderCommandBufferIndex == InvalidRenderCommandBufferIndex )
+            register_texture( texture );
+
+        const float texture_width  = static_cast<float>( texture->m_Specs.Width );
+        const float texture_height = static_cast<float>( texture->m_Specs.Height );
+
+        // shrink the borders proportionally when the size is smaller than the corners
+        DXSM::Vector4 world_border = border * border_scale;
+        float         horizontal   = world_border.x + world_border.z;
+        float         vertical     = world_border.y + world_border.w;
+        if ( horizontal > size.x && horizontal > 0.0f ) {
+            world_border.x *= size.x / horizontal;
+            world_border.z *= size.x / horizontal;
+        }
+        if ( vertical > size.y && vertical > 0.0f ) {
+            world_border.y *= size.y / vertical;
+            world_border.w *= size.y / vertical;
+        }
+
+        Sprite2DPipeline::NineSliceCommand& cmd = m_RenderCommandBuffer->NineSliceRenderCommands.emplace_back();
+        populate_command_base( &cmd );
+        cmd.TextureIndex = texture->m_RenderCommandBufferIndex;
+        cmd.SourceRect   = source_rect;
+        cmd.SourceBorder = { border.x / texture_width, border.y / texture_height, border.z / texture_width, border.w / texture_height };
+        cmd.Border       = world_border;
+        cmd.Color        = color;
+        cmd.Size         = size;
+        cmd.Position     = origin_transform( position_origin, position, size );
+    }
+
     void RenderContext::add_text( const Ref<Font> font, const DXSM::Vector2& position, uint32_t text_size, std::string_view text, const DXSM::Color& color ) const
+    {
+        add_text( font, position, Origin::RotationOrigin, text_size, text, {}, color );
+    }
+
+    void RenderContext::add_text( const Ref<Font> font, const DXSM::Vector2& position, Origin position_origin, uint32_t text_size, std::string_view text, const TextLayoutOptions& options, const DXSM::Color& color, const TextEffects& effects ) const
     {
         IE_ASSERT( font != nullptr );
         IE_ASSERT( m_RenderCommandBuffer != nullptr && m_RenderCommandBufferIndex != InvalidRenderCommandBufferIndex );
@@ -223,14 +424,14 @@ namespace InnoEngine
         cmd.Position        = position;
         cmd.FontSize        = text_size;
         cmd.ForegroundColor = color;
+        cmd.Options         = options;
+        cmd.Anchor          = position_origin;
+        cmd.Effects         = effects;
     }
 
     void RenderContext::add_text_centered( const Ref<Font> font, const DXSM::Vector2& position, uint32_t text_size, std::string_view text, const DXSM::Color& color ) const
     {
-        DXSM::Vector4 aabb        = font->get_aabb( text_size, text );
-        float         text_width  = aabb.z - aabb.x;
-        float         text_height = aabb.y - aabb.w;
-        add_text( font, { position.x - text_width / 2, position.y - text_height / 2 }, text_size, text, color );
+        add_text( font, position, Origin::Middle, text_size, text, {}, color );
     }
 
     uint16_t RenderContext::get_current_depth_layer()
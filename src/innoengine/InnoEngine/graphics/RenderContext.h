@@ -3,11 +3,15 @@
 #include "InnoEngine/graphics/Camera.h"
 #include "InnoEngine/graphics/Viewport.h"
 #include "InnoEngine/graphics/Sprite.h"
+#include "InnoEngine/graphics/TextLayout.h"
+#include "InnoEngine/graphics/TextEffects.h"
 
 namespace InnoEngine
 {
     class Font;
     class Texture2D;
+    class Tilemap;
+    class ParticleSystem;
     class GPURenderer;
     struct RenderContextCommands;
 
@@ -25,6 +29,7 @@ namespace InnoEngine
         DXSM::Color    ClearColor;      // only valid when a custom rendertarget is set, ignored otherwise
 
         DXSM::Matrix                 ViewProjectionMatrix;
+        float                        AnimationTime;    // GPURenderer::get_animation_time at collection
         SDL_GPUViewport              Viewport;
         RenderCommandBufferIndexType Index;
     };
@@ -65,12 +70,36 @@ namespace InnoEngine
                        float                thickness = 1.0f,
                        float                edge_fade = 0.0f ) const;
 
+        // every segment is a separate line, add_polyline joins them
         void add_lines( const std::vector<DXSM::Vector2>& points,
                         const DXSM::Color&                color,
                         float                             thickness = 1.0f,
                         float                             edge_fade = 0.0f,
                         bool                              loop      = false ) const;
 
+        // one command for the whole path, segments get expanded on the gpu
+        void add_polyline( const std::vector<DXSM::Vector2>& points,
+                           const DXSM::Color&                color,
+                           float                             thickness = 1.0f,
+                           LineJoin                          join      = LineJoin::Miter,
+                           LineCap                           cap       = LineCap::Butt,
+                           bool                              closed    = false,
+                           float                             edge_fade = 0.0f ) const;
+
+        // thickness and edge fade in world units, a thickness of 0 fills the rect
+        void add_rounded_rect( const DXSM::Vector2& position,
+                               Origin               position_origin,
+                               const DXSM::Vector2& size,
+                               float                corner_radius,
+                               const DXSM::Color&   color,
+                               float                thickness = 0.0f,
+                               float                edge_fade = 0.0f,
+                               float                rotation  = 0.0f ) const;
+
+        // the polygon has to be convex, it gets filled as a triangle fan around the first vertex
+        void add_polygon( const std::vector<DXSM::Vector2>& vertices,
+                          const DXSM::Color&                color ) const;
+
         void add_circle( const DXSM::Vector2& center_position,
                          float                radius,
                          const DXSM::Color&   color,
@@ -95,13 +124,40 @@ namespace InnoEngine
                                        const DXSM::Vector2& rotation_origin = { 0.5f, 0.5f },
                                        const DXSM::Color&   color           = { 1.0f, 1.0f, 1.0f, 1.0f } ) const;
 
+        // only the chunks inside the view get drawn, edited chunks get copied for the render thread
+        void add_tilemap( const Ref<Tilemap>& tilemap ) const;
+
+        // cpu simulated systems copy their live particles, gpu simulated ones only the particles spawned since the last upload
+        void add_particles( const Ref<ParticleSystem>& particle_system ) const;
+
+        // the border is given in texels of the texture, x == left; y == bottom; z == right; w == top
+        // corners keep their size, edges and center stretch to fill the size
+        void add_nine_slice( Ref<Texture2D>       texture,
+                             const DXSM::Vector4& source_rect,
+                             const DXSM::Vector4& border,
+                             const DXSM::Vector2& position,
+                             Origin               position_origin,
+                             const DXSM::Vector2& size,
+                             const DXSM::Color&   color        = { 1.0f, 1.0f, 1.0f, 1.0f },
+                             float                border_scale = 1.0f ) const;
+
+        // the position is the baseline of the first line
         void add_text( const Ref<Font>      font,
                        const DXSM::Vector2& position,
                        uint32_t             text_size,
                        std::string_view     text,
                        const DXSM::Color&   color = { 1.0f, 1.0f, 1.0f, 1.0f } ) const;
 
-        // Beware: recalculates text size every time. Its probably better to cache the text size for static texts.
+        // the position is the given corner or the middle of the laid out text, it gets measured by the renderer
+        void add_text( const Ref<Font>          font,
+                       const DXSM::Vector2&     position,
+                       Origin                   position_origin,
+                       uint32_t                 text_size,
+                       std::string_view         text,
+                       const TextLayoutOptions& options = {},
+                       const DXSM::Color&       color   = { 1.0f, 1.0f, 1.0f, 1.0f },
+                       const TextEffects&       effects = {} ) const;
+
         void add_text_centered( const Ref<Font>      font,
                                 const DXSM::Vector2& position,
                                 uint32_t             text_size,
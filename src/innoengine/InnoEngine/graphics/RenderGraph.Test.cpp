@@ -0,0 +1,165 @@
+#include "InnoEngine/graphics/RenderGraph.h"
+#include <gtest/gtest.h>
+#include <string_view>
+#include <vector>
+
+namespace InnoEngine
+{
+    namespace
+    {
+        // the graph is only compiled, imported textures are never dereferenced
+        SDL_GPUTexture* fake_texture( uintptr_t id )
+        {
+            return reinterpret_cast<SDL_GPUTexture*>( id );
+        }
+
+        Own<RenderGraph> create_graph()
+        {
+            return RenderGraph::create( nullptr ).value();
+        }
+
+        const RenderGraphTextureDesc ColorDesc = { 640, 360, SDL_GPU_TEXTUREFORMAT_R8G8B8A8_UNORM, SDL_GPU_TEXTUREUSAGE_COLOR_TARGET | SDL_GPU_TEXTUREUSAGE_SAMPLER };
+        const RenderGraphTextureDesc DepthDesc = { 640, 360, SDL_GPU_TEXTUREFORMAT_D16_UNORM, SDL_GPU_TEXTUREUSAGE_DEPTH_STENCIL_TARGET };
+    }    // namespace
+
+    TEST( RenderGraphTest, passOrdering )
+    {
+        Own<RenderGraph> graph = create_graph();
+
+        RenderGraphResource backbuffer = graph->import_texture( "Backbuffer", fake_texture( 1 ) );
+        RenderGraphResource scene      = graph->create_texture( "Scene", ColorDesc );
+
+        graph->add_pass( "Scene" ).write_color( scene, DXSM::Color( 0.0f, 0.0f, 0.0f, 1.0f ) ).depends_on( "Upload" );
+        graph->add_pass( "Composite" ).read( scene ).write_color( backbuffer );
+        graph->add_pass( "Ui" ).write_color( backbuffer );
+        graph->add_pass( "Upload" ).keep_alive();
+
+        ASSERT_EQ( graph->compile(), Result::Success );
+
+        // declaration order wherever the dependencies allow it
+        std::vector<std::string_view> expected = { "Upload", "Scene", "Composite", "Ui" };
+        EXPECT_EQ( graph->get_execution_order(), expected );
+    }
+
+    TEST( RenderGraphTest, cyclicDependencies )
+    {
+        Own<RenderGraph> graph = create_graph();
+
+        RenderGraphResource backbuffer = graph->import_texture( "Backbuffer", fake_texture( 1 ) );
+
+        // the shared target already orders First before Second
+        graph->add_pass( "First" ).write_color( backbuffer ).depends_on( "Second" );
+        graph->add_pass( "Second" ).write_color( backbuffer );
+
+        EXPECT_NE( graph->compile(), Result::Success );
+    }
+
+    TEST( RenderGraphTest, culling )
+    {
+        Own<RenderGraph> graph = create_graph();
+
+        RenderGraphResource backbuffer = graph->import_texture( "Backbuffer", fake_texture( 1 ) );
+        RenderGraphResource offscreen  = graph->import_texture( "Offscreen", fake_texture( 2 ), false );
+        RenderGraphResource debug      = graph->create_texture( "Debug", ColorDesc );
+
+        graph->add_pass( "Scene" ).write_color( backbuffer, DXSM::Color( 0.0f, 0.0f, 0.0f, 1.0f ) );
+        graph->add_pass( "Debug" ).write_color( debug, DXSM::Color( 0.0f, 0.0f, 0.0f, 0.0f ) );
+        graph->add_pass( "Offscreen" ).write_color( offscreen );
+        graph->add_pass( "Readback" ).write_color( offscreen ).keep_alive();
+
+        ASSERT_EQ( graph->compile(), Result::Success );
+
+        // nobody reads Debug, Offscreen only feeds a pass which is kept for its side effects
+        std::vector<std::string_view> expected = { "Scene", "Offscreen", "Readback" };
+        EXPECT_EQ( graph->get_execution_order(), expected );
+        EXPECT_EQ( graph->get_pass_count(), 4u );
+        EXPECT_EQ( graph->get_culled_pass_count(), 1u );
+
+        // culled transient textures dont take anything from the pool
+        EXPECT_EQ( graph->get_pooled_texture_count(), 0u );
+    }
+
+    TEST( RenderGraphTest, transientTexturePool )
+    {
+        Own<RenderGraph> graph = create_graph();
+
+        auto build = [ & ]() {
+            graph->reset();
+
+            RenderGraphResource backbuffer = graph->import_texture( "Backbuffer", fake_texture( 1 ) );
+            RenderGraphResource bloom      = graph->create_texture( "Bloom", ColorDesc );
+            RenderGraphResource blur       = graph->create_texture( "Blur", ColorDesc );
+            RenderGraphResource depth      = graph->create_texture( "Depth", DepthDesc );
+
+            graph->add_pass( "Bloom" ).write_color( bloom, DXSM::Color( 0.0f, 0.0f, 0.0f, 0.0f ) ).write_depth( depth, 0.0f );
+            graph->add_pass( "ApplyBloom" ).read( bloom ).write_color( backbuffer );
+            graph->add_pass( "Blur" ).write_color( blur, DXSM::Color( 0.0f, 0.0f, 0.0f, 0.0f ) );
+            graph->add_pass( "ApplyBlur" ).read( blur ).write_color( backbuffer );
+            return graph->compile();
+        };
+
+        // Bloom is dead before Blur gets written, both share one texture, the depth format needs its own
+        ASSERT_EQ( build(), Result::Success );
+        EXPECT_EQ( graph->get_pooled_texture_count(), 2u );
+
+        // the next frames reuse the pooled textures
+        for ( int frame = 0; frame < 3; ++frame ) {
+            ASSERT_EQ( build(), Result::Success );
+            EXPECT_EQ( graph->get_pooled_texture_count(), 2u );
+        }
+
+        // unused textures get released after a while
+        for ( int frame = 0; frame < 200; ++frame ) {
+            graph->reset();
+        }
+        EXPECT_EQ( graph->get_pooled_texture_count(), 0u );
+    }
+
+    TEST( RenderGraphTest, overlappingTransientTextures )
+    {
+        Own<RenderGraph> graph = create_graph();
+
+        RenderGraphResource backbuffer = graph->import_texture( "Backbuffer", fake_texture( 1 ) );
+        RenderGraphResource first      = graph->create_texture( "First", ColorDesc );
+        RenderGraphResource second     = graph->create_texture( "Second", ColorDesc );
+
+        graph->add_pass( "First" ).write_color( first, DXSM::Color( 0.0f, 0.0f, 0.0f, 0.0f ) );
+        graph->add_pass( "Second" ).read( first ).write_color( second, DXSM::Color( 0.0f, 0.0f, 0.0f, 0.0f ) );
+        graph->add_pass( "Composite" ).read( second ).write_color( backbuffer );
+
+        ASSERT_EQ( graph->compile(), Result::Success );
+
+        // Second is written while First is still read
+        EXPECT_EQ( graph->get_pooled_texture_count(), 2u );
+    }
+
+    TEST( RenderGraphTest, attachmentOps )
+    {
+        Own<RenderGraph> graph = create_graph();
+
+        RenderGraphResource backbuffer = graph->import_texture( "Backbuffer", fake_texture( 1 ) );
+        RenderGraphResource scene      = graph->create_texture( "Scene", ColorDesc );
+        RenderGraphResource depth      = graph->create_texture( "Depth", DepthDesc );
+
+        graph->add_pass( "Opaque" ).write_color( scene, DXSM::Color( 0.0f, 0.0f, 0.0f, 1.0f ) ).write_depth( depth );
+        graph->add_pass( "Alpha" ).write_color( scene ).write_depth( depth );
+        graph->add_pass( "Composite" ).read( scene ).write_color( backbuffer );
+
+        ASSERT_EQ( graph->compile(), Result::Success );
+
+        auto expect_ops = [ & ]( std::string_view pass, RenderGraphResource target, SDL_GPULoadOp load_op, SDL_GPUStoreOp store_op ) {
+            std::optional<RenderGraph::AttachmentOps> ops = graph->get_attachment_ops( pass, target );
+            ASSERT_TRUE( ops.has_value() ) << pass;
+            EXPECT_EQ( ops->LoadOp, load_op ) << pass;
+            EXPECT_EQ( ops->StoreOp, store_op ) << pass;
+        };
+
+        expect_ops( "Opaque", scene, SDL_GPU_LOADOP_CLEAR, SDL_GPU_STOREOP_STORE );
+        expect_ops( "Opaque", depth, SDL_GPU_LOADOP_DONT_CARE, SDL_GPU_STOREOP_STORE );    // nothing written before
+        expect_ops( "Alpha", scene, SDL_GPU_LOADOP_LOAD, SDL_GPU_STOREOP_STORE );
+        expect_ops( "Alpha", depth, SDL_GPU_LOADOP_LOAD, SDL_GPU_STOREOP_DONT_CARE );    // never needed again
+        expect_ops( "Composite", backbuffer, SDL_GPU_LOADOP_LOAD, SDL_GPU_STOREOP_STORE );
+
+        EXPECT_FALSE( graph->get_attachment_ops( "Composite", scene ).has_value() );    // only sampled
+    }
+}    // namespace InnoEngine
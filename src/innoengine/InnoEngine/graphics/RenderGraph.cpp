@@ -0,0 +1,553 @@
+#include "InnoEngine/iepch.h"
+#include "InnoEngine/graphics/RenderGraph.h"
+
+namespace InnoEngine
+{
+    RenderGraph::PassBuilder& RenderGraph::PassBuilder::write_color( RenderGraphResource target, std::optional<DXSM::Color> clear_color )
+    {
+        IE_ASSERT( target < m_Graph->m_Resources.size() );
+        ColorAttachment& attachment = m_Graph->m_Passes[ m_PassIndex ].ColorTargets.emplace_back();
+        attachment.Resource         = target;
+        attachment.Clear            = clear_color.has_value();
+        attachment.ClearColor       = clear_color.value_or( DXSM::Color( 0.0f, 0.0f, 0.0f, 0.0f ) );
+        return *this;
+    }
+
+    RenderGraph::PassBuilder& RenderGraph::PassBuilder::write_depth( RenderGraphResource target, std::optional<float> clear_depth )
+    {
+        IE_ASSERT( target < m_Graph->m_Resources.size() );
+        DepthAttachment& attachment = m_Graph->m_Passes[ m_PassIndex ].DepthTarget;
+        attachment.Resource         = target;
+        attachment.Clear            = clear_depth.has_value();
+        attachment.ClearDepth       = clear_depth.value_or( 0.0f );
+        return *this;
+    }
+
+    RenderGraph::PassBuilder& RenderGraph::PassBuilder::read( RenderGraphResource texture )
+    {
+        IE_ASSERT( texture < m_Graph->m_Resources.size() );
+        m_Graph->m_Passes[ m_PassIndex ].Reads.push_back( texture );
+        return *this;
+    }
+
+    RenderGraph::PassBuilder& RenderGraph::PassBuilder::depends_on( std::string_view pass_name )
+    {
+        m_Graph->m_Passes[ m_PassIndex ].Dependencies.emplace_back( pass_name );
+        return *this;
+    }
+
+    RenderGraph::PassBuilder& RenderGraph::PassBuilder::keep_alive()
+    {
+        m_Graph->m_Passes[ m_PassIndex ].KeepAlive = true;
+        return *this;
+    }
+
+    RenderGraph::PassBuilder& RenderGraph::PassBuilder::prepare( PrepareFunction function )
+    {
+        m_Graph->m_Passes[ m_PassIndex ].Prepare = std::move( function );
+        return *this;
+    }
+
+    RenderGraph::PassBuilder& RenderGraph::PassBuilder::execute( ExecuteFunction function )
+    {
+        m_Graph->m_Passes[ m_PassIndex ].Execute = std::move( function );
+        return *this;
+    }
+
+    RenderGraph::~RenderGraph()
+    {
+        if ( m_Device != nullptr ) {
+            for ( auto& pooled : m_TexturePool ) {
+                if ( pooled.Texture != nullptr )
+                    SDL_ReleaseGPUTexture( m_Device, pooled.Texture );
+            }
+            m_TexturePool.clear();
+            m_Device = nullptr;
+        }
+    }
+
+    auto RenderGraph::create( GPUDeviceRef device ) -> std::optional<Own<RenderGraph>>
+    {
+        return Own<RenderGraph>( new RenderGraph( device ) );
+    }
+
+    void RenderGraph::reset()
+    {
+        m_Passes.clear();
+        m_Resources.clear();
+        m_ExecutionOrder.clear();
+        m_Compiled = false;
+
+        // release transient textures which weren't requested for a while
+        for ( auto it = m_TexturePool.begin(); it != m_TexturePool.end(); ) {
+            it->UnusedFrames = it->BusyUntil < 0 ? it->UnusedFrames + 1 : 0;
+            it->BusyUntil    = -1;
+
+            if ( it->UnusedFrames > MaxUnusedFrames ) {
+                if ( it->Texture != nullptr )
+                    SDL_ReleaseGPUTexture( m_Device, it->Texture );
+                it = m_TexturePool.erase( it );
+            }
+            else {
+                ++it;
+            }
+        }
+    }
+
+    RenderGraphResource RenderGraph::import_texture( std::string_view name, SDL_GPUTexture* texture, bool output )
+    {
+        IE_ASSERT( texture != nullptr );
+
+        // multiple passes/contexts may target the same texture, they have to share the resource to get ordered correctly
+        for ( size_t i = 0; i < m_Resources.size(); ++i ) {
+            if ( m_Resources[ i ].Imported && m_Resources[ i ].Texture == texture ) {
+                m_Resources[ i ].Output |= output;
+                return static_cast<RenderGraphResource>( i );
+            }
+        }
+
+        Resource& resource = m_Resources.emplace_back();
+        resource.Name      = name;
+        resource.Texture   = texture;
+        resource.Imported  = true;
+        resource.Output    = output;
+        return static_cast<RenderGraphResource>( m_Resources.size() - 1 );
+    }
+
+    RenderGraphResource RenderGraph::create_texture( std::string_view name, const RenderGraphTextureDesc& desc )
+    {
+        IE_ASSERT( desc.Width > 0 && desc.Height > 0 && desc.Format != SDL_GPU_TEXTUREFORMAT_INVALID );
+
+        Resource& resource = m_Resources.emplace_back();
+        resource.Name      = name;
+        resource.Desc      = desc;
+        return static_cast<RenderGraphResource>( m_Resources.size() - 1 );
+    }
+
+    RenderGraphResource RenderGraph::find_resource( std::string_view name ) const
+    {
+        for ( size_t i = 0; i < m_Resources.size(); ++i ) {
+            if ( m_Resources[ i ].Name == name )
+                return static_cast<RenderGraphResource>( i );
+        }
+        return InvalidRenderGraphResource;
+    }
+
+    SDL_GPUTexture* RenderGraph::get_texture( RenderGraphResource resource ) const
+    {
+        IE_ASSERT( resource < m_Resources.size() );
+        return m_Resources[ resource ].Texture;
+    }
+
+    RenderGraph::PassBuilder RenderGraph::add_pass( std::string_view name )
+    {
+        Pass& pass = m_Passes.emplace_back();
+        pass.Name  = name;
+        return PassBuilder( this, static_cast<uint32_t>( m_Passes.size() - 1 ) );
+    }
+
+    Result RenderGraph::compile()
+    {
+        m_Compiled = false;
+
+        RETURN_RESULT_IF_FAILED( sort_passes() );
+        cull_passes();
+        assign_transient_textures();
+        resolve_attachment_ops();
+
+        m_Compiled = true;
+        return Result::Success;
+    }
+
+    void RenderGraph::execute( SDL_GPUCommandBuffer* gpu_cmd_buf )
+    {
+        IE_ASSERT( m_Device != nullptr && gpu_cmd_buf != nullptr );
+        IE_ASSERT( m_Compiled );
+
+        if ( IE_FAILED( create_pooled_textures() ) )
+            return;
+
+        for ( auto& resource : m_Resources ) {
+            if ( resource.Imported == false && resource.PoolIndex < m_TexturePool.size() )
+                resource.Texture = m_TexturePool[ resource.PoolIndex ].Texture;
+            resource.PendingClearColor.reset();
+            resource.PendingClearDepth.reset();
+        }
+
+        std::vector<SDL_GPUColorTargetInfo> color_targets;
+
+        for ( uint32_t position = 0; position < m_ExecutionOrder.size(); ++position ) {
+            const Pass& pass = m_Passes[ m_ExecutionOrder[ position ] ];
+
+            if ( pass.Prepare && pass.Prepare() == false ) {
+                // nothing to render, but the clears still have to happen in the next pass using the targets
+                for ( const auto& attachment : pass.ColorTargets ) {
+                    if ( attachment.Clear )
+                        m_Resources[ attachment.Resource ].PendingClearColor = attachment.ClearColor;
+                }
+                if ( pass.DepthTarget.Resource != InvalidRenderGraphResource && pass.DepthTarget.Clear )
+                    m_Resources[ pass.DepthTarget.Resource ].PendingClearDepth = pass.DepthTarget.ClearDepth;
+                continue;
+            }
+
+            color_targets.clear();
+            for ( const auto& attachment : pass.ColorTargets ) {
+                Resource& resource = m_Resources[ attachment.Resource ];
+
+                SDL_GPUColorTargetInfo& color_target = color_targets.emplace_back();
+                color_target                         = {};
+                color_target.texture                 = resource.Texture;
+                color_target.load_op                 = attachment.Ops.LoadOp;
+                color_target.store_op                = attachment.Ops.StoreOp;
+
+                // a skipped pass hands its clear on to the next pass using the target
+                if ( attachment.Clear || resource.PendingClearColor.has_value() ) {
+                    DXSM::Color clear_color  = attachment.Clear ? attachment.ClearColor : resource.PendingClearColor.value();
+                    color_target.clear_color = { clear_color.R(), clear_color.G(), clear_color.B(), clear_color.A() };
+                    color_target.load_op     = SDL_GPU_LOADOP_CLEAR;
+                }
+
+                resource.PendingClearColor.reset();
+            }
+
+            SDL_GPUDepthStencilTargetInfo depth_target = {};
+            bool                          has_depth    = pass.DepthTarget.Resource != InvalidRenderGraphResource;
+            if ( has_depth ) {
+                Resource& resource = m_Resources[ pass.DepthTarget.Resource ];
+
+                depth_target.texture          = resource.Texture;
+                depth_target.load_op          = pass.DepthTarget.Ops.LoadOp;
+                depth_target.store_op         = pass.DepthTarget.Ops.StoreOp;
+                depth_target.stencil_load_op  = SDL_GPU_LOADOP_DONT_CARE;
+                depth_target.stencil_store_op = SDL_GPU_STOREOP_DONT_CARE;
+
+                if ( pass.DepthTarget.Clear || resource.PendingClearDepth.has_value() ) {
+                    depth_target.clear_depth = pass.DepthTarget.Clear ? pass.DepthTarget.ClearDepth : resource.PendingClearDepth.value();
+                    depth_target.load_op     = SDL_GPU_LOADOP_CLEAR;
+                }
+
+                resource.PendingClearDepth.reset();
+            }
+
+            SDL_GPURenderPass* render_pass = SDL_BeginGPURenderPass( gpu_cmd_buf,
+                                                                     color_targets.data(),
+                                                                     static_cast<Uint32>( color_targets.size() ),
+                                                                     has_depth ? &depth_target : nullptr );
+            if ( render_pass == nullptr ) {
+                IE_LOG_ERROR( "Render pass \"{}\" failed to begin: {}", pass.Name, SDL_GetError() );
+                continue;
+            }
+
+            if ( pass.Execute )
+                pass.Execute( gpu_cmd_buf, render_pass );
+
+            SDL_EndGPURenderPass( render_pass );
+        }
+
+        flush_pending_clears( gpu_cmd_buf );
+    }
+
+    size_t RenderGraph::get_pass_count() const
+    {
+        return m_Passes.size();
+    }
+
+    size_t RenderGraph::get_culled_pass_count() const
+    {
+        return static_cast<size_t>( std::count_if( m_Passes.begin(), m_Passes.end(), []( const Pass& pass ) { return pass.Culled; } ) );
+    }
+
+    size_t RenderGraph::get_pooled_texture_count() const
+    {
+        return m_TexturePool.size();
+    }
+
+    std::vector<std::string_view> RenderGraph::get_execution_order() const
+    {
+        std::vector<std::string_view> names;
+        names.reserve( m_ExecutionOrder.size() );
+        for ( uint32_t pass_index : m_ExecutionOrder ) {
+            names.push_back( m_Passes[ pass_index ].Name );
+        }
+        return names;
+    }
+
+    auto RenderGraph::get_attachment_ops( std::string_view pass_name, RenderGraphResource target ) const -> std::optional<AttachmentOps>
+    {
+        for ( uint32_t pass_index : m_ExecutionOrder ) {
+            const Pass& pass = m_Passes[ pass_index ];
+            if ( pass.Name != pass_name )
+                continue;
+
+            for ( const auto& attachment : pass.ColorTargets ) {
+                if ( attachment.Resource == target )
+                    return attachment.Ops;
+            }
+            if ( pass.DepthTarget.Resource == target )
+                return pass.DepthTarget.Ops;
+        }
+        return std::nullopt;
+    }
+
+    bool RenderGraph::uses_resource( const Pass& pass, RenderGraphResource resource ) const
+    {
+        if ( writes_resource( pass, resource, nullptr ) )
+            return true;
+
+        return std::find( pass.Reads.begin(), pass.Reads.end(), resource ) != pass.Reads.end();
+    }
+
+    bool RenderGraph::writes_resource( const Pass& pass, RenderGraphResource resource, bool* clears ) const
+    {
+        for ( const auto& attachment : pass.ColorTargets ) {
+            if ( attachment.Resource == resource ) {
+                if ( clears )
+                    *clears = attachment.Clear;
+                return true;
+            }
+        }
+
+        if ( pass.DepthTarget.Resource == resource ) {
+            if ( clears )
+                *clears = pass.DepthTarget.Clear;
+            return true;
+        }
+        return false;
+    }
+
+    Result RenderGraph::sort_passes()
+    {
+        const size_t pass_count = m_Passes.size();
+
+        std::vector<std::vector<uint32_t>> successors( pass_count );
+        std::vector<uint32_t>              predecessor_count( pass_count, 0 );
+
+        auto add_edge = [ & ]( uint32_t from, uint32_t to ) {
+            successors[ from ].push_back( to );
+            ++predecessor_count[ to ];
+        };
+
+        // implicit dependencies: every pass using a resource has to run after the previous pass using it
+        for ( RenderGraphResource resource = 0; resource < m_Resources.size(); ++resource ) {
+            uint32_t previous_user = std::numeric_limits<uint32_t>::max();
+            for ( uint32_t pass_index = 0; pass_index < pass_count; ++pass_index ) {
+                if ( uses_resource( m_Passes[ pass_index ], resource ) == false )
+                    continue;
+
+                if ( previous_user != std::numeric_limits<uint32_t>::max() )
+                    add_edge( previous_user, pass_index );
+                previous_user = pass_index;
+            }
+        }
+
+        // explicit dependencies
+        for ( uint32_t pass_index = 0; pass_index < pass_count; ++pass_index ) {
+            for ( const auto& dependency : m_Passes[ pass_index ].Dependencies ) {
+                auto it = std::find_if( m_Passes.begin(), m_Passes.end(), [ & ]( const Pass& pass ) { return pass.Name == dependency; } );
+                if ( it == m_Passes.end() ) {
+                    IE_LOG_WARNING( "Render pass \"{}\" depends on unknown pass \"{}\"", m_Passes[ pass_index ].Name, dependency );
+                    continue;
+                }
+                add_edge( static_cast<uint32_t>( std::distance( m_Passes.begin(), it ) ), pass_index );
+            }
+        }
+
+        // topological sort, keeps the declaration order wherever the dependencies allow it
+        std::vector<bool> scheduled( pass_count, false );
+        m_ExecutionOrder.clear();
+
+        while ( m_ExecutionOrder.size() < pass_count ) {
+            uint32_t next = std::numeric_limits<uint32_t>::max();
+            for ( uint32_t pass_index = 0; pass_index < pass_count; ++pass_index ) {
+                if ( scheduled[ pass_index ] == false && predecessor_count[ pass_index ] == 0 ) {
+                    next = pass_index;
+                    break;
+                }
+            }
+
+            if ( next == std::numeric_limits<uint32_t>::max() ) {
+                IE_LOG_ERROR( "Render graph has cyclic pass dependencies!" );
+                return Result::Fail;
+            }
+
+            scheduled[ next ] = true;
+            m_ExecutionOrder.push_back( next );
+            for ( uint32_t successor : successors[ next ] ) {
+                --predecessor_count[ successor ];
+            }
+        }
+        return Result::Success;
+    }
+
+    void RenderGraph::cull_passes()
+    {
+        // walk backwards and keep track of which resource contents are still needed by a later pass
+        std::vector<bool> live( m_Resources.size(), false );
+        std::vector<bool> forced( m_Passes.size(), false );
+
+        for ( size_t i = 0; i < m_Resources.size(); ++i ) {
+            live[ i ] = m_Resources[ i ].Output;
+        }
+
+        for ( auto it = m_ExecutionOrder.rbegin(); it != m_ExecutionOrder.rend(); ++it ) {
+            Pass& pass = m_Passes[ *it ];
+
+            bool needed = pass.KeepAlive || forced[ *it ];
+            for ( const auto& attachment : pass.ColorTargets ) {
+                needed |= live[ attachment.Resource ];
+            }
+            if ( pass.DepthTarget.Resource != InvalidRenderGraphResource )
+                needed |= live[ pass.DepthTarget.Resource ];
+
+            pass.Culled = needed == false;
+            if ( pass.Culled )
+                continue;
+
+            // a clear makes the previous content irrelevant, loading it keeps it alive
+            for ( const auto& attachment : pass.ColorTargets ) {
+                live[ attachment.Resource ] = attachment.Clear == false;
+            }
+
+            if ( pass.DepthTarget.Resource != InvalidRenderGraphResource ) {
+                // depth is written and tested against, keep its content alive unless it gets cleared
+                live[ pass.DepthTarget.Resource ] = pass.DepthTarget.Clear == false;
+            }
+
+            for ( RenderGraphResource resource : pass.Reads ) {
+                live[ resource ] = true;
+            }
+
+            for ( const auto& dependency : pass.Dependencies ) {
+                for ( size_t i = 0; i < m_Passes.size(); ++i ) {
+                    if ( m_Passes[ i ].Name == dependency )
+                        forced[ i ] = true;
+                }
+            }
+        }
+
+        std::erase_if( m_ExecutionOrder, [ this ]( uint32_t pass_index ) { return m_Passes[ pass_index ].Culled; } );
+    }
+
+    void RenderGraph::assign_transient_textures()
+    {
+        constexpr uint32_t Unused = std::numeric_limits<uint32_t>::max();
+        std::vector<uint32_t> first_use( m_Resources.size(), Unused );
+
+        for ( uint32_t position = 0; position < m_ExecutionOrder.size(); ++position ) {
+            const Pass& pass = m_Passes[ m_ExecutionOrder[ position ] ];
+            for ( RenderGraphResource resource = 0; resource < m_Resources.size(); ++resource ) {
+                if ( uses_resource( pass, resource ) ) {
+                    if ( first_use[ resource ] == Unused )
+                        first_use[ resource ] = position;
+                    m_Resources[ resource ].LastUse = position;
+                }
+            }
+        }
+
+        std::vector<RenderGraphResource> transient_resources;
+        for ( RenderGraphResource resource = 0; resource < m_Resources.size(); ++resource ) {
+            if ( m_Resources[ resource ].Imported == false && first_use[ resource ] != Unused )
+                transient_resources.push_back( resource );
+        }
+
+        std::sort( transient_resources.begin(), transient_resources.end(), [ & ]( RenderGraphResource a, RenderGraphResource b ) {
+            return first_use[ a ] < first_use[ b ];
+        } );
+
+        // resources with disjoint lifetimes and equal descriptions share one pooled texture
+        for ( RenderGraphResource resource_index : transient_resources ) {
+            Resource& resource = m_Resources[ resource_index ];
+
+            auto pooled = std::find_if( m_TexturePool.begin(), m_TexturePool.end(), [ & ]( const PooledTexture& texture ) {
+                return texture.Desc == resource.Desc && texture.BusyUntil < static_cast<int64_t>( first_use[ resource_index ] );
+            } );
+
+            if ( pooled == m_TexturePool.end() ) {
+                m_TexturePool.push_back( { resource.Desc, nullptr, -1, 0 } );
+                pooled = m_TexturePool.end() - 1;
+            }
+
+            pooled->BusyUntil  = resource.LastUse;
+            resource.PoolIndex = static_cast<uint32_t>( std::distance( m_TexturePool.begin(), pooled ) );
+        }
+    }
+
+    void RenderGraph::resolve_attachment_ops()
+    {
+        // imported textures have content from outside, pooled ones nothing worth loading
+        std::vector<bool> has_content( m_Resources.size(), false );
+        for ( size_t i = 0; i < m_Resources.size(); ++i ) {
+            has_content[ i ] = m_Resources[ i ].Imported;
+        }
+
+        auto resolve = [ & ]( uint32_t position, RenderGraphResource resource_index, bool clear ) -> AttachmentOps {
+            const Resource& resource = m_Resources[ resource_index ];
+
+            AttachmentOps ops;
+            if ( clear )
+                ops.LoadOp = SDL_GPU_LOADOP_CLEAR;
+            else
+                ops.LoadOp = has_content[ resource_index ] ? SDL_GPU_LOADOP_LOAD : SDL_GPU_LOADOP_DONT_CARE;
+            ops.StoreOp = resource.Output || resource.LastUse > position ? SDL_GPU_STOREOP_STORE : SDL_GPU_STOREOP_DONT_CARE;
+
+            has_content[ resource_index ] = true;
+            return ops;
+        };
+
+        for ( uint32_t position = 0; position < m_ExecutionOrder.size(); ++position ) {
+            Pass& pass = m_Passes[ m_ExecutionOrder[ position ] ];
+
+            for ( auto& attachment : pass.ColorTargets ) {
+                attachment.Ops = resolve( position, attachment.Resource, attachment.Clear );
+            }
+            if ( pass.DepthTarget.Resource != InvalidRenderGraphResource )
+                pass.DepthTarget.Ops = resolve( position, pass.DepthTarget.Resource, pass.DepthTarget.Clear );
+        }
+    }
+
+    Result RenderGraph::create_pooled_textures()
+    {
+        for ( auto& pooled : m_TexturePool ) {
+            if ( pooled.Texture != nullptr )
+                continue;
+
+            SDL_GPUTextureCreateInfo createinfo = {};
+            createinfo.type                     = SDL_GPU_TEXTURETYPE_2D;
+            createinfo.format                   = pooled.Desc.Format;
+            createinfo.usage                    = pooled.Desc.Usage;
+            createinfo.width                    = pooled.Desc.Width;
+            createinfo.height                   = pooled.Desc.Height;
+            createinfo.layer_count_or_depth     = 1;
+            createinfo.num_levels               = 1;
+
+            pooled.Texture = SDL_CreateGPUTexture( m_Device, &createinfo );
+            if ( pooled.Texture == nullptr ) {
+                IE_LOG_ERROR( "Failed to create transient texture ({}x{}): {}", pooled.Desc.Width, pooled.Desc.Height, SDL_GetError() );
+                return Result::Fail;
+            }
+        }
+        return Result::Success;
+    }
+
+    void RenderGraph::flush_pending_clears( SDL_GPUCommandBuffer* gpu_cmd_buf )
+    {
+        // outputs which were supposed to be cleared but no pass rendered into them
+        for ( auto& resource : m_Resources ) {
+            if ( resource.Output == false || resource.PendingClearColor.has_value() == false )
+                continue;
+
+            DXSM::Color            clear_color  = resource.PendingClearColor.value();
+            SDL_GPUColorTargetInfo color_target = {};
+            color_target.texture                = resource.Texture;
+            color_target.clear_color            = { clear_color.R(), clear_color.G(), clear_color.B(), clear_color.A() };
+            color_target.load_op                = SDL_GPU_LOADOP_CLEAR;
+            color_target.store_op               = SDL_GPU_STOREOP_STORE;
+
+            SDL_GPURenderPass* render_pass = SDL_BeginGPURenderPass( gpu_cmd_buf, &color_target, 1, nullptr );
+            if ( render_pass != nullptr )
+                SDL_EndGPURenderPass( render_pass );
+
+            resource.PendingClearColor.reset();
+        }
+    }
+}    // namespace InnoEngine
@@ -0,0 +1,178 @@
+#pragma once
+#include "SDL3/SDL_gpu.h"
+
+#include "InnoEngine/BaseTypes.h"
+#include "InnoEngine/graphics/GPUDeviceRef.h"
+
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace InnoEngine
+{
+    using RenderGraphResource                                = uint32_t;
+    constexpr RenderGraphResource InvalidRenderGraphResource = ( std::numeric_limits<uint32_t>::max )();
+
+    struct RenderGraphTextureDesc
+    {
+        uint32_t                 Width  = 0;
+        uint32_t                 Height = 0;
+        SDL_GPUTextureFormat     Format = SDL_GPU_TEXTUREFORMAT_INVALID;
+        SDL_GPUTextureUsageFlags Usage  = 0;
+
+        bool operator==( const RenderGraphTextureDesc& other ) const = default;
+    };
+
+    // Declarative description of the render passes of one frame.
+    // The graph gets rebuilt every frame: reset() -> import/create textures -> add passes -> compile() -> execute().
+    // Passes which dont contribute to an output texture get culled, transient textures are pooled across frames
+    // and load/store ops are derived from the order in which the passes actually use the textures.
+    // compile() never touches the gpu device, the pooled textures are only created once the graph gets executed.
+    class RenderGraph
+    {
+    public:
+        using PrepareFunction = std::function<bool()>;    // return false when the pass has nothing to render this frame
+        using ExecuteFunction = std::function<void( SDL_GPUCommandBuffer* gpu_cmd_buf, SDL_GPURenderPass* render_pass )>;
+
+        struct AttachmentOps
+        {
+            SDL_GPULoadOp  LoadOp  = SDL_GPU_LOADOP_DONT_CARE;
+            SDL_GPUStoreOp StoreOp = SDL_GPU_STOREOP_DONT_CARE;
+        };
+
+        class PassBuilder
+        {
+            friend class RenderGraph;
+            PassBuilder( RenderGraph* graph, uint32_t pass_index ) :
+                m_Graph( graph ), m_PassIndex( pass_index ) { };
+
+        public:
+            PassBuilder& write_color( RenderGraphResource target, std::optional<DXSM::Color> clear_color = std::nullopt );
+            PassBuilder& write_depth( RenderGraphResource target, std::optional<float> clear_depth = std::nullopt );
+            PassBuilder& read( RenderGraphResource texture );    // texture is sampled inside the pass
+            PassBuilder& depends_on( std::string_view pass_name );
+            PassBuilder& keep_alive();    // never cull this pass, e.g. when it has side effects outside of the graph
+
+            PassBuilder& prepare( PrepareFunction function );
+            PassBuilder& execute( ExecuteFunction function );
+
+        private:
+            RenderGraph* m_Graph     = nullptr;
+            uint32_t     m_PassIndex = 0;
+        };
+
+    private:
+        RenderGraph( GPUDeviceRef device ) :
+            m_Device( device ) { };
+
+    public:
+        ~RenderGraph();
+
+        // without a device the graph can only be compiled
+        [[nodiscard]]
+        static auto create( GPUDeviceRef device ) -> std::optional<Own<RenderGraph>>;
+
+        void reset();
+
+        // imported textures are owned by someone else, outputs are never culled and always stored
+        RenderGraphResource import_texture( std::string_view name, SDL_GPUTexture* texture, bool output = true );
+        RenderGraphResource create_texture( std::string_view name, const RenderGraphTextureDesc& desc );
+        RenderGraphResource find_resource( std::string_view name ) const;
+
+        SDL_GPUTexture* get_texture( RenderGraphResource resource ) const;    // transient textures are only valid while executing
+
+        PassBuilder add_pass( std::string_view name );
+
+        Result compile();
+        void   execute( SDL_GPUCommandBuffer* gpu_cmd_buf );
+
+        size_t get_pass_count() const;
+        size_t get_culled_pass_count() const;
+        size_t get_pooled_texture_count() const;
+
+        // results of the last compile, the attachment ops assume that every pass renders
+        std::vector<std::string_view> get_execution_order() const;
+        auto                          get_attachment_ops( std::string_view pass_name, RenderGraphResource target ) const -> std::optional<AttachmentOps>;
+
+    private:
+        struct ColorAttachment
+        {
+            RenderGraphResource Resource = InvalidRenderGraphResource;
+            bool                Clear    = false;
+            DXSM::Color         ClearColor;
+            AttachmentOps       Ops;
+        };
+
+        struct DepthAttachment
+        {
+            RenderGraphResource Resource   = InvalidRenderGraphResource;
+            bool                Clear      = false;
+            float               ClearDepth = 0.0f;
+            AttachmentOps       Ops;
+        };
+
+        struct Pass
+        {
+            std::string                      Name;
+            std::vector<ColorAttachment>     ColorTargets;
+            DepthAttachment                  DepthTarget;
+            std::vector<RenderGraphResource> Reads;
+            std::vector<std::string>         Dependencies;
+
+            PrepareFunction Prepare;
+            ExecuteFunction Execute;
+
+            bool KeepAlive = false;
+            bool Culled    = false;
+        };
+
+        struct Resource
+        {
+            std::string            Name;
+            RenderGraphTextureDesc Desc;
+            SDL_GPUTexture*        Texture  = nullptr;
+            bool                   Imported = false;
+            bool                   Output   = false;
+
+            uint32_t LastUse   = 0;                                            // position in the execution order
+            uint32_t PoolIndex = ( std::numeric_limits<uint32_t>::max )();    // transient textures only
+
+            // runtime state while executing
+            std::optional<DXSM::Color> PendingClearColor;
+            std::optional<float>       PendingClearDepth;
+        };
+
+        struct PooledTexture
+        {
+            RenderGraphTextureDesc Desc;
+            SDL_GPUTexture*        Texture      = nullptr;    // created on the first execute
+            int64_t                BusyUntil    = -1;         // last pass (execution order) using it this frame
+            uint32_t               UnusedFrames = 0;
+        };
+
+        bool uses_resource( const Pass& pass, RenderGraphResource resource ) const;
+        bool writes_resource( const Pass& pass, RenderGraphResource resource, bool* clears ) const;
+
+        Result sort_passes();
+        void   cull_passes();
+        void   assign_transient_textures();
+        void   resolve_attachment_ops();
+        Result create_pooled_textures();
+
+        void flush_pending_clears( SDL_GPUCommandBuffer* gpu_cmd_buf );
+
+    private:
+        static constexpr uint32_t MaxUnusedFrames = 120;    // release pooled textures nobody asked for in this many frames
+
+        GPUDeviceRef m_Device = nullptr;
+
+        std::vector<Pass>          m_Passes;
+        std::vector<Resource>      m_Resources;
+        std::vector<uint32_t>      m_ExecutionOrder;    // indices into m_Passes, culled passes are not part of it
+        std::vector<PooledTexture> m_TexturePool;
+
+        bool m_Compiled = false;
+    };
+}    // namespace InnoEngine
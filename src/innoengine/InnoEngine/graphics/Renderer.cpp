@@ -57,6 +57,20 @@ namespace InnoEngine
                 return result;
             }
 
+            m_Tilemap2DPipeline = std::make_unique<Tilemap2DPipeline>();
+            result              = m_Tilemap2DPipeline->initialize( renderer, assetmanager );
+            if ( IE_FAILED( result ) ) {
+                IE_LOG_CRITICAL( "Failed to initialze Tilemap pipeline! Errorcode: {}", static_cast<uint32_t>( result ) );
+                return result;
+            }
+
+            m_Particle2DPipeline = std::make_unique<Particle2DPipeline>();
+            result               = m_Particle2DPipeline->initialize( renderer, assetmanager );
+            if ( IE_FAILED( result ) ) {
+                IE_LOG_CRITICAL( "Failed to initialze Particle pipeline! Errorcode: {}", static_cast<uint32_t>( result ) );
+                return result;
+            }
+
             m_ImGuiPipeline = std::make_unique<ImGuiPipeline>();
             result          = m_ImGuiPipeline->initialize( renderer );
             if ( IE_FAILED( result ) ) {
@@ -74,14 +88,18 @@ namespace InnoEngine
             IE_ASSERT( render_ctx_data.Index != InvalidRenderCommandBufferIndex );
             const RenderCommandBuffer& render_cmd_buf = get_command_buffer_for_rendering();
 
+            const RenderContextCommands& render_ctx_cmds = render_cmd_buf.get_context_commands( render_ctx_data.Index );
+
             uint32_t batch_count = 0;
-            batch_count += m_Sprite2DPipeline->prepare_render_opaque( render_cmd_buf.RenderContextCommands[ render_ctx_data.Index ].SpriteRenderCommandsOpaque );
+            batch_count += m_Tilemap2DPipeline->prepare_render( render_ctx_cmds.TilemapRenderCommands, render_ctx_data );
+            batch_count += m_Sprite2DPipeline->prepare_render_opaque( render_ctx_cmds.SpriteRenderCommandsOpaque );
 
-            batch_count += m_PrimitivePipeline->prepare_render_opaque( render_cmd_buf.RenderContextCommands[ render_ctx_data.Index ].QuadRenderCommandsOpaque,
-                                                                       render_cmd_buf.RenderContextCommands[ render_ctx_data.Index ].LineRenderCommands,
-                                                                       render_cmd_buf.RenderContextCommands[ render_ctx_data.Index ].CircleRenderCommands );
+            batch_count += m_PrimitivePipeline->prepare_render_opaque( render_ctx_cmds.QuadRenderCommandsOpaque,
+                                                                       render_ctx_cmds.LineRenderCommands,
+                                                                       render_ctx_cmds.CircleRenderCommands,
+                                                                       render_ctx_cmds.PolygonRenderCommandsOpaque );
 
-            batch_count += m_Font2DPipeline->prepare_render_opaque( render_cmd_buf.RenderContextCommands[ render_ctx_data.Index ].FontRenderCommands,
+            batch_count += m_Font2DPipeline->prepare_render_opaque( render_ctx_cmds.FontRenderCommands,
                                                                     render_cmd_buf.FontRegister,
                                                                     render_cmd_buf.StringBuffer );
             return batch_count;
@@ -93,33 +111,54 @@ namespace InnoEngine
             IE_ASSERT( render_ctx_data.Index != InvalidRenderCommandBufferIndex );
             const RenderCommandBuffer& render_cmd_buf = get_command_buffer_for_rendering();
 
+            const RenderContextCommands& render_ctx_cmds = render_cmd_buf.get_context_commands( render_ctx_data.Index );
+
             uint32_t batch_count = 0;
-            batch_count += m_Sprite2DPipeline->prepare_render( render_cmd_buf.RenderContextCommands[ render_ctx_data.Index ].SpriteRenderCommands );
+            batch_count += m_Sprite2DPipeline->prepare_render( render_ctx_cmds.SpriteRenderCommands,
+                                                               render_ctx_cmds.NineSliceRenderCommands );
 
-            batch_count += m_PrimitivePipeline->prepare_render( render_cmd_buf.RenderContextCommands[ render_ctx_data.Index ].QuadRenderCommands,
-                                                                render_cmd_buf.RenderContextCommands[ render_ctx_data.Index ].LineRenderCommands,
-                                                                render_cmd_buf.RenderContextCommands[ render_ctx_data.Index ].CircleRenderCommands );
+            batch_count += m_PrimitivePipeline->prepare_render( render_ctx_cmds.QuadRenderCommands,
+                                                                render_ctx_cmds.LineRenderCommands,
+                                                                render_ctx_cmds.CircleRenderCommands,
+                                                                render_ctx_cmds.RoundedRectRenderCommands,
+                                                                render_ctx_cmds.PolygonRenderCommands,
+                                                                render_ctx_cmds.PolylineRenderCommands );
 
-            batch_count += m_Font2DPipeline->prepare_render( render_cmd_buf.RenderContextCommands[ render_ctx_data.Index ].FontRenderCommands,
+            batch_count += m_Particle2DPipeline->prepare_render( render_ctx_cmds.ParticleRenderCommands );
+
+            batch_count += m_Font2DPipeline->prepare_render( render_ctx_cmds.FontRenderCommands,
                                                              render_cmd_buf.FontRegister,
                                                              render_cmd_buf.StringBuffer );
             return batch_count;
         }
 
-        void render( const RenderContextFrameData& render_ctx_data, SDL_GPURenderPass* render_pass, RenderStatistics& stats )
+        void render( const RenderContextFrameData& render_ctx_data, SDL_GPUCommandBuffer* gpu_cmd_buf, SDL_GPURenderPass* render_pass, RenderStatistics& stats )
         {
             IE_ASSERT( m_Initialized );
             const RenderCommandBuffer& render_cmd_buf = get_command_buffer_for_rendering();
 
+            // tilemaps are only prepared in the opaque pass
+            stats.TilemapDrawCalls += m_Tilemap2DPipeline->swapchain_render( render_ctx_data,
+                                                                             render_cmd_buf.TextureRegister,
+                                                                             gpu_cmd_buf,
+                                                                             render_pass );
+
             stats.SpriteDrawCalls += m_Sprite2DPipeline->swapchain_render( render_ctx_data,
                                                                            render_cmd_buf.TextureRegister,
+                                                                           gpu_cmd_buf,
                                                                            render_pass );
 
             stats.PrimitivesDrawCalls += m_PrimitivePipeline->swapchain_render( render_ctx_data,
+                                                                                gpu_cmd_buf,
                                                                                 render_pass );
 
+            stats.ParticleDrawCalls += m_Particle2DPipeline->swapchain_render( render_ctx_data,
+                                                                               gpu_cmd_buf,
+                                                                               render_pass );
+
             stats.FontDrawCalls += m_Font2DPipeline->swapchain_render( render_ctx_data,
                                                                        render_cmd_buf.FontRegister,
+                                                                       gpu_cmd_buf,
                                                                        render_pass );
         }
 
@@ -133,10 +172,7 @@ namespace InnoEngine
         void render_imgui( SDL_GPUCommandBuffer* gpu_cmd_buf, SDL_GPURenderPass* render_pass, RenderStatistics& stats )
         {
             IE_ASSERT( m_Initialized );
-            const RenderCommandBuffer& render_cmd_buf = get_command_buffer_for_rendering();
-            stats.ImGuiDrawCalls += m_ImGuiPipeline->swapchain_render( render_cmd_buf.ImGuiCommandBuffer,
-                                                                       gpu_cmd_buf,
-                                                                       render_pass );
+            stats.ImGuiDrawCalls += m_ImGuiPipeline->swapchain_render( gpu_cmd_buf, render_pass );
         }
 
         RenderCommandBuffer& get_command_buffer_for_collecting()
@@ -149,17 +185,68 @@ namespace InnoEngine
             return m_RenderCommandBuffer.get_consumer_data();
         }
 
-        void synchronize()
+        void publish()
+        {
+            m_RenderCommandBuffer.publish();
+        }
+
+        bool acquire_latest()
+        {
+            return m_RenderCommandBuffer.acquire_latest();
+        }
+
+        bool has_new_frame() const
+        {
+            return m_RenderCommandBuffer.has_new_data();
+        }
+
+        uint64_t get_dropped_frame_count() const
         {
-            m_RenderCommandBuffer.swap();
+            return m_RenderCommandBuffer.get_dropped_count();
+        }
+
+        void end_frame( RenderStatistics& stats )
+        {
+            IE_ASSERT( m_Initialized );
+            stats.TextLayoutCacheHits   = m_Font2DPipeline->get_layout_cache().get_hit_count();
+            stats.TextLayoutCacheMisses = m_Font2DPipeline->get_layout_cache().get_miss_count();
+
+            m_Sprite2DPipeline->end_frame();
+            m_PrimitivePipeline->end_frame();
+            m_Font2DPipeline->end_frame();
+            m_Tilemap2DPipeline->end_frame();
+            m_Particle2DPipeline->end_frame();
+
+            stats.SpriteGPUBufferSize         = m_Sprite2DPipeline->get_gpu_buffer_bytes();
+            stats.SpriteGPUBufferPeakSize     = m_Sprite2DPipeline->get_gpu_buffer_peak_bytes();
+            stats.PrimitivesGPUBufferSize     = m_PrimitivePipeline->get_gpu_buffer_bytes();
+            stats.PrimitivesGPUBufferPeakSize = m_PrimitivePipeline->get_gpu_buffer_peak_bytes();
+            stats.FontGPUBufferSize           = m_Font2DPipeline->get_gpu_buffer_bytes();
+            stats.FontGPUBufferPeakSize       = m_Font2DPipeline->get_gpu_buffer_peak_bytes();
+            stats.TilemapGPUBufferSize        = m_Tilemap2DPipeline->get_gpu_buffer_bytes();
+            stats.ParticleGPUBufferSize       = m_Particle2DPipeline->get_gpu_buffer_bytes();
+        }
+
+        void enable_gpu_culling( bool enabled )
+        {
+            IE_ASSERT( m_Initialized );
+            m_Sprite2DPipeline->set_gpu_culling( enabled );
+        }
+
+        bool gpu_culling_enabled() const
+        {
+            IE_ASSERT( m_Initialized );
+            return m_Sprite2DPipeline->gpu_culling_enabled();
         }
 
     private:
-        DoubleBuffered<RenderCommandBuffer> m_RenderCommandBuffer;
+        TripleBuffered<RenderCommandBuffer> m_RenderCommandBuffer;
         Own<Sprite2DPipeline>               m_Sprite2DPipeline;
         Own<Font2DPipeline>                 m_Font2DPipeline;
         Own<ImGuiPipeline>                  m_ImGuiPipeline;
         Own<Primitive2DPipeline>            m_PrimitivePipeline;
+        Own<Tilemap2DPipeline>              m_Tilemap2DPipeline;
+        Own<Particle2DPipeline>             m_Particle2DPipeline;
 
         bool m_Initialized = false;
     };
@@ -179,11 +266,7 @@ namespace InnoEngine
                 m_CameraMatrixStorageBuffer = nullptr;
             }
 
-            if ( m_DepthTexture ) {
-                SDL_ReleaseGPUTexture( m_sdlGPUDevice, m_DepthTexture );
-                m_DepthTexture = nullptr;
-            }
-
+            m_RenderGraph.reset();
             m_pipelineProcessor.reset();
 
             m_RenderContextCache.clear();
@@ -252,22 +335,14 @@ namespace InnoEngine
                 IE_LOG_CRITICAL( "GPUClaimWindow failed! Errorcode: {}", SDL_GetError() );
                 return Result::InitializationError;
             }
+        }
 
-            SDL_GPUTextureCreateInfo depthtexture_createinfo = {};
-
-            depthtexture_createinfo.usage                = SDL_GPU_TEXTUREUSAGE_DEPTH_STENCIL_TARGET;
-            depthtexture_createinfo.format               = SDL_GPU_TEXTUREFORMAT_D16_UNORM;
-            depthtexture_createinfo.width                = m_Window->get_width();
-            depthtexture_createinfo.height               = m_Window->get_height();
-            depthtexture_createinfo.num_levels           = 1;
-            depthtexture_createinfo.layer_count_or_depth = 1;
-            depthtexture_createinfo.type                 = SDL_GPU_TEXTURETYPE_2D;
-
-            m_DepthTexture = SDL_CreateGPUTexture( m_sdlGPUDevice, &depthtexture_createinfo );
-            if ( m_DepthTexture == nullptr ) {
-                IE_LOG_ERROR( "Failed to create depth texture: {}", SDL_GetError() );
-                return Result::Fail;
-            }
+        if ( auto render_graph = RenderGraph::create( m_sdlGPUDevice ) ) {
+            m_RenderGraph = std::move( render_graph.value() );
+        }
+        else {
+            IE_LOG_CRITICAL( "Failed to create render graph!" );
+            return Result::InitializationError;
         }
 
         RETURN_RESULT_IF_FAILED( create_camera_transformation_buffers() );
@@ -331,40 +406,45 @@ namespace InnoEngine
         return m_vsyncEnabled;
     }
 
+    void GPURenderer::enable_gpu_culling( bool enabled )
+    {
+        m_pipelineProcessor->enable_gpu_culling( enabled );
+    }
+
+    bool GPURenderer::gpu_culling_enabled() const
+    {
+        return m_pipelineProcessor->gpu_culling_enabled();
+    }
+
     const char* GPURenderer::get_devicedriver() const
     {
         return SDL_GetGPUDeviceDriver( m_sdlGPUDevice );
     }
 
-    const RenderStatistics& GPURenderer::get_statistics() const
+    RenderStatistics GPURenderer::get_statistics() const
     {
-        return m_Statistics.get_consumer_data();
+        std::unique_lock<std::mutex> ulock( m_StatisticsMutex );
+        return m_LastFrameStatistics;
     }
 
-    void GPURenderer::wait_for_gpu_idle()
+    uint64_t GPURenderer::get_dropped_frame_count() const
     {
-        SDL_WaitForGPUIdle( m_sdlGPUDevice );
+        return m_pipelineProcessor->get_dropped_frame_count();
     }
 
-    void GPURenderer::synchronize()
+    bool GPURenderer::has_new_frame() const
     {
-        auto& collect_buffer = m_pipelineProcessor->get_command_buffer_for_collecting();
-        for ( auto& texture : collect_buffer.TextureRegister ) {
-            texture->m_RenderCommandBufferIndex = InvalidRenderCommandBufferIndex;
-        }
+        return m_pipelineProcessor->has_new_frame();
+    }
 
-        for ( auto& font : collect_buffer.FontRegister ) {
-            font->m_RenderCommandBufferIndex = InvalidRenderCommandBufferIndex;
-        }
+    void GPURenderer::wait_for_gpu_idle()
+    {
+        SDL_WaitForGPUIdle( m_sdlGPUDevice );
+    }
 
-        m_pipelineProcessor->synchronize();
-        // now we can add the new render contexts
-        std::unique_lock<std::mutex> ulock( m_RenderContextRegisterMutex );
-        for ( auto specs : m_RenderContextRegisterQueue ) {
-            m_RenderContextCache.emplace_back( RenderContext::create( this, specs ) );
-        }
-        m_RenderContextRegisterQueue.clear();
-        IE_ASSERT( m_RenderContextCache.size() <= 256 );    // need to make camera storage buffer resizable if there are more than 256 cameras
+    bool GPURenderer::synchronize()
+    {
+        return m_pipelineProcessor->acquire_latest();
     }
 
     void GPURenderer::render()
@@ -374,10 +454,11 @@ namespace InnoEngine
         IE_ASSERT( m_Initialized );
         const RenderCommandBuffer& render_commands = m_pipelineProcessor->get_command_buffer_for_rendering();
 
-        IE_ASSERT( m_RenderContextCache.size() <= 256 );
+        IE_ASSERT( render_commands.RenderContextData.size() <= 256 );
+        m_FrameStatistics = RenderStatistics();
 
         // dont render when minimized or when no render data is available
-        if ( m_RenderContextCache.size() == 0 ||
+        if ( render_commands.RenderContextData.empty() ||
              ( m_Window && SDL_GetWindowFlags( m_Window->get_sdlwindow() ) & SDL_WINDOW_MINIMIZED ) ) {
             return;
         }
@@ -390,13 +471,27 @@ namespace InnoEngine
             return;
         }
 
-        render_custom_passes( gpu_cmd_buf, render_commands );
-
-        // main swapchain pass
+        SDL_GPUTexture* swapchain_texture = nullptr;
+        uint32_t        swapchain_width   = 0;
+        uint32_t        swapchain_height  = 0;
         if ( has_window() ) {    // only works when a window is associated
-            render_swapchain_passes( gpu_cmd_buf, render_commands );
+            ProfileScoped gpu_swapchain_wait( ProfilePoint::GPUSwapChainWait );
+            if ( !SDL_WaitAndAcquireGPUSwapchainTexture( gpu_cmd_buf, m_Window->get_sdlwindow(), &swapchain_texture, &swapchain_width, &swapchain_height ) ) {
+                SDL_CancelGPUCommandBuffer( gpu_cmd_buf );
+                IE_LOG_WARNING( "WaitAndAcquireGPUSwapchainTexture failed : %s", SDL_GetError() );
+                return;
+            }
+        }
+
+        m_RenderGraph->reset();
+        build_render_graph( render_commands, swapchain_texture, swapchain_width, swapchain_height );
+        if ( IE_SUCCESS( m_RenderGraph->compile() ) ) {
+            m_RenderGraph->execute( gpu_cmd_buf );
         }
 
+        m_pipelineProcessor->end_frame( m_FrameStatistics );
+        update_statistics( render_commands );
+
         if ( SDL_SubmitGPUCommandBuffer( gpu_cmd_buf ) == false ) {
             IE_LOG_ERROR( "SDL_SubmitGPUCommandBuffer failed : %s", SDL_GetError() );
             return;
@@ -405,7 +500,15 @@ namespace InnoEngine
 
     void GPURenderer::begin_collection()
     {
-        update_statistics_from_last_completed_frame();
+        {    // now we can add the new render contexts
+            std::unique_lock<std::mutex> ulock( m_RenderContextRegisterMutex );
+            for ( auto specs : m_RenderContextRegisterQueue ) {
+                m_RenderContextCache.emplace_back( RenderContext::create( this, specs ) );
+            }
+            m_RenderContextRegisterQueue.clear();
+            IE_ASSERT( m_RenderContextCache.size() <= 256 );    // need to make camera storage buffer resizable if there are more than 256 cameras
+        }
+
         auto& collect_buffer = m_pipelineProcessor->get_command_buffer_for_collecting();
         collect_buffer.clear();
 
@@ -419,7 +522,17 @@ namespace InnoEngine
 
     void GPURenderer::end_collection()
     {
-        // nothing yet but probably need to switch between multiple collecting commandbuffers in the future
+        auto& collect_buffer = m_pipelineProcessor->get_command_buffer_for_collecting();
+        for ( auto& texture : collect_buffer.TextureRegister ) {
+            texture->m_RenderCommandBufferIndex = InvalidRenderCommandBufferIndex;
+        }
+
+        for ( auto& font : collect_buffer.FontRegister ) {
+            font->m_RenderCommandBufferIndex = InvalidRenderCommandBufferIndex;
+        }
+
+        // hand the frame to the render thread, collecting continues in a free buffer
+        m_pipelineProcessor->publish();
     }
 
     RenderContextHandle GPURenderer::create_rendercontext( RenderContextSpecifications specs )
@@ -440,7 +553,7 @@ namespace InnoEngine
 
         Ref<RenderContext> render_ctx          = m_RenderContextCache[ handle ];
         render_ctx->m_RenderCommandBufferIndex = index;
-        render_ctx->m_RenderCommandBuffer      = &cmd_buffer.RenderContextCommands[ index ];
+        render_ctx->m_RenderCommandBuffer      = &cmd_buffer.acquire_context_commands();
 
         auto&       render_ctx_data          = cmd_buffer.RenderContextData.emplace_back();
         const auto& vp                       = render_ctx->get_viewport();
@@ -448,11 +561,22 @@ namespace InnoEngine
         render_ctx_data.RenderTarget         = render_ctx->m_Specs.ColorTarget;
         render_ctx_data.ClearColor           = render_ctx->m_ClearColor;
         render_ctx_data.ViewProjectionMatrix = render_ctx->get_camera()->get_viewprojectionmatrix();
+        render_ctx_data.AnimationTime        = get_animation_time();
         render_ctx_data.Index                = index;
 
         return render_ctx.get();
     }
 
+    RenderContext* GPURenderer::get_acquired_rendercontext( RenderContextHandle handle ) const
+    {
+        if ( handle >= m_RenderContextCache.size() )
+            return nullptr;
+
+        // begin_collection resets the index, so only contexts acquired this frame have one
+        RenderContext* render_ctx = m_RenderContextCache[ handle ].get();
+        return render_ctx->m_RenderCommandBufferIndex != InvalidRenderCommandBufferIndex ? render_ctx : nullptr;
+    }
+
     void GPURenderer::set_clear_color( DXSM::Color color )
     {
         auto& render_cmd_buf      = m_pipelineProcessor->get_command_buffer_for_collecting();
@@ -460,6 +584,11 @@ namespace InnoEngine
         render_cmd_buf.ClearColor = color;
     }
 
+    void GPURenderer::set_render_graph_setup( RenderGraphSetupFunction function )
+    {
+        m_RenderGraphSetup = std::move( function );
+    }
+
     void GPURenderer::add_imgui_draw_data( ImDrawData* draw_data )
     {
         IE_ASSERT( draw_data != nullptr );
@@ -470,22 +599,42 @@ namespace InnoEngine
         cmd.TotalVertexCount            = draw_data->TotalVtxCount;
         cmd.DisplayPos                  = draw_data->DisplayPos;
         cmd.DisplaySize                 = draw_data->DisplaySize;
+        cmd.Generation                  = ++m_ImGuiGeneration;
 
-        cmd.RenderCommandLists.reserve( draw_data->CmdListsCount );
+        // the buffers are handed over instead of copied, imgui gets the empty ones of an earlier frame in return
+        // it only clears its draw lists with the next ImGui::NewFrame, so nothing else may read them after this
         for ( int n = 0; n < draw_data->CmdListsCount; n++ ) {
-            const ImDrawList* drawList   = draw_data->CmdLists[ n ];
-            auto&             renderList = cmd.RenderCommandLists.emplace_back();
-            renderList.CommandBuffer     = drawList->CmdBuffer;
-            renderList.VertexBuffer      = drawList->VtxBuffer;
-            renderList.IndexBuffer       = drawList->IdxBuffer;
+            ImDrawList* drawList   = draw_data->CmdLists[ n ];
+            auto&       renderList = cmd.acquire_list();
+            renderList.CommandBuffer.swap( drawList->CmdBuffer );
+            renderList.VertexBuffer.swap( drawList->VtxBuffer );
+            renderList.IndexBuffer.swap( drawList->IdxBuffer );
         }
     }
 
+    void GPURenderer::replay_imgui_draw_data()
+    {
+        // if the frame with the last draw data got dropped, the one uploaded before it is drawn until the next rebuild
+        ImGuiPipeline::CommandData& cmd = m_pipelineProcessor->get_command_buffer_for_collecting().ImGuiCommandBuffer;
+        cmd.Generation                  = m_ImGuiGeneration;
+        cmd.Replay                      = true;
+    }
+
     Ref<Font> GPURenderer::get_debug_font() const
     {
         return m_DebugFont;
     }
 
+    float GPURenderer::get_animation_time()
+    {
+        return static_cast<float>( static_cast<double>( SDL_GetTicksNS() ) / SDL_NS_PER_SECOND );
+    }
+
+    SDL_GPUBuffer* GPURenderer::get_camera_buffer() const
+    {
+        return m_CameraMatrixStorageBuffer;
+    }
+
     /*
     void GPURenderer::add_bounding_box( const DXSM::Vector4& aabb, const DXSM::Vector2& position, const DXSM::Color& color )
     {
@@ -500,29 +649,55 @@ namespace InnoEngine
         add_lines( points, line_width, 0.0f, color, true );
     }
     */
-    void GPURenderer::update_statistics_from_last_completed_frame()
+    void GPURenderer::update_statistics( const RenderCommandBuffer& render_commands )
     {
-        const auto& render_commands = m_pipelineProcessor->get_command_buffer_for_rendering();
-        auto&       stats           = m_Statistics.get_producer_data();
+        auto& stats = m_FrameStatistics;
 
         stats.TotalBufferSize += sizeof( DXSM::Color );
         stats.TotalBufferSize += sizeof( DXSM::Matrix );
         stats.TotalBufferSize += render_commands.TextureRegister.size() * sizeof( Ref<Texture2D> );
 
-        for ( const auto& ctx_cmd : render_commands.RenderContextCommands ) {
+        for ( uint32_t i = 0; i < render_commands.get_active_context_count(); ++i ) {
+            const RenderContextCommands& ctx_cmd = render_commands.get_context_commands( i );
 
             stats.TotalCommands += ctx_cmd.SpriteRenderCommands.size();
             stats.TotalBufferSize += ctx_cmd.SpriteRenderCommands.size() * sizeof( Sprite2DPipeline::Command );
 
+            stats.TotalCommands += ctx_cmd.TilemapRenderCommands.size();
+            stats.TotalBufferSize += ctx_cmd.TilemapRenderCommands.size() * sizeof( Tilemap2DPipeline::Command );
+            stats.TotalBufferSize += ctx_cmd.TilemapRenderCommands.Uploads.size() * sizeof( Tilemap2DPipeline::ChunkUpload );
+            stats.TotalBufferSize += ctx_cmd.TilemapRenderCommands.TileData.size() * sizeof( Tilemap::TileIndex );
+
+            stats.TotalCommands += ctx_cmd.NineSliceRenderCommands.size();
+            stats.TotalBufferSize += ctx_cmd.NineSliceRenderCommands.size() * sizeof( Sprite2DPipeline::NineSliceCommand );
+
             stats.TotalCommands += ctx_cmd.QuadRenderCommands.size();
             stats.TotalBufferSize += ctx_cmd.QuadRenderCommands.size() * sizeof( Primitive2DPipeline::QuadCommand );
 
             stats.TotalCommands += ctx_cmd.LineRenderCommands.size();
             stats.TotalBufferSize += ctx_cmd.LineRenderCommands.size() * sizeof( Primitive2DPipeline::LineCommand );
 
+            stats.TotalCommands += ctx_cmd.PolylineRenderCommands.size();
+            stats.TotalBufferSize += ctx_cmd.PolylineRenderCommands.size() * sizeof( Primitive2DPipeline::PolylineCommand );
+            stats.TotalBufferSize += ctx_cmd.PolylineRenderCommands.Points.size() * sizeof( DXSM::Vector2 );
+
             stats.TotalCommands += ctx_cmd.CircleRenderCommands.size();
             stats.TotalBufferSize += ctx_cmd.CircleRenderCommands.size() * sizeof( Primitive2DPipeline::CircleCommand );
 
+            stats.TotalCommands += ctx_cmd.RoundedRectRenderCommands.size();
+            stats.TotalBufferSize += ctx_cmd.RoundedRectRenderCommands.size() * sizeof( Primitive2DPipeline::RoundedRectCommand );
+
+            for ( const PolygonCommandBuffer* polygons : { &ctx_cmd.PolygonRenderCommandsOpaque, &ctx_cmd.PolygonRenderCommands } ) {
+                stats.TotalCommands += polygons->size();
+                stats.TotalBufferSize += polygons->size() * sizeof( Primitive2DPipeline::PolygonCommand );
+                stats.TotalBufferSize += polygons->Vertices.size() * sizeof( DXSM::Vector2 );
+            }
+
+            stats.TotalCommands += ctx_cmd.ParticleRenderCommands.size();
+            stats.TotalBufferSize += ctx_cmd.ParticleRenderCommands.size() * sizeof( Particle2DPipeline::Command );
+            stats.TotalBufferSize += ctx_cmd.ParticleRenderCommands.Particles.size() * sizeof( Particle2DPipeline::StructuredBufferLayout );
+            stats.TotalBufferSize += ctx_cmd.ParticleRenderCommands.Spawns.size() * sizeof( ParticleSystem::GPUParticle );
+
             stats.TotalCommands += ctx_cmd.FontRenderCommands.size();
             stats.TotalBufferSize += ctx_cmd.FontRenderCommands.size() * sizeof( Font2DPipeline::Command );
         }
@@ -530,17 +705,18 @@ namespace InnoEngine
         stats.TotalBufferSize += render_commands.FontRegister.size() * sizeof( Ref<Font> );
         stats.TotalBufferSize += render_commands.StringBuffer.size();
 
-        for ( const auto& rcmd : render_commands.ImGuiCommandBuffer.RenderCommandLists ) {
+        for ( const auto& rcmd : render_commands.ImGuiCommandBuffer.get_lists() ) {
             stats.TotalCommands += rcmd.CommandBuffer.size();
             stats.TotalBufferSize += rcmd.CommandBuffer.size() * sizeof( ImDrawCmd );
             stats.TotalBufferSize += rcmd.IndexBuffer.size() * sizeof( ImDrawIdx );
             stats.TotalBufferSize += rcmd.VertexBuffer.size() * sizeof( ImDrawVert );
         }
 
-        stats.TotalDrawCalls = stats.SpriteDrawCalls + stats.FontDrawCalls + stats.ImGuiDrawCalls + stats.PrimitivesDrawCalls;
+        stats.TotalDrawCalls = stats.SpriteDrawCalls + stats.FontDrawCalls + stats.ImGuiDrawCalls + stats.PrimitivesDrawCalls + stats.TilemapDrawCalls +
+                               stats.ParticleDrawCalls;
 
-        m_Statistics.swap();
-        m_Statistics.get_producer_data() = RenderStatistics();
+        std::unique_lock<std::mutex> ulock( m_StatisticsMutex );
+        m_LastFrameStatistics = stats;
     }
 
     RenderCommandBuffer* GPURenderer::get_render_command_buffer() const
@@ -552,7 +728,7 @@ namespace InnoEngine
     {
         SDL_GPUTransferBufferCreateInfo tbufferCreateInfo = {};
         tbufferCreateInfo.usage                           = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
-        tbufferCreateInfo.size                            = 256 * sizeof( DXSM::Matrix );
+        tbufferCreateInfo.size                            = 256 * sizeof( CameraBufferLayout );
 
         m_CameraMatrixTransferBuffer = SDL_CreateGPUTransferBuffer( m_sdlGPUDevice, &tbufferCreateInfo );
         if ( m_CameraMatrixTransferBuffer == nullptr ) {
@@ -561,8 +737,8 @@ namespace InnoEngine
         }
 
         SDL_GPUBufferCreateInfo createInfo = {};
-        createInfo.usage                   = SDL_GPU_BUFFERUSAGE_GRAPHICS_STORAGE_READ;
-        createInfo.size                    = 256 * sizeof( DXSM::Matrix );
+        createInfo.usage                   = SDL_GPU_BUFFERUSAGE_GRAPHICS_STORAGE_READ | SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_READ;    // compute: sprite culling
+        createInfo.size                    = 256 * sizeof( CameraBufferLayout );
 
         m_CameraMatrixStorageBuffer = SDL_CreateGPUBuffer( m_sdlGPUDevice, &createInfo );
         if ( m_CameraMatrixStorageBuffer == nullptr ) {
@@ -582,10 +758,10 @@ namespace InnoEngine
         if ( render_ctx_data.size() == 0 )
             return;
 
-        DXSM::Matrix* buffer_data = static_cast<DXSM::Matrix*>( SDL_MapGPUTransferBuffer( m_sdlGPUDevice, m_CameraMatrixTransferBuffer, true ) );
+        CameraBufferLayout* buffer_data = static_cast<CameraBufferLayout*>( SDL_MapGPUTransferBuffer( m_sdlGPUDevice, m_CameraMatrixTransferBuffer, true ) );
 
-        for ( const auto render_ctx : render_ctx_data ) {
-            *buffer_data = render_ctx.ViewProjectionMatrix;
+        for ( const auto& render_ctx : render_ctx_data ) {
+            buffer_data->ViewProjectionMatrix = render_ctx.ViewProjectionMatrix;
             ++buffer_data;
         }
 
@@ -593,7 +769,7 @@ namespace InnoEngine
         SDL_GPUTransferBufferLocation tranferBufferLocation { .transfer_buffer = m_CameraMatrixTransferBuffer, .offset = 0 };
         SDL_GPUBufferRegion           bufferRegion { .buffer = m_CameraMatrixStorageBuffer,
                                                      .offset = 0,
-                                                     .size   = static_cast<uint32_t>( render_ctx_data.size() * sizeof( DXSM::Matrix ) ) };
+                                                     .size   = static_cast<uint32_t>( render_ctx_data.size() * sizeof( CameraBufferLayout ) ) };
 
         SDL_GPUCommandBuffer* gpu_copy_cmd_buf = SDL_AcquireGPUCommandBuffer( m_sdlGPUDevice );
         if ( gpu_copy_cmd_buf == nullptr ) {
@@ -611,111 +787,92 @@ namespace InnoEngine
         }
     }
 
-    void GPURenderer::render_custom_passes( SDL_GPUCommandBuffer* gpu_cmd_buf, const RenderCommandBuffer& render_cmd_buf )
+    void GPURenderer::build_render_graph( const RenderCommandBuffer& render_cmd_buf, SDL_GPUTexture* swapchain_texture, uint32_t width, uint32_t height )
     {
-        // custom rendertarget passes
-        for ( const auto& render_ctx : render_cmd_buf.RenderContextData ) {
-            if ( render_ctx.RenderTarget == nullptr ) {
-                continue;
-            }
+        RenderStatistics& stats = m_FrameStatistics;
 
-            if ( m_pipelineProcessor->prepare_opaque( render_ctx ) > 0 ) {
-                SDL_GPUColorTargetInfo color_target = {};
-                color_target.texture                = render_ctx.RenderTarget->get_sdltexture();
-                color_target.clear_color            = { render_ctx.ClearColor.R(), render_ctx.ClearColor.G(), render_ctx.ClearColor.B(), render_ctx.ClearColor.A() };
-                color_target.load_op                = SDL_GPU_LOADOP_CLEAR;
-                color_target.store_op               = SDL_GPU_STOREOP_STORE;
-
-                SDL_GPURenderPass* render_pass = SDL_BeginGPURenderPass( gpu_cmd_buf, &color_target, 1, nullptr );
-                SDL_BindGPUVertexStorageBuffers( render_pass, 0, &m_CameraMatrixStorageBuffer, 1 );
-                m_pipelineProcessor->render( render_ctx, render_pass, m_Statistics.get_producer_data() );
-                SDL_EndGPURenderPass( render_pass );
-            }
+        auto prepare_opaque = [ this ]( const RenderContextFrameData& render_ctx_data ) {
+            return [ this, &render_ctx_data ]() { return m_pipelineProcessor->prepare_opaque( render_ctx_data ) > 0; };
+        };
 
-            if ( m_pipelineProcessor->prepare( render_ctx ) > 0 ) {
-                SDL_GPUColorTargetInfo color_target = {};
-                color_target.texture                = render_ctx.RenderTarget->get_sdltexture();
-                color_target.load_op                = SDL_GPU_LOADOP_LOAD;
-                color_target.store_op               = SDL_GPU_STOREOP_STORE;
+        auto prepare = [ this ]( const RenderContextFrameData& render_ctx_data ) {
+            return [ this, &render_ctx_data ]() { return m_pipelineProcessor->prepare( render_ctx_data ) > 0; };
+        };
 
-                SDL_GPURenderPass* render_pass = SDL_BeginGPURenderPass( gpu_cmd_buf, &color_target, 1, nullptr );
+        auto render = [ this, &stats ]( const RenderContextFrameData& render_ctx_data ) {
+            return [ this, &stats, &render_ctx_data ]( SDL_GPUCommandBuffer* gpu_cmd_buf, SDL_GPURenderPass* render_pass ) {
                 SDL_BindGPUVertexStorageBuffers( render_pass, 0, &m_CameraMatrixStorageBuffer, 1 );
-                m_pipelineProcessor->render( render_ctx, render_pass, m_Statistics.get_producer_data() );
-                SDL_EndGPURenderPass( render_pass );
-            }
-        }
-    }
-
-    void GPURenderer::render_swapchain_passes( SDL_GPUCommandBuffer* gpu_cmd_buf, const RenderCommandBuffer& render_cmd_buf )
-    {
-        SDL_GPUTexture* swapchainTexture = nullptr;
-        {
-            ProfileScoped gpu_swapchain_wait( ProfilePoint::GPUSwapChainWait );
-            if ( !SDL_WaitAndAcquireGPUSwapchainTexture( gpu_cmd_buf, m_Window->get_sdlwindow(), &swapchainTexture, nullptr, nullptr ) ) {
-                SDL_CancelGPUCommandBuffer( gpu_cmd_buf );
-                IE_LOG_WARNING( "WaitAndAcquireGPUSwapchainTexture failed : %s", SDL_GetError() );
-                return;
-            }
-        }
+                m_pipelineProcessor->render( render_ctx_data, gpu_cmd_buf, render_pass, stats );
+            };
+        };
 
-        if ( swapchainTexture != nullptr ) {
-            SDL_GPUDepthStencilTargetInfo depth_stencil = {};
-            depth_stencil.texture                       = m_DepthTexture;
-            depth_stencil.clear_depth                   = 0;
-            depth_stencil.load_op                       = SDL_GPU_LOADOP_CLEAR;
-            depth_stencil.store_op                      = SDL_GPU_STOREOP_STORE;
+        // custom rendertarget passes
+        for ( const auto& render_ctx_data : render_cmd_buf.RenderContextData ) {
+            if ( render_ctx_data.RenderTarget == nullptr )
+                continue;
 
-            SDL_GPUColorTargetInfo color_target = {};
-            color_target.texture                = swapchainTexture;
-            color_target.clear_color            = { render_cmd_buf.ClearColor.R(), render_cmd_buf.ClearColor.G(), render_cmd_buf.ClearColor.B(), render_cmd_buf.ClearColor.A() };
-            color_target.load_op                = render_cmd_buf.Clear ? SDL_GPU_LOADOP_CLEAR : SDL_GPU_LOADOP_LOAD;
-            color_target.store_op               = SDL_GPU_STOREOP_STORE;
+            RenderGraphResource target = m_RenderGraph->import_texture( std::format( "Context{}Target", render_ctx_data.Index ),
+                                                                        render_ctx_data.RenderTarget->get_sdltexture() );
 
-            // opaque passes
-            for ( const auto& render_ctx_data : render_cmd_buf.RenderContextData ) {
-                if ( render_ctx_data.RenderTarget != nullptr )
-                    continue;
+            m_RenderGraph->add_pass( std::format( "Context{}Opaque", render_ctx_data.Index ) )
+                .write_color( target, render_ctx_data.ClearColor )
+                .prepare( prepare_opaque( render_ctx_data ) )
+                .execute( render( render_ctx_data ) );
 
-                uint32_t batch_count = m_pipelineProcessor->prepare_opaque( render_ctx_data );
-                if ( batch_count == 0 )
-                    continue;
+            m_RenderGraph->add_pass( std::format( "Context{}Alpha", render_ctx_data.Index ) )
+                .write_color( target )
+                .prepare( prepare( render_ctx_data ) )
+                .execute( render( render_ctx_data ) );
+        }
 
-                SDL_GPURenderPass* render_pass = SDL_BeginGPURenderPass( gpu_cmd_buf, &color_target, 1, &depth_stencil );
-                SDL_BindGPUVertexStorageBuffers( render_pass, 0, &m_CameraMatrixStorageBuffer, 1 );
-                m_pipelineProcessor->render( render_ctx_data, render_pass, m_Statistics.get_producer_data() );
-                SDL_EndGPURenderPass( render_pass );
+        if ( swapchain_texture == nullptr )
+            return;
 
-                depth_stencil.texture  = m_DepthTexture;
-                depth_stencil.load_op  = SDL_GPU_LOADOP_LOAD;
-                depth_stencil.store_op = SDL_GPU_STOREOP_STORE;
+        DefaultRenderGraphResources resources;
+        resources.Backbuffer = m_RenderGraph->import_texture( "Backbuffer", swapchain_texture );
+        resources.SceneDepth = m_RenderGraph->create_texture( "SceneDepth", { width, height, SDL_GPU_TEXTUREFORMAT_D16_UNORM, SDL_GPU_TEXTUREUSAGE_DEPTH_STENCIL_TARGET } );
 
-                color_target.texture  = swapchainTexture;
-                color_target.load_op  = SDL_GPU_LOADOP_LOAD;
-                color_target.store_op = SDL_GPU_STOREOP_STORE;
-            }
+        // renders nothing, the graph hands the clears to the first pass that actually renders into the targets
+        std::optional<DXSM::Color> backbuffer_clear = render_cmd_buf.Clear ? std::optional<DXSM::Color>( render_cmd_buf.ClearColor ) : std::nullopt;
+        m_RenderGraph->add_pass( "SwapchainClear" )
+            .write_color( resources.Backbuffer, backbuffer_clear )
+            .write_depth( resources.SceneDepth, 0.0f )
+            .prepare( []() { return false; } );
 
-            // alpha passes
-            for ( const auto& render_ctx_data : render_cmd_buf.RenderContextData ) {
-                if ( render_ctx_data.RenderTarget != nullptr )
-                    continue;
+        // opaque passes
+        for ( const auto& render_ctx_data : render_cmd_buf.RenderContextData ) {
+            if ( render_ctx_data.RenderTarget != nullptr )
+                continue;
 
-                uint32_t batch_count = m_pipelineProcessor->prepare( render_ctx_data );
-                if ( batch_count == 0 )
-                    continue;
+            m_RenderGraph->add_pass( std::format( "Context{}SwapchainOpaque", render_ctx_data.Index ) )
+                .write_color( resources.Backbuffer )
+                .write_depth( resources.SceneDepth )
+                .prepare( prepare_opaque( render_ctx_data ) )
+                .execute( render( render_ctx_data ) );
+        }
 
-                SDL_GPURenderPass* render_pass = SDL_BeginGPURenderPass( gpu_cmd_buf, &color_target, 1, &depth_stencil );
-                SDL_BindGPUVertexStorageBuffers( render_pass, 0, &m_CameraMatrixStorageBuffer, 1 );
-                m_pipelineProcessor->render( render_ctx_data, render_pass, m_Statistics.get_producer_data() );
-                SDL_EndGPURenderPass( render_pass );
-            }
+        // alpha passes
+        for ( const auto& render_ctx_data : render_cmd_buf.RenderContextData ) {
+            if ( render_ctx_data.RenderTarget != nullptr )
+                continue;
 
-            // render imgui always topmost and without depth testing
-            if ( m_pipelineProcessor->prepare_imgui() > 0 ) {
-                SDL_GPURenderPass* render_pass = SDL_BeginGPURenderPass( gpu_cmd_buf, &color_target, 1, nullptr );
-                m_pipelineProcessor->render_imgui( gpu_cmd_buf, render_pass, m_Statistics.get_producer_data() );
-                SDL_EndGPURenderPass( render_pass );
-            }
+            m_RenderGraph->add_pass( std::format( "Context{}SwapchainAlpha", render_ctx_data.Index ) )
+                .write_color( resources.Backbuffer )
+                .write_depth( resources.SceneDepth )
+                .prepare( prepare( render_ctx_data ) )
+                .execute( render( render_ctx_data ) );
         }
+
+        if ( m_RenderGraphSetup )
+            m_RenderGraphSetup( *m_RenderGraph, resources );
+
+        // render imgui always topmost and without depth testing
+        m_RenderGraph->add_pass( "ImGui" )
+            .write_color( resources.Backbuffer )
+            .prepare( [ this ]() { return m_pipelineProcessor->prepare_imgui() > 0; } )
+            .execute( [ this, &stats ]( SDL_GPUCommandBuffer* gpu_cmd_buf, SDL_GPURenderPass* render_pass ) {
+                m_pipelineProcessor->render_imgui( gpu_cmd_buf, render_pass, stats );
+            } );
     }
 
     void GPURenderer::retrieve_shaderformatinfo()
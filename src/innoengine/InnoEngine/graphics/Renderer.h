@@ -9,9 +9,11 @@
 #include "InnoEngine/graphics/GPUDeviceRef.h"
 
 #include "InnoEngine/graphics/RenderContext.h"
+#include "InnoEngine/graphics/RenderGraph.h"
 
 #include <string>
 #include <atomic>
+#include <functional>
 #include <optional>
 #include <vector>
 
@@ -32,12 +34,37 @@ namespace InnoEngine
         size_t PrimitivesDrawCalls = 0;
         size_t FontDrawCalls       = 0;
         size_t ImGuiDrawCalls      = 0;
+        size_t TilemapDrawCalls    = 0;
+        size_t ParticleDrawCalls   = 0;
 
         size_t TotalCommands   = 0;
         size_t TotalDrawCalls  = 0;
         size_t TotalBufferSize = 0;
+
+        // gpu memory held by the batch buffers of the pipelines, in bytes
+        size_t SpriteGPUBufferSize         = 0;
+        size_t SpriteGPUBufferPeakSize     = 0;
+        size_t PrimitivesGPUBufferSize     = 0;
+        size_t PrimitivesGPUBufferPeakSize = 0;
+        size_t FontGPUBufferSize           = 0;
+        size_t FontGPUBufferPeakSize       = 0;
+        size_t TilemapGPUBufferSize        = 0;
+        size_t ParticleGPUBufferSize       = 0;
+
+        // strings taken from the text layout cache this frame and strings which had to be laid out
+        size_t TextLayoutCacheHits   = 0;
+        size_t TextLayoutCacheMisses = 0;
     };
 
+    // resources of the default render graph, available to custom passes
+    struct DefaultRenderGraphResources
+    {
+        RenderGraphResource Backbuffer = InvalidRenderGraphResource;    // swapchain texture
+        RenderGraphResource SceneDepth = InvalidRenderGraphResource;    // transient depth buffer of the swapchain passes
+    };
+
+    using RenderGraphSetupFunction = std::function<void( RenderGraph& graph, const DefaultRenderGraphResources& resources )>;
+
     class GPURenderer
 
     {
@@ -60,29 +87,46 @@ namespace InnoEngine
         Result enable_vsync( bool enabled );
         bool   vsync_enabled() const;
 
+        void enable_gpu_culling( bool enabled );    // cull sprites with a compute pass and draw them indirect
+        bool gpu_culling_enabled() const;
+
         const char* get_devicedriver() const;
 
-        const RenderStatistics& get_statistics() const;    // get the stats with of the last completed fram
+        RenderStatistics get_statistics() const;    // get the stats of the last completed frame, safe from any thread
+        uint64_t         get_dropped_frame_count() const;    // collected frames which got replaced before the render thread picked them up
 
         void wait_for_gpu_idle();
-        void synchronize();
+        bool synchronize();      // render thread: switch to the latest collected frame, false when there is no new one
+        bool has_new_frame() const;
 
         void render();    // process all available rendercommands and send them to the gpu
         void begin_collection();
-        void end_collection();
+        void end_collection();    // publishes the collected frame to the render thread
 
         RenderContextHandle create_rendercontext( RenderContextSpecifications specs );
         RenderContext*      acquire_rendercontext( RenderContextHandle handle );
+        RenderContext*      get_acquired_rendercontext( RenderContextHandle handle ) const;    // nullptr if the context wasn't acquired this frame
 
         void set_clear_color( DXSM::Color color );    // the color the swapchain texture should be cleared to at the begin of the frame
+        void set_render_graph_setup( RenderGraphSetupFunction function );    // called on the render thread after the scene passes, before imgui
         void add_imgui_draw_data( ImDrawData* draw_data );
+        void replay_imgui_draw_data();    // draws the last added draw data again, without building or uploading it
 
         Ref<Font> get_debug_font() const;
 
+        SDL_GPUBuffer* get_camera_buffer() const;    // view projection matrices of all render contexts, indexed by the context index
+
+        static float get_animation_time();    // seconds since startup, the clock of the gpu evaluated sprite animations
+
     private:
+        struct CameraBufferLayout
+        {
+            DXSM::Matrix ViewProjectionMatrix;    // stride has to match CameraData in VertexBase.verti.hlsl
+        };
+
         void retrieve_shaderformatinfo();
 
-        void update_statistics_from_last_completed_frame();
+        void update_statistics( const RenderCommandBuffer& render_commands );
 
         // debug only
         RenderCommandBuffer* get_render_command_buffer() const;
@@ -90,8 +134,7 @@ namespace InnoEngine
         Result create_camera_transformation_buffers();
         void   upload_camera_transformations( const std::vector<RenderContextFrameData>& render_ctx_data );
 
-        void render_custom_passes( SDL_GPUCommandBuffer* gpu_cmd_buf, const RenderCommandBuffer& render_cmd_buf );
-        void render_swapchain_passes( SDL_GPUCommandBuffer* gpu_cmd_buf, const RenderCommandBuffer& render_cmd_buf );
+        void build_render_graph( const RenderCommandBuffer& render_cmd_buf, SDL_GPUTexture* swapchain_texture, uint32_t width, uint32_t height );
 
     private:
         bool m_Initialized  = false;
@@ -103,9 +146,12 @@ namespace InnoEngine
         GPUDeviceRef m_sdlGPUDevice = nullptr;
         Window*      m_Window       = nullptr;
 
-        SDL_GPUTexture* m_DepthTexture = nullptr;
+        Own<RenderGraph>         m_RenderGraph = nullptr;
+        RenderGraphSetupFunction m_RenderGraphSetup;
 
-        DoubleBuffered<RenderStatistics> m_Statistics;
+        RenderStatistics   m_FrameStatistics;    // render thread only
+        RenderStatistics   m_LastFrameStatistics;
+        mutable std::mutex m_StatisticsMutex;
 
         std::mutex                               m_RenderContextRegisterMutex;
         std::vector<RenderContextSpecifications> m_RenderContextRegisterQueue;
@@ -115,5 +161,7 @@ namespace InnoEngine
         SDL_GPUBuffer*         m_CameraMatrixStorageBuffer  = nullptr;
 
         Ref<Font> m_DebugFont;
+
+        uint64_t m_ImGuiGeneration = 0;    // of the last added draw data, update thread only
     };
 }    // namespace InnoEngine
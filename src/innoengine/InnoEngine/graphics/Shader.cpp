@@ -16,6 +16,11 @@ namespace InnoEngine
             SDL_ReleaseGPUShader( m_Device, m_sdlShader );
             m_sdlShader = nullptr;
         }
+
+        if ( m_sdlComputePipeline != nullptr ) {
+            SDL_ReleaseGPUComputePipeline( m_Device, m_sdlComputePipeline );
+            m_sdlComputePipeline = nullptr;
+        }
     }
 
     SDL_GPUShader* Shader::get_sdlshader() const
@@ -23,18 +28,41 @@ namespace InnoEngine
         return m_sdlShader;
     }
 
+    SDL_GPUComputePipeline* Shader::get_sdlcomputepipeline() const
+    {
+        return m_sdlComputePipeline;
+    }
+
+    bool Shader::is_compute() const
+    {
+        return m_IsCompute;
+    }
+
+    Result Shader::require_uniform_buffers( uint32_t count ) const
+    {
+        if ( m_UniformBufferCount < count ) {
+            IE_LOG_ERROR( "Shader \"{}\" is out of date, regenerate it with scripts/compile_shaders_for_sandbox.sh", m_FileName );
+            return Result::Fail;
+        }
+        return Result::Success;
+    }
+
     Result Shader::load_asset( const std::filesystem::path& full_path )
     {
-        IE_ASSERT( m_sdlShader == nullptr );
+        IE_ASSERT( m_sdlShader == nullptr && m_sdlComputePipeline == nullptr );
 
         // Auto-detect the shader stage from the file name for convenience
         const std::string file_name = full_path.filename().string();
+        m_FileName                  = file_name;
         if ( file_name.find( ".vert" ) != std::string::npos ) {
             m_stage = SDL_GPU_SHADERSTAGE_VERTEX;
         }
         else if ( file_name.find( ".frag" ) != std::string::npos ) {
             m_stage = SDL_GPU_SHADERSTAGE_FRAGMENT;
         }
+        else if ( file_name.find( ".comp" ) != std::string::npos ) {
+            m_IsCompute = true;
+        }
         else {
             IE_LOG_ERROR( "Loading shader \"{}\" failed: {}", full_path.string(), "Invalid shader stage" );
             return Result::Fail;
@@ -52,9 +80,16 @@ namespace InnoEngine
 
         if ( std::filesystem::exists( metadata_full_path ) == false ) {
             IE_LOG_ERROR( "Loading shader \"{}\" failed: {}", full_path.string(), "Couldn't find meta data" );
+            SDL_free( shader_data );
             return Result::Fail;
         }
 
+        if ( m_IsCompute ) {
+            Result result = create_compute_pipeline( full_path, shader_data, data_size, metadata_full_path );
+            SDL_free( shader_data );
+            return result;
+        }
+
         SDL_GPUShaderCreateInfo sdl_shadercreateinfo = {};
         try {
             std::ifstream  ifs( metadata_full_path.string().c_str() );
@@ -77,8 +112,11 @@ namespace InnoEngine
             sdl_shadercreateinfo.num_uniform_buffers  = meta_data_json.at( "uniform_buffers" );
             sdl_shadercreateinfo.props                = pid;
 
+            m_UniformBufferCount = sdl_shadercreateinfo.num_uniform_buffers;
+
         } catch ( std::exception e ) {
             IE_LOG_ERROR( "Loading shader \"{}\" failed: {}", full_path.string(), "Invalid meta data" );
+            SDL_free( shader_data );
             return Result::Fail;
         }
 
@@ -89,6 +127,44 @@ namespace InnoEngine
         return Result::Success;
     }
 
+    Result Shader::create_compute_pipeline( const std::filesystem::path& full_path, void* shader_data, size_t data_size, const std::filesystem::path& metadata_full_path )
+    {
+        SDL_GPUComputePipelineCreateInfo sdl_pipelinecreateinfo = {};
+        try {
+            std::ifstream  ifs( metadata_full_path.string().c_str() );
+            nlohmann::json meta_data_json = nlohmann::json::parse( ifs );
+
+            sdl_pipelinecreateinfo.code_size                      = data_size;
+            sdl_pipelinecreateinfo.code                           = static_cast<Uint8*>( shader_data );
+            sdl_pipelinecreateinfo.entrypoint                     = ms_shaderFormat.EntryPoint.data();
+            sdl_pipelinecreateinfo.format                         = ms_shaderFormat.Format;
+            sdl_pipelinecreateinfo.num_samplers                   = meta_data_json.at( "samplers" );
+            sdl_pipelinecreateinfo.num_readonly_storage_textures  = meta_data_json.at( "readonly_storage_textures" );
+            sdl_pipelinecreateinfo.num_readonly_storage_buffers   = meta_data_json.at( "readonly_storage_buffers" );
+            sdl_pipelinecreateinfo.num_readwrite_storage_textures = meta_data_json.at( "readwrite_storage_textures" );
+            sdl_pipelinecreateinfo.num_readwrite_storage_buffers  = meta_data_json.at( "readwrite_storage_buffers" );
+            sdl_pipelinecreateinfo.num_uniform_buffers            = meta_data_json.at( "uniform_buffers" );
+            sdl_pipelinecreateinfo.threadcount_x                  = meta_data_json.at( "threadcount_x" );
+            sdl_pipelinecreateinfo.threadcount_y                  = meta_data_json.at( "threadcount_y" );
+            sdl_pipelinecreateinfo.threadcount_z                  = meta_data_json.at( "threadcount_z" );
+
+            m_UniformBufferCount = sdl_pipelinecreateinfo.num_uniform_buffers;
+
+        } catch ( std::exception e ) {
+            IE_LOG_ERROR( "Loading shader \"{}\" failed: {}", full_path.string(), "Invalid meta data" );
+            return Result::Fail;
+        }
+
+        m_sdlComputePipeline = SDL_CreateGPUComputePipeline( m_Device, &sdl_pipelinecreateinfo );
+        if ( m_sdlComputePipeline == nullptr ) {
+            IE_LOG_ERROR( "Loading shader \"{}\" failed at SDL_CreateGPUComputePipeline: {}", full_path.string(), SDL_GetError() );
+            return Result::Fail;
+        }
+
+        IE_LOG_DEBUG( "Loaded compute shader \"{}\"", full_path.string() );
+        return Result::Success;
+    }
+
     std::filesystem::path Shader::build_path( const std::filesystem::path& folder, std::string_view file_name )
     {
         IE_ASSERT( ms_shaderFormat.Format != SDL_GPU_SHADERFORMAT_INVALID );
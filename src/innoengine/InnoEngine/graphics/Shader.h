@@ -29,19 +29,30 @@ namespace InnoEngine
     public:
         virtual ~Shader();
 
-        SDL_GPUShader* get_sdlshader() const;
+        SDL_GPUShader*          get_sdlshader() const;
+        SDL_GPUComputePipeline* get_sdlcomputepipeline() const;    // only valid for compute shaders (*.comp)
+        bool                    is_compute() const;
+
+        // binaries compiled from an older source lack uniforms the pipelines push, those have to fail instead of reading garbage
+        Result require_uniform_buffers( uint32_t count ) const;
 
     private:
         // Geerbt ber Asset
         Result                load_asset( const std::filesystem::path& full_path ) override;
         std::filesystem::path build_path( const std::filesystem::path& folder, std::string_view file_name ) override;
 
+        Result create_compute_pipeline( const std::filesystem::path& full_path, void* shader_data, size_t data_size, const std::filesystem::path& metadata_full_path );
+
     private:
         static ShaderFormatInfo ms_shaderFormat;
 
-        GPUDeviceRef       m_Device    = nullptr;
-        SDL_GPUShader*     m_sdlShader = nullptr;
-        SDL_GPUShaderStage m_stage = SDL_GPUShaderStage::SDL_GPU_SHADERSTAGE_VERTEX;
+        GPUDeviceRef            m_Device             = nullptr;
+        SDL_GPUShader*          m_sdlShader          = nullptr;
+        SDL_GPUComputePipeline* m_sdlComputePipeline = nullptr;
+        SDL_GPUShaderStage      m_stage              = SDL_GPUShaderStage::SDL_GPU_SHADERSTAGE_VERTEX;
+        bool                    m_IsCompute          = false;
+        std::string             m_FileName;
+        uint32_t                m_UniformBufferCount = 0;
     };
 
 }    // namespace InnoEngine
@@ -2,8 +2,10 @@
 #include "InnoEngine/graphics/Sprite.h"
 
 #include "InnoEngine/graphics/Texture2D.h"
+#include "InnoEngine/graphics/SpriteAtlas.h"
 
 #include "InnoEngine/graphics/Renderer.h"
+#include "InnoEngine/graphics/pipelines/Sprite2DPipeline.h"
 
 namespace InnoEngine
 {
@@ -26,11 +28,20 @@ namespace InnoEngine
 
     void Sprite::set_source_rect( const DXSM::Vector4& source_rect )
     {
-        m_SourceRect     = source_rect;
-        m_Size.x         = m_Scale.x * m_Texture->get_specs().Width * ( m_SourceRect.z - m_SourceRect.x );
-        m_Size.y         = m_Scale.y * m_Texture->get_specs().Height * ( m_SourceRect.w - m_SourceRect.y );
-        m_RotationOffset = m_RotationOrigin * m_Size;
-        m_RenderPosition = origin_transform( m_Origin, m_Position, m_Size, m_RotationOffset );
+        m_SourceRect = source_rect;
+        update_size();
+    }
+
+    bool Sprite::set_region( const SpriteAtlas& atlas, std::string_view region_name )
+    {
+        const SpriteAtlasRegion* region = atlas.find_region( region_name );
+        if ( region == nullptr ) {
+            IE_LOG_WARNING( "Sprite atlas \"{}\" has no region \"{}\"", atlas.get_path().filename().string(), region_name );
+            return false;
+        }
+
+        set_texture( atlas.get_page( region->Page ), region->SourceRect );
+        return true;
     }
 
     void Sprite::set_position( const DXSM::Vector2& position )
@@ -61,12 +72,35 @@ namespace InnoEngine
         m_RenderPosition = origin_transform( m_Origin, m_Position, m_Size, m_RotationOffset );
     }
 
-    void Sprite::set_scale( const DXSM::Vector2&& scale )
+    void Sprite::play_animation( SpriteAnimation animation )
+    {
+        if ( animation.StartTime == 0.0f )
+            animation.StartTime = GPURenderer::get_animation_time();
+
+        m_Animation       = animation;
+        m_PackedAnimation = Sprite2DPipeline::pack_animation( animation.Columns, animation.Rows, animation.FrameCount, animation.Loop );
+        update_size();
+    }
+
+    void Sprite::stop_animation()
+    {
+        m_Animation       = {};
+        m_PackedAnimation = 0;
+        update_size();
+    }
+
+    void Sprite::update_size()
     {
-        m_Scale          = scale;
-        m_Size.x         = m_Scale.x * m_Texture->get_specs().Width * ( m_SourceRect.z - m_SourceRect.x );
-        m_Size.y         = m_Scale.y * m_Texture->get_specs().Height * ( m_SourceRect.w - m_SourceRect.y );
+        // an animated sprite shows one cell of the grid
+        m_Size.x         = m_Scale.x * m_Texture->get_specs().Width * ( m_SourceRect.z - m_SourceRect.x ) / m_Animation.Columns;
+        m_Size.y         = m_Scale.y * m_Texture->get_specs().Height * ( m_SourceRect.w - m_SourceRect.y ) / m_Animation.Rows;
         m_RotationOffset = m_RotationOrigin * m_Size;
         m_RenderPosition = origin_transform( m_Origin, m_Position, m_Size, m_RotationOffset );
     }
+
+    void Sprite::set_scale( const DXSM::Vector2&& scale )
+    {
+        m_Scale = scale;
+        update_size();
+    }
 }    // namespace InnoEngine
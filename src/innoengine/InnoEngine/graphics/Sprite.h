@@ -5,9 +5,24 @@
 #include "InnoEngine/BaseTypes.h"
 #include "InnoEngine/graphics/Texture2D.h"
 
+#include <string_view>
+
 namespace InnoEngine
 {
     class GPURenderer;
+    class SpriteAtlas;
+
+    // flipbook over a grid of equally sized frames inside the source rect of a sprite, row by row
+    // the current frame is picked by the vertex shader, so playing it costs no cpu time per frame
+    struct SpriteAnimation
+    {
+        uint32_t Columns    = 1;
+        uint32_t Rows       = 1;
+        uint32_t FrameCount = 0;       // 0 uses all cells of the grid
+        float    FrameRate  = 0.0f;    // frames per second
+        float    StartTime  = 0.0f;    // in GPURenderer::get_animation_time seconds
+        bool     Loop       = true;
+    };
 
     class Sprite
     {
@@ -27,6 +42,7 @@ namespace InnoEngine
 
         void set_texture( const Ref<Texture2D> texture, const DXSM::Vector4& source_rect = { 0.0f, 0.0f, 1.0f, 1.0f } );
         void set_source_rect( const DXSM::Vector4& source_rect );    // source area of the texture
+        bool set_region( const SpriteAtlas& atlas, std::string_view region_name );    // page and source area of a named atlas region
 
         void set_position( const DXSM::Vector2& position );
         void set_position_origin( Origin origin );
@@ -36,6 +52,12 @@ namespace InnoEngine
         void set_rotation_origin( const DXSM::Vector2& rotation_origin );
         void set_scale( const DXSM::Vector2&& scale );
 
+        void play_animation( SpriteAnimation animation );    // starts now when StartTime is 0
+        void stop_animation();
+
+    private:
+        void update_size();
+
     private:
         GPURenderer*   m_Renderer        = nullptr;
         Ref<Texture2D> m_Texture         = nullptr;
@@ -50,6 +72,9 @@ namespace InnoEngine
         DXSM::Vector2  m_RotationOffset  = {0.0f, 0.0f};           
         DXSM::Vector2  m_RenderPosition  = {0, 0};
         DXSM::Vector2  m_Size            = {0.0f, 0.0f};
+
+        SpriteAnimation m_Animation       = {};
+        uint32_t        m_PackedAnimation = 0;    // 0 when not animated
     };
 
 }    // namespace InnoEngine
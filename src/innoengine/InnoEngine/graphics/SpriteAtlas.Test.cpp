@@ -0,0 +1,94 @@
+#include "InnoEngine/graphics/SpriteAtlas.h"
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+namespace InnoEngine
+{
+    TEST( SpriteAtlasTest, parse )
+    {
+        const std::string json = R"({
+            "page_size": 512,
+            "padding": 1,
+            "images": [ "weapons/MG.png", { "name": "Cannon", "file": "Cannon.png" }, { "file": "sub/Missile.png" }, "MG.png" ]
+        })";
+
+        std::optional<SpriteAtlasDescription> description = SpriteAtlasDescription::parse( json );
+        ASSERT_TRUE( description.has_value() );
+
+        EXPECT_EQ( description->PageSize, 512 );
+        EXPECT_EQ( description->Padding, 1 );
+        EXPECT_FALSE( description->Mipmaps );
+
+        ASSERT_EQ( description->Images.size(), 3u );    // the second "MG.png" is dropped
+        EXPECT_EQ( description->Images[ 0 ].Name, "MG.png" );
+        EXPECT_EQ( description->Images[ 0 ].File, std::filesystem::path( "weapons/MG.png" ) );
+        EXPECT_EQ( description->Images[ 1 ].Name, "Cannon" );
+        EXPECT_EQ( description->Images[ 2 ].Name, "Missile.png" );
+    }
+
+    TEST( SpriteAtlasTest, parseInvalid )
+    {
+        EXPECT_FALSE( SpriteAtlasDescription::parse( "" ).has_value() );
+        EXPECT_FALSE( SpriteAtlasDescription::parse( R"({ "page_size": 512 })" ).has_value() );
+        EXPECT_FALSE( SpriteAtlasDescription::parse( R"({ "images": [ { "name": "NoFile" } ] })" ).has_value() );
+        EXPECT_FALSE( SpriteAtlasDescription::parse( R"({ "page_size": 0, "images": [] })" ).has_value() );
+    }
+
+    TEST( SpriteAtlasTest, findRegion )
+    {
+        const std::vector<SpriteAtlasLayout::Image> images = { { "A", 64, 32 }, { "B", 16, 16 }, { "C", 30, 60 } };
+
+        std::optional<SpriteAtlasLayout> layout = SpriteAtlasLayout::pack( images, 256, 2 );
+        ASSERT_TRUE( layout.has_value() );
+        ASSERT_EQ( layout->PageExtents.size(), 1u );
+
+        const auto [ page_width, page_height ] = layout->PageExtents[ 0 ];
+        for ( const SpriteAtlasLayout::Image& image : images ) {
+            const SpriteAtlasRegion* region = layout->find_region( image.Name );
+            ASSERT_NE( region, nullptr );
+
+            EXPECT_EQ( region->Page, 0u );
+            EXPECT_EQ( region->Width, static_cast<uint32_t>( image.Width ) );
+            EXPECT_EQ( region->Height, static_cast<uint32_t>( image.Height ) );
+            EXPECT_LE( region->X + region->Width, static_cast<uint32_t>( page_width ) );
+            EXPECT_LE( region->Y + region->Height, static_cast<uint32_t>( page_height ) );
+
+            EXPECT_FLOAT_EQ( region->SourceRect.x, static_cast<float>( region->X ) / page_width );
+            EXPECT_FLOAT_EQ( region->SourceRect.y, static_cast<float>( region->Y ) / page_height );
+            EXPECT_FLOAT_EQ( region->SourceRect.z, static_cast<float>( region->X + region->Width ) / page_width );
+            EXPECT_FLOAT_EQ( region->SourceRect.w, static_cast<float>( region->Y + region->Height ) / page_height );
+        }
+
+        // regions don't overlap
+        for ( const auto& [ name_a, a ] : layout->Regions ) {
+            for ( const auto& [ name_b, b ] : layout->Regions ) {
+                if ( name_a == name_b )
+                    continue;
+                const bool separate = a.X + a.Width <= b.X || b.X + b.Width <= a.X || a.Y + a.Height <= b.Y || b.Y + b.Height <= a.Y;
+                EXPECT_TRUE( separate ) << name_a << " overlaps " << name_b;
+            }
+        }
+
+        EXPECT_EQ( layout->find_region( "D" ), nullptr );
+    }
+
+    TEST( SpriteAtlasTest, pageOverflow )
+    {
+        const std::vector<SpriteAtlasLayout::Image> images = { { "A", 100, 100 }, { "B", 100, 100 }, { "C", 100, 100 } };
+
+        std::optional<SpriteAtlasLayout> layout = SpriteAtlasLayout::pack( images, 128, 0 );
+        ASSERT_TRUE( layout.has_value() );
+        EXPECT_EQ( layout->PageExtents.size(), 3u );
+
+        std::vector<bool> used( 3, false );
+        for ( const auto& [ name, region ] : layout->Regions ) {
+            ASSERT_LT( region.Page, 3u );
+            EXPECT_FALSE( used[ region.Page ] );
+            used[ region.Page ] = true;
+        }
+
+        EXPECT_FALSE( SpriteAtlasLayout::pack( { { "Huge", 300, 10 } }, 128, 0 ).has_value() );
+    }
+}    // namespace InnoEngine
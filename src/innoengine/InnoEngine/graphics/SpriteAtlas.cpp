@@ -0,0 +1,269 @@
+#include "InnoEngine/iepch.h"
+#include "InnoEngine/graphics/SpriteAtlas.h"
+
+#include "SDL3_image/SDL_image.h"
+
+#include "InnoEngine/graphics/Texture2D.h"
+#include "InnoEngine/graphics/MSDFData.h"
+
+#include "nlohmann/json.hpp"
+
+#include <set>
+#include <sstream>
+
+namespace InnoEngine
+{
+    namespace
+    {
+        void destroy_surfaces( std::vector<SDL_Surface*>& surfaces )
+        {
+            for ( SDL_Surface*& surface : surfaces ) {
+                if ( surface )
+                    SDL_DestroySurface( surface );
+                surface = nullptr;
+            }
+        }
+    }    // namespace
+
+    auto SpriteAtlasDescription::parse( std::string_view json ) -> std::optional<SpriteAtlasDescription>
+    {
+        SpriteAtlasDescription description;
+        try {
+            nlohmann::json atlas_json = nlohmann::json::parse( json );
+
+            description.PageSize = atlas_json.value( "page_size", description.PageSize );
+            description.Padding  = atlas_json.value( "padding", description.Padding );
+            description.Mipmaps  = atlas_json.value( "mipmaps", description.Mipmaps );
+
+            std::set<std::string, std::less<>> names;
+            for ( const nlohmann::json& entry : atlas_json.at( "images" ) ) {
+                Image image;
+                if ( entry.is_string() ) {
+                    image.File = entry.get<std::string>();
+                    image.Name = image.File.filename().string();
+                }
+                else {
+                    image.File = entry.at( "file" ).get<std::string>();
+                    image.Name = entry.value( "name", image.File.filename().string() );
+                }
+
+                if ( names.insert( image.Name ).second == false ) {
+                    IE_LOG_WARNING( "Sprite atlas contains the region \"{}\" more than once", image.Name );
+                    continue;
+                }
+                description.Images.push_back( std::move( image ) );
+            }
+        } catch ( std::exception e ) {
+            return std::nullopt;
+        }
+
+        if ( description.PageSize <= 0 || description.Padding < 0 )
+            return std::nullopt;
+
+        return description;
+    }
+
+    const SpriteAtlasRegion* SpriteAtlasLayout::find_region( std::string_view name ) const
+    {
+        auto it = Regions.find( name );
+        if ( it == Regions.end() )
+            return nullptr;
+        return &it->second;
+    }
+
+    auto SpriteAtlasLayout::pack( const std::vector<Image>& images, int page_size, int padding ) -> std::optional<SpriteAtlasLayout>
+    {
+        SpriteAtlasLayout layout;
+
+        // pack with the same packer msdf-atlas-gen uses for the glyphs, every image
+        // which doesn't fit on the current page moves on to the next one
+        std::vector<size_t>                remaining( images.size() );
+        std::vector<msdf_atlas::Rectangle> rects;
+        std::vector<SpriteAtlasRegion>     placed( images.size() );
+        for ( size_t i = 0; i < remaining.size(); ++i )
+            remaining[ i ] = i;
+
+        while ( remaining.empty() == false ) {
+            rects.resize( remaining.size() );
+            for ( size_t i = 0; i < remaining.size(); ++i ) {
+                const Image& image = images[ remaining[ i ] ];
+                rects[ i ]         = { -1, -1, image.Width + padding, image.Height + padding };
+            }
+
+            msdf_atlas::RectanglePacker packer( page_size, page_size );
+            packer.pack( rects.data(), static_cast<int>( rects.size() ) );
+
+            const uint32_t      page = static_cast<uint32_t>( layout.PageExtents.size() );
+            std::pair<int, int> extent( 0, 0 );
+            std::vector<size_t> next;
+            for ( size_t i = 0; i < remaining.size(); ++i ) {
+                const Image&       image  = images[ remaining[ i ] ];
+                SpriteAtlasRegion& region = placed[ remaining[ i ] ];
+                if ( rects[ i ].x < 0 ) {
+                    next.push_back( remaining[ i ] );
+                    continue;
+                }
+
+                region.Page   = page;
+                region.X      = rects[ i ].x;
+                region.Y      = rects[ i ].y;
+                region.Width  = image.Width;
+                region.Height = image.Height;
+                extent.first  = std::max( extent.first, rects[ i ].x + image.Width );
+                extent.second = std::max( extent.second, rects[ i ].y + image.Height );
+            }
+
+            if ( next.size() == remaining.size() ) {
+                IE_LOG_ERROR( "Sprite atlas image \"{}\" doesn't fit on a {}x{} page", images[ next.front() ].Name, page_size, page_size );
+                return std::nullopt;
+            }
+
+            layout.PageExtents.push_back( extent );
+            remaining = std::move( next );
+        }
+
+        // pages are cropped to the area in use
+        for ( size_t i = 0; i < images.size(); ++i ) {
+            SpriteAtlasRegion&         region = placed[ i ];
+            const std::pair<int, int>& extent = layout.PageExtents[ region.Page ];
+            region.SourceRect                 = { static_cast<float>( region.X ) / extent.first,
+                                                  static_cast<float>( region.Y ) / extent.second,
+                                                  static_cast<float>( region.X + region.Width ) / extent.first,
+                                                  static_cast<float>( region.Y + region.Height ) / extent.second };
+
+            layout.Regions.emplace( images[ i ].Name, region );
+        }
+
+        return layout;
+    }
+
+    auto SpriteAtlas::create_from_file( const std::filesystem::path& full_path ) -> std::optional<Ref<SpriteAtlas>>
+    {
+        Ref<SpriteAtlas> atlas = Ref<SpriteAtlas>( new SpriteAtlas() );
+        if ( IE_SUCCESS( atlas->load_asset( full_path ) ) ) {
+            return atlas;
+        }
+        return std::nullopt;
+    }
+
+    const SpriteAtlasRegion* SpriteAtlas::find_region( std::string_view name ) const
+    {
+        return m_Layout.find_region( name );
+    }
+
+    Ref<Texture2D> SpriteAtlas::get_page( uint32_t index ) const
+    {
+        IE_ASSERT( index < m_Pages.size() );
+        return m_Pages[ index ];
+    }
+
+    uint32_t SpriteAtlas::get_page_count() const
+    {
+        return static_cast<uint32_t>( m_Pages.size() );
+    }
+
+    size_t SpriteAtlas::get_region_count() const
+    {
+        return m_Layout.Regions.size();
+    }
+
+    Result SpriteAtlas::load_asset( const std::filesystem::path& full_path )
+    {
+        if ( m_Pages.empty() == false ) {
+            return Result::AlreadyInitialized;
+        }
+
+        std::ifstream     ifs( full_path.string().c_str() );
+        std::stringstream json;
+        json << ifs.rdbuf();
+
+        std::optional<SpriteAtlasDescription> description = SpriteAtlasDescription::parse( json.str() );
+        if ( description.has_value() == false ) {
+            IE_LOG_ERROR( "Loading sprite atlas \"{}\" failed: {}", full_path.filename().string(), "Invalid description" );
+            return Result::Fail;
+        }
+
+        const std::filesystem::path directory = full_path.parent_path();
+
+        std::vector<SDL_Surface*>             surfaces;
+        std::vector<SpriteAtlasLayout::Image> images;
+        for ( const SpriteAtlasDescription::Image& image : description->Images ) {
+            SDL_Surface* surface = IMG_Load( ( directory / image.File ).string().c_str() );
+            if ( surface == nullptr ) {
+                IE_LOG_ERROR( "Loading sprite atlas \"{}\" failed at IMG_Load: {}", full_path.filename().string(), SDL_GetError() );
+                destroy_surfaces( surfaces );
+                return Result::Fail;
+            }
+
+            // blitting between equal formats keeps the alpha channel untouched
+            SDL_Surface* converted = SDL_ConvertSurface( surface, SDL_PIXELFORMAT_RGBA32 );
+            SDL_DestroySurface( surface );
+            if ( converted == nullptr ) {
+                IE_LOG_ERROR( "Loading sprite atlas \"{}\" failed at SDL_ConvertSurface: {}", full_path.filename().string(), SDL_GetError() );
+                destroy_surfaces( surfaces );
+                return Result::Fail;
+            }
+            SDL_SetSurfaceBlendMode( converted, SDL_BLENDMODE_NONE );
+
+            surfaces.push_back( converted );
+            images.push_back( { image.Name, converted->w, converted->h } );
+        }
+
+        std::optional<SpriteAtlasLayout> layout = SpriteAtlasLayout::pack( images, description->PageSize, description->Padding );
+        if ( layout.has_value() == false ) {
+            IE_LOG_ERROR( "Loading sprite atlas \"{}\" failed: {}", full_path.filename().string(), "Images don't fit on a page" );
+            destroy_surfaces( surfaces );
+            return Result::Fail;
+        }
+
+        std::vector<SDL_Surface*> page_surfaces;
+        for ( const auto& [ width, height ] : layout->PageExtents ) {
+            SDL_Surface* page_surface = SDL_CreateSurface( width, height, SDL_PIXELFORMAT_RGBA32 );
+            if ( page_surface == nullptr ) {
+                IE_LOG_ERROR( "Loading sprite atlas \"{}\" failed at SDL_CreateSurface: {}", full_path.filename().string(), SDL_GetError() );
+                break;
+            }
+            SDL_FillSurfaceRect( page_surface, nullptr, 0 );
+            page_surfaces.push_back( page_surface );
+        }
+
+        Result result = page_surfaces.size() == layout->PageExtents.size() ? Result::Success : Result::Fail;
+
+        for ( size_t i = 0; i < surfaces.size() && IE_SUCCESS( result ); ++i ) {
+            const SpriteAtlasRegion* region      = layout->find_region( images[ i ].Name );
+            SDL_Rect                 destination = { static_cast<int>( region->X ), static_cast<int>( region->Y ), surfaces[ i ]->w, surfaces[ i ]->h };
+            SDL_BlitSurface( surfaces[ i ], nullptr, page_surfaces[ region->Page ], &destination );
+        }
+        destroy_surfaces( surfaces );
+
+        for ( SDL_Surface* page_surface : page_surfaces ) {
+            if ( IE_SUCCESS( result ) ) {
+                TextureSpecifications specs = {};
+                specs.Width                 = page_surface->w;
+                specs.Height                = page_surface->h;
+                specs.Format                = TextureFormat::RGBA;
+                specs.EnableMipmap          = description->Mipmaps;
+
+                std::optional<Ref<Texture2D>> page = Texture2D::create( specs );
+                if ( page.has_value() ) {
+                    result = ( *page )->load_data( page_surface->pixels, page_surface->w * page_surface->h, page_surface->format );
+                    m_Pages.push_back( *page );
+                }
+                else {
+                    result = Result::Fail;
+                }
+            }
+            SDL_DestroySurface( page_surface );
+        }
+
+        if ( IE_FAILED( result ) ) {
+            m_Pages.clear();
+            return result;
+        }
+
+        m_Layout = std::move( *layout );
+
+        IE_LOG_DEBUG( "Loaded sprite atlas \"{}\" with {} regions on {} pages", full_path.filename().string(), m_Layout.Regions.size(), m_Pages.size() );
+        return Result::Success;
+    }
+}    // namespace InnoEngine
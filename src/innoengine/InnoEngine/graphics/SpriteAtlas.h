@@ -0,0 +1,95 @@
+#pragma once
+#include "InnoEngine/BaseTypes.h"
+#include "InnoEngine/Asset.h"
+
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace InnoEngine
+{
+    class Texture2D;
+
+    struct SpriteAtlasRegion
+    {
+        uint32_t      Page       = 0;
+        DXSM::Vector4 SourceRect = { 0.0f, 0.0f, 1.0f, 1.0f };    // normalized, x0 y0 x1 y1
+        uint32_t      X          = 0;                              // in pixels on the page
+        uint32_t      Y          = 0;
+        uint32_t      Width      = 0;                              // in pixels
+        uint32_t      Height     = 0;
+    };
+
+    struct SpriteAtlasDescription
+    {
+        struct Image
+        {
+            std::string           Name;
+            std::filesystem::path File;    // relative to the description file
+        };
+
+        int                PageSize = 2048;
+        int                Padding  = 2;    // in pixels
+        bool               Mipmaps  = false;
+        std::vector<Image> Images;          // names are unique, later duplicates are dropped
+
+        static auto parse( std::string_view json ) -> std::optional<SpriteAtlasDescription>;
+    };
+
+    // placement of the atlas images on cropped pages, independent of the pixel data
+    struct SpriteAtlasLayout
+    {
+        struct Image
+        {
+            std::string_view Name;
+            int              Width  = 0;
+            int              Height = 0;
+        };
+
+        std::vector<std::pair<int, int>>                      PageExtents;    // in pixels
+        std::map<std::string, SpriteAtlasRegion, std::less<>> Regions;
+
+        const SpriteAtlasRegion* find_region( std::string_view name ) const;
+
+        // fails when a single image doesn't fit on an empty page
+        static auto pack( const std::vector<Image>& images, int page_size, int padding ) -> std::optional<SpriteAtlasLayout>;
+    };
+
+    // packs many source images into one or a few texture pages when loaded
+    // so sprites using the same page can be drawn in a single batch
+    //
+    // description file:
+    // {
+    //     "page_size": 2048,    (optional)
+    //     "padding": 2,         (optional, in pixels)
+    //     "mipmaps": false,     (optional)
+    //     "images": [ "MG.png", { "name": "Cannon", "file": "Cannon.png" } ]
+    // }
+    // image paths are relative to the description file, the region name defaults to the file name
+    class SpriteAtlas : public Asset<SpriteAtlas>
+    {
+        friend class AssetRepository<SpriteAtlas>;
+
+        SpriteAtlas() = default;
+
+    public:
+        static auto create_from_file( const std::filesystem::path& full_path ) -> std::optional<Ref<SpriteAtlas>>;
+
+        const SpriteAtlasRegion* find_region( std::string_view name ) const;
+
+        Ref<Texture2D> get_page( uint32_t index ) const;
+        uint32_t       get_page_count() const;
+        size_t         get_region_count() const;
+
+    private:
+        // Inherited via Asset
+        Result load_asset( const std::filesystem::path& full_path ) override;
+
+    private:
+        std::vector<Ref<Texture2D>> m_Pages;
+        SpriteAtlasLayout           m_Layout;
+    };
+}    // namespace InnoEngine
@@ -0,0 +1,25 @@
+#pragma once
+#include "InnoEngine/BaseTypes.h"
+
+namespace InnoEngine
+{
+    // drawn in the same pass as the text, straight from the distance field of the font
+    // sizes are in the units of the text size, the distance field limits outline and glow to about 1/16 em
+    struct TextEffects
+    {
+        DXSM::Color   OutlineColor   = { 0.0f, 0.0f, 0.0f, 0.0f };
+        float         OutlineWidth   = 0.0f;
+        DXSM::Color   ShadowColor    = { 0.0f, 0.0f, 0.0f, 0.0f };
+        DXSM::Vector2 ShadowOffset   = {};      // y-up like the position of the text
+        float         ShadowSoftness = 0.0f;    // 0 gives a hard edge
+        DXSM::Color   GlowColor      = { 0.0f, 0.0f, 0.0f, 0.0f };
+        float         GlowRadius     = 0.0f;
+
+        bool operator==( const TextEffects& other ) const = default;
+
+        bool is_enabled() const
+        {
+            return ( OutlineWidth > 0.0f && OutlineColor.w > 0.0f ) || ShadowColor.w > 0.0f || ( GlowRadius > 0.0f && GlowColor.w > 0.0f );
+        }
+    };
+}    // namespace InnoEngine
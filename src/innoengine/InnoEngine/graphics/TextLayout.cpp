@@ -0,0 +1,206 @@
+#include "InnoEngine/iepch.h"
+#include "InnoEngine/graphics/TextLayout.h"
+
+#include "InnoEngine/graphics/Font.h"
+#include "InnoEngine/graphics/MSDFData.h"
+#include "InnoEngine/graphics/GlyphAtlas.h"
+#include "InnoEngine/graphics/Texture2D.h"
+#include "InnoEngine/utility/UTF8.h"
+
+namespace InnoEngine
+{
+    namespace
+    {
+        void move_glyphs( std::vector<TextLayoutGlyph>& glyphs, size_t first, size_t end, const DXSM::Vector2& delta )
+        {
+            for ( size_t i = first; i < end; ++i ) {
+                glyphs[ i ].Offset += delta;
+                glyphs[ i ].Pen += delta;
+            }
+        }
+
+        void close_line( TextLayout& layout, uint32_t first_glyph, uint32_t end_glyph )
+        {
+            TextLayoutLine& line = layout.Lines.emplace_back();
+            line.FirstGlyph      = first_glyph;
+            line.GlyphCount      = end_glyph - first_glyph;
+
+            for ( uint32_t i = first_glyph; i < end_glyph; ++i ) {
+                const TextLayoutGlyph& glyph = layout.Glyphs[ i ];
+                line.Width                   = std::max( line.Width, glyph.Offset.x + glyph.Size.x );
+            }
+        }
+    }    // namespace
+
+    void TextLayout::build( const Font& font, uint32_t font_size, std::string_view text, const TextLayoutOptions& options, TextLayout& layout )
+    {
+        layout.Glyphs.clear();
+        layout.Lines.clear();
+        layout.Bounds   = {};
+        layout.PageMask = 0;
+        layout.Complete = true;
+
+        // nothing to lay out with until the atlas is generated
+        if ( font.is_ready() == false ) {
+            layout.Complete = false;
+            return;
+        }
+
+        const Ref<MSDFData> msdf_data = font.get_msdf_data();
+        IE_ASSERT( msdf_data != nullptr );
+
+        const TextureSpecifications& atlas_specs         = font.get_atlas_texture()->get_specs();
+        const MSDFMetrics&           metrics             = msdf_data->Metrics;
+        const double                 space_glyph_advance = msdf_data->get_glyph( ' ' )->Advance;
+        const double                 scale               = 1.0 / ( metrics.AscenderY - metrics.DescenderY ) * font_size;
+        const double                 line_height         = scale * metrics.LineHeight * options.LineSpacing;
+        const bool                   wrap                = options.MaxWidth > 0.0f;
+
+        double x = 0.0;
+        double y = 0.0;
+
+        // wrapping moves everything behind the last space of the line onto the next one
+        uint32_t line_start  = 0;
+        uint32_t break_glyph = InvalidGlyphIndex;    // first glyph after the last space of the current line
+        double   break_x     = 0.0;                  // pen position of break_glyph
+
+        auto next_line = [ & ]( uint32_t first_glyph ) {
+            close_line( layout, line_start, first_glyph );
+            line_start  = first_glyph;
+            break_glyph = InvalidGlyphIndex;
+            y -= line_height;
+        };
+
+        // one codepoint of lookahead for the kerning
+        size_t   offset         = 0;
+        char32_t next_codepoint = text.empty() ? 0 : decode_utf8( text, offset );
+        while ( next_codepoint != 0 ) {
+            const char32_t codepoint = next_codepoint;
+            next_codepoint           = offset < text.size() ? decode_utf8( text, offset ) : 0;
+
+            IE_ASSERT( codepoint != '\0' );
+
+            if ( codepoint == '\n' ) {
+                next_line( static_cast<uint32_t>( layout.Glyphs.size() ) );
+                x = 0.0;
+                continue;
+            }
+
+            if ( codepoint == ' ' || codepoint == '\t' ) {
+                double advance = space_glyph_advance;
+                if ( codepoint == '\t' )
+                    advance *= 4.0;
+                else if ( next_codepoint != 0 )
+                    msdf_data->get_advance( advance, codepoint, next_codepoint );
+
+                x += scale * advance;
+
+                break_glyph = static_cast<uint32_t>( layout.Glyphs.size() );
+                break_x     = x;
+                continue;
+            }
+
+            MSDFGlyph   glyph;
+            GlyphStatus status = font.find_glyph( codepoint, glyph );
+            if ( status == GlyphStatus::Missing )
+                status = font.find_glyph( '?', glyph );
+            if ( status != GlyphStatus::Available ) {
+                layout.Complete = false;
+                continue;
+            }
+
+            const double pl = glyph.PlaneBounds.x;
+            const double pb = glyph.PlaneBounds.y;
+            const double pr = glyph.PlaneBounds.z;
+            const double pt = glyph.PlaneBounds.w;
+
+            const uint32_t glyph_count = static_cast<uint32_t>( layout.Glyphs.size() );
+            if ( wrap && x + pr * scale > options.MaxWidth && glyph_count > line_start ) {
+                if ( break_glyph != InvalidGlyphIndex && break_glyph > line_start ) {
+                    const uint32_t first_glyph = break_glyph;
+                    next_line( first_glyph );
+                    move_glyphs( layout.Glyphs, first_glyph, glyph_count, DXSM::Vector2( static_cast<float>( -break_x ), static_cast<float>( -line_height ) ) );
+                    x -= break_x;
+                }
+                else {
+                    // a single word wider than the line gets broken anywhere
+                    next_line( glyph_count );
+                    x = 0.0;
+                }
+            }
+
+            TextLayoutGlyph& quad = layout.Glyphs.emplace_back();
+            quad.Page             = glyph.Page;
+            quad.GlyphIndex       = glyph.Page == 0 ? msdf_data->get_glyph_index( glyph.Codepoint ) : InvalidGlyphIndex;
+            layout.PageMask |= 1ull << glyph.Page;
+
+            // generated glyphs live on pages of their own size
+            const float texel_width  = glyph.Page == 0 ? 1.0f / atlas_specs.Width : 1.0f / GlyphAtlas::PageSize;
+            const float texel_height = glyph.Page == 0 ? 1.0f / atlas_specs.Height : 1.0f / GlyphAtlas::PageSize;
+
+            // remember that the atlas y grows in bottom-up and our renderer expects it to grow top-down
+            const DXSM::Vector4& atlas_bounds = glyph.AtlasBounds;
+            quad.SourceRect.x                 = atlas_bounds.x * texel_width;
+            quad.SourceRect.y                 = atlas_bounds.w * texel_height;
+            quad.SourceRect.z                 = atlas_bounds.z * texel_width;
+            quad.SourceRect.w                 = atlas_bounds.y * texel_height;
+
+            quad.Pen      = DXSM::Vector2( static_cast<float>( x ), static_cast<float>( y ) );
+            quad.Offset.x = static_cast<float>( x + pl * scale );
+            quad.Offset.y = static_cast<float>( y + ( pt * scale ) );
+            quad.Size.x   = static_cast<float>( ( pr - pl ) * scale );
+            quad.Size.y   = static_cast<float>( ( pb - pt ) * scale );
+
+            if ( next_codepoint != 0 ) {
+                double advance = glyph.Advance;
+                msdf_data->get_advance( advance, codepoint, next_codepoint );
+                x += scale * advance;
+            }
+        }
+        close_line( layout, line_start, static_cast<uint32_t>( layout.Glyphs.size() ) );
+
+        if ( layout.Glyphs.empty() )
+            return;
+
+        // lines get aligned inside the wrap width, or the widest line without wrapping
+        float block_width = options.MaxWidth;
+        if ( wrap == false ) {
+            for ( const TextLayoutLine& line : layout.Lines )
+                block_width = std::max( block_width, line.Width );
+        }
+
+        const float alignment = options.Alignment == TextAlignment::Center ? 0.5f : options.Alignment == TextAlignment::Right ? 1.0f : 0.0f;
+        if ( alignment > 0.0f ) {
+            for ( const TextLayoutLine& line : layout.Lines )
+                move_glyphs( layout.Glyphs, line.FirstGlyph, line.FirstGlyph + line.GlyphCount, DXSM::Vector2( ( block_width - line.Width ) * alignment, 0.0f ) );
+        }
+
+        DXSM::Vector2 min( std::numeric_limits<float>::max() );
+        DXSM::Vector2 max( std::numeric_limits<float>::lowest() );
+        for ( const TextLayoutGlyph& quad : layout.Glyphs ) {
+            min = DXSM::Vector2::Min( min, quad.Offset );
+            min = DXSM::Vector2::Min( min, quad.Offset + quad.Size );
+            max = DXSM::Vector2::Max( max, quad.Offset );
+            max = DXSM::Vector2::Max( max, quad.Offset + quad.Size );
+        }
+        layout.Bounds = DXSM::Vector4( min.x, min.y, max.x, max.y );
+    }
+
+    DXSM::Vector2 TextLayout::get_anchor_offset( Origin anchor ) const
+    {
+        switch ( anchor ) {
+        case Origin::Middle:
+            return { -( Bounds.x + Bounds.z ) * 0.5f, -( Bounds.y + Bounds.w ) * 0.5f };
+        case Origin::TopLeft:
+            return { -Bounds.x, -Bounds.w };
+        case Origin::TopRight:
+            return { -Bounds.z, -Bounds.w };
+        case Origin::BottomLeft:
+            return { -Bounds.x, -Bounds.y };
+        case Origin::BottomRight:
+            return { -Bounds.z, -Bounds.y };
+        default:
+            return {};
+        }
+    }
+}    // namespace InnoEngine
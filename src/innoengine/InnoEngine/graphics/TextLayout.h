@@ -0,0 +1,64 @@
+#pragma once
+#include "InnoEngine/BaseTypes.h"
+
+#include <limits>
+#include <string_view>
+#include <vector>
+
+namespace InnoEngine
+{
+    class Font;
+
+    constexpr uint32_t InvalidGlyphIndex = std::numeric_limits<uint32_t>::max();
+
+    enum class TextAlignment : uint8_t
+    {
+        Left = 0,
+        Center,
+        Right,
+    };
+
+    struct TextLayoutOptions
+    {
+        float         MaxWidth    = 0.0f;    // in pixels, words wrap onto the next line beyond it, 0 disables wrapping
+        float         LineSpacing = 1.0f;    // times the line height of the font
+        TextAlignment Alignment   = TextAlignment::Left;
+
+        bool operator==( const TextLayoutOptions& other ) const = default;
+    };
+
+    // one laid out glyph quad, relative to the position of the text
+    struct TextLayoutGlyph
+    {
+        DXSM::Vector2 Offset     = {};
+        DXSM::Vector2 Size       = {};
+        DXSM::Vector4 SourceRect = {};    // uv rect inside the atlas page, top-down
+        DXSM::Vector2 Pen        = {};    // x and baseline of the glyph origin, the gpu derives the quad from it
+        uint32_t      Page       = 0;     // see MSDFGlyph::Page
+        uint32_t      GlyphIndex = InvalidGlyphIndex;    // into MSDFData::Glyphs, only for baked glyphs
+    };
+
+    struct TextLayoutLine
+    {
+        uint32_t FirstGlyph = 0;
+        uint32_t GlyphCount = 0;
+        float    Width      = 0.0f;    // up to the right edge of the last glyph
+    };
+
+    // the only place where text gets laid out, rendering and measuring both use it
+    // the position of the text is the baseline of the first line, further lines go down
+    struct TextLayout
+    {
+        std::vector<TextLayoutGlyph> Glyphs;
+        std::vector<TextLayoutLine>  Lines;
+        DXSM::Vector4                Bounds   = {};      // x == left; y == bottom; z == right; w == top, relative to the position
+        uint64_t                     PageMask = 0;       // bit n is set if a glyph of page n is used
+        bool                         Complete = true;    // false while some glyphs are still being generated
+
+        // lays out the utf-8 text, reuses the allocations of the layout
+        static void build( const Font& font, uint32_t font_size, std::string_view text, const TextLayoutOptions& options, TextLayout& layout );
+
+        // moves the given point of the bounds onto the position, RotationOrigin keeps the baseline of the first line
+        DXSM::Vector2 get_anchor_offset( Origin anchor ) const;
+    };
+}    // namespace InnoEngine
@@ -0,0 +1,96 @@
+#include "InnoEngine/iepch.h"
+#include "InnoEngine/graphics/TextLayoutCache.h"
+
+#include "InnoEngine/graphics/Font.h"
+#include "InnoEngine/utility/Hash.h"
+
+namespace InnoEngine
+{
+    TextLayoutCache::TextLayoutCache( size_t capacity ) :
+        m_Capacity( capacity )
+    {
+        IE_ASSERT( capacity > 0 );
+        m_Lookup.reserve( capacity );
+    }
+
+    const TextLayout& TextLayoutCache::get_layout( const Font& font, uint32_t font_size, std::string_view text, const TextLayoutOptions& options )
+    {
+        const Key key = { fnv1a( text ), font.get_id(), font_size, font.get_glyph_generation(), options };
+
+        auto it = m_Lookup.find( key );
+        if ( it != m_Lookup.end() && it->second->Text == text ) {
+            ++m_Hits;
+            m_Entries.splice( m_Entries.begin(), m_Entries, it->second );
+
+            // keeps the generated glyph pages of the layout from getting evicted
+            font.touch_glyph_pages( it->second->Layout.PageMask );
+            return it->second->Layout;
+        }
+
+        ++m_Misses;
+
+        if ( it != m_Lookup.end() ) {
+            // hash collision, the new text replaces the old one
+            m_Entries.erase( it->second );
+            m_Lookup.erase( it );
+        }
+
+        // reuse the least recently used entry, keeps the allocations of its glyph vector
+        if ( m_Entries.size() >= m_Capacity ) {
+            m_Lookup.erase( m_Entries.back().CacheKey );
+            m_Entries.splice( m_Entries.begin(), m_Entries, std::prev( m_Entries.end() ) );
+        }
+        else {
+            m_Entries.emplace_front();
+        }
+
+        Entry& entry   = m_Entries.front();
+        entry.CacheKey = key;
+        entry.Text.assign( text );
+        TextLayout::build( font, font_size, text, options, entry.Layout );
+
+        m_Lookup[ key ] = m_Entries.begin();
+        return entry.Layout;
+    }
+
+    void TextLayoutCache::clear()
+    {
+        m_Lookup.clear();
+        m_Entries.clear();
+    }
+
+    size_t TextLayoutCache::size() const
+    {
+        return m_Entries.size();
+    }
+
+    size_t TextLayoutCache::get_capacity() const
+    {
+        return m_Capacity;
+    }
+
+    uint64_t TextLayoutCache::get_hit_count() const
+    {
+        return m_Hits;
+    }
+
+    uint64_t TextLayoutCache::get_miss_count() const
+    {
+        return m_Misses;
+    }
+
+    void TextLayoutCache::reset_statistics()
+    {
+        m_Hits   = 0;
+        m_Misses = 0;
+    }
+
+    size_t TextLayoutCache::KeyHasher::operator()( const Key& key ) const
+    {
+        uint64_t hash = key.TextHash ^ ( static_cast<uint64_t>( key.FontID ) << 32 | key.FontSize ) * FNV1aPrime;
+        hash          = fnv1a_value( key.Options.MaxWidth, hash );
+        hash          = fnv1a_value( key.Options.LineSpacing, hash );
+        hash          = fnv1a_value( key.Options.Alignment, hash );
+        return static_cast<size_t>( hash );
+    }
+}    // namespace InnoEngine
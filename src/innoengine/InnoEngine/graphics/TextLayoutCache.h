@@ -0,0 +1,66 @@
+#pragma once
+#include "InnoEngine/BaseTypes.h"
+#include "InnoEngine/graphics/TextLayout.h"
+
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace InnoEngine
+{
+    // keeps laid out strings around, so unchanged text only gets copied into the upload buffer
+    // not thread safe, every thread that lays out text needs its own cache
+    class TextLayoutCache
+    {
+    public:
+        TextLayoutCache( size_t capacity = 1024 );
+
+        // lays out the utf-8 text on a miss, the reference stays valid until the next call
+        // layouts get outdated whenever the font generated or evicted glyphs
+        const TextLayout& get_layout( const Font& font, uint32_t font_size, std::string_view text, const TextLayoutOptions& options = {} );
+
+        void   clear();
+        size_t size() const;
+        size_t get_capacity() const;
+
+        // counted since the last call of reset_statistics
+        uint64_t get_hit_count() const;
+        uint64_t get_miss_count() const;
+        void     reset_statistics();
+
+    private:
+        struct Key
+        {
+            uint64_t          TextHash        = 0;
+            uint32_t          FontID          = 0;
+            uint32_t          FontSize        = 0;
+            uint32_t          GlyphGeneration = 0;
+            TextLayoutOptions Options         = {};
+
+            bool operator==( const Key& other ) const = default;
+        };
+
+        struct KeyHasher
+        {
+            size_t operator()( const Key& key ) const;
+        };
+
+        struct Entry
+        {
+            Key         CacheKey;
+            std::string Text;    // to rule out hash collisions
+            TextLayout  Layout;
+        };
+
+        using EntryList = std::list<Entry>;
+
+        size_t                                                  m_Capacity = 0;
+        EntryList                                               m_Entries;    // most recently used first
+        std::unordered_map<Key, EntryList::iterator, KeyHasher> m_Lookup;
+
+        uint64_t m_Hits   = 0;
+        uint64_t m_Misses = 0;
+    };
+}    // namespace InnoEngine
@@ -0,0 +1,74 @@
+#include "InnoEngine/graphics/Tilemap.h"
+#include <gtest/gtest.h>
+
+namespace InnoEngine
+{
+    namespace
+    {
+        Ref<Tilemap> create_tilemap( uint32_t width, uint32_t height )
+        {
+            TilemapSpecifications specs = {};
+            specs.Width                 = width;
+            specs.Height                = height;
+            return Tilemap::create( specs ).value();
+        }
+    }    // namespace
+
+    TEST( TilemapTest, chunkIndex )
+    {
+        constexpr uint32_t chunk_size = Tilemap::ChunkSize;
+
+        Ref<Tilemap> tilemap = create_tilemap( chunk_size * 2 + 6, chunk_size + 8 );
+
+        EXPECT_EQ( tilemap->get_chunk_count(), 6u );    // 3 x 2, partial chunks at the right and top edge
+
+        EXPECT_EQ( tilemap->get_chunk_index( 0, 0 ), 0u );
+        EXPECT_EQ( tilemap->get_chunk_index( chunk_size - 1, chunk_size - 1 ), 0u );
+        EXPECT_EQ( tilemap->get_chunk_index( chunk_size, 0 ), 1u );
+        EXPECT_EQ( tilemap->get_chunk_index( chunk_size * 2 + 5, 0 ), 2u );
+        EXPECT_EQ( tilemap->get_chunk_index( 0, chunk_size ), 3u );
+        EXPECT_EQ( tilemap->get_chunk_index( chunk_size * 2 + 5, chunk_size + 7 ), 5u );
+    }
+
+    TEST( TilemapTest, tiles )
+    {
+        constexpr uint32_t chunk_size = Tilemap::ChunkSize;
+
+        Ref<Tilemap> tilemap = create_tilemap( chunk_size * 2, chunk_size * 2 );
+        EXPECT_EQ( tilemap->get_tile( 5, 5 ), Tilemap::EmptyTile );
+
+        tilemap->set_tile( chunk_size - 1, chunk_size, 7 );
+        tilemap->set_tile( chunk_size, chunk_size - 1, 9 );
+
+        EXPECT_EQ( tilemap->get_tile( chunk_size - 1, chunk_size ), 7 );
+        EXPECT_EQ( tilemap->get_tile( chunk_size, chunk_size - 1 ), 9 );
+        EXPECT_EQ( tilemap->get_tile( chunk_size, chunk_size ), Tilemap::EmptyTile );
+
+        tilemap->fill( 3 );
+        EXPECT_EQ( tilemap->get_tile( chunk_size - 1, chunk_size ), 3 );
+    }
+
+    TEST( TilemapTest, chunkRevisions )
+    {
+        constexpr uint32_t chunk_size = Tilemap::ChunkSize;
+
+        Ref<Tilemap> tilemap = create_tilemap( chunk_size * 2, chunk_size );
+
+        const uint32_t left  = tilemap->get_chunk_revision( 0 );
+        const uint32_t right = tilemap->get_chunk_revision( 1 );
+
+        // only the edited chunk has to be uploaded again
+        tilemap->set_tile( 1, 1, 4 );
+        EXPECT_NE( tilemap->get_chunk_revision( 0 ), left );
+        EXPECT_EQ( tilemap->get_chunk_revision( 1 ), right );
+
+        // writing the same tile again is no edit
+        const uint32_t edited = tilemap->get_chunk_revision( 0 );
+        tilemap->set_tile( 1, 1, 4 );
+        EXPECT_EQ( tilemap->get_chunk_revision( 0 ), edited );
+
+        tilemap->fill( 2 );
+        EXPECT_NE( tilemap->get_chunk_revision( 0 ), edited );
+        EXPECT_NE( tilemap->get_chunk_revision( 1 ), right );
+    }
+}    // namespace InnoEngine
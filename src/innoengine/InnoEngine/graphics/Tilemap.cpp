@@ -0,0 +1,101 @@
+#include "InnoEngine/iepch.h"
+#include "InnoEngine/graphics/Tilemap.h"
+
+#include "InnoEngine/graphics/Texture2D.h"
+
+namespace InnoEngine
+{
+    std::atomic<uint32_t> Tilemap::ms_NextID = 1;
+
+    auto Tilemap::create( const TilemapSpecifications& specs ) -> std::optional<Ref<Tilemap>>
+    {
+        if ( specs.Width == 0 || specs.Height == 0 || specs.TilesetColumns == 0 || specs.TilesetRows == 0 ) {
+            IE_LOG_ERROR( "Creating tilemap failed: {}", "Invalid specifications" );
+            return std::nullopt;
+        }
+
+        Ref<Tilemap> tilemap    = Ref<Tilemap>( new Tilemap() );
+        tilemap->m_Specs        = specs;
+        tilemap->m_ChunkColumns = ( specs.Width + ChunkSize - 1 ) / ChunkSize;
+        tilemap->m_ChunkRows    = ( specs.Height + ChunkSize - 1 ) / ChunkSize;
+        tilemap->m_Chunks       = std::vector<Chunk>( tilemap->m_ChunkColumns * tilemap->m_ChunkRows );
+        tilemap->m_ID           = ms_NextID.fetch_add( 1, std::memory_order_relaxed );
+        tilemap->fill( EmptyTile );
+        return tilemap;
+    }
+
+    void Tilemap::set_tile( uint32_t x, uint32_t y, TileIndex tile )
+    {
+        IE_ASSERT( x < m_Specs.Width && y < m_Specs.Height );
+
+        Chunk&     chunk = get_chunk( x, y );
+        TileIndex& entry = chunk.Tiles[ ( y % ChunkSize ) * ChunkSize + x % ChunkSize ];
+        if ( entry != tile ) {
+            entry = tile;
+            ++chunk.Revision;
+        }
+    }
+
+    Tilemap::TileIndex Tilemap::get_tile( uint32_t x, uint32_t y ) const
+    {
+        IE_ASSERT( x < m_Specs.Width && y < m_Specs.Height );
+
+        const Chunk& chunk = m_Chunks[ get_chunk_index( x, y ) ];
+        return chunk.Tiles[ ( y % ChunkSize ) * ChunkSize + x % ChunkSize ];
+    }
+
+    void Tilemap::fill( TileIndex tile )
+    {
+        for ( Chunk& chunk : m_Chunks ) {
+            chunk.Tiles.fill( tile );
+            ++chunk.Revision;
+        }
+    }
+
+    void Tilemap::set_position( const DXSM::Vector2& position )
+    {
+        m_Position = position;
+    }
+
+    void Tilemap::set_color( const DXSM::Color& color )
+    {
+        m_Color = color;
+    }
+
+    const TilemapSpecifications& Tilemap::get_specs() const
+    {
+        return m_Specs;
+    }
+
+    const DXSM::Vector2& Tilemap::get_position() const
+    {
+        return m_Position;
+    }
+
+    uint32_t Tilemap::get_id() const
+    {
+        return m_ID;
+    }
+
+    uint32_t Tilemap::get_chunk_count() const
+    {
+        return static_cast<uint32_t>( m_Chunks.size() );
+    }
+
+    uint32_t Tilemap::get_chunk_index( uint32_t x, uint32_t y ) const
+    {
+        IE_ASSERT( x < m_Specs.Width && y < m_Specs.Height );
+        return ( y / ChunkSize ) * m_ChunkColumns + x / ChunkSize;
+    }
+
+    uint32_t Tilemap::get_chunk_revision( uint32_t chunk_index ) const
+    {
+        IE_ASSERT( chunk_index < m_Chunks.size() );
+        return m_Chunks[ chunk_index ].Revision;
+    }
+
+    Tilemap::Chunk& Tilemap::get_chunk( uint32_t x, uint32_t y )
+    {
+        return m_Chunks[ get_chunk_index( x, y ) ];
+    }
+}    // namespace InnoEngine
@@ -0,0 +1,79 @@
+#pragma once
+#include "InnoEngine/BaseTypes.h"
+
+#include <array>
+#include <atomic>
+#include <optional>
+#include <vector>
+
+namespace InnoEngine
+{
+    class Texture2D;
+
+    struct TilemapSpecifications
+    {
+        uint32_t       Width          = 0;    // in tiles
+        uint32_t       Height         = 0;    // in tiles
+        DXSM::Vector2  TileSize       = { 16.0f, 16.0f };    // in world units
+        Ref<Texture2D> Tileset        = nullptr;    // only needed to draw the map
+        DXSM::Vector4  TilesetRect    = { 0.0f, 0.0f, 1.0f, 1.0f };    // area of the tileset inside the texture, e.g. a sprite atlas region
+        uint32_t       TilesetColumns = 1;
+        uint32_t       TilesetRows    = 1;
+    };
+
+    // tile indices stored in fixed size chunks, the renderer keeps a gpu buffer per chunk
+    // and only uploads the chunks which changed since their last upload
+    // tile (0, 0) is the bottom left one, tiles of the tileset are counted row by row from the top left
+    class Tilemap
+    {
+        friend class RenderContext;
+        friend class Tilemap2DPipeline;
+
+        Tilemap() = default;
+
+    public:
+        using TileIndex = uint16_t;
+
+        static constexpr TileIndex EmptyTile = 0xFFFF;
+        static constexpr uint32_t  ChunkSize = 32;    // has to match TilemapChunk.vert.hlsl
+
+        static auto create( const TilemapSpecifications& specs ) -> std::optional<Ref<Tilemap>>;
+
+        void      set_tile( uint32_t x, uint32_t y, TileIndex tile );
+        TileIndex get_tile( uint32_t x, uint32_t y ) const;
+        void      fill( TileIndex tile );
+
+        void set_position( const DXSM::Vector2& position );    // bottom left corner of the map
+        void set_color( const DXSM::Color& color );
+
+        const TilemapSpecifications& get_specs() const;
+        const DXSM::Vector2&         get_position() const;
+        uint32_t                     get_id() const;
+
+        uint32_t get_chunk_count() const;
+        uint32_t get_chunk_index( uint32_t x, uint32_t y ) const;    // chunk holding tile (x, y), chunks are counted row by row from the bottom left
+        uint32_t get_chunk_revision( uint32_t chunk_index ) const;
+
+    private:
+        struct Chunk
+        {
+            std::array<TileIndex, ChunkSize * ChunkSize> Tiles;
+
+            uint32_t              Revision         = 1;    // bumped with every edit
+            std::atomic<uint32_t> UploadedRevision = 0;    // written by the render thread, 0 when there is no gpu copy
+        };
+
+        Chunk& get_chunk( uint32_t x, uint32_t y );
+
+    private:
+        TilemapSpecifications m_Specs        = {};
+        DXSM::Vector2         m_Position     = { 0.0f, 0.0f };
+        DXSM::Color           m_Color        = { 1.0f, 1.0f, 1.0f, 1.0f };
+        uint32_t              m_ChunkColumns = 0;
+        uint32_t              m_ChunkRows    = 0;
+        std::vector<Chunk>    m_Chunks;
+        uint32_t              m_ID           = 0;
+
+        static std::atomic<uint32_t> ms_NextID;
+    };
+}    // namespace InnoEngine
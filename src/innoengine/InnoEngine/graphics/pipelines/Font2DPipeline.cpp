@@ -8,11 +8,31 @@
 #include "InnoEngine/graphics/RenderCommandBuffer.h"
 
 #include "InnoEngine/graphics/Font.h"
-
 #include "InnoEngine/graphics/MSDFData.h"
+#include "InnoEngine/graphics/Texture2D.h"
 
 namespace InnoEngine
 {
+    namespace
+    {
+        auto make_effect_uniforms( const TextEffects& effects ) -> Font2DPipeline::EffectUniforms
+        {
+            Font2DPipeline::EffectUniforms uniforms = {};
+            if ( effects.is_enabled() == false )
+                return uniforms;
+
+            uniforms.OutlineColor   = effects.OutlineColor;
+            uniforms.ShadowColor    = effects.ShadowColor;
+            uniforms.GlowColor      = effects.GlowColor;
+            uniforms.ShadowOffset   = effects.ShadowOffset;
+            uniforms.OutlineWidth   = effects.OutlineColor.w > 0.0f ? std::max( effects.OutlineWidth, 0.0f ) : 0.0f;
+            uniforms.ShadowSoftness = std::max( effects.ShadowSoftness, 0.0f );
+            uniforms.GlowRadius     = effects.GlowColor.w > 0.0f ? std::max( effects.GlowRadius, 0.0f ) : 0.0f;
+            uniforms.Enabled        = 1;
+            return uniforms;
+        }
+    }    // namespace
+
     Font2DPipeline::~Font2DPipeline()
     {
         if ( m_Device != nullptr ) {
@@ -25,6 +45,17 @@ namespace InnoEngine
                 SDL_ReleaseGPUGraphicsPipeline( m_Device, m_Pipeline );
                 m_Pipeline = nullptr;
             }
+
+            if ( m_RunPipeline ) {
+                SDL_ReleaseGPUGraphicsPipeline( m_Device, m_RunPipeline );
+                m_RunPipeline = nullptr;
+            }
+
+            for ( GlyphTable& table : m_GlyphTables ) {
+                if ( table.Buffer )
+                    SDL_ReleaseGPUBuffer( m_Device, table.Buffer );
+            }
+            m_GlyphTables.clear();
         }
     }
 
@@ -50,12 +81,19 @@ namespace InnoEngine
             return Result::InitializationError;
         }
 
+        if ( IE_FAILED( vertexShaderAsset.value().get()->require_uniform_buffers( 1 ) ) )
+            return Result::InitializationError;
+
         auto fragmentShaderAsset = shaderRepo->require_asset( "MSDFText2D.frag" );
         if ( fragmentShaderAsset.has_value() == false ) {
             IE_LOG_ERROR( "Fragment Shader not found!" );
             return Result::InitializationError;
         }
 
+        // the effects are pushed as fragment uniforms
+        if ( IE_FAILED( fragmentShaderAsset.value().get()->require_uniform_buffers( 1 ) ) )
+            return Result::InitializationError;
+
         AssetView<Shader>& vertexShader   = vertexShaderAsset.value();
         AssetView<Shader>& fragmentShader = fragmentShaderAsset.value();
 
@@ -108,6 +146,8 @@ namespace InnoEngine
 
         m_GPUBatch = GPUBatchStorageBuffer<StructuredBufferLayout, BatchData>::create( m_Device, MaxBatchSize );
 
+        RETURN_RESULT_IF_FAILED( load_run_pipeline( window, shaderRepo.get() ) );
+
         m_Initialized = true;
         return Result::Success;
     }
@@ -132,39 +172,146 @@ namespace InnoEngine
         return prepare_batches( font_list, string_buffer );
     }
 
-    uint32_t Font2DPipeline::swapchain_render( const RenderContextFrameData& render_ctx_data, const FontList& font_list, SDL_GPURenderPass* render_pass )
+    uint32_t Font2DPipeline::swapchain_render( const RenderContextFrameData& render_ctx_data,
+                                               const FontList&               font_list,
+                                               SDL_GPUCommandBuffer*         gpu_cmd_buf,
+                                               SDL_GPURenderPass*            render_pass )
     {
         IE_ASSERT( m_Device != nullptr );
         IE_ASSERT( render_pass != nullptr );
 
-        SDL_BindGPUGraphicsPipeline( render_pass, m_Pipeline );
+        const auto& batches      = m_GPUBatch->get_batchlist();
+        const auto& run_batches  = m_RunGPUBatch->get_batchlist();
+        const auto& text_batches = m_TextHeaderGPUBatch->get_batchlist();
+
+        // a failed upload drops a batch, the others would not match anymore
+        size_t run_count = run_batches.size();
+        if ( run_count != text_batches.size() ) {
+            IE_LOG_WARNING( "Glyph run batches out of sync, skipping text runs this frame" );
+            run_count = 0;
+        }
+
         SDL_BindGPUVertexBuffers( render_pass, 0, nullptr, 0 );
         SDL_SetGPUViewport( render_pass, &render_ctx_data.Viewport );
 
-        RenderCommandBufferIndexType current_font = InvalidRenderCommandBufferIndex;
+        SDL_GPUGraphicsPipeline* current_pipeline = nullptr;
+        SDL_GPUTexture*          current_texture  = nullptr;
+        uint32_t                 current_effect   = InvalidEffectIndex;
 
+        // both lists follow the sorted commands, merged by their sort key they draw in that order
         uint32_t draw_calls = 0;
-        for ( const auto& batch_data : m_GPUBatch->get_batchlist() ) {
-            if ( batch_data.CustomData.FontFBIndex != current_font ) {
+        size_t   record     = 0;
+        size_t   run        = 0;
+        while ( record < batches.size() || run < run_count ) {
+            const bool is_run = run < run_count && ( record == batches.size() || run_batches[ run ].CustomData.SortKey < batches[ record ].CustomData.SortKey );
+
+            SDL_GPUGraphicsPipeline* pipeline = is_run ? m_RunPipeline : m_Pipeline;
+            if ( pipeline != current_pipeline ) {
+                SDL_BindGPUGraphicsPipeline( render_pass, pipeline );
+                current_pipeline = pipeline;
+                current_texture  = nullptr;
+                current_effect   = InvalidEffectIndex;
+            }
+
+            const Font&     font         = is_run ? *font_list[ run_batches[ run ].CustomData.FontFBIndex ] : *font_list[ batches[ record ].CustomData.FontFBIndex ];
+            const uint32_t  effect_index = is_run ? run_batches[ run ].CustomData.EffectIndex : batches[ record ].CustomData.EffectIndex;
+            SDL_GPUTexture* texture      = is_run ? font.get_atlas_texture()->get_sdltexture() : font.get_page_texture( batches[ record ].CustomData.Page )->get_sdltexture();
+            if ( texture != current_texture ) {
                 SDL_GPUTextureSamplerBinding texture_sampler_binding = {};
                 texture_sampler_binding.sampler                      = m_FontSampler;
-                texture_sampler_binding.texture                      = font_list[ batch_data.CustomData.FontFBIndex ]->get_atlas_texture()->get_sdltexture();
+                texture_sampler_binding.texture                      = texture;
                 SDL_BindGPUFragmentSamplers( render_pass, 0, &texture_sampler_binding, 1 );
-                current_font = batch_data.CustomData.FontFBIndex;
+                current_texture = texture;
+            }
+
+            const TextEffects& effects = m_Effects[ effect_index ];
+            if ( effect_index != current_effect ) {
+                EffectUniforms effect_uniforms = make_effect_uniforms( effects );
+                SDL_PushGPUFragmentUniformData( gpu_cmd_buf, 0, &effect_uniforms, sizeof( effect_uniforms ) );
+                current_effect = effect_index;
             }
 
-            SDL_BindGPUVertexStorageBuffers( render_pass, 1, &batch_data.GPUBuffer, 1 );
-            SDL_DrawGPUPrimitives( render_pass, batch_data.Count * 6, 1, 0, 0 );
+            if ( is_run ) {
+                const auto& runs = run_batches[ run ];
+
+                SDL_GPUBuffer* buffers[ 3 ] = { runs.GPUBuffer, text_batches[ run ].GPUBuffer, runs.CustomData.GlyphTable };
+                SDL_BindGPUVertexStorageBuffers( render_pass, 1, buffers, 3 );
+
+                RunUniforms uniforms = { effects.ShadowOffset, text_batches[ run ].Offset, runs.Offset };
+                SDL_PushGPUVertexUniformData( gpu_cmd_buf, 0, &uniforms, sizeof( uniforms ) );
+
+                SDL_DrawGPUPrimitives( render_pass, runs.Count * 6, 1, 0, 0 );
+                ++run;
+            }
+            else {
+                const auto& batch_data = batches[ record ];
+
+                BatchUniforms batch_uniforms = { effects.ShadowOffset, batch_data.Offset };
+                SDL_PushGPUVertexUniformData( gpu_cmd_buf, 0, &batch_uniforms, sizeof( batch_uniforms ) );
+
+                SDL_BindGPUVertexStorageBuffers( render_pass, 1, &batch_data.GPUBuffer, 1 );
+                SDL_DrawGPUPrimitives( render_pass, batch_data.Count * 6, 1, 0, 0 );
+                ++record;
+            }
             ++draw_calls;
         }
 
         m_GPUBatch->clear();
+        m_RunGPUBatch->clear();
+        m_TextHeaderGPUBatch->clear();
+
         return draw_calls;
     }
 
+    void Font2DPipeline::end_frame()
+    {
+        m_GPUBatch->end_frame();
+        m_RunGPUBatch->end_frame();
+        m_TextHeaderGPUBatch->end_frame();
+
+        // fonts never reuse their id, tables of unloaded fonts just run idle
+        for ( auto it = m_GlyphTables.begin(); it != m_GlyphTables.end(); ) {
+            if ( ++it->UnusedFrames < GlyphTableTrimFrames ) {
+                ++it;
+                continue;
+            }
+
+            if ( it->Buffer )
+                SDL_ReleaseGPUBuffer( m_Device, it->Buffer );
+            it = m_GlyphTables.erase( it );
+        }
+
+        m_LayoutCache.reset_statistics();
+        ++m_Frame;
+    }
+
+    size_t Font2DPipeline::get_gpu_buffer_bytes() const
+    {
+        size_t bytes = m_GPUBatch->get_allocated_bytes() + m_RunGPUBatch->get_allocated_bytes() + m_TextHeaderGPUBatch->get_allocated_bytes();
+
+        for ( const GlyphTable& table : m_GlyphTables )
+            bytes += table.GlyphCount * sizeof( GlyphMetricsLayout );
+        return bytes;
+    }
+
+    size_t Font2DPipeline::get_gpu_buffer_peak_bytes() const
+    {
+        return m_GPUBatch->get_peak_bytes() + m_RunGPUBatch->get_peak_bytes() + m_TextHeaderGPUBatch->get_peak_bytes();
+    }
+
+    const TextLayoutCache& Font2DPipeline::get_layout_cache() const
+    {
+        return m_LayoutCache;
+    }
+
     uint32_t Font2DPipeline::prepare_batches( const FontList& font_list, const StringArena& string_buffer )
     {
         m_GPUBatch->clear();
+        m_RunGPUBatch->clear();
+        m_TextHeaderGPUBatch->clear();
+
+        m_Effects.clear();
+        m_Effects.emplace_back();
 
         SDL_GPUCommandBuffer* gpu_copy_cmd_buf = SDL_AcquireGPUCommandBuffer( m_Device );
         if ( gpu_copy_cmd_buf == nullptr ) {
@@ -174,114 +321,101 @@ namespace InnoEngine
 
         SDL_GPUCopyPass* copy_pass = SDL_BeginGPUCopyPass( gpu_copy_cmd_buf );
 
-        // current font data
-        Ref<Font>                       font                = nullptr;
-        Ref<MSDFData>                   msdf_data           = nullptr;
-        float                           texel_width         = 0.0f;
-        float                           texel_height        = 0.0f;
-        double                          space_glyph_advance = 0.0f;
-        double                          scale               = 0.0f;
-        const msdf_atlas::FontGeometry* font_geometry       = nullptr;
-        const msdfgen::FontMetrics*     metrics             = nullptr;
+        // glyphs generated in the background since the last frame, before anything gets laid out
+        for ( const Ref<Font>& font : font_list )
+            font->upload_glyphs( copy_pass, m_Frame );
 
         // each command represents one string
-        BatchData* current = nullptr;
+        // a batch only takes glyphs while no other batch was opened after it, so the sort keys keep the command order
+        BatchData*    current     = nullptr;
+        RunBatchData* current_run = nullptr;
+        uint32_t      sort_key    = 0;
         for ( const Command* command : m_SortedCommands ) {
 
-            // check if have to switch to a new batch
-            // reasons might be: change in texture, batch is full
-            if ( m_GPUBatch->current_batch_full() ||
-                 current == nullptr ||
-                 current->ContextIndex != command->ContextIndex ||
-                 current->FontFBIndex != command->FontFBIndex ||
-                 m_GPUBatch->get_current_batch_remaining_size() < command->StringLength ) {
-
-                current               = m_GPUBatch->upload_and_add_batch( copy_pass );
-                current->ContextIndex = command->ContextIndex;
-                current->FontFBIndex  = command->FontFBIndex;
-
-                // font change?
-                font          = font_list[ command->FontFBIndex ];
-                msdf_data     = font->get_msdf_data();
-                font_geometry = &msdf_data->FontGeo;
-                metrics       = &font_geometry->getMetrics();
-
-                texel_width  = 1.0f / font->get_atlas_texture()->get_specs().Width;
-                texel_height = 1.0f / font->get_atlas_texture()->get_specs().Width;
-
-                space_glyph_advance = msdf_data->get_glyph( ' ' )->getAdvance();
-                scale               = 1.0 / ( metrics->ascenderY - metrics->descenderY ) * command->FontSize;
-            }
-
-            double x = static_cast<double>( command->Position.x );
-            double y = static_cast<double>( command->Position.y );
-
-            // now retrieve the string back and iterate it
-            const char* text = string_buffer.get_string( command->StringIndex );
-
-            for ( uint32_t i = 0; i < command->StringLength; ++i ) {
-                char character = text[ i ];
+            // text of fonts which are still generating their atlas is skipped
+            const Font& font = *font_list[ command->FontFBIndex ];
+            if ( font.is_ready() == false )
+                continue;
+
+            // now retrieve the string back, unchanged text is already laid out
+            std::string_view  text   = { string_buffer.get_string( command->StringIndex ), command->StringLength };
+            const TextLayout& layout = m_LayoutCache.get_layout( font, command->FontSize, text, command->Options );
+
+            // anchored text is placed by the bounds of its layout, so it never needs to be measured up front
+            const DXSM::Vector2 position     = command->Position + layout.get_anchor_offset( command->Anchor );
+            const uint32_t      effect_index = add_effects( command->Effects );
+
+            const GlyphTable* glyph_table = require_glyph_table( font, copy_pass );
+            uint32_t          text_index  = InvalidTextIndex;    // inside the current text batch, written with the first baked glyph
+
+            for ( const TextLayoutGlyph& glyph : layout.Glyphs ) {
+
+                // baked glyphs only send their index, the shader builds the quad from the glyph table
+                if ( glyph_table != nullptr && glyph.GlyphIndex < glyph_table->GlyphCount ) {
+                    if ( m_RunGPUBatch->current_batch_full() ||
+                         m_TextHeaderGPUBatch->current_batch_full() ||
+                         current_run == nullptr ||
+                         current_run->SortKey + 1 != sort_key ||
+                         current_run->FontFBIndex != command->FontFBIndex ||
+                         current_run->EffectIndex != effect_index ) {
+
+                        current_run              = m_RunGPUBatch->upload_and_add_batch( copy_pass );
+                        current_run->FontFBIndex = command->FontFBIndex;
+                        current_run->GlyphTable  = glyph_table->Buffer;
+                        current_run->EffectIndex = effect_index;
+                        current_run->SortKey     = sort_key++;
+                        m_TextHeaderGPUBatch->upload_and_add_batch( copy_pass );
+                        text_index = InvalidTextIndex;
+                    }
 
-                IE_ASSERT( character != '\0' );
+                    if ( text_index == InvalidTextIndex ) {
+                        text_index = static_cast<uint32_t>( MaxBatchTextCount - m_TextHeaderGPUBatch->get_current_batch_remaining_size() );
 
-                if ( character == '\n' ) {
-                    x = command->Position.x;
-                    y += scale * metrics->lineHeight;
-                    continue;
-                }
-
-                if ( character == ' ' ) {
-                    double advance = space_glyph_advance;
-                    if ( i < command->StringLength - 1 ) {
-                        char nextCharacter = text[ i + 1 ];
-                        msdf_data->get_advance( advance, character, nextCharacter );
+                        TextHeaderLayout* header = m_TextHeaderGPUBatch->next_data();
+                        header->Position         = position;
+                        header->Scale            = glyph_table->EmScale * command->FontSize;
+                        header->Depth            = command->Depth;
+                        header->ForegroundColor  = command->ForegroundColor;
+                        header->ContextIndex     = command->ContextIndex;
                     }
 
-                    x += scale * advance;
+                    GlyphRunLayout* run_data = m_RunGPUBatch->next_data();
+                    run_data->Pen            = glyph.Pen;
+                    run_data->GlyphIndex     = glyph.GlyphIndex;
+                    run_data->TextIndex      = text_index;
                     continue;
                 }
 
-                if ( character == '\t' ) {
-                    x += 4.0 * ( scale * space_glyph_advance );
-                    continue;
+                // check if have to switch to a new batch
+                // reasons might be: change in texture, batch is full
+                if ( m_GPUBatch->current_batch_full() ||
+                     current == nullptr ||
+                     current->SortKey + 1 != sort_key ||
+                     current->ContextIndex != command->ContextIndex ||
+                     current->FontFBIndex != command->FontFBIndex ||
+                     current->Page != glyph.Page ||
+                     current->EffectIndex != effect_index ) {
+
+                    current               = m_GPUBatch->upload_and_add_batch( copy_pass );
+                    current->ContextIndex = command->ContextIndex;
+                    current->FontFBIndex  = command->FontFBIndex;
+                    current->Page         = glyph.Page;
+                    current->EffectIndex  = effect_index;
+                    current->SortKey      = sort_key++;
                 }
 
-                const msdf_atlas::GlyphGeometry* glyph = msdf_data->get_glyph( character );
-                if ( !glyph )
-                    glyph = msdf_data->get_glyph( '?' );
-                if ( !glyph )
-                    continue;
-
                 StructuredBufferLayout* buffer_data = m_GPUBatch->next_data();
-                // remember that the atlas y grows in bottom-up and our renderer expects it to grow top-down
-                double                  al, ab, ar, at;
-                glyph->getQuadAtlasBounds( al, ab, ar, at );
-                buffer_data->SourceRect.x = static_cast<float>( al * texel_width );
-                buffer_data->SourceRect.y = static_cast<float>( at * texel_height );
-                buffer_data->SourceRect.z = static_cast<float>( ar * texel_width );
-                buffer_data->SourceRect.w = static_cast<float>( ab * texel_height );
-
-                double pl, pb, pr, pt;
-                glyph->getQuadPlaneBounds( pl, pb, pr, pt );
-                buffer_data->Position.x = static_cast<float>( x + pl * scale );
-                buffer_data->Position.y = static_cast<float>( y + ( pt * scale ) );
-                buffer_data->Size.x     = static_cast<float>( ( pr - pl ) * scale );
-                buffer_data->Size.y     = static_cast<float>( ( ( pb - pt ) * scale ));
-
-                buffer_data->ForegroundColor = command->ForegroundColor;
-                buffer_data->Depth           = command->Depth;
-                buffer_data->ContextIndex    = command->ContextIndex;
-
-                if ( i < command->StringLength - 1 ) {
-                    double advance       = glyph->getAdvance();
-                    char   nextCharacter = text[ i + 1 ];
-                    msdf_data->get_advance( advance, character, nextCharacter );
-                    // fontGeometry->getAdvance(advance, character, nextCharacter);
-                    x += scale * advance;
-                }
+                buffer_data->Position               = position + glyph.Offset;
+                buffer_data->Size                   = glyph.Size;
+                buffer_data->SourceRect             = glyph.SourceRect;
+                buffer_data->ForegroundColor        = command->ForegroundColor;
+                buffer_data->Depth                  = command->Depth;
+                buffer_data->ContextIndex           = command->ContextIndex;
             }
         }
         m_GPUBatch->upload_last( copy_pass );
+        m_RunGPUBatch->upload_last( copy_pass );
+        m_TextHeaderGPUBatch->upload_last( copy_pass );
 
         SDL_EndGPUCopyPass( copy_pass );
 
@@ -290,7 +424,23 @@ namespace InnoEngine
             return 0;
         }
 
-        return static_cast<uint32_t>(m_GPUBatch->size());
+        return static_cast<uint32_t>( m_GPUBatch->size() + m_RunGPUBatch->size() );
+    }
+
+    uint32_t Font2DPipeline::add_effects( const TextEffects& effects )
+    {
+        if ( effects.is_enabled() == false )
+            return 0;
+
+        // the offset grows the glyph quads, only worth it with a visible shadow
+        TextEffects used_effects = effects;
+        if ( used_effects.ShadowColor.w <= 0.0f )
+            used_effects.ShadowOffset = DXSM::Vector2::Zero;
+
+        // equal effects usually come in a row, those share their batches
+        if ( m_Effects.back() != used_effects )
+            m_Effects.push_back( used_effects );
+        return static_cast<uint32_t>( m_Effects.size() - 1 );
     }
 
     void Font2DPipeline::sort_commands( const CommandList& command_list, bool opaque )
@@ -321,4 +471,139 @@ namespace InnoEngine
 
         std::sort( m_SortedCommands.begin(), m_SortedCommands.end(), command_sort );
     }
+
+    Result Font2DPipeline::load_run_pipeline( SDL_Window* sdl_window, AssetRepository<Shader>* shader_repo )
+    {
+        // load shaders
+        auto vertexShaderAsset = shader_repo->require_asset( "MSDFText2DRun.vert" );
+        if ( vertexShaderAsset.has_value() == false ) {
+            IE_LOG_ERROR( "Vertex Shader not found: {}", "MSDFText2DRun.vert" );
+            return Result::InitializationError;
+        }
+
+        if ( IE_FAILED( vertexShaderAsset.value().get()->require_uniform_buffers( 1 ) ) )
+            return Result::InitializationError;
+
+        auto fragmentShaderAsset = shader_repo->require_asset( "MSDFText2D.frag" );
+        if ( fragmentShaderAsset.has_value() == false ) {
+            IE_LOG_ERROR( "Fragment Shader not found: {}", "MSDFText2D.frag" );
+            return Result::InitializationError;
+        }
+
+        AssetView<Shader>& vertexShader   = vertexShaderAsset.value();
+        AssetView<Shader>& fragmentShader = fragmentShaderAsset.value();
+
+        // Create the pipeline
+        SDL_GPUColorTargetDescription colorTargets[ 1 ]     = {};
+        colorTargets[ 0 ].format                            = SDL_GetGPUSwapchainTextureFormat( m_Device, sdl_window );
+        colorTargets[ 0 ].blend_state.src_color_blendfactor = SDL_GPU_BLENDFACTOR_SRC_ALPHA;
+        colorTargets[ 0 ].blend_state.dst_color_blendfactor = SDL_GPU_BLENDFACTOR_ONE_MINUS_SRC_ALPHA;
+        colorTargets[ 0 ].blend_state.color_blend_op        = SDL_GPU_BLENDOP_ADD;
+        colorTargets[ 0 ].blend_state.src_alpha_blendfactor = SDL_GPU_BLENDFACTOR_SRC_ALPHA;
+        colorTargets[ 0 ].blend_state.dst_alpha_blendfactor = SDL_GPU_BLENDFACTOR_ONE_MINUS_SRC_ALPHA;
+        colorTargets[ 0 ].blend_state.alpha_blend_op        = SDL_GPU_BLENDOP_ADD;
+        colorTargets[ 0 ].blend_state.enable_blend          = true;
+
+        SDL_GPUGraphicsPipelineCreateInfo pipelineCreateInfo     = {};
+        pipelineCreateInfo.vertex_shader                         = vertexShader.get()->get_sdlshader();
+        pipelineCreateInfo.fragment_shader                       = fragmentShader.get()->get_sdlshader();
+        pipelineCreateInfo.primitive_type                        = SDL_GPU_PRIMITIVETYPE_TRIANGLELIST;
+        pipelineCreateInfo.target_info.color_target_descriptions = colorTargets;
+        pipelineCreateInfo.target_info.num_color_targets         = 1;
+
+        pipelineCreateInfo.target_info.depth_stencil_format     = SDL_GPU_TEXTUREFORMAT_D16_UNORM;
+        pipelineCreateInfo.target_info.has_depth_stencil_target = true;
+
+        pipelineCreateInfo.depth_stencil_state.compare_op          = SDL_GPU_COMPAREOP_GREATER_OR_EQUAL;
+        pipelineCreateInfo.depth_stencil_state.enable_depth_test   = true;
+        pipelineCreateInfo.depth_stencil_state.enable_depth_write  = true;
+        pipelineCreateInfo.depth_stencil_state.enable_stencil_test = false;
+        pipelineCreateInfo.depth_stencil_state.write_mask          = 0xFF;
+
+        m_RunPipeline = SDL_CreateGPUGraphicsPipeline( m_Device, &pipelineCreateInfo );
+        if ( m_RunPipeline == nullptr ) {
+            IE_LOG_ERROR( "Failed to create pipeline!" );
+            return Result::InitializationError;
+        }
+
+        m_RunGPUBatch        = GPUBatchStorageBuffer<GlyphRunLayout, RunBatchData>::create( m_Device, MaxBatchSize );
+        m_TextHeaderGPUBatch = GPUBatchStorageBuffer<TextHeaderLayout, RunBatchData>::create( m_Device, MaxBatchTextCount );
+        if ( m_RunGPUBatch == nullptr || m_TextHeaderGPUBatch == nullptr ) {
+            SDL_ReleaseGPUGraphicsPipeline( m_Device, m_RunPipeline );
+            m_RunPipeline = nullptr;
+            return Result::InitializationError;
+        }
+
+        return Result::Success;
+    }
+
+    auto Font2DPipeline::require_glyph_table( const Font& font, SDL_GPUCopyPass* copy_pass ) -> const GlyphTable*
+    {
+        for ( GlyphTable& table : m_GlyphTables ) {
+            if ( table.FontID == font.get_id() ) {
+                table.UnusedFrames = 0;
+                return &table;
+            }
+        }
+
+        // a failed upload is remembered as an empty table, so it is not tried again every frame
+        GlyphTable& table = m_GlyphTables.emplace_back();
+        table.FontID      = font.get_id();
+
+        const Ref<MSDFData> msdf_data = font.get_msdf_data();
+        if ( msdf_data == nullptr || msdf_data->Glyphs.empty() )
+            return &table;
+
+        const MSDFMetrics& metrics = msdf_data->Metrics;
+        table.EmScale              = 1.0f / ( metrics.AscenderY - metrics.DescenderY );
+
+        const uint32_t glyph_count = static_cast<uint32_t>( msdf_data->Glyphs.size() );
+        const uint32_t table_bytes = static_cast<uint32_t>( glyph_count * sizeof( GlyphMetricsLayout ) );
+
+        SDL_GPUTransferBufferCreateInfo transfer_info = {};
+        transfer_info.usage                           = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
+        transfer_info.size                            = table_bytes;
+
+        SDL_GPUTransferBuffer* transfer_buffer = SDL_CreateGPUTransferBuffer( m_Device, &transfer_info );
+        GlyphMetricsLayout*    transfer_data   = transfer_buffer ? static_cast<GlyphMetricsLayout*>( SDL_MapGPUTransferBuffer( m_Device, transfer_buffer, false ) ) : nullptr;
+        if ( transfer_data == nullptr ) {
+            IE_LOG_ERROR( "Failed to map glyph table transfer buffer: {}", SDL_GetError() );
+            if ( transfer_buffer )
+                SDL_ReleaseGPUTransferBuffer( m_Device, transfer_buffer );
+            return &table;
+        }
+
+        // same source rects as TextLayout::build produces for the baked page
+        const TextureSpecifications& atlas_specs  = font.get_atlas_texture()->get_specs();
+        const float                  texel_width  = 1.0f / atlas_specs.Width;
+        const float                  texel_height = 1.0f / atlas_specs.Height;
+        for ( uint32_t i = 0; i < glyph_count; ++i ) {
+            const MSDFGlyph& glyph = msdf_data->Glyphs[ i ];
+            transfer_data[ i ]     = { glyph.PlaneBounds,
+                                       DXSM::Vector4( glyph.AtlasBounds.x * texel_width,
+                                                      glyph.AtlasBounds.w * texel_height,
+                                                      glyph.AtlasBounds.z * texel_width,
+                                                      glyph.AtlasBounds.y * texel_height ) };
+        }
+        SDL_UnmapGPUTransferBuffer( m_Device, transfer_buffer );
+
+        SDL_GPUBufferCreateInfo buffer_info = {};
+        buffer_info.usage                   = SDL_GPU_BUFFERUSAGE_GRAPHICS_STORAGE_READ;
+        buffer_info.size                    = table_bytes;
+
+        table.Buffer = SDL_CreateGPUBuffer( m_Device, &buffer_info );
+        if ( table.Buffer == nullptr ) {
+            IE_LOG_ERROR( "SDL_CreateGPUBuffer failed : {0}", SDL_GetError() );
+            SDL_ReleaseGPUTransferBuffer( m_Device, transfer_buffer );
+            return &table;
+        }
+
+        SDL_GPUTransferBufferLocation transfer_location { .transfer_buffer = transfer_buffer, .offset = 0 };
+        SDL_GPUBufferRegion           buffer_region { .buffer = table.Buffer, .offset = 0, .size = table_bytes };
+        SDL_UploadToGPUBuffer( copy_pass, &transfer_location, &buffer_region, false );
+        SDL_ReleaseGPUTransferBuffer( m_Device, transfer_buffer );    // released once the copy pass is done
+
+        table.GlyphCount = glyph_count;
+        return &table;
+    }
 }    // namespace InnoEngine
@@ -5,6 +5,8 @@
 #include "InnoEngine/graphics/GPUDeviceRef.h"
 
 #include "InnoEngine/graphics/Font.h"
+#include "InnoEngine/graphics/TextLayoutCache.h"
+#include "InnoEngine/graphics/TextEffects.h"
 #include "InnoEngine/utility/StringArena.h"
 #include "InnoEngine/graphics/GPUBatchBuffer.h"
 #include "InnoEngine/graphics/RenderContext.h"
@@ -14,6 +16,7 @@ namespace InnoEngine
 {
     class AssetManager;
     class GPURenderer;
+    class Shader;
 
     class Font2DPipeline
     {
@@ -22,6 +25,9 @@ namespace InnoEngine
         {
             RenderCommandBufferIndexType FontFBIndex  = InvalidRenderCommandBufferIndex;
             RenderCommandBufferIndexType ContextIndex = InvalidRenderCommandBufferIndex;
+            uint32_t                     Page         = 0;    // atlas page of the font, see MSDFGlyph::Page
+            uint32_t                     EffectIndex  = 0;    // into the effects of the frame
+            uint32_t                     SortKey      = 0;    // draw order among record and run batches
         };
 
         struct Command : RenderCommandBase
@@ -32,6 +38,9 @@ namespace InnoEngine
             uint32_t                     FontSize        = 0;
             DXSM::Vector2                Position        = {};
             DXSM::Color                  ForegroundColor = {};
+            TextLayoutOptions            Options         = {};
+            Origin                       Anchor          = Origin::RotationOrigin;    // RotationOrigin keeps the position at the baseline
+            TextEffects                  Effects         = {};
         };
 
         struct StructuredBufferLayout
@@ -45,6 +54,53 @@ namespace InnoEngine
             float         pad[ 2 ];
         };
 
+        // the glyph run path: every baked glyph of a font is uploaded once, strings only send their glyph indices
+        // the layouts have to match MSDFText2DRun.vert.hlsl
+        struct GlyphMetricsLayout
+        {
+            DXSM::Vector4 PlaneBounds = {};    // left, bottom, right, top in em
+            DXSM::Vector4 SourceRect  = {};    // uv rect inside the baked atlas, top-down
+        };
+
+        struct GlyphRunLayout
+        {
+            DXSM::Vector2 Pen        = {};    // relative to the position of the text
+            uint32_t      GlyphIndex = 0;
+            uint32_t      TextIndex  = 0;     // inside the text batch
+        };
+
+        struct TextHeaderLayout
+        {
+            DXSM::Vector2 Position        = {};
+            float         Scale           = 0.0f;    // em to pixels
+            float         Depth           = 0.0f;
+            DXSM::Color   ForegroundColor = {};
+            uint32_t      ContextIndex    = InvalidRenderCommandBufferIndex;
+            float         pad[ 3 ];
+        };
+
+        struct RunBatchData
+        {
+            RenderCommandBufferIndexType FontFBIndex = InvalidRenderCommandBufferIndex;
+            SDL_GPUBuffer*               GlyphTable  = nullptr;
+            uint32_t                     EffectIndex = 0;
+            uint32_t                     SortKey     = 0;    // draw order among record and run batches
+        };
+
+        // pushed per batch, has to match the cbuffer of MSDFText2D.frag.hlsl
+        struct EffectUniforms
+        {
+            DXSM::Color   OutlineColor   = {};
+            DXSM::Color   ShadowColor    = {};
+            DXSM::Color   GlowColor      = {};
+            DXSM::Vector2 ShadowOffset   = {};
+            float         OutlineWidth   = 0.0f;
+            float         ShadowSoftness = 0.0f;
+            float         GlowRadius     = 0.0f;
+            uint32_t      Enabled        = 0;
+            float         pad[ 2 ];
+        };
+
         using CommandList = std::vector<Command>;
 
     public:
@@ -56,11 +112,47 @@ namespace InnoEngine
         uint32_t prepare_render( const CommandList& command_list, const FontList& texture_list, const StringArena& string_buffer );
         uint32_t swapchain_render( const RenderContextFrameData& render_ctx_data,
                                    const FontList&               texture_list,
+                                   SDL_GPUCommandBuffer*         gpu_cmd_buf,
                                    SDL_GPURenderPass*            render_pass );
 
+        void   end_frame();    // trims gpu buffers which were not needed for a while
+        size_t get_gpu_buffer_bytes() const;
+        size_t get_gpu_buffer_peak_bytes() const;
+
+        const TextLayoutCache& get_layout_cache() const;
+
     private:
         uint32_t prepare_batches( const FontList& font_list, const StringArena& string_buffer );
         void     sort_commands( const CommandList& command_list, bool opaque );
+        uint32_t add_effects( const TextEffects& effects );
+
+        // per font, released once the font was not drawn for a while
+        struct GlyphTable
+        {
+            uint32_t       FontID       = 0;
+            SDL_GPUBuffer* Buffer       = nullptr;
+            uint32_t       GlyphCount   = 0;       // 0 if the upload failed, the font then takes the fallback path
+            float          EmScale      = 0.0f;    // times the font size gives the scale of the text
+            uint32_t       UnusedFrames = 0;
+        };
+
+        // the vertex shaders grow the glyph quads by the shadow offset
+        struct BatchUniforms
+        {
+            DXSM::Vector2 ShadowOffset;
+            uint32_t      BatchOffset;    // first glyph of the batch in the shared page
+            uint32_t      pad;
+        };
+
+        struct RunUniforms
+        {
+            DXSM::Vector2 ShadowOffset;
+            uint32_t      TextOffset;    // first text header of the batch in the shared page
+            uint32_t      RunOffset;     // first glyph of the batch in the shared page
+        };
+
+        Result            load_run_pipeline( SDL_Window* sdl_window, AssetRepository<Shader>* shader_repo );
+        const GlyphTable* require_glyph_table( const Font& font, SDL_GPUCopyPass* copy_pass );
 
     private:
         bool                     m_Initialized = false;
@@ -69,9 +161,22 @@ namespace InnoEngine
         SDL_GPUSampler*          m_FontSampler = nullptr;
 
         std::vector<const Command*> m_SortedCommands;    // objects owned by the RenderCommandBuffer
+        TextLayoutCache             m_LayoutCache;
+        uint64_t                    m_Frame = 1;    // drives the page eviction of generated glyphs
+        std::vector<TextEffects>    m_Effects;      // of the prepared batches, 0 is always without effects
 
-        static constexpr uint32_t                                     MaxBatchSize = 20000;
+        static constexpr uint32_t                                     MaxBatchSize       = 20000;
+        static constexpr uint32_t                                     InvalidEffectIndex = std::numeric_limits<uint32_t>::max();
         Ref<GPUBatchStorageBuffer<StructuredBufferLayout, BatchData>> m_GPUBatch;
+
+        // baked glyphs of fonts with a glyph table, generated glyphs always go through m_GPUBatch as their pages change at runtime
+        static constexpr uint32_t                                  MaxBatchTextCount    = 4096;
+        static constexpr uint32_t                                  InvalidTextIndex     = std::numeric_limits<uint32_t>::max();
+        static constexpr uint32_t                                  GlyphTableTrimFrames = 600;
+        SDL_GPUGraphicsPipeline*                                   m_RunPipeline        = nullptr;
+        std::vector<GlyphTable>                                    m_GlyphTables;
+        Ref<GPUBatchStorageBuffer<GlyphRunLayout, RunBatchData>>   m_RunGPUBatch;
+        Ref<GPUBatchStorageBuffer<TextHeaderLayout, RunBatchData>> m_TextHeaderGPUBatch;    // in lockstep with m_RunGPUBatch
     };
 
     using FontCommandBuffer = Font2DPipeline::CommandList;
@@ -7,6 +7,8 @@
 #include "imgui_impl_sdl3.h"
 #include "imgui_impl_sdlgpu3.h"
 
+#include <bit>
+
 namespace InnoEngine
 {
     // Reusable buffers used for rendering 1 current in-flight frame, for ImGui_ImplSDLGPU3_RenderDrawData()
@@ -36,8 +38,47 @@ namespace InnoEngine
         ImGui_ImplSDLGPU3_FrameData MainWindowFrameData;
     };
 
+    auto ImGuiPipeline::CommandData::acquire_list() -> RenderCommandList&
+    {
+        if ( m_ActiveListCount == m_RenderCommandLists.size() )
+            m_RenderCommandLists.emplace_back();
+
+        return m_RenderCommandLists[ m_ActiveListCount++ ];
+    }
+
+    auto ImGuiPipeline::CommandData::get_lists() const -> std::span<const RenderCommandList>
+    {
+        return { m_RenderCommandLists.data(), m_ActiveListCount };
+    }
+
+    void ImGuiPipeline::CommandData::clear()
+    {
+        // resize keeps the allocations, they get swapped into the draw lists of imgui again
+        for ( uint32_t i = 0; i < m_ActiveListCount; ++i ) {
+            RenderCommandList& list = m_RenderCommandLists[ i ];
+            list.CommandBuffer.resize( 0 );
+            list.IndexBuffer.resize( 0 );
+            list.VertexBuffer.resize( 0 );
+        }
+        m_ActiveListCount = 0;
+
+        TotalVertexCount = 0;
+        TotalIndexCount  = 0;
+        Generation       = 0;
+        Replay           = false;
+    }
+
     ImGuiPipeline::~ImGuiPipeline()
     {
+        if ( m_Device != nullptr ) {
+            if ( m_VertexBuffer )
+                SDL_ReleaseGPUBuffer( m_Device, m_VertexBuffer );
+            if ( m_IndexBuffer )
+                SDL_ReleaseGPUBuffer( m_Device, m_IndexBuffer );
+            if ( m_TransferBuffer )
+                SDL_ReleaseGPUTransferBuffer( m_Device, m_TransferBuffer );
+        }
+
         if ( m_Initialized ) {
             ImGui_ImplSDL3_Shutdown();
             ImGui_ImplSDLGPU3_Shutdown();
@@ -79,13 +120,27 @@ namespace InnoEngine
     {
         IE_ASSERT( m_Device != nullptr );
 
+        // the gpu buffers still hold the last upload, a slot rendered twice does not need a new one either
+        if ( command_data.Replay || command_data.Generation == m_UploadedGeneration )
+            return m_UploadedListCount > 0 ? 1 : 0;
+
+        m_UploadedGeneration = command_data.Generation;
+        m_UploadedListCount  = 0;
+
         // Avoid rendering when minimized, scale coordinates for retina displays (screen coordinates != framebuffer coordinates)
-        int fb_width  = (int)(command_data.DisplaySize.x * command_data.FrameBufferScale.x);
-        int fb_height = (int)(command_data.DisplaySize.y * command_data.FrameBufferScale.y);
-        if (fb_width <= 0 || fb_height <= 0 || command_data.TotalVertexCount <= 0)
+        int fb_width  = (int)( command_data.DisplaySize.x * command_data.FrameBufferScale.x );
+        int fb_height = (int)( command_data.DisplaySize.y * command_data.FrameBufferScale.y );
+        if ( fb_width <= 0 || fb_height <= 0 || command_data.TotalVertexCount <= 0 )
+            return 0;
+
+        if ( ImGui::GetCurrentContext() == nullptr )
             return 0;
 
-        if (ImGui::GetCurrentContext() == nullptr)
+        const uint32_t vertex_size = command_data.TotalVertexCount * sizeof( ImDrawVert );
+        const uint32_t index_size  = command_data.TotalIndexCount * sizeof( ImDrawIdx );
+        if ( reserve_buffer( &m_VertexBuffer, &m_VertexBufferCapacity, vertex_size, SDL_GPU_BUFFERUSAGE_VERTEX ) == false ||
+             reserve_buffer( &m_IndexBuffer, &m_IndexBufferCapacity, index_size, SDL_GPU_BUFFERUSAGE_INDEX ) == false ||
+             reserve_transfer_buffer( vertex_size + index_size ) == false )
             return 0;
 
         SDL_GPUCommandBuffer* copyCmdbuf = SDL_AcquireGPUCommandBuffer( m_Device );
@@ -94,77 +149,62 @@ namespace InnoEngine
             return 0;
         }
 
-        ImGui_ImplSDLGPU3_Data*      bd = (ImGui_ImplSDLGPU3_Data*)ImGui::GetIO().BackendRendererUserData;
-        ImGui_ImplSDLGPU3_FrameData* fd = &bd->MainWindowFrameData;
-
-        uint32_t vertex_size = command_data.TotalVertexCount * sizeof( ImDrawVert );
-        uint32_t index_size  = command_data.TotalIndexCount * sizeof( ImDrawIdx );
-        if ( fd->VertexBuffer == nullptr || fd->VertexBufferSize < vertex_size )
-            create_or_resize_buffer( &fd->VertexBuffer, &fd->VertexBufferSize, vertex_size, SDL_GPU_BUFFERUSAGE_VERTEX );
-        if ( fd->IndexBuffer == nullptr || fd->IndexBufferSize < index_size )
-            create_or_resize_buffer( &fd->IndexBuffer, &fd->IndexBufferSize, index_size, SDL_GPU_BUFFERUSAGE_INDEX );
-
-        // FIXME: It feels like more code could be shared there.
-        SDL_GPUTransferBufferCreateInfo vertex_transferbuffer_info = {};
-        vertex_transferbuffer_info.usage                           = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
-        vertex_transferbuffer_info.size                            = vertex_size;
-        SDL_GPUTransferBufferCreateInfo index_transferbuffer_info  = {};
-        index_transferbuffer_info.usage                            = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
-        index_transferbuffer_info.size                             = index_size;
-
-        SDL_GPUTransferBuffer* vertex_transferbuffer = SDL_CreateGPUTransferBuffer( m_Device, &vertex_transferbuffer_info );
-        IM_ASSERT( vertex_transferbuffer != nullptr && "Failed to create the vertex transfer buffer, call SDL_GetError() for more information" );
-        SDL_GPUTransferBuffer* index_transferbuffer = SDL_CreateGPUTransferBuffer( m_Device, &index_transferbuffer_info );
-        IM_ASSERT( index_transferbuffer != nullptr && "Failed to create the index transfer buffer, call SDL_GetError() for more information" );
-
-        ImDrawVert* vtx_dst = (ImDrawVert*)SDL_MapGPUTransferBuffer( m_Device, vertex_transferbuffer, true );
-        ImDrawIdx*  idx_dst = (ImDrawIdx*)SDL_MapGPUTransferBuffer( m_Device, index_transferbuffer, true );
-        for ( const auto& cmdList : command_data.RenderCommandLists ) {
+        // one staging copy for all draw lists, cycling hands out a transfer buffer the gpu is not reading anymore
+        uint8_t* transfer_data = static_cast<uint8_t*>( SDL_MapGPUTransferBuffer( m_Device, m_TransferBuffer, true ) );
+        if ( transfer_data == nullptr ) {
+            IE_LOG_ERROR( "Failed to map imgui transfer buffer: {}", SDL_GetError() );
+            SDL_CancelGPUCommandBuffer( copyCmdbuf );
+            return 0;
+        }
+
+        ImDrawVert* vtx_dst = reinterpret_cast<ImDrawVert*>( transfer_data );
+        ImDrawIdx*  idx_dst = reinterpret_cast<ImDrawIdx*>( transfer_data + vertex_size );
+        for ( const auto& cmdList : command_data.get_lists() ) {
             memcpy( vtx_dst, cmdList.VertexBuffer.Data, cmdList.VertexBuffer.Size * sizeof( ImDrawVert ) );
             memcpy( idx_dst, cmdList.IndexBuffer.Data, cmdList.IndexBuffer.Size * sizeof( ImDrawIdx ) );
             vtx_dst += cmdList.VertexBuffer.Size;
             idx_dst += cmdList.IndexBuffer.Size;
         }
-        SDL_UnmapGPUTransferBuffer( m_Device, vertex_transferbuffer );
-        SDL_UnmapGPUTransferBuffer( m_Device, index_transferbuffer );
+        SDL_UnmapGPUTransferBuffer( m_Device, m_TransferBuffer );
 
         SDL_GPUTransferBufferLocation vertex_buffer_location = {};
         vertex_buffer_location.offset                        = 0;
-        vertex_buffer_location.transfer_buffer               = vertex_transferbuffer;
+        vertex_buffer_location.transfer_buffer               = m_TransferBuffer;
         SDL_GPUTransferBufferLocation index_buffer_location  = {};
-        index_buffer_location.offset                         = 0;
-        index_buffer_location.transfer_buffer                = index_transferbuffer;
+        index_buffer_location.offset                         = vertex_size;
+        index_buffer_location.transfer_buffer                = m_TransferBuffer;
 
         SDL_GPUBufferRegion vertex_buffer_region = {};
-        vertex_buffer_region.buffer              = fd->VertexBuffer;
+        vertex_buffer_region.buffer              = m_VertexBuffer;
         vertex_buffer_region.offset              = 0;
         vertex_buffer_region.size                = vertex_size;
 
         SDL_GPUBufferRegion index_buffer_region = {};
-        index_buffer_region.buffer              = fd->IndexBuffer;
+        index_buffer_region.buffer              = m_IndexBuffer;
         index_buffer_region.offset              = 0;
         index_buffer_region.size                = index_size;
 
+        // cycle, the frame before may still draw from them
         SDL_GPUCopyPass* copy_pass = SDL_BeginGPUCopyPass( copyCmdbuf );
         SDL_UploadToGPUBuffer( copy_pass, &vertex_buffer_location, &vertex_buffer_region, true );
         SDL_UploadToGPUBuffer( copy_pass, &index_buffer_location, &index_buffer_region, true );
         SDL_EndGPUCopyPass( copy_pass );
-        SDL_ReleaseGPUTransferBuffer( m_Device, index_transferbuffer );
-        SDL_ReleaseGPUTransferBuffer( m_Device, vertex_transferbuffer );
 
         if ( SDL_SubmitGPUCommandBuffer( copyCmdbuf ) == false ) {
             IE_LOG_ERROR( "SDL_SubmitGPUCommandBuffer failed: {}", SDL_GetError() );
             return 0;
         }
+
+        keep_uploaded_lists( command_data );
         return 1;
     }
 
-    uint32_t ImGuiPipeline::swapchain_render( const CommandData& command_data, SDL_GPUCommandBuffer* gpu_cmd_buf, SDL_GPURenderPass* render_pass )
+    uint32_t ImGuiPipeline::swapchain_render( SDL_GPUCommandBuffer* gpu_cmd_buf, SDL_GPURenderPass* render_pass )
     {
         // Avoid rendering when minimized, scale coordinates for retina displays (screen coordinates != framebuffer coordinates)
-        int fb_width  = (int)( command_data.DisplaySize.x * command_data.FrameBufferScale.x );
-        int fb_height = (int)( command_data.DisplaySize.y * command_data.FrameBufferScale.y );
-        if ( fb_width <= 0 || fb_height <= 0 )
+        int fb_width  = (int)( m_DisplaySize.x * m_FrameBufferScale.x );
+        int fb_height = (int)( m_DisplaySize.y * m_FrameBufferScale.y );
+        if ( fb_width <= 0 || fb_height <= 0 || m_UploadedListCount == 0 )
             return 0;
 
         if ( ImGui::GetCurrentContext() == nullptr )
@@ -172,19 +212,18 @@ namespace InnoEngine
 
         uint32_t draw_calls = 0;
 
-        ImGui_ImplSDLGPU3_Data*      bd = (ImGui_ImplSDLGPU3_Data*)ImGui::GetIO().BackendRendererUserData;
-        ImGui_ImplSDLGPU3_FrameData* fd = &bd->MainWindowFrameData;
+        ImGui_ImplSDLGPU3_Data* bd = (ImGui_ImplSDLGPU3_Data*)ImGui::GetIO().BackendRendererUserData;
 
         // Bind graphics pipeline
         SDL_BindGPUGraphicsPipeline( render_pass, bd->Pipeline );
 
         // Bind Vertex And Index Buffers
-        if ( command_data.TotalVertexCount > 0 ) {
+        {
             SDL_GPUBufferBinding vertex_buffer_binding = {};
-            vertex_buffer_binding.buffer               = fd->VertexBuffer;
+            vertex_buffer_binding.buffer               = m_VertexBuffer;
             vertex_buffer_binding.offset               = 0;
             SDL_GPUBufferBinding index_buffer_binding  = {};
-            index_buffer_binding.buffer                = fd->IndexBuffer;
+            index_buffer_binding.buffer                = m_IndexBuffer;
             index_buffer_binding.offset                = 0;
             SDL_BindGPUVertexBuffers( render_pass, 0, &vertex_buffer_binding, 1 );
             SDL_BindGPUIndexBuffer( render_pass, &index_buffer_binding, sizeof( ImDrawIdx ) == 2 ? SDL_GPU_INDEXELEMENTSIZE_16BIT : SDL_GPU_INDEXELEMENTSIZE_32BIT );
@@ -209,21 +248,22 @@ namespace InnoEngine
             float translation[ 2 ];
         } ubo;
 
-        ubo.scale[ 0 ]       = 2.0f / command_data.DisplaySize.x;
-        ubo.scale[ 1 ]       = 2.0f / command_data.DisplaySize.y;
-        ubo.translation[ 0 ] = -1.0f - command_data.DisplayPos.x * ubo.scale[ 0 ];
-        ubo.translation[ 1 ] = -1.0f - command_data.DisplayPos.y * ubo.scale[ 1 ];
+        ubo.scale[ 0 ]       = 2.0f / m_DisplaySize.x;
+        ubo.scale[ 1 ]       = 2.0f / m_DisplaySize.y;
+        ubo.translation[ 0 ] = -1.0f - m_DisplayPos.x * ubo.scale[ 0 ];
+        ubo.translation[ 1 ] = -1.0f - m_DisplayPos.y * ubo.scale[ 1 ];
         SDL_PushGPUVertexUniformData( gpu_cmd_buf, 0, &ubo, sizeof( UBO ) );
 
         // Will project scissor/clipping rectangles into framebuffer space
-        ImVec2 clip_off   = command_data.DisplayPos;          // (0,0) unless using multi-viewports
-        ImVec2 clip_scale = command_data.FrameBufferScale;    // (1,1) unless using retina display which are often (2,2)
+        ImVec2 clip_off   = m_DisplayPos;          // (0,0) unless using multi-viewports
+        ImVec2 clip_scale = m_FrameBufferScale;    // (1,1) unless using retina display which are often (2,2)
 
         // Render command lists
         // (Because we merged all buffers into a single one, we maintain our own offset into them)
         int global_vtx_offset = 0;
         int global_idx_offset = 0;
-        for ( const auto& cmdList : command_data.RenderCommandLists ) {
+        for ( uint32_t list_index = 0; list_index < m_UploadedListCount; ++list_index ) {
+            const UploadedList& cmdList = m_UploadedLists[ list_index ];
             for ( const auto& renderCmd : cmdList.CommandBuffer ) {
                 /*
                 // Usercallbacks are not supported for now
@@ -269,8 +309,8 @@ namespace InnoEngine
                     ++draw_calls;
                 }
             }
-            global_idx_offset += cmdList.IndexBuffer.Size;
-            global_vtx_offset += cmdList.VertexBuffer.Size;
+            global_idx_offset += cmdList.IndexCount;
+            global_vtx_offset += cmdList.VertexCount;
         }
 
         // Note: at this point both SDL_SetGPUViewport() and SDL_SetGPUScissor() have been called.
@@ -284,24 +324,69 @@ namespace InnoEngine
         return draw_calls;
     }
 
-    void ImGuiPipeline::create_or_resize_buffer( SDL_GPUBuffer** buffer, uint32_t* old_size, uint32_t new_size, SDL_GPUBufferUsageFlags usage )
+    void ImGuiPipeline::keep_uploaded_lists( const CommandData& command_data )
     {
-        if ( ImGui::GetCurrentContext() == nullptr )
-            return;
+        m_DisplayPos       = command_data.DisplayPos;
+        m_DisplaySize      = command_data.DisplaySize;
+        m_FrameBufferScale = command_data.FrameBufferScale;
+
+        const auto lists = command_data.get_lists();
+        if ( m_UploadedLists.size() < lists.size() )
+            m_UploadedLists.resize( lists.size() );
+
+        // the assignment of ImVector frees first, copying by hand keeps the capacity
+        for ( size_t i = 0; i < lists.size(); ++i ) {
+            UploadedList& uploaded = m_UploadedLists[ i ];
+            uploaded.CommandBuffer.resize( lists[ i ].CommandBuffer.Size );
+            if ( lists[ i ].CommandBuffer.Size > 0 )
+                memcpy( uploaded.CommandBuffer.Data, lists[ i ].CommandBuffer.Data, lists[ i ].CommandBuffer.size_in_bytes() );
+
+            uploaded.VertexCount = lists[ i ].VertexBuffer.Size;
+            uploaded.IndexCount  = lists[ i ].IndexBuffer.Size;
+        }
+        m_UploadedListCount = static_cast<uint32_t>( lists.size() );
+    }
 
-        ImGui_ImplSDLGPU3_Data*     bd = (ImGui_ImplSDLGPU3_Data*)ImGui::GetIO().BackendRendererUserData;
-        ImGui_ImplSDLGPU3_InitInfo* v  = &bd->InitInfo;
+    bool ImGuiPipeline::reserve_buffer( SDL_GPUBuffer** buffer, uint32_t* capacity, uint32_t size, SDL_GPUBufferUsageFlags usage )
+    {
+        if ( *buffer != nullptr && *capacity >= size )
+            return true;
 
-        // Even though this is fairly rarely called.
-        SDL_WaitForGPUIdle( v->Device );
-        SDL_ReleaseGPUBuffer( v->Device, *buffer );
+        // the old buffer may still be drawn from, sdl defers the destruction until the gpu is done with it
+        if ( *buffer != nullptr )
+            SDL_ReleaseGPUBuffer( m_Device, *buffer );
 
         SDL_GPUBufferCreateInfo buffer_info = {};
         buffer_info.usage                   = usage;
-        buffer_info.size                    = new_size;
-        buffer_info.props                   = 0;
-        *buffer                             = SDL_CreateGPUBuffer( v->Device, &buffer_info );
-        *old_size                           = new_size;
-        IM_ASSERT( *buffer != nullptr && "Failed to create GPU Buffer, call SDL_GetError() for more information" );
+        buffer_info.size                    = std::bit_ceil( std::max( size, MinBufferSize ) );
+
+        *buffer   = SDL_CreateGPUBuffer( m_Device, &buffer_info );
+        *capacity = *buffer != nullptr ? buffer_info.size : 0;
+        if ( *buffer == nullptr ) {
+            IE_LOG_ERROR( "SDL_CreateGPUBuffer failed : {0}", SDL_GetError() );
+            return false;
+        }
+        return true;
+    }
+
+    bool ImGuiPipeline::reserve_transfer_buffer( uint32_t size )
+    {
+        if ( m_TransferBuffer != nullptr && m_TransferBufferCapacity >= size )
+            return true;
+
+        if ( m_TransferBuffer != nullptr )
+            SDL_ReleaseGPUTransferBuffer( m_Device, m_TransferBuffer );
+
+        SDL_GPUTransferBufferCreateInfo transfer_info = {};
+        transfer_info.usage                           = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
+        transfer_info.size                            = std::bit_ceil( std::max( size, MinBufferSize ) );
+
+        m_TransferBuffer         = SDL_CreateGPUTransferBuffer( m_Device, &transfer_info );
+        m_TransferBufferCapacity = m_TransferBuffer != nullptr ? transfer_info.size : 0;
+        if ( m_TransferBuffer == nullptr ) {
+            IE_LOG_ERROR( "Failed to create GPUTransferBuffer! {}", SDL_GetError() );
+            return false;
+        }
+        return true;
     }
 }    // namespace InnoEngine
@@ -6,6 +6,8 @@
 
 #include "imgui.h"
 
+#include <span>
+
 namespace InnoEngine
 {
     class GPURenderer;
@@ -13,7 +15,7 @@ namespace InnoEngine
     class ImGuiPipeline
     {
     public:
-        // using ImVector here for ease of use
+        // using ImVector here, so the buffers of the draw lists can be swapped in instead of copied
         struct RenderCommandList
         {
             ImVector<ImDrawCmd>  CommandBuffer;
@@ -23,34 +25,24 @@ namespace InnoEngine
 
         struct CommandData
         {
-            int                            TotalVertexCount = 0;
-            int                            TotalIndexCount  = 0;
-            ImVec2                         DisplayPos       = { 0, 0 };
-            ImVec2                         DisplaySize      = { 0, 0 };
-            ImVec2                         FrameBufferScale = { 0, 0 };
-            std::vector<RenderCommandList> RenderCommandLists;
-
-            CommandData& operator=( CommandData& other )
-            {
-                if ( this == &other )
-                    return *this;
-
-                TotalVertexCount = other.TotalVertexCount;
-                TotalIndexCount  = other.TotalIndexCount;
-                DisplayPos       = other.DisplayPos;
-                DisplaySize      = other.DisplaySize;
-                FrameBufferScale = other.FrameBufferScale;
-
-                RenderCommandLists.reserve( other.RenderCommandLists.size() );
-                for ( const auto& rcl : other.RenderCommandLists ) {
-                    auto& new_rcl         = RenderCommandLists.emplace_back();
-                    new_rcl.CommandBuffer = rcl.CommandBuffer;
-                    new_rcl.IndexBuffer   = rcl.IndexBuffer;
-                    new_rcl.VertexBuffer  = rcl.VertexBuffer;
-                }
-
-                return *this;
-            }
+            int    TotalVertexCount = 0;
+            int    TotalIndexCount  = 0;
+            ImVec2 DisplayPos       = { 0, 0 };
+            ImVec2 DisplaySize      = { 0, 0 };
+            ImVec2 FrameBufferScale = { 0, 0 };
+
+            uint64_t Generation = 0;        // changes with every added draw data, the pipeline only uploads new ones
+            bool     Replay     = false;    // no lists, the last uploaded draw data gets drawn again
+
+            RenderCommandList&                 acquire_list();    // empty, but keeps the capacity of earlier frames
+            std::span<const RenderCommandList> get_lists() const;
+
+            void clear();
+
+        private:
+            // only the first m_ActiveListCount entries are in use this frame, the rest keep their capacity for later frames
+            std::vector<RenderCommandList> m_RenderCommandLists;
+            uint32_t                       m_ActiveListCount = 0;
         };
 
     public:
@@ -60,13 +52,41 @@ namespace InnoEngine
         // Inherited via GPUPipeline
         Result   initialize( GPURenderer* renderer );
         uint32_t prepare_render( const CommandData& command_data );
-        uint32_t swapchain_render( const CommandData& command_data, SDL_GPUCommandBuffer* gpu_cmd_buf, SDL_GPURenderPass* render_pass );
+        uint32_t swapchain_render( SDL_GPUCommandBuffer* gpu_cmd_buf, SDL_GPURenderPass* render_pass );    // draws what prepare_render uploaded last
 
     private:
-        void create_or_resize_buffer( SDL_GPUBuffer** buffer, uint32_t* old_size, uint32_t new_size, SDL_GPUBufferUsageFlags usage );
+        // the vertices and indices stay in the gpu buffers, only the draw commands are kept for replays
+        struct UploadedList
+        {
+            ImVector<ImDrawCmd> CommandBuffer;
+            int                 VertexCount = 0;
+            int                 IndexCount  = 0;
+        };
+
+        void keep_uploaded_lists( const CommandData& command_data );
+
+        // grows geometrically, buffers the gpu still reads get released by sdl once it is done with them
+        bool reserve_buffer( SDL_GPUBuffer** buffer, uint32_t* capacity, uint32_t size, SDL_GPUBufferUsageFlags usage );
+        bool reserve_transfer_buffer( uint32_t size );
 
     private:
+        static constexpr uint32_t MinBufferSize = 64 * 1024;
+
         GPUDeviceRef m_Device      = nullptr;
         bool         m_Initialized = false;
+
+        SDL_GPUBuffer*         m_VertexBuffer           = nullptr;
+        SDL_GPUBuffer*         m_IndexBuffer            = nullptr;
+        SDL_GPUTransferBuffer* m_TransferBuffer         = nullptr;    // vertices followed by the indices, cycled every frame
+        uint32_t               m_VertexBufferCapacity   = 0;
+        uint32_t               m_IndexBufferCapacity    = 0;
+        uint32_t               m_TransferBufferCapacity = 0;
+
+        uint64_t                  m_UploadedGeneration = 0;
+        ImVec2                    m_DisplayPos         = { 0, 0 };
+        ImVec2                    m_DisplaySize        = { 0, 0 };
+        ImVec2                    m_FrameBufferScale   = { 0, 0 };
+        std::vector<UploadedList> m_UploadedLists;
+        uint32_t                  m_UploadedListCount = 0;
     };
 }    // namespace InnoEngine
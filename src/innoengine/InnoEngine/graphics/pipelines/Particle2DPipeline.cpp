@@ -0,0 +1,449 @@
+#include "InnoEngine/iepch.h"
+#include "InnoEngine/graphics/pipelines/Particle2DPipeline.h"
+
+#include "InnoEngine/AssetManager.h"
+#include "InnoEngine/graphics/Renderer.h"
+#include "InnoEngine/graphics/Window.h"
+
+#include "InnoEngine/graphics/Shader.h"
+
+#include <bit>
+
+namespace InnoEngine
+{
+    size_t Particle2DPipeline::CommandList::size() const
+    {
+        return Commands.size();
+    }
+
+    void Particle2DPipeline::CommandList::clear()
+    {
+        Commands.clear();
+        Particles.clear();
+        Spawns.clear();
+    }
+
+    Particle2DPipeline::~Particle2DPipeline()
+    {
+        if ( m_Device != nullptr ) {
+            for ( auto& [ id, gpu_system ] : m_Systems ) {
+                release_system( gpu_system );
+            }
+            m_Systems.clear();
+
+            if ( m_TransferBuffer ) {
+                SDL_ReleaseGPUTransferBuffer( m_Device, m_TransferBuffer );
+                m_TransferBuffer = nullptr;
+            }
+
+            if ( m_Pipeline ) {
+                SDL_ReleaseGPUGraphicsPipeline( m_Device, m_Pipeline );
+                m_Pipeline = nullptr;
+            }
+        }
+    }
+
+    Result Particle2DPipeline::initialize( GPURenderer* renderer, AssetManager* assetmanager )
+    {
+        IE_ASSERT( renderer != nullptr && renderer->has_window() && assetmanager != nullptr );
+
+        if ( m_Initialized ) {
+            IE_LOG_WARNING( "Pipeline already initialized!" );
+            return Result::AlreadyInitialized;
+        }
+
+        m_Device           = renderer->get_gpudevice();
+        SDL_Window* window = renderer->get_window()->get_sdlwindow();
+
+        auto shaderRepo = assetmanager->get_repository<Shader>();
+        IE_ASSERT( shaderRepo != nullptr );
+
+        // load shaders
+        auto vertexShaderAsset = shaderRepo->require_asset( "ParticleBatch.vert" );
+        if ( vertexShaderAsset.has_value() == false ) {
+            IE_LOG_ERROR( "Vertex Shader not found: {}", "ParticleBatch.vert" );
+            return Result::InitializationError;
+        }
+
+        if ( IE_FAILED( vertexShaderAsset.value().get()->require_uniform_buffers( 1 ) ) )
+            return Result::InitializationError;
+
+        // particles are drawn as soft filled circles
+        auto fragmentShaderAsset = shaderRepo->require_asset( "Circle.frag" );
+        if ( fragmentShaderAsset.has_value() == false ) {
+            IE_LOG_ERROR( "Fragment Shader not found: {}", "Circle.frag" );
+            return Result::InitializationError;
+        }
+
+        AssetView<Shader>& vertexShader   = vertexShaderAsset.value();
+        AssetView<Shader>& fragmentShader = fragmentShaderAsset.value();
+
+        // Create the pipeline
+        SDL_GPUColorTargetDescription colorTargets[ 1 ]     = {};
+        colorTargets[ 0 ].format                            = SDL_GetGPUSwapchainTextureFormat( m_Device, window );
+        colorTargets[ 0 ].blend_state.src_color_blendfactor = SDL_GPU_BLENDFACTOR_SRC_ALPHA;
+        colorTargets[ 0 ].blend_state.dst_color_blendfactor = SDL_GPU_BLENDFACTOR_ONE_MINUS_SRC_ALPHA;
+        colorTargets[ 0 ].blend_state.color_blend_op        = SDL_GPU_BLENDOP_ADD;
+        colorTargets[ 0 ].blend_state.src_alpha_blendfactor = SDL_GPU_BLENDFACTOR_SRC_ALPHA;
+        colorTargets[ 0 ].blend_state.dst_alpha_blendfactor = SDL_GPU_BLENDFACTOR_ONE_MINUS_SRC_ALPHA;
+        colorTargets[ 0 ].blend_state.alpha_blend_op        = SDL_GPU_BLENDOP_ADD;
+        colorTargets[ 0 ].blend_state.enable_blend          = true;
+
+        SDL_GPUGraphicsPipelineCreateInfo pipelineCreateInfo     = {};
+        pipelineCreateInfo.vertex_shader                         = vertexShader.get()->get_sdlshader();
+        pipelineCreateInfo.fragment_shader                       = fragmentShader.get()->get_sdlshader();
+        pipelineCreateInfo.primitive_type                        = SDL_GPU_PRIMITIVETYPE_TRIANGLELIST;
+        pipelineCreateInfo.target_info.color_target_descriptions = colorTargets;
+        pipelineCreateInfo.target_info.num_color_targets         = 1;
+
+        pipelineCreateInfo.target_info.depth_stencil_format     = SDL_GPU_TEXTUREFORMAT_D16_UNORM;
+        pipelineCreateInfo.target_info.has_depth_stencil_target = true;
+
+        pipelineCreateInfo.depth_stencil_state.compare_op          = SDL_GPU_COMPAREOP_GREATER_OR_EQUAL;
+        pipelineCreateInfo.depth_stencil_state.enable_depth_test   = true;
+        pipelineCreateInfo.depth_stencil_state.enable_depth_write  = true;
+        pipelineCreateInfo.depth_stencil_state.enable_stencil_test = false;
+        pipelineCreateInfo.depth_stencil_state.write_mask          = 0xFF;
+
+        m_Pipeline = SDL_CreateGPUGraphicsPipeline( m_Device, &pipelineCreateInfo );
+        if ( m_Pipeline == nullptr ) {
+            IE_LOG_ERROR( "Failed to create pipeline!" );
+            return Result::InitializationError;
+        }
+
+        m_GPUBatch = GPUBatchStorageBuffer<StructuredBufferLayout, BatchData>::create( m_Device, MaxBatchSize );
+
+        if ( auto simulateShaderAsset = shaderRepo->require_asset( "ParticleSimulate.comp" ) ) {
+            m_SimulateShader = simulateShaderAsset.value().get();
+        }
+        if ( m_SimulateShader == nullptr || m_SimulateShader->get_sdlcomputepipeline() == nullptr ) {
+            IE_LOG_ERROR( "Compute Shader not found: {}", "ParticleSimulate.comp" );
+            return Result::InitializationError;
+        }
+
+        if ( IE_FAILED( m_SimulateShader->require_uniform_buffers( 1 ) ) )
+            return Result::InitializationError;
+
+        m_Initialized = true;
+        return Result::Success;
+    }
+
+    uint32_t Particle2DPipeline::prepare_render( const CommandList& command_list )
+    {
+        if ( m_Initialized == false || command_list.size() == 0 )
+            return 0;
+
+        uint32_t batch_count = prepare_gpu_systems( command_list );
+        if ( command_list.Particles.empty() )
+            return batch_count;
+
+        m_GPUBatch->clear();
+
+        SDL_GPUCommandBuffer* gpu_copy_cmd_buf = SDL_AcquireGPUCommandBuffer( m_Device );
+        if ( gpu_copy_cmd_buf == nullptr ) {
+            IE_LOG_ERROR( "AcquireGPUCommandBuffer failed: {}", SDL_GetError() );
+            return batch_count;
+        }
+
+        SDL_GPUCopyPass* copy_pass = SDL_BeginGPUCopyPass( gpu_copy_cmd_buf );
+
+        BatchData* current = nullptr;
+
+        for ( const Command& command : command_list.Commands ) {
+            if ( command.System != nullptr )
+                continue;
+
+            for ( uint32_t i = command.DataOffset; i < command.DataOffset + command.DataCount; ++i ) {
+                if ( current == nullptr || m_GPUBatch->current_batch_full() ||
+                     current->ContextIndex != command.ContextIndex ||
+                     current->Depth != command.Depth ) {
+
+                    current               = m_GPUBatch->upload_and_add_batch( copy_pass );
+                    current->ContextIndex = command.ContextIndex;
+                    current->Depth        = command.Depth;
+                }
+
+                *m_GPUBatch->next_data() = command_list.Particles[ i ];
+            }
+        }
+        m_GPUBatch->upload_last( copy_pass );
+
+        SDL_EndGPUCopyPass( copy_pass );
+
+        if ( SDL_SubmitGPUCommandBuffer( gpu_copy_cmd_buf ) == false ) {
+            IE_LOG_ERROR( "SDL_SubmitGPUCommandBuffer failed: {}", SDL_GetError() );
+            return batch_count;
+        }
+
+        return batch_count + static_cast<uint32_t>( m_GPUBatch->size() );
+    }
+
+    uint32_t Particle2DPipeline::swapchain_render( const RenderContextFrameData& render_ctx_data,
+                                                   SDL_GPUCommandBuffer*         gpu_cmd_buf,
+                                                   SDL_GPURenderPass*            render_pass )
+    {
+        IE_ASSERT( render_pass != nullptr );
+
+        if ( m_Initialized == false || ( m_GPUBatch->size() == 0 && m_Draws.empty() ) )
+            return 0;
+
+        SDL_BindGPUGraphicsPipeline( render_pass, m_Pipeline );
+        SDL_BindGPUVertexBuffers( render_pass, 0, nullptr, 0 );
+        SDL_SetGPUViewport( render_pass, &render_ctx_data.Viewport );
+
+        uint32_t draw_calls = 0;
+
+        for ( const auto& batch_data : m_GPUBatch->get_batchlist() ) {
+            BatchUniforms uniforms = { batch_data.CustomData.ContextIndex, batch_data.CustomData.Depth, batch_data.Offset };
+            SDL_PushGPUVertexUniformData( gpu_cmd_buf, 0, &uniforms, sizeof( BatchUniforms ) );
+            SDL_BindGPUVertexStorageBuffers( render_pass, 1, &batch_data.GPUBuffer, 1 );
+            SDL_DrawGPUPrimitives( render_pass, batch_data.Count * 6, 1, 0, 0 );
+            ++draw_calls;
+        }
+
+        // dead particles of gpu simulated systems have a size of 0 and get discarded by the rasterizer
+        for ( const GPUDraw& draw : m_Draws ) {
+            SDL_PushGPUVertexUniformData( gpu_cmd_buf, 0, &draw.Uniforms, sizeof( BatchUniforms ) );
+            SDL_BindGPUVertexStorageBuffers( render_pass, 1, &draw.Buffer, 1 );
+            SDL_DrawGPUPrimitives( render_pass, draw.Count * 6, 1, 0, 0 );
+            ++draw_calls;
+        }
+
+        m_GPUBatch->clear();
+        m_Draws.clear();
+        return draw_calls;
+    }
+
+    void Particle2DPipeline::end_frame()
+    {
+        if ( m_Initialized == false )
+            return;
+
+        m_GPUBatch->end_frame();
+
+        for ( auto it = m_Systems.begin(); it != m_Systems.end(); ) {
+            GPUParticleSystem& gpu_system = it->second;
+            if ( gpu_system.System.expired() || ++gpu_system.UnusedFrames >= TrimFrameCount ) {
+                release_system( gpu_system );
+                it = m_Systems.erase( it );
+            }
+            else {
+                ++it;
+            }
+        }
+    }
+
+    size_t Particle2DPipeline::get_gpu_buffer_bytes() const
+    {
+        if ( m_Initialized == false )
+            return 0;
+
+        return m_GPUBatch->get_allocated_bytes() + m_SystemBufferBytes + m_TransferBufferBytes;
+    }
+
+    uint32_t Particle2DPipeline::prepare_gpu_systems( const CommandList& command_list )
+    {
+        m_Draws.clear();
+        if ( m_SimulateShader == nullptr )
+            return 0;
+
+        // create the buffers of new systems and find the upper bound of the data to upload
+        uint32_t upload_bytes = 0;
+        for ( const Command& command : command_list.Commands ) {
+            if ( command.System == nullptr )
+                continue;
+
+            GPUParticleSystem& gpu_system = m_Systems[ command.System->get_id() ];
+            if ( gpu_system.State == nullptr ) {
+                gpu_system.System = command.System;
+                if ( IE_FAILED( create_system_buffers( gpu_system, command.System->get_specs().MaxParticles ) ) )
+                    continue;
+            }
+
+            upload_bytes += gpu_system.Cleared ? command.DataCount * sizeof( ParticleSystem::GPUParticle )
+                                               : gpu_system.Capacity * sizeof( ParticleSystem::GPUParticle );
+        }
+
+        if ( upload_bytes > m_TransferBufferBytes ) {
+            if ( m_TransferBuffer )
+                SDL_ReleaseGPUTransferBuffer( m_Device, m_TransferBuffer );
+
+            SDL_GPUTransferBufferCreateInfo transferbuffer_createinfo = {};
+            transferbuffer_createinfo.usage                           = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
+            transferbuffer_createinfo.size                            = std::bit_ceil( upload_bytes );
+
+            m_TransferBuffer      = SDL_CreateGPUTransferBuffer( m_Device, &transferbuffer_createinfo );
+            m_TransferBufferBytes = m_TransferBuffer ? transferbuffer_createinfo.size : 0;
+            if ( m_TransferBuffer == nullptr ) {
+                IE_LOG_ERROR( "Failed to create GPUTransferBuffer! {}", SDL_GetError() );
+                return 0;
+            }
+        }
+
+        std::byte* transfer_data = nullptr;
+        if ( upload_bytes > 0 ) {
+            transfer_data = static_cast<std::byte*>( SDL_MapGPUTransferBuffer( m_Device, m_TransferBuffer, true ) );
+            if ( transfer_data == nullptr ) {
+                IE_LOG_ERROR( "SDL_MapGPUTransferBuffer failed: {}", SDL_GetError() );
+                return 0;
+            }
+        }
+
+        m_PendingUploads.clear();
+        m_PendingSimulations.clear();
+        uint32_t transfer_offset = 0;
+
+        constexpr uint32_t particle_bytes = sizeof( ParticleSystem::GPUParticle );
+
+        for ( const Command& command : command_list.Commands ) {
+            if ( command.System == nullptr )
+                continue;
+
+            GPUParticleSystem& gpu_system = m_Systems[ command.System->get_id() ];
+            if ( gpu_system.State == nullptr )
+                continue;
+
+            gpu_system.UnusedFrames = 0;
+
+            // a collected frame might have been dropped, so spawns arrive until the upload got confirmed
+            const uint64_t spawn_end   = command.FirstSpawn + command.DataCount;
+            const uint64_t spawn_begin = std::max( command.FirstSpawn, gpu_system.UploadedSpawns );
+            const uint32_t spawn_count = spawn_end > spawn_begin ? static_cast<uint32_t>( spawn_end - spawn_begin ) : 0;
+            const auto*    spawns      = command_list.Spawns.data() + command.DataOffset + ( spawn_begin - command.FirstSpawn );
+            const uint32_t first_slot  = static_cast<uint32_t>( spawn_begin % gpu_system.Capacity );
+
+            if ( gpu_system.Cleared == false ) {
+                // the whole ring at once, unused slots are dead particles with a lifetime of 0
+                std::byte* ring = transfer_data + transfer_offset;
+                std::memset( ring, 0, gpu_system.Capacity * particle_bytes );
+                for ( uint32_t i = 0; i < spawn_count; ++i ) {
+                    std::memcpy( ring + ( ( first_slot + i ) % gpu_system.Capacity ) * particle_bytes, &spawns[ i ], particle_bytes );
+                }
+
+                m_PendingUploads.push_back( { gpu_system.State, transfer_offset, 0, gpu_system.Capacity * particle_bytes } );
+                transfer_offset    += gpu_system.Capacity * particle_bytes;
+                gpu_system.Cleared  = true;
+            }
+            else if ( spawn_count > 0 ) {
+                std::memcpy( transfer_data + transfer_offset, spawns, spawn_count * particle_bytes );
+
+                // the spawns wrap around the end of the ring at most once
+                const uint32_t until_wrap = std::min( spawn_count, gpu_system.Capacity - first_slot );
+                m_PendingUploads.push_back( { gpu_system.State, transfer_offset, first_slot * particle_bytes, until_wrap * particle_bytes } );
+                if ( spawn_count > until_wrap )
+                    m_PendingUploads.push_back( { gpu_system.State, transfer_offset + until_wrap * particle_bytes, 0, ( spawn_count - until_wrap ) * particle_bytes } );
+                transfer_offset += spawn_count * particle_bytes;
+            }
+
+            if ( spawn_end > gpu_system.UploadedSpawns ) {
+                gpu_system.UploadedSpawns = spawn_end;
+                command.System->m_UploadedSpawns.store( spawn_end, std::memory_order_release );
+            }
+
+            // the same system may be drawn by several contexts, simulate it only once per frame
+            if ( gpu_system.SimulatedTime != command.SimulationTime ) {
+                const ParticleSystemSpecifications& specs = command.System->get_specs();
+
+                float delta_time         = gpu_system.SimulatedTime < 0.0f ? 0.0f : command.SimulationTime - gpu_system.SimulatedTime;
+                gpu_system.SimulatedTime = command.SimulationTime;
+
+                SimulationParameters parameters = {};
+                parameters.Gravity              = specs.Gravity;
+                parameters.Drag                 = specs.Drag;
+                parameters.DeltaTime            = std::clamp( delta_time, 0.0f, MaxTimeStep );
+                parameters.ParticleCount        = gpu_system.Capacity;
+                m_PendingSimulations.push_back( { &gpu_system, parameters } );
+            }
+
+            GPUDraw& draw             = m_Draws.emplace_back();
+            draw.Buffer               = gpu_system.Output;
+            draw.Count                = gpu_system.Capacity;
+            draw.Uniforms.CameraIndex = command.ContextIndex;
+            draw.Uniforms.Depth       = command.Depth;
+        }
+
+        if ( transfer_data != nullptr )
+            SDL_UnmapGPUTransferBuffer( m_Device, m_TransferBuffer );
+
+        if ( m_PendingUploads.empty() && m_PendingSimulations.empty() )
+            return static_cast<uint32_t>( m_Draws.size() );
+
+        SDL_GPUCommandBuffer* gpu_cmd_buf = SDL_AcquireGPUCommandBuffer( m_Device );
+        if ( gpu_cmd_buf == nullptr ) {
+            IE_LOG_ERROR( "AcquireGPUCommandBuffer failed: {}", SDL_GetError() );
+            m_Draws.clear();
+            return 0;
+        }
+
+        if ( m_PendingUploads.empty() == false ) {
+            SDL_GPUCopyPass* copy_pass = SDL_BeginGPUCopyPass( gpu_cmd_buf );
+            for ( const PendingUpload& upload : m_PendingUploads ) {
+                SDL_GPUTransferBufferLocation transferbuffer_location { .transfer_buffer = m_TransferBuffer, .offset = upload.TransferOffset };
+                SDL_GPUBufferRegion           buffer_region { .buffer = upload.Buffer, .offset = upload.BufferOffset, .size = upload.Bytes };
+                SDL_UploadToGPUBuffer( copy_pass, &transferbuffer_location, &buffer_region, false );    // the ring keeps the living particles
+            }
+            SDL_EndGPUCopyPass( copy_pass );
+        }
+
+        SDL_GPUComputePipeline* simulate_pipeline = m_SimulateShader->get_sdlcomputepipeline();
+        for ( const PendingSimulation& simulation : m_PendingSimulations ) {
+            SDL_GPUStorageBufferReadWriteBinding readwrite_buffers[ 2 ] = {};
+            readwrite_buffers[ 0 ].buffer                               = simulation.System->State;
+            readwrite_buffers[ 0 ].cycle                                = false;
+            readwrite_buffers[ 1 ].buffer                               = simulation.System->Output;
+            readwrite_buffers[ 1 ].cycle                                = true;    // fully rewritten, earlier frames may still draw it
+
+            SDL_GPUComputePass* compute_pass = SDL_BeginGPUComputePass( gpu_cmd_buf, nullptr, 0, readwrite_buffers, 2 );
+            SDL_BindGPUComputePipeline( compute_pass, simulate_pipeline );
+            SDL_PushGPUComputeUniformData( gpu_cmd_buf, 0, &simulation.Parameters, sizeof( SimulationParameters ) );
+            SDL_DispatchGPUCompute( compute_pass, ( simulation.Parameters.ParticleCount + SimulateGroupSize - 1 ) / SimulateGroupSize, 1, 1 );
+            SDL_EndGPUComputePass( compute_pass );
+        }
+
+        if ( SDL_SubmitGPUCommandBuffer( gpu_cmd_buf ) == false ) {
+            IE_LOG_ERROR( "SDL_SubmitGPUCommandBuffer failed: {}", SDL_GetError() );
+            m_Draws.clear();
+            return 0;
+        }
+
+        return static_cast<uint32_t>( m_Draws.size() );
+    }
+
+    Result Particle2DPipeline::create_system_buffers( GPUParticleSystem& gpu_system, uint32_t capacity )
+    {
+        SDL_GPUBufferCreateInfo state_createinfo = {};
+        state_createinfo.usage                   = SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_READ | SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_WRITE;
+        state_createinfo.size                    = capacity * sizeof( ParticleSystem::GPUParticle );
+
+        SDL_GPUBufferCreateInfo output_createinfo = {};
+        output_createinfo.usage                   = SDL_GPU_BUFFERUSAGE_GRAPHICS_STORAGE_READ | SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_WRITE;
+        output_createinfo.size                    = capacity * sizeof( StructuredBufferLayout );
+
+        gpu_system.State  = SDL_CreateGPUBuffer( m_Device, &state_createinfo );
+        gpu_system.Output = SDL_CreateGPUBuffer( m_Device, &output_createinfo );
+        if ( gpu_system.State == nullptr || gpu_system.Output == nullptr ) {
+            IE_LOG_ERROR( "SDL_CreateGPUBuffer failed : {0}", SDL_GetError() );
+            SDL_ReleaseGPUBuffer( m_Device, gpu_system.State );
+            SDL_ReleaseGPUBuffer( m_Device, gpu_system.Output );
+            gpu_system.State  = nullptr;
+            gpu_system.Output = nullptr;
+            return Result::Fail;
+        }
+
+        gpu_system.Capacity  = capacity;
+        m_SystemBufferBytes += state_createinfo.size + output_createinfo.size;
+        return Result::Success;
+    }
+
+    void Particle2DPipeline::release_system( GPUParticleSystem& gpu_system )
+    {
+        if ( gpu_system.State == nullptr )
+            return;
+
+        SDL_ReleaseGPUBuffer( m_Device, gpu_system.State );
+        SDL_ReleaseGPUBuffer( m_Device, gpu_system.Output );
+        m_SystemBufferBytes -= gpu_system.Capacity * ( sizeof( ParticleSystem::GPUParticle ) + sizeof( StructuredBufferLayout ) );
+        gpu_system.State     = nullptr;
+        gpu_system.Output    = nullptr;
+    }
+}    // namespace InnoEngine
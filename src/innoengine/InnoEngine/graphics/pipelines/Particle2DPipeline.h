@@ -0,0 +1,150 @@
+#pragma once
+#include "SDL3/SDL_gpu.h"
+
+#include "InnoEngine/BaseTypes.h"
+#include "InnoEngine/graphics/GPUDeviceRef.h"
+
+#include "InnoEngine/graphics/GPUBatchBuffer.h"
+#include "InnoEngine/graphics/ParticleSystem.h"
+
+#include "InnoEngine/graphics/RenderContext.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace InnoEngine
+{
+    class AssetManager;
+    class GPURenderer;
+    class Shader;
+
+    class Particle2DPipeline
+    {
+    public:
+        struct BatchData
+        {
+            RenderCommandBufferIndexType ContextIndex = InvalidRenderCommandBufferIndex;
+            float                        Depth        = 0.0f;
+        };
+
+        // only the streams needed to draw, the simulation state stays with the particle system
+        struct StructuredBufferLayout
+        {
+            DXSM::Vector2 Position;
+            float         Size;
+            uint32_t      Color;    // rgba8
+        };
+
+        struct Command : RenderCommandBase
+        {
+            Ref<ParticleSystem> System;    // only set for gpu simulated systems
+
+            uint32_t DataOffset     = 0;    // first element inside CommandList::Particles or CommandList::Spawns
+            uint32_t DataCount      = 0;
+            uint64_t FirstSpawn     = 0;       // sequence number of the first spawn, gpu simulation only
+            float    SimulationTime = 0.0f;    // gpu simulation only
+        };
+
+        struct CommandList
+        {
+            std::vector<Command>                     Commands;
+            std::vector<StructuredBufferLayout>      Particles;    // cpu simulated particles
+            std::vector<ParticleSystem::GPUParticle> Spawns;       // new particles of gpu simulated systems
+
+            size_t size() const;
+            void   clear();
+        };
+
+    public:
+        Particle2DPipeline() = default;
+        ~Particle2DPipeline();
+
+        Result initialize( GPURenderer* renderer, AssetManager* assetmanager );
+
+        uint32_t prepare_render( const CommandList& command_list );
+        uint32_t swapchain_render( const RenderContextFrameData& render_ctx_data,
+                                   SDL_GPUCommandBuffer*         gpu_cmd_buf,
+                                   SDL_GPURenderPass*            render_pass );
+
+        void   end_frame();    // releases the buffers of gpu simulated systems which were not drawn for a while
+        size_t get_gpu_buffer_bytes() const;
+
+    private:
+        struct BatchUniforms
+        {
+            uint32_t CameraIndex;
+            float    Depth;
+            uint32_t BatchOffset = 0;    // first particle of the batch in the shared buffer
+            uint32_t pad         = 0;
+        };
+
+        struct SimulationParameters
+        {
+            DXSM::Vector2 Gravity;
+            float         Drag;
+            float         DeltaTime;
+            uint32_t      ParticleCount;
+        };
+
+        struct GPUParticleSystem
+        {
+            std::weak_ptr<ParticleSystem> System;
+            SDL_GPUBuffer*                State          = nullptr;    // ring buffer of ParticleSystem::GPUParticle
+            SDL_GPUBuffer*                Output         = nullptr;    // StructuredBufferLayout, read by the vertex shader
+            uint32_t                      Capacity       = 0;
+            uint64_t                      UploadedSpawns = 0;
+            float                         SimulatedTime  = -1.0f;    // negative until the first simulation step
+            bool                          Cleared        = false;    // new buffers hold garbage until they get zeroed once
+            uint32_t                      UnusedFrames   = 0;
+        };
+
+        struct PendingUpload
+        {
+            SDL_GPUBuffer* Buffer;
+            uint32_t       TransferOffset;
+            uint32_t       BufferOffset;
+            uint32_t       Bytes;
+        };
+
+        struct PendingSimulation
+        {
+            GPUParticleSystem*   System;
+            SimulationParameters Parameters;
+        };
+
+        struct GPUDraw
+        {
+            SDL_GPUBuffer* Buffer;
+            uint32_t       Count;
+            BatchUniforms  Uniforms;
+        };
+
+        uint32_t prepare_gpu_systems( const CommandList& command_list );
+        Result   create_system_buffers( GPUParticleSystem& gpu_system, uint32_t capacity );
+        void     release_system( GPUParticleSystem& gpu_system );
+
+    private:
+        static constexpr uint32_t MaxBatchSize      = 20000;
+        static constexpr uint32_t SimulateGroupSize = 64;       // has to match ParticleSimulate.comp.hlsl
+        static constexpr uint32_t TrimFrameCount    = 300;
+        static constexpr float    MaxTimeStep       = 0.25f;    // in seconds, longer gaps get clamped
+
+        bool                     m_Initialized = false;
+        GPUDeviceRef             m_Device      = nullptr;
+        SDL_GPUGraphicsPipeline* m_Pipeline    = nullptr;
+
+        Ref<GPUBatchStorageBuffer<StructuredBufferLayout, BatchData>> m_GPUBatch;
+
+        // optional, without the compute shader gpu simulated systems are skipped
+        Ref<Shader>                                     m_SimulateShader      = nullptr;
+        SDL_GPUTransferBuffer*                          m_TransferBuffer      = nullptr;
+        uint32_t                                        m_TransferBufferBytes = 0;
+        std::unordered_map<uint32_t, GPUParticleSystem> m_Systems;    // by particle system id
+        std::vector<PendingUpload>                      m_PendingUploads;
+        std::vector<PendingSimulation>                  m_PendingSimulations;
+        std::vector<GPUDraw>                            m_Draws;
+        size_t                                          m_SystemBufferBytes = 0;
+    };
+
+    using ParticleCommandBuffer = Particle2DPipeline::CommandList;
+}    // namespace InnoEngine
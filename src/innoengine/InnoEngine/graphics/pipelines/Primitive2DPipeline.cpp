@@ -9,21 +9,62 @@
 
 namespace InnoEngine
 {
+    namespace
+    {
+        uint32_t get_segment_count( const Primitive2DPipeline::PolylineCommand& command )
+        {
+            return command.Closed ? command.PointCount : command.PointCount - 1;
+        }
+
+        // same rotation as ShapeBatch.vert
+        DXSM::Vector2 rotate( const DXSM::Vector2& vector, float radians )
+        {
+            if ( radians == 0.0f )
+                return vector;
+
+            const float c = std::cos( radians );
+            const float s = std::sin( radians );
+            return { vector.x * c - vector.y * s, vector.x * s + vector.y * c };
+        }
+    }    // namespace
+
+    size_t Primitive2DPipeline::PolygonCommandList::size() const
+    {
+        return Commands.size();
+    }
+
+    void Primitive2DPipeline::PolygonCommandList::clear()
+    {
+        Commands.clear();
+        Vertices.clear();
+    }
+
+    size_t Primitive2DPipeline::PolylineCommandList::size() const
+    {
+        return Commands.size();
+    }
+
+    void Primitive2DPipeline::PolylineCommandList::clear()
+    {
+        Commands.clear();
+        Points.clear();
+    }
+
     Primitive2DPipeline::~Primitive2DPipeline()
     {
-        if ( m_QuadPipeline ) {
-            SDL_ReleaseGPUGraphicsPipeline( m_Device, m_QuadPipeline );
-            m_QuadPipeline = nullptr;
+        if ( m_ShapePipeline ) {
+            SDL_ReleaseGPUGraphicsPipeline( m_Device, m_ShapePipeline );
+            m_ShapePipeline = nullptr;
         }
 
-        if ( m_LinePipeline ) {
-            SDL_ReleaseGPUGraphicsPipeline( m_Device, m_LinePipeline );
-            m_LinePipeline = nullptr;
+        if ( m_PolygonPipeline ) {
+            SDL_ReleaseGPUGraphicsPipeline( m_Device, m_PolygonPipeline );
+            m_PolygonPipeline = nullptr;
         }
 
-        if ( m_CirclePipeline ) {
-            SDL_ReleaseGPUGraphicsPipeline( m_Device, m_CirclePipeline );
-            m_CirclePipeline = nullptr;
+        if ( m_PolylinePipeline ) {
+            SDL_ReleaseGPUGraphicsPipeline( m_Device, m_PolylinePipeline );
+            m_PolylinePipeline = nullptr;
         }
     }
 
@@ -44,46 +85,53 @@ namespace InnoEngine
 
         Result res = Result::Success;
 
-        res = load_quad_pipeline( window, shaderRepo.get() );
+        res = load_shape_pipeline( window, shaderRepo.get() );
         RETURN_RESULT_IF_FAILED( res );
 
-        res = load_line_pipeline( window, shaderRepo.get() );
+        res = load_polygon_pipeline( window, shaderRepo.get() );
         RETURN_RESULT_IF_FAILED( res );
 
-        res = load_circle_pipeline( window, shaderRepo.get() );
+        res = load_polyline_pipeline( window, shaderRepo.get() );
         RETURN_RESULT_IF_FAILED( res );
 
         m_Initialized = true;
         return res;
     }
 
-    uint32_t Primitive2DPipeline::prepare_render_opaque( const QuadCommandList& quad_command_list, const LineCommandList& line_command_list, const CircleCommandList& circle_command_list )
+    uint32_t Primitive2DPipeline::prepare_render_opaque( const QuadCommandList&    quad_command_list,
+                                                         const LineCommandList&    line_command_list,
+                                                         const CircleCommandList&  circle_command_list,
+                                                         const PolygonCommandList& polygon_command_list )
     {
         IE_ASSERT( m_Device != nullptr );
-        if ( quad_command_list.size() == 0 && line_command_list.size() == 0 && circle_command_list.size() == 0 )
+        if ( quad_command_list.size() == 0 && line_command_list.size() == 0 && circle_command_list.size() == 0 && polygon_command_list.size() == 0 )
             return 0;
 
-        sort_quad_commands( quad_command_list, true );
-        sort_line_commands( line_command_list, true );
-        sort_circle_commands( circle_command_list, true );
+        sort_shape_commands( quad_command_list, line_command_list, circle_command_list, nullptr, true );
+        sort_polygon_commands( polygon_command_list, true );
+        sort_polyline_commands( nullptr );
         return prepare_batches();
     }
 
-    uint32_t Primitive2DPipeline::prepare_render( const QuadCommandList&   quad_command_list,
-                                                  const LineCommandList&   line_command_list,
-                                                  const CircleCommandList& circle_command_list )
+    uint32_t Primitive2DPipeline::prepare_render( const QuadCommandList&        quad_command_list,
+                                                  const LineCommandList&        line_command_list,
+                                                  const CircleCommandList&      circle_command_list,
+                                                  const RoundedRectCommandList& rounded_rect_command_list,
+                                                  const PolygonCommandList&     polygon_command_list,
+                                                  const PolylineCommandList&    polyline_command_list )
     {
         IE_ASSERT( m_Device != nullptr );
-        if ( quad_command_list.size() == 0 && line_command_list.size() == 0 && circle_command_list.size() == 0 )
+        if ( quad_command_list.size() == 0 && line_command_list.size() == 0 && circle_command_list.size() == 0 &&
+             rounded_rect_command_list.size() == 0 && polygon_command_list.size() == 0 && polyline_command_list.size() == 0 )
             return 0;
 
-        sort_line_commands( line_command_list, false );
-        sort_quad_commands( quad_command_list, false );
-        sort_circle_commands( circle_command_list, false );
+        sort_shape_commands( quad_command_list, line_command_list, circle_command_list, &rounded_rect_command_list, false );
+        sort_polygon_commands( polygon_command_list, false );
+        sort_polyline_commands( &polyline_command_list );
         return prepare_batches();
     }
 
-    uint32_t Primitive2DPipeline::swapchain_render( const RenderContextFrameData& render_ctx_data, SDL_GPURenderPass* render_pass )
+    uint32_t Primitive2DPipeline::swapchain_render( const RenderContextFrameData& render_ctx_data, SDL_GPUCommandBuffer* gpu_cmd_buf, SDL_GPURenderPass* render_pass )
     {
         IE_ASSERT( m_Device != nullptr );
         IE_ASSERT( render_pass != nullptr );
@@ -93,80 +141,112 @@ namespace InnoEngine
 
         uint32_t draw_calls = 0;
 
-        if ( m_QuadGPUBatch->size() > 0 ) {
-            SDL_BindGPUGraphicsPipeline( render_pass, m_QuadPipeline );
-            for ( const auto& batch_data : m_QuadGPUBatch->get_batchlist() ) {
+        if ( m_ShapeGPUBatch->size() > 0 ) {
+            SDL_BindGPUGraphicsPipeline( render_pass, m_ShapePipeline );
+            for ( const auto& batch_data : m_ShapeGPUBatch->get_batchlist() ) {
+                BatchUniforms uniforms = { batch_data.Offset };
+                SDL_PushGPUVertexUniformData( gpu_cmd_buf, 0, &uniforms, sizeof( uniforms ) );
                 SDL_BindGPUVertexStorageBuffers( render_pass, 1, &batch_data.GPUBuffer, 1 );
                 SDL_DrawGPUPrimitives( render_pass, batch_data.Count * 6, 1, 0, 0 );
                 ++draw_calls;
             }
         }
 
-        if ( m_LineGPUBatch->size() > 0 ) {
-            SDL_BindGPUGraphicsPipeline( render_pass, m_LinePipeline );
-            for ( const auto& batch_data : m_LineGPUBatch->get_batchlist() ) {
-                SDL_BindGPUVertexStorageBuffers( render_pass, 1, &batch_data.GPUBuffer, 1 );
-                SDL_DrawGPUPrimitives( render_pass, batch_data.Count * 6, 1, 0, 0 );
-                ++draw_calls;
-            }
-        }
+        draw_calls += render_polygons( gpu_cmd_buf, render_pass );
 
-        if ( m_CircleGPUBatch->size() > 0 ) {
-            SDL_BindGPUGraphicsPipeline( render_pass, m_CirclePipeline );
-            for ( const auto& batch_data : m_CircleGPUBatch->get_batchlist() ) {
-                SDL_BindGPUVertexStorageBuffers( render_pass, 1, &batch_data.GPUBuffer, 1 );
-                SDL_DrawGPUPrimitives( render_pass, batch_data.Count * 6, 1, 0, 0 );
-                ++draw_calls;
-            }
-        }
+        draw_calls += render_polylines( gpu_cmd_buf, render_pass );
 
-        m_QuadGPUBatch->clear();
-        m_LineGPUBatch->clear();
-        m_CircleGPUBatch->clear();
+        m_ShapeGPUBatch->clear();
+        m_PolygonGPUBatch->clear();
+        m_PolygonVertexGPUBatch->clear();
+        m_PolygonTriangleGPUBatch->clear();
+        m_PolylineGPUBatch->clear();
+        m_PolylinePointGPUBatch->clear();
+        m_PolylineSegmentGPUBatch->clear();
         return draw_calls;
     }
 
-    void Primitive2DPipeline::sort_quad_commands( const QuadCommandList& quad_command_list, bool opaque )
+    void Primitive2DPipeline::end_frame()
     {
-        m_SortedQuadCommands.clear();
+        m_PeakBufferBytes = std::max( m_PeakBufferBytes, get_gpu_buffer_bytes() );
+        m_ShapeGPUBatch->end_frame();
+        m_PolygonGPUBatch->end_frame();
+        m_PolygonVertexGPUBatch->end_frame();
+        m_PolygonTriangleGPUBatch->end_frame();
+        m_PolylineGPUBatch->end_frame();
+        m_PolylinePointGPUBatch->end_frame();
+        m_PolylineSegmentGPUBatch->end_frame();
+    }
 
-        if ( quad_command_list.size() > m_SortedQuadCommands.size() )
-            m_SortedQuadCommands.reserve( quad_command_list.size() );
+    size_t Primitive2DPipeline::get_gpu_buffer_bytes() const
+    {
+        size_t bytes = m_ShapeGPUBatch->get_allocated_bytes();
+        bytes += m_PolygonGPUBatch->get_allocated_bytes() + m_PolygonVertexGPUBatch->get_allocated_bytes() + m_PolygonTriangleGPUBatch->get_allocated_bytes();
+        bytes += m_PolylineGPUBatch->get_allocated_bytes() + m_PolylinePointGPUBatch->get_allocated_bytes() + m_PolylineSegmentGPUBatch->get_allocated_bytes();
+        return bytes;
+    }
 
-        for ( size_t i = 0; i < quad_command_list.size(); ++i ) {
-            m_SortedQuadCommands.push_back( &quad_command_list[ i ] );
-        }
+    size_t Primitive2DPipeline::get_gpu_buffer_peak_bytes() const
+    {
+        return std::max( m_PeakBufferBytes, get_gpu_buffer_bytes() );
+    }
 
-        auto command_sort = [ & ]( const QuadCommand* a, const QuadCommand* b ) {
-            if ( a->ContextIndex > b->ContextIndex )
-                return true;
+    void Primitive2DPipeline::sort_shape_commands( const QuadCommandList&        quad_command_list,
+                                                   const LineCommandList&        line_command_list,
+                                                   const CircleCommandList&      circle_command_list,
+                                                   const RoundedRectCommandList* rounded_rect_command_list,
+                                                   bool                          opaque )
+    {
+        m_SortedShapes.clear();
 
-            if ( opaque ) {
-                if ( a->Depth < b->Depth )
-                    return true;
-            }
-            else {
-                if ( a->Depth > b->Depth )
-                    return true;
+        // rounded rects are never opaque, the edges are anti aliased
+        size_t count = quad_command_list.size() + line_command_list.size() + circle_command_list.size();
+        if ( rounded_rect_command_list != nullptr )
+            count += rounded_rect_command_list->size();
+
+        m_SortedShapes.reserve( count );
+        for ( const QuadCommand& command : quad_command_list ) {
+            m_SortedShapes.push_back( { &command, ShapeType::Quad, command.Sequence } );
+        }
+        for ( const LineCommand& command : line_command_list ) {
+            m_SortedShapes.push_back( { &command, ShapeType::Line, command.Sequence } );
+        }
+        for ( const CircleCommand& command : circle_command_list ) {
+            m_SortedShapes.push_back( { &command, ShapeType::Circle, command.Sequence } );
+        }
+        if ( rounded_rect_command_list != nullptr ) {
+            for ( const RoundedRectCommand& command : *rounded_rect_command_list ) {
+                m_SortedShapes.push_back( { &command, ShapeType::RoundedRect, command.Sequence } );
             }
-            return false;
+        }
+
+        // shapes on the same layer keep the order they were added in
+        auto command_sort = [ & ]( const SortedShape& a, const SortedShape& b ) {
+            if ( a.Command->ContextIndex != b.Command->ContextIndex )
+                return a.Command->ContextIndex > b.Command->ContextIndex;
+
+            if ( a.Command->Depth != b.Command->Depth )
+                return opaque ? a.Command->Depth < b.Command->Depth : a.Command->Depth > b.Command->Depth;
+
+            return a.Sequence < b.Sequence;
         };
 
-        std::sort( m_SortedQuadCommands.begin(), m_SortedQuadCommands.end(), command_sort );
+        std::sort( m_SortedShapes.begin(), m_SortedShapes.end(), command_sort );
     }
 
-    void Primitive2DPipeline::sort_line_commands( const LineCommandList& line_command_list, bool opaque )
+    void Primitive2DPipeline::sort_polygon_commands( const PolygonCommandList& polygon_command_list, bool opaque )
     {
-        m_SortedLineCommands.clear();
+        m_SortedPolygonCommands.clear();
+        m_PolygonVertices = &polygon_command_list.Vertices;
 
-        if ( line_command_list.size() > m_SortedLineCommands.size() )
-            m_SortedLineCommands.reserve( line_command_list.size() );
+        if ( polygon_command_list.size() > m_SortedPolygonCommands.size() )
+            m_SortedPolygonCommands.reserve( polygon_command_list.size() );
 
-        for ( size_t i = 0; i < line_command_list.size(); ++i ) {
-            m_SortedLineCommands.push_back( &line_command_list[ i ] );
+        for ( size_t i = 0; i < polygon_command_list.Commands.size(); ++i ) {
+            m_SortedPolygonCommands.push_back( &polygon_command_list.Commands[ i ] );
         }
 
-        auto command_sort = [ & ]( const LineCommand* a, const LineCommand* b ) {
+        auto command_sort = [ & ]( const PolygonCommand* a, const PolygonCommand* b ) {
             if ( a->ContextIndex > b->ContextIndex )
                 return true;
 
@@ -181,50 +261,52 @@ namespace InnoEngine
             return false;
         };
 
-        std::sort( m_SortedLineCommands.begin(), m_SortedLineCommands.end(), command_sort );
+        std::sort( m_SortedPolygonCommands.begin(), m_SortedPolygonCommands.end(), command_sort );
     }
 
-    void Primitive2DPipeline::sort_circle_commands( const CircleCommandList& circle_command_list, bool opaque )
+    void Primitive2DPipeline::sort_polyline_commands( const PolylineCommandList* polyline_command_list )
     {
-        m_SortedCircleCommands.clear();
+        m_SortedPolylineCommands.clear();
+        m_PolylinePoints = nullptr;
+
+        // polylines are never opaque, the joins overlap the segments
+        if ( polyline_command_list == nullptr )
+            return;
 
-        if ( circle_command_list.size() > m_SortedCircleCommands.size() )
-            m_SortedCircleCommands.reserve( circle_command_list.size() );
+        m_PolylinePoints = &polyline_command_list->Points;
+        m_SortedPolylineCommands.reserve( polyline_command_list->Commands.size() );
 
-        for ( size_t i = 0; i < circle_command_list.size(); ++i ) {
-            m_SortedCircleCommands.push_back( &circle_command_list[ i ] );
+        for ( size_t i = 0; i < polyline_command_list->Commands.size(); ++i ) {
+            m_SortedPolylineCommands.push_back( &polyline_command_list->Commands[ i ] );
         }
 
-        auto command_sort = [ & ]( const CircleCommand* a, const CircleCommand* b ) {
+        auto command_sort = [ & ]( const PolylineCommand* a, const PolylineCommand* b ) {
             if ( a->ContextIndex > b->ContextIndex )
                 return true;
 
-            if ( opaque ) {
-                if ( a->Depth < b->Depth )
-                    return true;
-            }
-            else {
-                if ( a->Depth > b->Depth )
-                    return true;
-            }
+            if ( a->Depth > b->Depth )
+                return true;
             return false;
         };
 
-        std::sort( m_SortedCircleCommands.begin(), m_SortedCircleCommands.end(), command_sort );
+        std::sort( m_SortedPolylineCommands.begin(), m_SortedPolylineCommands.end(), command_sort );
     }
 
-    Result Primitive2DPipeline::load_quad_pipeline( SDL_Window* sdl_window, AssetRepository<Shader>* shader_repo )
+    Result Primitive2DPipeline::load_shape_pipeline( SDL_Window* sdl_window, AssetRepository<Shader>* shader_repo )
     {
         // load shaders
-        auto vertexShaderAsset = shader_repo->require_asset( "QuadBatch.vert" );
+        auto vertexShaderAsset = shader_repo->require_asset( "ShapeBatch.vert" );
         if ( vertexShaderAsset.has_value() == false ) {
-            IE_LOG_ERROR( "Vertex Shader not found: {}", "QuadBatch.vert" );
+            IE_LOG_ERROR( "Vertex Shader not found: {}", "ShapeBatch.vert" );
             return Result::InitializationError;
         }
 
-        auto fragmentShaderAsset = shader_repo->require_asset( "Color.frag" );
+        if ( IE_FAILED( vertexShaderAsset.value().get()->require_uniform_buffers( 1 ) ) )
+            return Result::InitializationError;
+
+        auto fragmentShaderAsset = shader_repo->require_asset( "Shape.frag" );
         if ( fragmentShaderAsset.has_value() == false ) {
-            IE_LOG_ERROR( "Fragment Shader not found: {}", "Color.frag" );
+            IE_LOG_ERROR( "Fragment Shader not found: {}", "Shape.frag" );
             return Result::InitializationError;
         }
 
@@ -258,28 +340,31 @@ namespace InnoEngine
         pipelineCreateInfo.depth_stencil_state.enable_stencil_test = false;
         pipelineCreateInfo.depth_stencil_state.write_mask          = 0xFF;
 
-        m_QuadPipeline = SDL_CreateGPUGraphicsPipeline( m_Device, &pipelineCreateInfo );
-        if ( m_QuadPipeline == nullptr ) {
+        m_ShapePipeline = SDL_CreateGPUGraphicsPipeline( m_Device, &pipelineCreateInfo );
+        if ( m_ShapePipeline == nullptr ) {
             IE_LOG_ERROR( "Failed to create pipeline!" );
             return Result::InitializationError;
         }
 
-        m_QuadGPUBatch = GPUBatchStorageBuffer<QuadStorageBufferLayout, BatchData>::create( m_Device, QuadBatchSize );
+        m_ShapeGPUBatch = GPUBatchStorageBuffer<ShapeStorageBufferLayout, BatchData>::create( m_Device, ShapeBatchSize );
         return Result::Success;
     }
 
-    Result Primitive2DPipeline::load_line_pipeline( SDL_Window* sdl_window, AssetRepository<Shader>* shader_repo )
+    Result Primitive2DPipeline::load_polyline_pipeline( SDL_Window* sdl_window, AssetRepository<Shader>* shader_repo )
     {
         // load shaders
-        auto vertexShaderAsset = shader_repo->require_asset( "LineBatch.vert" );
+        auto vertexShaderAsset = shader_repo->require_asset( "PolylineBatch.vert" );
         if ( vertexShaderAsset.has_value() == false ) {
-            IE_LOG_ERROR( "Vertex Shader not found: {}", "LineBatch.vert" );
+            IE_LOG_ERROR( "Vertex Shader not found: {}", "PolylineBatch.vert" );
             return Result::InitializationError;
         }
 
-        auto fragmentShaderAsset = shader_repo->require_asset( "Line.frag" );
+        if ( IE_FAILED( vertexShaderAsset.value().get()->require_uniform_buffers( 1 ) ) )
+            return Result::InitializationError;
+
+        auto fragmentShaderAsset = shader_repo->require_asset( "Polyline.frag" );
         if ( fragmentShaderAsset.has_value() == false ) {
-            IE_LOG_ERROR( "Fragment Shader not found: {}", "Line.frag" );
+            IE_LOG_ERROR( "Fragment Shader not found: {}", "Polyline.frag" );
             return Result::InitializationError;
         }
 
@@ -313,28 +398,33 @@ namespace InnoEngine
         pipelineCreateInfo.depth_stencil_state.enable_stencil_test = false;
         pipelineCreateInfo.depth_stencil_state.write_mask          = 0xFF;
 
-        m_LinePipeline = SDL_CreateGPUGraphicsPipeline( m_Device, &pipelineCreateInfo );
-        if ( m_LinePipeline == nullptr ) {
+        m_PolylinePipeline = SDL_CreateGPUGraphicsPipeline( m_Device, &pipelineCreateInfo );
+        if ( m_PolylinePipeline == nullptr ) {
             IE_LOG_ERROR( "Failed to create pipeline!" );
             return Result::InitializationError;
         }
 
-        m_LineGPUBatch = GPUBatchStorageBuffer<LineStorageBufferLayout, BatchData>::create( m_Device, LineBatchSize );
+        m_PolylineGPUBatch        = GPUBatchStorageBuffer<PolylineStorageBufferLayout, BatchData>::create( m_Device, PolylineBatchSize );
+        m_PolylinePointGPUBatch   = GPUBatchStorageBuffer<DXSM::Vector2, BatchData>::create( m_Device, MaxPolylinePoints );
+        m_PolylineSegmentGPUBatch = GPUBatchStorageBuffer<uint32_t, BatchData>::create( m_Device, MaxPolylinePoints );
         return Result::Success;
     }
 
-    Result Primitive2DPipeline::load_circle_pipeline( SDL_Window* sdl_window, AssetRepository<Shader>* shader_repo )
+    Result Primitive2DPipeline::load_polygon_pipeline( SDL_Window* sdl_window, AssetRepository<Shader>* shader_repo )
     {
         // load shaders
-        auto vertexShaderAsset = shader_repo->require_asset( "CircleBatch.vert" );
+        auto vertexShaderAsset = shader_repo->require_asset( "PolygonBatch.vert" );
         if ( vertexShaderAsset.has_value() == false ) {
-            IE_LOG_ERROR( "Vertex Shader not found: {}", "CircleBatch.vert" );
+            IE_LOG_ERROR( "Vertex Shader not found: {}", "PolygonBatch.vert" );
             return Result::InitializationError;
         }
 
-        auto fragmentShaderAsset = shader_repo->require_asset( "Circle.frag" );
+        if ( IE_FAILED( vertexShaderAsset.value().get()->require_uniform_buffers( 1 ) ) )
+            return Result::InitializationError;
+
+        auto fragmentShaderAsset = shader_repo->require_asset( "Color.frag" );
         if ( fragmentShaderAsset.has_value() == false ) {
-            IE_LOG_ERROR( "Fragment Shader not found: {}", "Circle.frag" );
+            IE_LOG_ERROR( "Fragment Shader not found: {}", "Color.frag" );
             return Result::InitializationError;
         }
 
@@ -368,21 +458,27 @@ namespace InnoEngine
         pipelineCreateInfo.depth_stencil_state.enable_stencil_test = false;
         pipelineCreateInfo.depth_stencil_state.write_mask          = 0xFF;
 
-        m_CirclePipeline = SDL_CreateGPUGraphicsPipeline( m_Device, &pipelineCreateInfo );
-        if ( m_CirclePipeline == nullptr ) {
+        m_PolygonPipeline = SDL_CreateGPUGraphicsPipeline( m_Device, &pipelineCreateInfo );
+        if ( m_PolygonPipeline == nullptr ) {
             IE_LOG_ERROR( "Failed to create pipeline!" );
             return Result::InitializationError;
         }
 
-        m_CircleGPUBatch = GPUBatchStorageBuffer<CircleStorageBufferLayout, BatchData>::create( m_Device, CircleBatchSize );
+        m_PolygonGPUBatch         = GPUBatchStorageBuffer<PolygonStorageBufferLayout, BatchData>::create( m_Device, PolygonBatchSize );
+        m_PolygonVertexGPUBatch   = GPUBatchStorageBuffer<DXSM::Vector2, BatchData>::create( m_Device, MaxPolygonVertices );
+        m_PolygonTriangleGPUBatch = GPUBatchStorageBuffer<uint32_t, BatchData>::create( m_Device, MaxPolygonVertices );
         return Result::Success;
     }
 
     uint32_t Primitive2DPipeline::prepare_batches()
     {
-        m_QuadGPUBatch->clear();
-        m_LineGPUBatch->clear();
-        m_CircleGPUBatch->clear();
+        m_ShapeGPUBatch->clear();
+        m_PolygonGPUBatch->clear();
+        m_PolygonVertexGPUBatch->clear();
+        m_PolygonTriangleGPUBatch->clear();
+        m_PolylineGPUBatch->clear();
+        m_PolylinePointGPUBatch->clear();
+        m_PolylineSegmentGPUBatch->clear();
 
         SDL_GPUCommandBuffer* gpu_copy_cmd_buf = SDL_AcquireGPUCommandBuffer( m_Device );
         if ( gpu_copy_cmd_buf == nullptr ) {
@@ -392,78 +488,263 @@ namespace InnoEngine
 
         SDL_GPUCopyPass* copy_pass = SDL_BeginGPUCopyPass( gpu_copy_cmd_buf );
 
+        prepare_shape_batches( copy_pass );
+
+        prepare_polygon_batches( copy_pass );
+
+        prepare_polyline_batches( copy_pass );
+
+        SDL_EndGPUCopyPass( copy_pass );
+
+        if ( SDL_SubmitGPUCommandBuffer( gpu_copy_cmd_buf ) == false ) {
+            IE_LOG_ERROR( "SDL_SubmitGPUCommandBuffer failed: {}", SDL_GetError() );
+            return 0;
+        }
+
+        size_t batch_count = m_ShapeGPUBatch->size();
+        batch_count += m_PolygonGPUBatch->size();
+        batch_count += m_PolylineGPUBatch->size();
+        return static_cast<uint32_t>( batch_count );
+    }
+
+    void Primitive2DPipeline::prepare_shape_batches( SDL_GPUCopyPass* copy_pass )
+    {
         BatchData* current = nullptr;
-        for ( const QuadCommand* command : m_SortedQuadCommands ) {
-            if ( m_QuadGPUBatch->current_batch_full() ||
+        for ( const SortedShape& shape : m_SortedShapes ) {
+            if ( m_ShapeGPUBatch->current_batch_full() ||
+                 current == nullptr ||
+                 current->ContextIndex != shape.Command->ContextIndex ) {
+
+                current               = m_ShapeGPUBatch->upload_and_add_batch( copy_pass );
+                current->ContextIndex = shape.Command->ContextIndex;
+            }
+
+            ShapeStorageBufferLayout* buffer_data = m_ShapeGPUBatch->next_data();
+
+            buffer_data->ContextIndex = shape.Command->ContextIndex;
+            buffer_data->Depth        = shape.Command->Depth;
+            buffer_data->Type         = shape.Type;
+            buffer_data->Rotation     = 0.0f;
+            buffer_data->Thickness    = 0.0f;
+            buffer_data->Fade         = 0.0f;
+            buffer_data->CornerRadius = 0.0f;
+
+            switch ( shape.Type ) {
+            case ShapeType::Quad:
+            {
+                const QuadCommand* command = static_cast<const QuadCommand*>( shape.Command );
+                buffer_data->Color         = command->Color;
+                buffer_data->HalfSize      = command->Size * 0.5f;
+                buffer_data->Rotation      = command->Rotation;
+                buffer_data->Center        = command->Position + command->RotationOrigin + rotate( buffer_data->HalfSize - command->RotationOrigin, command->Rotation );
+                break;
+            }
+            case ShapeType::Line:
+            {
+                const LineCommand*  command = static_cast<const LineCommand*>( shape.Command );
+                const DXSM::Vector2 delta   = command->End - command->Start;
+                buffer_data->Color          = command->Color;
+                buffer_data->Center         = ( command->Start + command->End ) * 0.5f;
+                buffer_data->HalfSize       = { delta.Length() * 0.5f, command->Thickness * 0.5f };
+                buffer_data->Rotation       = std::atan2( delta.y, delta.x );
+                buffer_data->Fade           = command->EdgeFade;
+                break;
+            }
+            case ShapeType::Circle:
+            {
+                const CircleCommand* command = static_cast<const CircleCommand*>( shape.Command );
+                buffer_data->Color           = command->Color;
+                buffer_data->Center          = command->Position + DXSM::Vector2( command->Radius );
+                buffer_data->HalfSize        = DXSM::Vector2( command->Radius );
+                buffer_data->Thickness       = command->Thickness;
+                buffer_data->Fade            = command->Fade;
+                break;
+            }
+            case ShapeType::RoundedRect:
+            {
+                const RoundedRectCommand* command = static_cast<const RoundedRectCommand*>( shape.Command );
+                buffer_data->Color                = command->Color;
+                buffer_data->HalfSize             = command->Size * 0.5f;
+                buffer_data->Center               = command->Position + buffer_data->HalfSize;
+                buffer_data->Rotation             = command->Rotation;
+                buffer_data->Thickness            = command->Thickness;
+                buffer_data->Fade                 = command->EdgeFade;
+                buffer_data->CornerRadius         = command->CornerRadius;
+                break;
+            }
+            }
+        }
+        m_ShapeGPUBatch->upload_last( copy_pass );
+    }
+
+    void Primitive2DPipeline::prepare_polygon_batches( SDL_GPUCopyPass* copy_pass )
+    {
+        // the three buffers always start new batches together, so the batch lists line up
+        BatchData* current        = nullptr;
+        uint32_t   polygon_index  = 0;
+        uint32_t   vertex_index   = 0;
+        uint32_t   triangle_index = 0;
+        for ( const PolygonCommand* command : m_SortedPolygonCommands ) {
+            const uint32_t triangle_count = command->VertexCount - 2;
+
+            if ( m_PolygonGPUBatch->current_batch_full() ||
                  current == nullptr ||
-                 current->ContextIndex != command->ContextIndex ) {
+                 current->ContextIndex != command->ContextIndex ||
+                 m_PolygonVertexGPUBatch->get_current_batch_remaining_size() < command->VertexCount ||
+                 m_PolygonTriangleGPUBatch->get_current_batch_remaining_size() < triangle_count ) {
 
-                current               = m_QuadGPUBatch->upload_and_add_batch( copy_pass );
+                current               = m_PolygonGPUBatch->upload_and_add_batch( copy_pass );
                 current->ContextIndex = command->ContextIndex;
+                m_PolygonVertexGPUBatch->upload_and_add_batch( copy_pass )->ContextIndex   = command->ContextIndex;
+                m_PolygonTriangleGPUBatch->upload_and_add_batch( copy_pass )->ContextIndex = command->ContextIndex;
+
+                polygon_index  = 0;
+                vertex_index   = 0;
+                triangle_index = 0;
             }
 
-            QuadStorageBufferLayout* buffer_data = m_QuadGPUBatch->next_data();
+            PolygonStorageBufferLayout* buffer_data = m_PolygonGPUBatch->next_data();
+
+            buffer_data->Color         = command->Color;
+            buffer_data->FirstVertex   = vertex_index;
+            buffer_data->VertexCount   = command->VertexCount;
+            buffer_data->FirstTriangle = triangle_index;
+            buffer_data->Depth         = command->Depth;
+            buffer_data->ContextIndex  = command->ContextIndex;
 
-            buffer_data->ContextIndex   = command->ContextIndex;
-            buffer_data->Color          = command->Color;
-            buffer_data->Depth          = command->Depth;
-            buffer_data->Position       = command->Position;
-            buffer_data->Rotation       = command->Rotation;
-            buffer_data->RotationOrigin = command->RotationOrigin;
-            buffer_data->Size           = command->Size;
+            const DXSM::Vector2* vertices = m_PolygonVertices->data() + command->FirstVertex;
+            for ( uint32_t i = 0; i < command->VertexCount; ++i ) {
+                *m_PolygonVertexGPUBatch->next_data() = vertices[ i ];
+            }
+
+            for ( uint32_t i = 0; i < triangle_count; ++i ) {
+                *m_PolygonTriangleGPUBatch->next_data() = polygon_index;
+            }
+
+            ++polygon_index;
+            vertex_index   += command->VertexCount;
+            triangle_index += triangle_count;
         }
-        m_QuadGPUBatch->upload_last( copy_pass );
+        m_PolygonGPUBatch->upload_last( copy_pass );
+        m_PolygonVertexGPUBatch->upload_last( copy_pass );
+        m_PolygonTriangleGPUBatch->upload_last( copy_pass );
+    }
 
-        current = nullptr;
-        for ( const LineCommand* command : m_SortedLineCommands ) {
-            if ( m_LineGPUBatch->current_batch_full() ||
+    void Primitive2DPipeline::prepare_polyline_batches( SDL_GPUCopyPass* copy_pass )
+    {
+        // the three buffers always start new batches together, so the batch lists line up
+        BatchData* current        = nullptr;
+        uint32_t   polyline_index = 0;
+        uint32_t   point_index    = 0;
+        uint32_t   segment_index  = 0;
+        for ( const PolylineCommand* command : m_SortedPolylineCommands ) {
+            const uint32_t segment_count = get_segment_count( *command );
+
+            if ( m_PolylineGPUBatch->current_batch_full() ||
                  current == nullptr ||
-                 current->ContextIndex != command->ContextIndex ) {
+                 current->ContextIndex != command->ContextIndex ||
+                 m_PolylinePointGPUBatch->get_current_batch_remaining_size() < command->PointCount ||
+                 m_PolylineSegmentGPUBatch->get_current_batch_remaining_size() < segment_count ) {
 
-                current               = m_LineGPUBatch->upload_and_add_batch( copy_pass );
+                current               = m_PolylineGPUBatch->upload_and_add_batch( copy_pass );
                 current->ContextIndex = command->ContextIndex;
+                m_PolylinePointGPUBatch->upload_and_add_batch( copy_pass )->ContextIndex   = command->ContextIndex;
+                m_PolylineSegmentGPUBatch->upload_and_add_batch( copy_pass )->ContextIndex = command->ContextIndex;
+
+                polyline_index = 0;
+                point_index    = 0;
+                segment_index  = 0;
             }
 
-            LineStorageBufferLayout* buffer_data = m_LineGPUBatch->next_data();
+            PolylineStorageBufferLayout* buffer_data = m_PolylineGPUBatch->next_data();
 
-            buffer_data->ContextIndex = command->ContextIndex;
             buffer_data->Color        = command->Color;
+            buffer_data->FirstPoint   = point_index;
+            buffer_data->PointCount   = command->PointCount;
+            buffer_data->FirstSegment = segment_index;
+            buffer_data->Flags        = static_cast<uint32_t>( command->Join ) | static_cast<uint32_t>( command->Cap ) << 2 | ( command->Closed ? 1u : 0u ) << 4;
             buffer_data->Thickness    = command->Thickness;
             buffer_data->EdgeFade     = command->EdgeFade;
-            buffer_data->Start        = command->Start;
-            buffer_data->End          = command->End;
             buffer_data->Depth        = command->Depth;
-        }
-        m_LineGPUBatch->upload_last( copy_pass );
+            buffer_data->ContextIndex = command->ContextIndex;
 
-        current = nullptr;
-        for ( const CircleCommand* command : m_SortedCircleCommands ) {
-            if ( m_CircleGPUBatch->current_batch_full() ||
-                 current == nullptr ||
-                 current->ContextIndex != command->ContextIndex ) {
+            const DXSM::Vector2* points = m_PolylinePoints->data() + command->FirstPoint;
+            for ( uint32_t i = 0; i < command->PointCount; ++i ) {
+                *m_PolylinePointGPUBatch->next_data() = points[ i ];
+            }
 
-                current               = m_CircleGPUBatch->upload_and_add_batch( copy_pass );
-                current->ContextIndex = command->ContextIndex;
+            for ( uint32_t i = 0; i < segment_count; ++i ) {
+                *m_PolylineSegmentGPUBatch->next_data() = polyline_index;
             }
-            CircleStorageBufferLayout* buffer_data = m_CircleGPUBatch->next_data();
 
-            buffer_data->ContextIndex = command->ContextIndex;
-            buffer_data->Color        = command->Color;
-            buffer_data->Depth        = command->Depth;
-            buffer_data->Position     = command->Position;
-            buffer_data->Fade         = command->Fade;
-            buffer_data->Thickness    = command->Thickness;
-            buffer_data->Radius       = command->Radius;
+            ++polyline_index;
+            point_index   += command->PointCount;
+            segment_index += segment_count;
         }
-        m_CircleGPUBatch->upload_last( copy_pass );
+        m_PolylineGPUBatch->upload_last( copy_pass );
+        m_PolylinePointGPUBatch->upload_last( copy_pass );
+        m_PolylineSegmentGPUBatch->upload_last( copy_pass );
+    }
 
-        SDL_EndGPUCopyPass( copy_pass );
+    uint32_t Primitive2DPipeline::render_polygons( SDL_GPUCommandBuffer* gpu_cmd_buf, SDL_GPURenderPass* render_pass )
+    {
+        const auto& polygon_batches  = m_PolygonGPUBatch->get_batchlist();
+        const auto& vertex_batches   = m_PolygonVertexGPUBatch->get_batchlist();
+        const auto& triangle_batches = m_PolygonTriangleGPUBatch->get_batchlist();
 
-        if ( SDL_SubmitGPUCommandBuffer( gpu_copy_cmd_buf ) == false ) {
-            IE_LOG_ERROR( "SDL_SubmitGPUCommandBuffer failed: {}", SDL_GetError() );
+        if ( polygon_batches.empty() )
+            return 0;
+
+        // a failed upload drops a batch, the others would not match anymore
+        if ( polygon_batches.size() != vertex_batches.size() || polygon_batches.size() != triangle_batches.size() ) {
+            IE_LOG_WARNING( "Polygon batches out of sync, skipping polygons this frame" );
+            return 0;
+        }
+
+        uint32_t draw_calls = 0;
+        SDL_BindGPUGraphicsPipeline( render_pass, m_PolygonPipeline );
+        for ( size_t i = 0; i < polygon_batches.size(); ++i ) {
+            SDL_GPUBuffer* buffers[ 3 ] = { polygon_batches[ i ].GPUBuffer, vertex_batches[ i ].GPUBuffer, triangle_batches[ i ].GPUBuffer };
+            SDL_BindGPUVertexStorageBuffers( render_pass, 1, buffers, 3 );
+
+            PolygonUniforms uniforms = { polygon_batches[ i ].Offset, vertex_batches[ i ].Offset, triangle_batches[ i ].Offset };
+            SDL_PushGPUVertexUniformData( gpu_cmd_buf, 0, &uniforms, sizeof( uniforms ) );
+
+            const auto& triangles = triangle_batches[ i ];
+            SDL_DrawGPUPrimitives( render_pass, triangles.Count * 3, 1, 0, 0 );
+            ++draw_calls;
+        }
+        return draw_calls;
+    }
+
+    uint32_t Primitive2DPipeline::render_polylines( SDL_GPUCommandBuffer* gpu_cmd_buf, SDL_GPURenderPass* render_pass )
+    {
+        const auto& polyline_batches = m_PolylineGPUBatch->get_batchlist();
+        const auto& point_batches    = m_PolylinePointGPUBatch->get_batchlist();
+        const auto& segment_batches  = m_PolylineSegmentGPUBatch->get_batchlist();
+
+        if ( polyline_batches.empty() )
+            return 0;
+
+        // a failed upload drops a batch, the others would not match anymore
+        if ( polyline_batches.size() != point_batches.size() || polyline_batches.size() != segment_batches.size() ) {
+            IE_LOG_WARNING( "Polyline batches out of sync, skipping polylines this frame" );
             return 0;
         }
 
-        return static_cast<uint32_t>( m_QuadGPUBatch->size() + m_LineGPUBatch->size() + m_CircleGPUBatch->size() );
+        uint32_t draw_calls = 0;
+        SDL_BindGPUGraphicsPipeline( render_pass, m_PolylinePipeline );
+        for ( size_t i = 0; i < polyline_batches.size(); ++i ) {
+            SDL_GPUBuffer* buffers[ 3 ] = { polyline_batches[ i ].GPUBuffer, point_batches[ i ].GPUBuffer, segment_batches[ i ].GPUBuffer };
+            SDL_BindGPUVertexStorageBuffers( render_pass, 1, buffers, 3 );
+
+            PolylineUniforms uniforms = { polyline_batches[ i ].Offset, point_batches[ i ].Offset, segment_batches[ i ].Offset };
+            SDL_PushGPUVertexUniformData( gpu_cmd_buf, 0, &uniforms, sizeof( uniforms ) );
+
+            const auto& segments = segment_batches[ i ];
+            SDL_DrawGPUPrimitives( render_pass, segments.Count * PolylineSegmentVertices, 1, 0, 0 );
+            ++draw_calls;
+        }
+        return draw_calls;
     }
 }    // namespace InnoEngine
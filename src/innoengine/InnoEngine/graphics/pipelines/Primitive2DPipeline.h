@@ -23,17 +23,16 @@ namespace InnoEngine
             RenderCommandBufferIndexType ContextIndex = InvalidRenderCommandBufferIndex;
         };
 
-        struct QuadCommand : RenderCommandBase
+        // has to match Shape.frag.hlsl
+        enum class ShapeType : uint32_t
         {
-            DXSM::Vector2 Position;
-            DXSM::Vector2 Size;
-            DXSM::Color   Color;
-
-            DXSM::Vector2 RotationOrigin;
-            float         Rotation;
+            Quad = 0,
+            Line,
+            Circle,
+            RoundedRect,
         };
 
-        struct QuadStorageBufferLayout
+        struct QuadCommand : RenderCommandBase
         {
             DXSM::Vector2 Position;
             DXSM::Vector2 Size;
@@ -41,9 +40,7 @@ namespace InnoEngine
 
             DXSM::Vector2 RotationOrigin;
             float         Rotation;
-            float         Depth;
-            uint32_t      ContextIndex;
-            float         pad[ 3 ];
+            uint32_t      Sequence;    // submission order of the shapes inside the context
         };
 
         struct LineCommand : RenderCommandBase
@@ -53,17 +50,70 @@ namespace InnoEngine
             DXSM::Color   Color;
             float         Thickness;
             float         EdgeFade;
+            uint32_t      Sequence;
         };
 
-        struct LineStorageBufferLayout
+        // the points live in PolylineCommandList::Points, consecutive duplicates are already removed
+        struct PolylineCommand : RenderCommandBase
         {
-            DXSM::Vector2 Start;
-            DXSM::Vector2 End;
-            DXSM::Color   Color;
-            float         Thickness;
-            float         EdgeFade;
-            float         Depth;
-            uint32_t      ContextIndex;
+            uint32_t    FirstPoint;
+            uint32_t    PointCount;
+            DXSM::Color Color;
+            float       Thickness;
+            float       EdgeFade;
+            LineJoin    Join;
+            LineCap     Cap;
+            bool        Closed;
+        };
+
+        struct PolylineStorageBufferLayout
+        {
+            DXSM::Color Color;
+            uint32_t    FirstPoint;      // inside the point batch
+            uint32_t    PointCount;
+            uint32_t    FirstSegment;    // inside the segment batch
+            uint32_t    Flags;           // join | cap << 2 | closed << 4
+            float       Thickness;
+            float       EdgeFade;
+            float       Depth;
+            uint32_t    ContextIndex;
+        };
+
+        struct PolylineCommandList
+        {
+            std::vector<PolylineCommand> Commands;
+            std::vector<DXSM::Vector2>   Points;    // shared by all polylines of the frame
+
+            size_t size() const;
+            void   clear();
+        };
+
+        // convex, the vertices live in PolygonCommandList::Vertices and get triangulated as a fan
+        struct PolygonCommand : RenderCommandBase
+        {
+            uint32_t    FirstVertex;
+            uint32_t    VertexCount;
+            DXSM::Color Color;
+        };
+
+        struct PolygonStorageBufferLayout
+        {
+            DXSM::Color Color;
+            uint32_t    FirstVertex;      // inside the vertex batch
+            uint32_t    VertexCount;
+            uint32_t    FirstTriangle;    // inside the triangle batch
+            float       Depth;
+            uint32_t    ContextIndex;
+            float       pad[ 3 ];
+        };
+
+        struct PolygonCommandList
+        {
+            std::vector<PolygonCommand> Commands;
+            std::vector<DXSM::Vector2>  Vertices;    // shared by all polygons of the frame
+
+            size_t size() const;
+            void   clear();
         };
 
         struct CircleCommand : RenderCommandBase
@@ -73,69 +123,149 @@ namespace InnoEngine
             float         Radius;
             float         Thickness;
             float         Fade;
+            uint32_t      Sequence;
         };
 
-        struct CircleStorageBufferLayout
+        struct RoundedRectCommand : RenderCommandBase
         {
+            DXSM::Vector2 Position;    // after origin_transform
+            DXSM::Vector2 Size;
             DXSM::Color   Color;
-            DXSM::Vector2 Position;
-            float         Radius;
+            float         CornerRadius;
+            float         Thickness;    // in world units, 0 fills the rect
+            float         EdgeFade;     // in world units
+            float         Rotation;     // around the center
+            uint32_t      Sequence;
+        };
+
+        // every shape type in one layout, drawn by ShapeBatch.vert as a rotated quad around the center
+        struct ShapeStorageBufferLayout
+        {
+            DXSM::Color   Color;
+            DXSM::Vector2 Center;
+            DXSM::Vector2 HalfSize;
+            float         Rotation;
             float         Thickness;
             float         Fade;
+            float         CornerRadius;
             float         Depth;
             uint32_t      ContextIndex;
+            ShapeType     Type;
             float         pad[ 1 ];
         };
 
-        using QuadCommandList   = std::vector<QuadCommand>;
-        using LineCommandList   = std::vector<LineCommand>;
-        using CircleCommandList = std::vector<CircleCommand>;
+        using QuadCommandList        = std::vector<QuadCommand>;
+        using LineCommandList        = std::vector<LineCommand>;
+        using CircleCommandList      = std::vector<CircleCommand>;
+        using RoundedRectCommandList = std::vector<RoundedRectCommand>;
+
+        const uint32_t ShapeBatchSize = 20000;
 
-        const uint32_t QuadBatchSize   = 20000;
-        const uint32_t LineBatchSize   = 20000;
-        const uint32_t CircleBatchSize = 20000;
+        static constexpr uint32_t PolylineBatchSize       = 4096;
+        static constexpr uint32_t MaxPolylinePoints       = 65536;    // points per batch, longer polylines get cut
+        static constexpr uint32_t PolylineSegmentVertices = 18;       // has to match PolylineBatch.vert.hlsl
+        static constexpr uint32_t PolygonBatchSize        = 4096;
+        static constexpr uint32_t MaxPolygonVertices      = 65536;    // vertices per batch
 
         ~Primitive2DPipeline();
 
         Result   initialize( GPURenderer* renderer, AssetManager* asset_manager );
-        uint32_t prepare_render_opaque( const QuadCommandList&   quad_command_list,
-                                        const LineCommandList&   line_command_list,
-                                        const CircleCommandList& circle_command_list );
-        uint32_t prepare_render( const QuadCommandList&   quad_command_list,
-                                 const LineCommandList&   line_command_list,
-                                 const CircleCommandList& circle_command_list );
+        uint32_t prepare_render_opaque( const QuadCommandList&    quad_command_list,
+                                        const LineCommandList&    line_command_list,
+                                        const CircleCommandList&  circle_command_list,
+                                        const PolygonCommandList& polygon_command_list );
+        uint32_t prepare_render( const QuadCommandList&        quad_command_list,
+                                 const LineCommandList&        line_command_list,
+                                 const CircleCommandList&      circle_command_list,
+                                 const RoundedRectCommandList& rounded_rect_command_list,
+                                 const PolygonCommandList&     polygon_command_list,
+                                 const PolylineCommandList&    polyline_command_list );
         uint32_t swapchain_render( const RenderContextFrameData& render_ctx_data,
+                                   SDL_GPUCommandBuffer*         gpu_cmd_buf,
                                    SDL_GPURenderPass*            render_pass );
 
-        void sort_quad_commands( const QuadCommandList& quad_command_list, bool opaque );
-        void sort_line_commands( const LineCommandList& quad_command_list, bool opaque );
-        void sort_circle_commands( const CircleCommandList& circle_command_list, bool opaque );
+        void   end_frame();    // trims gpu buffers which were not needed for a while
+        size_t get_gpu_buffer_bytes() const;
+        size_t get_gpu_buffer_peak_bytes() const;
+
+        // merges quads, lines, circles and rounded rects, nullptr for no rounded rects
+        void sort_shape_commands( const QuadCommandList&        quad_command_list,
+                                  const LineCommandList&        line_command_list,
+                                  const CircleCommandList&      circle_command_list,
+                                  const RoundedRectCommandList* rounded_rect_command_list,
+                                  bool                          opaque );
+        void sort_polygon_commands( const PolygonCommandList& polygon_command_list, bool opaque );
+        void sort_polyline_commands( const PolylineCommandList* polyline_command_list );    // nullptr for none
 
     private:
-        Result load_quad_pipeline( SDL_Window* sdl_window, AssetRepository<Shader>* shader_repo );
-        Result load_line_pipeline( SDL_Window* sdl_window, AssetRepository<Shader>* shader_repo );
-        Result load_circle_pipeline( SDL_Window* sdl_window, AssetRepository<Shader>* shader_repo );
+        Result load_shape_pipeline( SDL_Window* sdl_window, AssetRepository<Shader>* shader_repo );
+        Result load_polygon_pipeline( SDL_Window* sdl_window, AssetRepository<Shader>* shader_repo );
+        Result load_polyline_pipeline( SDL_Window* sdl_window, AssetRepository<Shader>* shader_repo );
 
         uint32_t prepare_batches();
+        void     prepare_shape_batches( SDL_GPUCopyPass* copy_pass );
+        void     prepare_polygon_batches( SDL_GPUCopyPass* copy_pass );
+        void     prepare_polyline_batches( SDL_GPUCopyPass* copy_pass );
+        uint32_t render_polygons( SDL_GPUCommandBuffer* gpu_cmd_buf, SDL_GPURenderPass* render_pass );
+        uint32_t render_polylines( SDL_GPUCommandBuffer* gpu_cmd_buf, SDL_GPURenderPass* render_pass );
+
+        struct SortedShape
+        {
+            const RenderCommandBase* Command;
+            ShapeType                Type;
+            uint32_t                 Sequence;
+        };
+
+        // the vertex shaders index their batch from this element of the shared page on
+        struct BatchUniforms
+        {
+            uint32_t BatchOffset;
+            uint32_t pad[ 3 ];
+        };
+
+        struct PolygonUniforms
+        {
+            uint32_t PolygonOffset;
+            uint32_t VertexOffset;
+            uint32_t TriangleOffset;
+        };
+
+        struct PolylineUniforms
+        {
+            uint32_t PolylineOffset;
+            uint32_t PointOffset;
+            uint32_t SegmentOffset;
+        };
 
     private:
         bool         m_Initialized = false;
         GPUDeviceRef m_Device      = nullptr;
 
-        SDL_GPUGraphicsPipeline*                                       m_QuadPipeline = nullptr;
-        std::vector<const QuadCommand*>                                m_SortedQuadCommands;    // objects owned by the RenderCommandBuffer
-        Ref<GPUBatchStorageBuffer<QuadStorageBufferLayout, BatchData>> m_QuadGPUBatch = nullptr;
+        SDL_GPUGraphicsPipeline*                                        m_ShapePipeline = nullptr;
+        std::vector<SortedShape>                                        m_SortedShapes;    // objects owned by the RenderCommandBuffer
+        Ref<GPUBatchStorageBuffer<ShapeStorageBufferLayout, BatchData>> m_ShapeGPUBatch = nullptr;
+
+        SDL_GPUGraphicsPipeline*                                          m_PolygonPipeline = nullptr;
+        std::vector<const PolygonCommand*>                                m_SortedPolygonCommands;    // objects owned by the RenderCommandBuffer
+        const std::vector<DXSM::Vector2>*                                 m_PolygonVertices         = nullptr;
+        Ref<GPUBatchStorageBuffer<PolygonStorageBufferLayout, BatchData>> m_PolygonGPUBatch         = nullptr;
+        Ref<GPUBatchStorageBuffer<DXSM::Vector2, BatchData>>              m_PolygonVertexGPUBatch   = nullptr;
+        Ref<GPUBatchStorageBuffer<uint32_t, BatchData>>                   m_PolygonTriangleGPUBatch = nullptr;
 
-        SDL_GPUGraphicsPipeline*                                       m_LinePipeline = nullptr;
-        std::vector<const LineCommand*>                                m_SortedLineCommands;    // objects owned by the RenderCommandBuffer
-        Ref<GPUBatchStorageBuffer<LineStorageBufferLayout, BatchData>> m_LineGPUBatch = nullptr;
+        SDL_GPUGraphicsPipeline*                                           m_PolylinePipeline = nullptr;
+        std::vector<const PolylineCommand*>                                m_SortedPolylineCommands;    // objects owned by the RenderCommandBuffer
+        const std::vector<DXSM::Vector2>*                                  m_PolylinePoints          = nullptr;
+        Ref<GPUBatchStorageBuffer<PolylineStorageBufferLayout, BatchData>> m_PolylineGPUBatch        = nullptr;
+        Ref<GPUBatchStorageBuffer<DXSM::Vector2, BatchData>>               m_PolylinePointGPUBatch   = nullptr;
+        Ref<GPUBatchStorageBuffer<uint32_t, BatchData>>                    m_PolylineSegmentGPUBatch = nullptr;
 
-        SDL_GPUGraphicsPipeline*                                         m_CirclePipeline = nullptr;
-        std::vector<const CircleCommand*>                                m_SortedCircleCommands;    // objects owned by the RenderCommandBuffer
-        Ref<GPUBatchStorageBuffer<CircleStorageBufferLayout, BatchData>> m_CircleGPUBatch = nullptr;
+        size_t m_PeakBufferBytes = 0;
     };
 
-    using QuadCommandBuffer   = Primitive2DPipeline::QuadCommandList;
-    using LineCommandBuffer   = Primitive2DPipeline::LineCommandList;
-    using CircleCommandBuffer = Primitive2DPipeline::CircleCommandList;
+    using QuadCommandBuffer        = Primitive2DPipeline::QuadCommandList;
+    using LineCommandBuffer        = Primitive2DPipeline::LineCommandList;
+    using CircleCommandBuffer      = Primitive2DPipeline::CircleCommandList;
+    using RoundedRectCommandBuffer = Primitive2DPipeline::RoundedRectCommandList;
+    using PolygonCommandBuffer     = Primitive2DPipeline::PolygonCommandList;
+    using PolylineCommandBuffer    = Primitive2DPipeline::PolylineCommandList;
 }    // namespace InnoEngine
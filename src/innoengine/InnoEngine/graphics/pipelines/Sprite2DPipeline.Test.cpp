@@ -0,0 +1,260 @@
+#include "InnoEngine/graphics/pipelines/Sprite2DPipeline.h"
+#include <gtest/gtest.h>
+
+#include "SDL3/SDL.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// runs SpriteCull.comp on the first vulkan device, a software one like lavapipe is enough
+// skipped without a device, e.g. VK_ICD_FILENAMES=/usr/share/vulkan/icd.d/lvp_icd.x86_64.json selects lavapipe
+namespace InnoEngine
+{
+    namespace
+    {
+        using SpriteLayout = Sprite2DPipeline::StructuredBufferLayout;
+
+        // has to match SpriteCull.comp.hlsl
+        struct CullParameters
+        {
+            uint32_t SpriteCount = 0;
+            uint32_t Phase       = 0;
+            uint32_t InputOffset = 0;
+        };
+
+        constexpr uint32_t CullGroupSize   = 64;
+        constexpr uint32_t GroupDataOffset = 4;
+
+        class SpriteCullTest : public ::testing::Test
+        {
+        protected:
+            void SetUp() override
+            {
+                SDL_SetHint( SDL_HINT_VIDEO_DRIVER, "offscreen" );
+                if ( SDL_Init( SDL_INIT_VIDEO ) == false )
+                    GTEST_SKIP() << "SDL_Init failed: " << SDL_GetError();
+
+                m_Device = SDL_CreateGPUDevice( SDL_GPU_SHADERFORMAT_SPIRV, false, "vulkan" );
+                if ( m_Device == nullptr )
+                    GTEST_SKIP() << "No vulkan device: " << SDL_GetError();
+
+                const std::string shader_path = std::string( IE_TEST_SHADER_DIRECTORY ) + "/SPIRV/SpriteCull.comp.spv";
+
+                size_t code_size = 0;
+                void*  code      = SDL_LoadFile( shader_path.c_str(), &code_size );
+                ASSERT_NE( code, nullptr ) << shader_path;
+
+                SDL_GPUComputePipelineCreateInfo create_info = {};
+                create_info.code_size                        = code_size;
+                create_info.code                             = static_cast<Uint8*>( code );
+                create_info.entrypoint                       = "main";
+                create_info.format                           = SDL_GPU_SHADERFORMAT_SPIRV;
+                create_info.num_readonly_storage_buffers     = 2;
+                create_info.num_readwrite_storage_buffers    = 2;
+                create_info.num_uniform_buffers              = 1;
+                create_info.threadcount_x                    = CullGroupSize;
+                create_info.threadcount_y                    = 1;
+                create_info.threadcount_z                    = 1;
+
+                m_Pipeline = SDL_CreateGPUComputePipeline( m_Device, &create_info );
+                SDL_free( code );
+                ASSERT_NE( m_Pipeline, nullptr ) << SDL_GetError();
+            }
+
+            void TearDown() override
+            {
+                if ( m_Device != nullptr ) {
+                    for ( SDL_GPUBuffer* buffer : m_Buffers )
+                        SDL_ReleaseGPUBuffer( m_Device, buffer );
+                    if ( m_Pipeline != nullptr )
+                        SDL_ReleaseGPUComputePipeline( m_Device, m_Pipeline );
+                    SDL_DestroyGPUDevice( m_Device );
+                }
+                SDL_Quit();
+            }
+
+            SDL_GPUBuffer* create_buffer( SDL_GPUBufferUsageFlags usage, uint32_t size )
+            {
+                SDL_GPUBufferCreateInfo create_info = {};
+                create_info.usage                   = usage;
+                create_info.size                    = size;
+
+                SDL_GPUBuffer* buffer = SDL_CreateGPUBuffer( m_Device, &create_info );
+                m_Buffers.push_back( buffer );
+                return buffer;
+            }
+
+            SDL_GPUTransferBuffer* create_transfer_buffer( SDL_GPUTransferBufferUsage usage, uint32_t size, const void* data = nullptr )
+            {
+                SDL_GPUTransferBufferCreateInfo create_info = {};
+                create_info.usage                           = usage;
+                create_info.size                            = size;
+
+                SDL_GPUTransferBuffer* transfer_buffer = SDL_CreateGPUTransferBuffer( m_Device, &create_info );
+                if ( data != nullptr ) {
+                    std::memcpy( SDL_MapGPUTransferBuffer( m_Device, transfer_buffer, false ), data, size );
+                    SDL_UnmapGPUTransferBuffer( m_Device, transfer_buffer );
+                }
+                return transfer_buffer;
+            }
+
+            // same passes as Sprite2DPipeline::dispatch_culling, returns the visible sprites and the indirect draw arguments
+            void cull( const std::vector<SpriteLayout>& input, uint32_t input_offset, std::vector<SpriteLayout>& output, std::array<uint32_t, 4>& draw_arguments )
+            {
+                const uint32_t sprite_count = static_cast<uint32_t>( input.size() ) - input_offset;
+                const uint32_t group_count  = std::max( ( sprite_count + CullGroupSize - 1 ) / CullGroupSize, 1u );
+                const uint32_t input_bytes  = static_cast<uint32_t>( input.size() * sizeof( SpriteLayout ) );
+                const uint32_t output_bytes = sprite_count * static_cast<uint32_t>( sizeof( SpriteLayout ) );
+                const uint32_t data_bytes   = ( GroupDataOffset + group_count ) * static_cast<uint32_t>( sizeof( uint32_t ) );
+
+                const DXSM::Matrix camera = DXSM::Matrix::Identity;    // world units are clip space
+
+                SDL_GPUBuffer* input_buffer  = create_buffer( SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_READ, input_bytes );
+                SDL_GPUBuffer* camera_buffer = create_buffer( SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_READ, sizeof( camera ) );
+                SDL_GPUBuffer* output_buffer = create_buffer( SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_WRITE, output_bytes );
+                SDL_GPUBuffer* data_buffer   = create_buffer( SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_READ | SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_WRITE, data_bytes );
+
+                SDL_GPUTransferBuffer* input_upload    = create_transfer_buffer( SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD, input_bytes, input.data() );
+                SDL_GPUTransferBuffer* camera_upload   = create_transfer_buffer( SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD, sizeof( camera ), &camera );
+                SDL_GPUTransferBuffer* output_download = create_transfer_buffer( SDL_GPU_TRANSFERBUFFERUSAGE_DOWNLOAD, output_bytes );
+                SDL_GPUTransferBuffer* data_download   = create_transfer_buffer( SDL_GPU_TRANSFERBUFFERUSAGE_DOWNLOAD, data_bytes );
+
+                SDL_GPUCommandBuffer* cmd_buf   = SDL_AcquireGPUCommandBuffer( m_Device );
+                SDL_GPUCopyPass*      copy_pass = SDL_BeginGPUCopyPass( cmd_buf );
+
+                SDL_GPUTransferBufferLocation input_location { .transfer_buffer = input_upload, .offset = 0 };
+                SDL_GPUBufferRegion           input_region { .buffer = input_buffer, .offset = 0, .size = input_bytes };
+                SDL_UploadToGPUBuffer( copy_pass, &input_location, &input_region, false );
+
+                SDL_GPUTransferBufferLocation camera_location { .transfer_buffer = camera_upload, .offset = 0 };
+                SDL_GPUBufferRegion           camera_region { .buffer = camera_buffer, .offset = 0, .size = sizeof( camera ) };
+                SDL_UploadToGPUBuffer( copy_pass, &camera_location, &camera_region, false );
+                SDL_EndGPUCopyPass( copy_pass );
+
+                SDL_GPUBuffer* readonly_buffers[ 2 ] = { input_buffer, camera_buffer };
+
+                CullParameters parameters = {};
+                parameters.SpriteCount    = sprite_count;
+                parameters.InputOffset    = input_offset;
+
+                for ( uint32_t phase = 0; phase < 3; ++phase ) {
+                    SDL_GPUStorageBufferReadWriteBinding readwrite_buffers[ 2 ] = {};
+                    readwrite_buffers[ 0 ].buffer                               = output_buffer;
+                    readwrite_buffers[ 1 ].buffer                               = data_buffer;
+
+                    SDL_GPUComputePass* compute_pass = SDL_BeginGPUComputePass( cmd_buf, nullptr, 0, readwrite_buffers, 2 );
+                    SDL_BindGPUComputePipeline( compute_pass, m_Pipeline );
+                    SDL_BindGPUComputeStorageBuffers( compute_pass, 0, readonly_buffers, 2 );
+
+                    parameters.Phase = phase;
+                    SDL_PushGPUComputeUniformData( cmd_buf, 0, &parameters, sizeof( parameters ) );
+                    SDL_DispatchGPUCompute( compute_pass, phase == 1 ? 1 : group_count, 1, 1 );
+                    SDL_EndGPUComputePass( compute_pass );
+                }
+
+                copy_pass = SDL_BeginGPUCopyPass( cmd_buf );
+
+                SDL_GPUBufferRegion           output_region { .buffer = output_buffer, .offset = 0, .size = output_bytes };
+                SDL_GPUTransferBufferLocation output_location { .transfer_buffer = output_download, .offset = 0 };
+                SDL_DownloadFromGPUBuffer( copy_pass, &output_region, &output_location );
+
+                SDL_GPUBufferRegion           data_region { .buffer = data_buffer, .offset = 0, .size = data_bytes };
+                SDL_GPUTransferBufferLocation data_location { .transfer_buffer = data_download, .offset = 0 };
+                SDL_DownloadFromGPUBuffer( copy_pass, &data_region, &data_location );
+                SDL_EndGPUCopyPass( copy_pass );
+
+                SDL_GPUFence* fence = SDL_SubmitGPUCommandBufferAndAcquireFence( cmd_buf );
+                ASSERT_NE( fence, nullptr ) << SDL_GetError();
+                SDL_WaitForGPUFences( m_Device, true, &fence, 1 );
+                SDL_ReleaseGPUFence( m_Device, fence );
+
+                std::memcpy( draw_arguments.data(), SDL_MapGPUTransferBuffer( m_Device, data_download, false ), sizeof( draw_arguments ) );
+                SDL_UnmapGPUTransferBuffer( m_Device, data_download );
+
+                const uint32_t visible_count = std::min( draw_arguments[ 0 ] / 6, sprite_count );
+                output.resize( visible_count );
+                std::memcpy( output.data(), SDL_MapGPUTransferBuffer( m_Device, output_download, false ), visible_count * sizeof( SpriteLayout ) );
+                SDL_UnmapGPUTransferBuffer( m_Device, output_download );
+
+                for ( SDL_GPUTransferBuffer* transfer_buffer : { input_upload, camera_upload, output_download, data_download } )
+                    SDL_ReleaseGPUTransferBuffer( m_Device, transfer_buffer );
+            }
+
+        private:
+            SDL_GPUDevice*              m_Device   = nullptr;
+            SDL_GPUComputePipeline*     m_Pipeline = nullptr;
+            std::vector<SDL_GPUBuffer*> m_Buffers;
+        };
+
+        SpriteLayout make_sprite( DXSM::Vector2 position, float id )
+        {
+            SpriteLayout sprite = {};
+            sprite.Position     = position;
+            sprite.Size         = { 0.1f, 0.1f };
+            sprite.Color        = DXSM::Color( 1.0f, 1.0f, 1.0f, 1.0f );
+            sprite.Depth        = id;
+            return sprite;
+        }
+    }    // namespace
+
+    TEST_F( SpriteCullTest, compactsVisibleSpritesInOrder )
+    {
+        // spans more than one thread group and starts behind sprites of a previous batch
+        constexpr uint32_t input_offset = 3;
+        constexpr uint32_t sprite_count = 150;
+
+        std::vector<SpriteLayout> input;
+        std::vector<float>        expected;
+        for ( uint32_t i = 0; i < input_offset; ++i )
+            input.push_back( make_sprite( { 0.0f, 0.0f }, -1.0f ) );
+
+        for ( uint32_t i = 0; i < sprite_count; ++i ) {
+            const float id = static_cast<float>( i );
+            if ( i % 3 == 0 ) {
+                input.push_back( make_sprite( { -0.5f, 0.5f }, id ) );
+                expected.push_back( id );
+            }
+            else if ( i % 3 == 1 ) {
+                input.push_back( make_sprite( { 2.0f, 0.0f }, id ) );
+            }
+            else {
+                // just outside unrotated, the rotation bounds reach into the view
+                SpriteLayout sprite = make_sprite( { 1.05f, 0.0f }, id );
+                sprite.Rotation     = 1.0f;
+                input.push_back( sprite );
+                expected.push_back( id );
+            }
+        }
+
+        std::vector<SpriteLayout> output;
+        std::array<uint32_t, 4>   draw_arguments = {};
+        cull( input, input_offset, output, draw_arguments );
+
+        EXPECT_EQ( draw_arguments[ 0 ], expected.size() * 6 );
+        EXPECT_EQ( draw_arguments[ 1 ], 1u );
+        EXPECT_EQ( draw_arguments[ 2 ], 0u );
+        EXPECT_EQ( draw_arguments[ 3 ], 0u );
+
+        ASSERT_EQ( output.size(), expected.size() );
+        for ( size_t i = 0; i < expected.size(); ++i )
+            EXPECT_EQ( output[ i ].Depth, expected[ i ] ) << "at " << i;
+    }
+
+    TEST_F( SpriteCullTest, allCulled )
+    {
+        std::vector<SpriteLayout> input;
+        for ( uint32_t i = 0; i < 10; ++i )
+            input.push_back( make_sprite( { -3.0f, 0.0f }, static_cast<float>( i ) ) );
+
+        std::vector<SpriteLayout> output;
+        std::array<uint32_t, 4>   draw_arguments = { 1, 1, 1, 1 };
+        cull( input, 0, output, draw_arguments );
+
+        EXPECT_EQ( draw_arguments[ 0 ], 0u );
+        EXPECT_EQ( draw_arguments[ 1 ], 1u );
+        EXPECT_TRUE( output.empty() );
+    }
+}    // namespace InnoEngine
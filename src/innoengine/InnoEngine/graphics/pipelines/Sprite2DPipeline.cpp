@@ -28,6 +28,17 @@ namespace InnoEngine
                 SDL_ReleaseGPUGraphicsPipeline( m_Device, m_Pipeline );
                 m_Pipeline = nullptr;
             }
+
+            if ( m_NineSlicePipeline ) {
+                SDL_ReleaseGPUGraphicsPipeline( m_Device, m_NineSlicePipeline );
+                m_NineSlicePipeline = nullptr;
+            }
+
+            for ( auto& buffers : m_CullingBuffers ) {
+                SDL_ReleaseGPUBuffer( m_Device, buffers.Output );
+                SDL_ReleaseGPUBuffer( m_Device, buffers.Data );
+            }
+            m_CullingBuffers.clear();
         }
     }
 
@@ -53,6 +64,9 @@ namespace InnoEngine
             return Result::InitializationError;
         }
 
+        if ( IE_FAILED( vertexShaderAsset.value().get()->require_uniform_buffers( 1 ) ) )
+            return Result::InitializationError;
+
         auto fragmentShaderAsset = shaderRepo->require_asset( "TextureXColor.frag" );
         if ( fragmentShaderAsset.has_value() == false ) {
             IE_LOG_ERROR( "Fragment Shader not found!" );
@@ -109,12 +123,44 @@ namespace InnoEngine
             return Result::InitializationError;
         }
 
-        m_GPUBatch = GPUBatchStorageBuffer<StructuredBufferLayout, BatchData>::create( m_Device, MaxBatchSize );
+        m_GPUBatch = GPUBatchStorageBuffer<StructuredBufferLayout, BatchData>::create( m_Device, MaxBatchSize, SDL_GPU_BUFFERUSAGE_GRAPHICS_STORAGE_READ | SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_READ );
+
+        m_NineSliceGPUBatch = GPUBatchStorageBuffer<NineSliceStorageBufferLayout, BatchData>::create( m_Device, NineSliceBatchSize );
+        if ( IE_FAILED( load_nine_slice_pipeline( window, shaderRepo.get() ) ) ) {
+            IE_LOG_ERROR( "Nine slice pipeline not available" );
+            return Result::InitializationError;
+        }
+
+        m_CameraBuffer = renderer->get_camera_buffer();
+        if ( auto cullShaderAsset = shaderRepo->require_asset( "SpriteCull.comp" ) ) {
+            m_CullShader = cullShaderAsset.value().get();
+        }
+        set_gpu_culling( true );
+        if ( m_GPUCulling == false ) {
+            IE_LOG_ERROR( "Compute Shader not found: {}", "SpriteCull.comp" );
+            return Result::InitializationError;
+        }
+
+        if ( IE_FAILED( m_CullShader->require_uniform_buffers( 1 ) ) )
+            return Result::InitializationError;
 
         m_Initialized = true;
         return Result::Success;
     }
 
+    uint32_t Sprite2DPipeline::pack_animation( uint32_t columns, uint32_t rows, uint32_t frame_count, bool loop )
+    {
+        IE_ASSERT( columns >= 1 && columns <= 0xFF && rows >= 1 && rows <= 0xFF );
+
+        if ( frame_count == 0 || frame_count > columns * rows )
+            frame_count = columns * rows;
+
+        // the frame count has 15 bits, more would run into the loop bit
+        frame_count = std::min( frame_count, 0x7FFFu );
+
+        return columns | ( rows << 8 ) | ( frame_count << 16 ) | ( loop ? 1u << 31 : 0u );
+    }
+
     uint32_t Sprite2DPipeline::prepare_render_opaque( const CommandList& command_list )
     {
         IE_ASSERT( m_Device != nullptr );
@@ -125,34 +171,41 @@ namespace InnoEngine
         return prepare_batches();
     }
 
-    uint32_t Sprite2DPipeline::prepare_render( const CommandList& command_list )
+    uint32_t Sprite2DPipeline::prepare_render( const CommandList& command_list, const NineSliceCommandList& nine_slice_command_list )
     {
         IE_ASSERT( m_Device != nullptr );
+
+        uint32_t batch_count = prepare_nine_slice_batches( nine_slice_command_list );
         if ( command_list.size() == 0 )
-            return 0;
+            return batch_count;
 
         sort_commands( command_list, false );
-        return prepare_batches();
+        return batch_count + prepare_batches();
     }
 
     uint32_t Sprite2DPipeline::swapchain_render( const RenderContextFrameData& render_ctx_data,
                                                  const TextureList&            texture_list,
+                                                 SDL_GPUCommandBuffer*         gpu_cmd_buf,
                                                  SDL_GPURenderPass*            render_pass )
     {
         IE_ASSERT( m_Device != nullptr );
         IE_ASSERT( render_pass != nullptr );
 
+        // nine slices are usually backgrounds of ui elements, draw them first so sprites on top blend over them
+        uint32_t draw_calls = render_nine_slices( render_ctx_data, texture_list, gpu_cmd_buf, render_pass );
+
         if ( m_GPUBatch->size() == 0 )
-            return 0;
+            return draw_calls;
 
         SDL_BindGPUGraphicsPipeline( render_pass, m_Pipeline );
         SDL_BindGPUVertexBuffers( render_pass, 0, nullptr, 0 );
         SDL_SetGPUViewport( render_pass, &render_ctx_data.Viewport );
 
-        uint32_t                     draw_calls      = 0;
         RenderCommandBufferIndexType current_texture = InvalidRenderCommandBufferIndex;
 
-        for ( const auto& batch_data : m_GPUBatch->get_batchlist() ) {
+        const auto& batch_list = m_GPUBatch->get_batchlist();
+        for ( size_t i = 0; i < batch_list.size(); ++i ) {
+            const auto& batch_data = batch_list[ i ];
             if ( batch_data.CustomData.TextureIndex != current_texture ) {
                 SDL_GPUTextureSamplerBinding texture_sampler_binding = {};
                 texture_sampler_binding.sampler                      = m_DefaultSampler;
@@ -161,15 +214,68 @@ namespace InnoEngine
                 current_texture = batch_data.CustomData.TextureIndex;
             }
 
-            SDL_BindGPUVertexStorageBuffers( render_pass, 1, &batch_data.GPUBuffer, 1 );
-            SDL_DrawGPUPrimitives( render_pass, batch_data.Count * 6, 1, 0, 0 );
+            // culled sprites get compacted into buffers of their own
+            BatchUniforms uniforms = {};
+            uniforms.BatchOffset   = m_CullingPrepared ? 0 : batch_data.Offset;
+            uniforms.Time          = render_ctx_data.AnimationTime;
+            SDL_PushGPUVertexUniformData( gpu_cmd_buf, 0, &uniforms, sizeof( uniforms ) );
+
+            if ( m_CullingPrepared ) {
+                // only the visible sprites were compacted into the output buffer, the vertex count lives on the gpu
+                SDL_BindGPUVertexStorageBuffers( render_pass, 1, &m_CullingBuffers[ i ].Output, 1 );
+                SDL_DrawGPUPrimitivesIndirect( render_pass, m_CullingBuffers[ i ].Data, 0, 1 );
+            }
+            else {
+                SDL_BindGPUVertexStorageBuffers( render_pass, 1, &batch_data.GPUBuffer, 1 );
+                SDL_DrawGPUPrimitives( render_pass, batch_data.Count * 6, 1, 0, 0 );
+            }
             ++draw_calls;
         }
 
         m_GPUBatch->clear();
+        m_CullingPrepared = false;
         return draw_calls;
     }
 
+    void Sprite2DPipeline::set_gpu_culling( bool enabled )
+    {
+        m_GPUCulling = enabled && m_CullShader != nullptr && m_CullShader->get_sdlcomputepipeline() != nullptr;
+    }
+
+    bool Sprite2DPipeline::gpu_culling_enabled() const
+    {
+        return m_GPUCulling;
+    }
+
+    void Sprite2DPipeline::end_frame()
+    {
+        m_PeakBufferBytes = std::max( m_PeakBufferBytes, get_gpu_buffer_bytes() );
+        m_GPUBatch->end_frame();
+        m_NineSliceGPUBatch->end_frame();
+
+        for ( auto& buffers : m_CullingBuffers ) {
+            ++buffers.UnusedFrames;
+        }
+
+        // batches always use the culling buffers from the front, so the idle ones are at the back
+        while ( m_CullingBuffers.empty() == false && m_CullingBuffers.back().UnusedFrames >= TrimFrameCount ) {
+            SDL_ReleaseGPUBuffer( m_Device, m_CullingBuffers.back().Output );
+            SDL_ReleaseGPUBuffer( m_Device, m_CullingBuffers.back().Data );
+            m_CullingBufferBytes -= m_CullingBuffers.back().Bytes;
+            m_CullingBuffers.pop_back();
+        }
+    }
+
+    size_t Sprite2DPipeline::get_gpu_buffer_bytes() const
+    {
+        return m_GPUBatch->get_allocated_bytes() + m_NineSliceGPUBatch->get_allocated_bytes() + m_CullingBufferBytes;
+    }
+
+    size_t Sprite2DPipeline::get_gpu_buffer_peak_bytes() const
+    {
+        return std::max( m_PeakBufferBytes, get_gpu_buffer_bytes() );
+    }
+
     uint32_t Sprite2DPipeline::prepare_batches()
     {
         m_GPUBatch->clear();
@@ -196,16 +302,207 @@ namespace InnoEngine
 
             StructuredBufferLayout* buffer_data = m_GPUBatch->next_data();
 
+            buffer_data->ContextIndex   = command->ContextIndex;
+            buffer_data->Color          = command->Color;
+            buffer_data->Position       = command->Position;
+            buffer_data->RotationOrigin = command->RotationOrigin;
+            buffer_data->Size           = command->Size;
+            buffer_data->Rotation       = command->Rotation;
+            buffer_data->Depth          = command->Depth;
+            buffer_data->SourceRect     = command->SourceRect;
+            buffer_data->Animation      = command->Animation;
+            buffer_data->FrameRate      = command->FrameRate;
+            buffer_data->AnimationStart = command->AnimationStart;
+        }
+        m_GPUBatch->upload_last( copy_pass );
+
+        SDL_EndGPUCopyPass( copy_pass );
+
+        m_CullingPrepared = false;
+        if ( m_GPUCulling && IE_SUCCESS( create_culling_buffers( m_GPUBatch->size() ) ) ) {
+            dispatch_culling( gpu_copy_cmd_buf );
+            m_CullingPrepared = true;
+        }
+
+        if ( SDL_SubmitGPUCommandBuffer( gpu_copy_cmd_buf ) == false ) {
+            IE_LOG_ERROR( "SDL_SubmitGPUCommandBuffer failed: {}", SDL_GetError() );
+            return 0;
+        }
+
+        return static_cast<uint32_t>( m_GPUBatch->size() );
+    }
+
+    Result Sprite2DPipeline::create_culling_buffers( size_t batch_count )
+    {
+        const uint32_t max_group_count = ( MaxBatchSize + CullGroupSize - 1 ) / CullGroupSize;
+
+        while ( m_CullingBuffers.size() < batch_count ) {
+            SDL_GPUBufferCreateInfo output_createinfo = {};
+            output_createinfo.usage                   = SDL_GPU_BUFFERUSAGE_GRAPHICS_STORAGE_READ | SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_WRITE;
+            output_createinfo.size                    = MaxBatchSize * sizeof( StructuredBufferLayout );
+
+            SDL_GPUBufferCreateInfo data_createinfo = {};
+            data_createinfo.usage                   = SDL_GPU_BUFFERUSAGE_INDIRECT | SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_READ | SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_WRITE;
+            data_createinfo.size                    = static_cast<uint32_t>( sizeof( SDL_GPUIndirectDrawCommand ) + max_group_count * sizeof( uint32_t ) );
+
+            CullingBuffers buffers;
+            buffers.Output = SDL_CreateGPUBuffer( m_Device, &output_createinfo );
+            buffers.Data   = SDL_CreateGPUBuffer( m_Device, &data_createinfo );
+            if ( buffers.Output == nullptr || buffers.Data == nullptr ) {
+                IE_LOG_ERROR( "SDL_CreateGPUBuffer failed : {0}", SDL_GetError() );
+                SDL_ReleaseGPUBuffer( m_Device, buffers.Output );
+                SDL_ReleaseGPUBuffer( m_Device, buffers.Data );
+                return Result::Fail;
+            }
+
+            buffers.Bytes         = output_createinfo.size + data_createinfo.size;
+            m_CullingBufferBytes += buffers.Bytes;
+            m_CullingBuffers.push_back( buffers );
+        }
+        return Result::Success;
+    }
+
+    void Sprite2DPipeline::dispatch_culling( SDL_GPUCommandBuffer* gpu_cmd_buf )
+    {
+        IE_ASSERT( m_CameraBuffer != nullptr );
+
+        SDL_GPUComputePipeline* cull_pipeline = m_CullShader->get_sdlcomputepipeline();
+        const auto&             batch_list    = m_GPUBatch->get_batchlist();
+
+        for ( size_t i = 0; i < batch_list.size(); ++i ) {
+            const auto&     batch_data = batch_list[ i ];
+            CullingBuffers& buffers    = m_CullingBuffers[ i ];
+            buffers.UnusedFrames       = 0;
+
+            SDL_GPUBuffer* readonly_buffers[ 2 ] = { batch_data.GPUBuffer, m_CameraBuffer };
+            uint32_t       group_count           = std::max( ( batch_data.Count + CullGroupSize - 1 ) / CullGroupSize, 1u );
+
+            CullParameters parameters = {};
+            parameters.SpriteCount    = batch_data.Count;
+            parameters.InputOffset    = batch_data.Offset;
+
+            // every phase depends on the results of the previous one, separate compute passes synchronize them
+            for ( uint32_t phase = 0; phase < 3; ++phase ) {
+                SDL_GPUStorageBufferReadWriteBinding readwrite_buffers[ 2 ] = {};
+                readwrite_buffers[ 0 ].buffer                               = buffers.Output;
+                readwrite_buffers[ 0 ].cycle                                = phase == 0;    // later phases need the data of the first one
+                readwrite_buffers[ 1 ].buffer                               = buffers.Data;
+                readwrite_buffers[ 1 ].cycle                                = phase == 0;
+
+                SDL_GPUComputePass* compute_pass = SDL_BeginGPUComputePass( gpu_cmd_buf, nullptr, 0, readwrite_buffers, 2 );
+                SDL_BindGPUComputePipeline( compute_pass, cull_pipeline );
+                SDL_BindGPUComputeStorageBuffers( compute_pass, 0, readonly_buffers, 2 );
+
+                parameters.Phase = phase;
+                SDL_PushGPUComputeUniformData( gpu_cmd_buf, 0, &parameters, sizeof( parameters ) );
+                SDL_DispatchGPUCompute( compute_pass, phase == 1 ? 1 : group_count, 1, 1 );
+                SDL_EndGPUComputePass( compute_pass );
+            }
+        }
+    }
+
+    Result Sprite2DPipeline::load_nine_slice_pipeline( SDL_Window* sdl_window, AssetRepository<Shader>* shader_repo )
+    {
+        auto vertexShaderAsset = shader_repo->require_asset( "NineSliceBatch.vert" );
+        if ( vertexShaderAsset.has_value() == false ) {
+            IE_LOG_ERROR( "Vertex Shader not found: {}", "NineSliceBatch.vert" );
+            return Result::InitializationError;
+        }
+
+        if ( IE_FAILED( vertexShaderAsset.value().get()->require_uniform_buffers( 1 ) ) )
+            return Result::InitializationError;
+
+        auto fragmentShaderAsset = shader_repo->require_asset( "TextureXColor.frag" );
+        if ( fragmentShaderAsset.has_value() == false ) {
+            IE_LOG_ERROR( "Fragment Shader not found: {}", "TextureXColor.frag" );
+            return Result::InitializationError;
+        }
+
+        AssetView<Shader>& vertexShader   = vertexShaderAsset.value();
+        AssetView<Shader>& fragmentShader = fragmentShaderAsset.value();
+
+        SDL_GPUColorTargetDescription colorTargets[ 1 ]     = {};
+        colorTargets[ 0 ].format                            = SDL_GetGPUSwapchainTextureFormat( m_Device, sdl_window );
+        colorTargets[ 0 ].blend_state.src_color_blendfactor = SDL_GPU_BLENDFACTOR_SRC_ALPHA;
+        colorTargets[ 0 ].blend_state.dst_color_blendfactor = SDL_GPU_BLENDFACTOR_ONE_MINUS_SRC_ALPHA;
+        colorTargets[ 0 ].blend_state.color_blend_op        = SDL_GPU_BLENDOP_ADD;
+        colorTargets[ 0 ].blend_state.src_alpha_blendfactor = SDL_GPU_BLENDFACTOR_SRC_ALPHA;
+        colorTargets[ 0 ].blend_state.dst_alpha_blendfactor = SDL_GPU_BLENDFACTOR_ONE_MINUS_SRC_ALPHA;
+        colorTargets[ 0 ].blend_state.alpha_blend_op        = SDL_GPU_BLENDOP_ADD;
+        colorTargets[ 0 ].blend_state.enable_blend          = true;
+
+        SDL_GPUGraphicsPipelineCreateInfo pipelineCreateInfo     = {};
+        pipelineCreateInfo.vertex_shader                         = vertexShader.get()->get_sdlshader();
+        pipelineCreateInfo.fragment_shader                       = fragmentShader.get()->get_sdlshader();
+        pipelineCreateInfo.primitive_type                        = SDL_GPU_PRIMITIVETYPE_TRIANGLELIST;
+        pipelineCreateInfo.target_info.color_target_descriptions = colorTargets;
+        pipelineCreateInfo.target_info.num_color_targets         = 1;
+
+        pipelineCreateInfo.target_info.depth_stencil_format     = SDL_GPU_TEXTUREFORMAT_D16_UNORM;
+        pipelineCreateInfo.target_info.has_depth_stencil_target = true;
+
+        pipelineCreateInfo.depth_stencil_state.compare_op          = SDL_GPU_COMPAREOP_GREATER_OR_EQUAL;
+        pipelineCreateInfo.depth_stencil_state.enable_depth_test   = true;
+        pipelineCreateInfo.depth_stencil_state.enable_depth_write  = true;
+        pipelineCreateInfo.depth_stencil_state.enable_stencil_test = false;
+        pipelineCreateInfo.depth_stencil_state.write_mask          = 0xFF;
+
+        m_NineSlicePipeline = SDL_CreateGPUGraphicsPipeline( m_Device, &pipelineCreateInfo );
+        if ( m_NineSlicePipeline == nullptr ) {
+            IE_LOG_ERROR( "Failed to create pipeline!" );
+            return Result::InitializationError;
+        }
+        return Result::Success;
+    }
+
+    uint32_t Sprite2DPipeline::prepare_nine_slice_batches( const NineSliceCommandList& command_list )
+    {
+        m_NineSliceGPUBatch->clear();
+        if ( command_list.size() == 0 )
+            return 0;
+
+        m_SortedNineSliceCommands.clear();
+        for ( const NineSliceCommand& command : command_list )
+            m_SortedNineSliceCommands.push_back( &command );
+
+        std::sort( m_SortedNineSliceCommands.begin(), m_SortedNineSliceCommands.end(), []( const NineSliceCommand* a, const NineSliceCommand* b ) {
+            if ( a->TextureIndex != b->TextureIndex )
+                return a->TextureIndex > b->TextureIndex;
+            return a->Depth > b->Depth;
+        } );
+
+        SDL_GPUCommandBuffer* gpu_copy_cmd_buf = SDL_AcquireGPUCommandBuffer( m_Device );
+        if ( gpu_copy_cmd_buf == nullptr ) {
+            IE_LOG_ERROR( "AcquireGPUCommandBuffer failed: {}", SDL_GetError() );
+            return 0;
+        }
+
+        SDL_GPUCopyPass* copy_pass = SDL_BeginGPUCopyPass( gpu_copy_cmd_buf );
+
+        BatchData* current = nullptr;
+
+        for ( const NineSliceCommand* command : m_SortedNineSliceCommands ) {
+            if ( current == nullptr || m_NineSliceGPUBatch->current_batch_full() ||
+                 current->ContextIndex != command->ContextIndex ||
+                 current->TextureIndex != command->TextureIndex ) {
+
+                current               = m_NineSliceGPUBatch->upload_and_add_batch( copy_pass );
+                current->ContextIndex = command->ContextIndex;
+                current->TextureIndex = command->TextureIndex;
+            }
+
+            NineSliceStorageBufferLayout* buffer_data = m_NineSliceGPUBatch->next_data();
+
             buffer_data->ContextIndex = command->ContextIndex;
+            buffer_data->SourceRect   = command->SourceRect;
+            buffer_data->SourceBorder = command->SourceBorder;
+            buffer_data->Border       = command->Border;
             buffer_data->Color        = command->Color;
             buffer_data->Position     = command->Position;
-            buffer_data->RotationOrigin = command->RotationOrigin;
             buffer_data->Size         = command->Size;
-            buffer_data->Rotation     = command->Rotation;
             buffer_data->Depth        = command->Depth;
-            buffer_data->SourceRect   = command->SourceRect;
         }
-        m_GPUBatch->upload_last( copy_pass );
+        m_NineSliceGPUBatch->upload_last( copy_pass );
 
         SDL_EndGPUCopyPass( copy_pass );
 
@@ -214,7 +511,45 @@ namespace InnoEngine
             return 0;
         }
 
-        return static_cast<uint32_t>( m_GPUBatch->size() );
+        return static_cast<uint32_t>( m_NineSliceGPUBatch->size() );
+    }
+
+    uint32_t Sprite2DPipeline::render_nine_slices( const RenderContextFrameData& render_ctx_data,
+                                                   const TextureList&            texture_list,
+                                                   SDL_GPUCommandBuffer*         gpu_cmd_buf,
+                                                   SDL_GPURenderPass*            render_pass )
+    {
+        if ( m_NineSliceGPUBatch->size() == 0 )
+            return 0;
+
+        SDL_BindGPUGraphicsPipeline( render_pass, m_NineSlicePipeline );
+        SDL_BindGPUVertexBuffers( render_pass, 0, nullptr, 0 );
+        SDL_SetGPUViewport( render_pass, &render_ctx_data.Viewport );
+
+        uint32_t                     draw_calls      = 0;
+        RenderCommandBufferIndexType current_texture = InvalidRenderCommandBufferIndex;
+
+        for ( const auto& batch_data : m_NineSliceGPUBatch->get_batchlist() ) {
+            if ( batch_data.CustomData.TextureIndex != current_texture ) {
+                SDL_GPUTextureSamplerBinding texture_sampler_binding = {};
+                texture_sampler_binding.sampler                      = m_DefaultSampler;
+                texture_sampler_binding.texture                      = texture_list[ batch_data.CustomData.TextureIndex ]->get_sdltexture();
+                SDL_BindGPUFragmentSamplers( render_pass, 0, &texture_sampler_binding, 1 );
+                current_texture = batch_data.CustomData.TextureIndex;
+            }
+
+            BatchUniforms uniforms = {};
+            uniforms.BatchOffset   = batch_data.Offset;
+            SDL_PushGPUVertexUniformData( gpu_cmd_buf, 0, &uniforms, sizeof( uniforms ) );
+
+            // 9 quads per element
+            SDL_BindGPUVertexStorageBuffers( render_pass, 1, &batch_data.GPUBuffer, 1 );
+            SDL_DrawGPUPrimitives( render_pass, batch_data.Count * 54, 1, 0, 0 );
+            ++draw_calls;
+        }
+
+        m_NineSliceGPUBatch->clear();
+        return draw_calls;
     }
 
     void Sprite2DPipeline::sort_commands( const CommandList& command_list, bool opaque )
@@ -16,6 +16,9 @@ namespace InnoEngine
 {
     class AssetManager;
     class GPURenderer;
+    class Shader;
+    template <typename T>
+    class AssetRepository;
 
     class Sprite2DPipeline
     {
@@ -36,6 +39,10 @@ namespace InnoEngine
             DXSM::Vector2 Size;
             DXSM::Vector2 RotationOrigin;    // for rotation, in texels
             float         Rotation;          // in radians
+
+            uint32_t Animation      = 0;       // see pack_animation, 0 when not animated
+            float    FrameRate      = 0.0f;    // frames per second
+            float    AnimationStart = 0.0f;    // in GPURenderer::get_animation_time seconds
         };
 
         struct StructuredBufferLayout
@@ -48,10 +55,43 @@ namespace InnoEngine
             float         Rotation;    // in radians
             float         Depth;
             uint32_t      ContextIndex;
-            float         pad[ 3 ];
+            uint32_t      Animation;
+            float         FrameRate;
+            float         AnimationStart;
+        };
+
+        // x == left; y == bottom; z == right; w == top
+        struct NineSliceCommand : RenderCommandBase
+        {
+            RenderCommandBufferIndexType TextureIndex;
+
+            DXSM::Vector4 SourceRect;
+            DXSM::Vector4 SourceBorder;    // normalized, inside the source rect
+            DXSM::Vector4 Border;          // in world units
+            DXSM::Color   Color;
+            DXSM::Vector2 Position;
+            DXSM::Vector2 Size;
+        };
+
+        struct NineSliceStorageBufferLayout
+        {
+            DXSM::Vector4 SourceRect;
+            DXSM::Vector4 SourceBorder;
+            DXSM::Vector4 Border;
+            DXSM::Color   Color;
+            DXSM::Vector2 Position;
+            DXSM::Vector2 Size;
+            float         Depth;
+            uint32_t      ContextIndex;
+            float         pad[ 2 ];
         };
 
-        using CommandList = std::vector<Command>;
+        using CommandList          = std::vector<Command>;
+        using NineSliceCommandList = std::vector<NineSliceCommand>;
+
+        // flipbook layout evaluated by the vertex shader, the source rect of the command covers all frames
+        // columns and rows have to be in [1, 255], a frame_count of 0 uses all cells, at most 32767 frames are played
+        static uint32_t pack_animation( uint32_t columns, uint32_t rows, uint32_t frame_count, bool loop );
 
     public:
         Sprite2DPipeline() = default;
@@ -60,15 +100,57 @@ namespace InnoEngine
         Result initialize( GPURenderer* renderer, AssetManager* assetmanager );
 
         uint32_t prepare_render_opaque( const CommandList& command_list );
-        uint32_t prepare_render( const CommandList& command_list );
+        uint32_t prepare_render( const CommandList& command_list, const NineSliceCommandList& nine_slice_command_list );
         uint32_t swapchain_render( const RenderContextFrameData& render_ctx_data,
                                    const TextureList&            texture_list,
+                                   SDL_GPUCommandBuffer*         gpu_cmd_buf,
                                    SDL_GPURenderPass*            renderPass );
 
+        void set_gpu_culling( bool enabled );    // cull and compact sprites per context view in a compute pass before drawing
+        bool gpu_culling_enabled() const;
+
+        void   end_frame();    // trims gpu buffers which were not needed for a while
+        size_t get_gpu_buffer_bytes() const;
+        size_t get_gpu_buffer_peak_bytes() const;
+
     private:
+        struct CullingBuffers
+        {
+            SDL_GPUBuffer* Output = nullptr;    // visible sprites, read by the vertex shader
+            SDL_GPUBuffer* Data   = nullptr;    // indirect draw arguments followed by the per group counters
+
+            uint32_t Bytes        = 0;
+            uint32_t UnusedFrames = 0;
+        };
+
+        // sprite and nine slice vertex shaders index their batch from this element of the shared page on
+        struct BatchUniforms
+        {
+            uint32_t BatchOffset = 0;
+            float    Time        = 0.0f;    // RenderContextFrameData::AnimationTime
+            uint32_t pad[ 2 ];
+        };
+
+        struct CullParameters
+        {
+            uint32_t SpriteCount = 0;
+            uint32_t Phase       = 0;
+            uint32_t InputOffset = 0;    // first sprite of the batch in the shared input buffer
+        };
+
         uint32_t prepare_batches();
         void     sort_commands( const CommandList& command_list, bool opaque );
 
+        Result   load_nine_slice_pipeline( SDL_Window* sdl_window, AssetRepository<Shader>* shader_repo );
+        uint32_t prepare_nine_slice_batches( const NineSliceCommandList& command_list );
+        uint32_t render_nine_slices( const RenderContextFrameData& render_ctx_data,
+                                     const TextureList&            texture_list,
+                                     SDL_GPUCommandBuffer*         gpu_cmd_buf,
+                                     SDL_GPURenderPass*            render_pass );
+
+        Result create_culling_buffers( size_t batch_count );
+        void   dispatch_culling( SDL_GPUCommandBuffer* gpu_cmd_buf );
+
     private:
         bool                     m_Initialized    = false;
         GPUDeviceRef             m_Device         = nullptr;
@@ -78,10 +160,26 @@ namespace InnoEngine
 
         std::vector<const Command*> m_SortedCommands;    // objects owned by the RenderCommandBuffer
 
-        static constexpr uint32_t MaxBatchSize = 20000;
+        static constexpr uint32_t MaxBatchSize       = 20000;
+        static constexpr uint32_t NineSliceBatchSize = 4096;
+        static constexpr uint32_t CullGroupSize      = 64;     // has to match SpriteCull.comp.hlsl
+        static constexpr uint32_t TrimFrameCount     = 300;    // release culling buffers no batch needed for this many frames
+
+        Ref<Shader>                 m_CullShader         = nullptr;
+        SDL_GPUBuffer*              m_CameraBuffer       = nullptr;    // owned by the renderer
+        bool                        m_GPUCulling         = false;
+        bool                        m_CullingPrepared    = false;
+        std::vector<CullingBuffers> m_CullingBuffers;
+        size_t                      m_CullingBufferBytes = 0;
+        size_t                      m_PeakBufferBytes    = 0;
 
         Ref<GPUBatchStorageBuffer<StructuredBufferLayout, BatchData>> m_GPUBatch;
+
+        SDL_GPUGraphicsPipeline*                                            m_NineSlicePipeline = nullptr;
+        std::vector<const NineSliceCommand*>                                m_SortedNineSliceCommands;    // objects owned by the RenderCommandBuffer
+        Ref<GPUBatchStorageBuffer<NineSliceStorageBufferLayout, BatchData>> m_NineSliceGPUBatch = nullptr;
     };
 
-    using SpriteCommandBuffer = Sprite2DPipeline::CommandList;
+    using SpriteCommandBuffer    = Sprite2DPipeline::CommandList;
+    using NineSliceCommandBuffer = Sprite2DPipeline::NineSliceCommandList;
 }    // namespace InnoEngine
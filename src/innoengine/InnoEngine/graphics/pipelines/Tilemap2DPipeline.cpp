@@ -0,0 +1,353 @@
+#include "InnoEngine/iepch.h"
+#include "InnoEngine/graphics/pipelines/Tilemap2DPipeline.h"
+
+#include "InnoEngine/AssetManager.h"
+#include "InnoEngine/graphics/Renderer.h"
+#include "InnoEngine/graphics/Window.h"
+
+#include "InnoEngine/graphics/Shader.h"
+
+#include <bit>
+
+namespace InnoEngine
+{
+    size_t Tilemap2DPipeline::CommandList::size() const
+    {
+        return Commands.size();
+    }
+
+    void Tilemap2DPipeline::CommandList::clear()
+    {
+        Commands.clear();
+        Uploads.clear();
+        TileData.clear();
+    }
+
+    Tilemap2DPipeline::~Tilemap2DPipeline()
+    {
+        if ( m_Device != nullptr ) {
+            for ( auto& [ id, gpu_tilemap ] : m_Tilemaps ) {
+                release_tilemap( gpu_tilemap );
+            }
+            m_Tilemaps.clear();
+
+            if ( m_TransferBuffer ) {
+                SDL_ReleaseGPUTransferBuffer( m_Device, m_TransferBuffer );
+                m_TransferBuffer = nullptr;
+            }
+
+            if ( m_DefaultSampler ) {
+                SDL_ReleaseGPUSampler( m_Device, m_DefaultSampler );
+                m_DefaultSampler = nullptr;
+            }
+
+            if ( m_Pipeline ) {
+                SDL_ReleaseGPUGraphicsPipeline( m_Device, m_Pipeline );
+                m_Pipeline = nullptr;
+            }
+        }
+    }
+
+    Result Tilemap2DPipeline::initialize( GPURenderer* renderer, AssetManager* assetmanager )
+    {
+        IE_ASSERT( renderer != nullptr && renderer->has_window() && assetmanager != nullptr );
+
+        if ( m_Initialized ) {
+            IE_LOG_WARNING( "Pipeline already initialized!" );
+            return Result::AlreadyInitialized;
+        }
+
+        m_Device           = renderer->get_gpudevice();
+        SDL_Window* window = renderer->get_window()->get_sdlwindow();
+
+        auto shaderRepo = assetmanager->get_repository<Shader>();
+        IE_ASSERT( shaderRepo != nullptr );
+
+        // load shaders
+        auto vertexShaderAsset = shaderRepo->require_asset( "TilemapChunk.vert" );
+        if ( vertexShaderAsset.has_value() == false ) {
+            IE_LOG_ERROR( "Vertex Shader not found: {}", "TilemapChunk.vert" );
+            return Result::InitializationError;
+        }
+
+        if ( IE_FAILED( vertexShaderAsset.value().get()->require_uniform_buffers( 1 ) ) )
+            return Result::InitializationError;
+
+        auto fragmentShaderAsset = shaderRepo->require_asset( "TextureXColor.frag" );
+        if ( fragmentShaderAsset.has_value() == false ) {
+            IE_LOG_ERROR( "Fragment Shader not found: {}", "TextureXColor.frag" );
+            return Result::InitializationError;
+        }
+
+        AssetView<Shader>& vertexShader   = vertexShaderAsset.value();
+        AssetView<Shader>& fragmentShader = fragmentShaderAsset.value();
+
+        // Create the pipeline
+        SDL_GPUColorTargetDescription colorTargets[ 1 ]     = {};
+        colorTargets[ 0 ].format                            = SDL_GetGPUSwapchainTextureFormat( m_Device, window );
+        colorTargets[ 0 ].blend_state.src_color_blendfactor = SDL_GPU_BLENDFACTOR_SRC_ALPHA;
+        colorTargets[ 0 ].blend_state.dst_color_blendfactor = SDL_GPU_BLENDFACTOR_ONE_MINUS_SRC_ALPHA;
+        colorTargets[ 0 ].blend_state.color_blend_op        = SDL_GPU_BLENDOP_ADD;
+        colorTargets[ 0 ].blend_state.src_alpha_blendfactor = SDL_GPU_BLENDFACTOR_SRC_ALPHA;
+        colorTargets[ 0 ].blend_state.dst_alpha_blendfactor = SDL_GPU_BLENDFACTOR_ONE_MINUS_SRC_ALPHA;
+        colorTargets[ 0 ].blend_state.alpha_blend_op        = SDL_GPU_BLENDOP_ADD;
+        colorTargets[ 0 ].blend_state.enable_blend          = true;
+
+        SDL_GPUGraphicsPipelineCreateInfo pipelineCreateInfo     = {};
+        pipelineCreateInfo.vertex_shader                         = vertexShader.get()->get_sdlshader();
+        pipelineCreateInfo.fragment_shader                       = fragmentShader.get()->get_sdlshader();
+        pipelineCreateInfo.primitive_type                        = SDL_GPU_PRIMITIVETYPE_TRIANGLELIST;
+        pipelineCreateInfo.target_info.color_target_descriptions = colorTargets;
+        pipelineCreateInfo.target_info.num_color_targets         = 1;
+
+        pipelineCreateInfo.target_info.depth_stencil_format     = SDL_GPU_TEXTUREFORMAT_D16_UNORM;
+        pipelineCreateInfo.target_info.has_depth_stencil_target = true;
+
+        pipelineCreateInfo.depth_stencil_state.compare_op          = SDL_GPU_COMPAREOP_GREATER_OR_EQUAL;
+        pipelineCreateInfo.depth_stencil_state.enable_depth_test   = true;
+        pipelineCreateInfo.depth_stencil_state.enable_depth_write  = true;
+        pipelineCreateInfo.depth_stencil_state.enable_stencil_test = false;
+        pipelineCreateInfo.depth_stencil_state.write_mask          = 0xFF;
+
+        m_Pipeline = SDL_CreateGPUGraphicsPipeline( m_Device, &pipelineCreateInfo );
+        if ( m_Pipeline == nullptr ) {
+            IE_LOG_ERROR( "Failed to create pipeline!" );
+            return Result::InitializationError;
+        }
+
+        SDL_GPUSamplerCreateInfo sampler_create_info = {};
+        sampler_create_info.min_filter               = SDL_GPU_FILTER_NEAREST;
+        sampler_create_info.mag_filter               = SDL_GPU_FILTER_NEAREST;
+        sampler_create_info.mipmap_mode              = SDL_GPU_SAMPLERMIPMAPMODE_NEAREST;
+        sampler_create_info.address_mode_u           = SDL_GPU_SAMPLERADDRESSMODE_CLAMP_TO_EDGE;
+        sampler_create_info.address_mode_v           = SDL_GPU_SAMPLERADDRESSMODE_CLAMP_TO_EDGE;
+        sampler_create_info.address_mode_w           = SDL_GPU_SAMPLERADDRESSMODE_CLAMP_TO_EDGE;
+
+        m_DefaultSampler = SDL_CreateGPUSampler( m_Device, &sampler_create_info );
+        if ( m_DefaultSampler == nullptr ) {
+            IE_LOG_ERROR( "Failed to create GPUSampler!" );
+            return Result::InitializationError;
+        }
+
+        m_Initialized = true;
+        return Result::Success;
+    }
+
+    uint32_t Tilemap2DPipeline::prepare_render( const CommandList& command_list, const RenderContextFrameData& render_ctx_data )
+    {
+        m_Draws.clear();
+        if ( m_Initialized == false || command_list.size() == 0 )
+            return 0;
+
+        upload_chunks( command_list );
+
+        // world space area of the view, chunks outside of it are skipped
+        DXSM::Matrix  inverse_view_projection = render_ctx_data.ViewProjectionMatrix.Invert();
+        DXSM::Vector2 view_min( std::numeric_limits<float>::max(), std::numeric_limits<float>::max() );
+        DXSM::Vector2 view_max( std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest() );
+        for ( const DXSM::Vector2& ndc : { DXSM::Vector2( -1.0f, -1.0f ), DXSM::Vector2( 1.0f, -1.0f ), DXSM::Vector2( -1.0f, 1.0f ), DXSM::Vector2( 1.0f, 1.0f ) } ) {
+            DXSM::Vector2 world = DXSM::Vector2::Transform( ndc, inverse_view_projection );
+            view_min            = DXSM::Vector2::Min( view_min, world );
+            view_max            = DXSM::Vector2::Max( view_max, world );
+        }
+
+        for ( const Command& command : command_list.Commands ) {
+            auto gpu_tilemap_it = m_Tilemaps.find( command.Map->get_id() );
+            if ( gpu_tilemap_it == m_Tilemaps.end() )
+                continue;
+
+            GPUTilemap&                  gpu_tilemap = gpu_tilemap_it->second;
+            const TilemapSpecifications& specs       = command.Map->get_specs();
+            gpu_tilemap.UnusedFrames                 = 0;
+
+            const DXSM::Vector2 chunk_size = specs.TileSize * static_cast<float>( Tilemap::ChunkSize );
+            const DXSM::Vector2 first      = ( view_min - command.Position ) / chunk_size;
+            const DXSM::Vector2 last       = ( view_max - command.Position ) / chunk_size;
+
+            const int32_t columns = static_cast<int32_t>( command.Map->m_ChunkColumns );
+            const int32_t rows    = static_cast<int32_t>( command.Map->m_ChunkRows );
+            const int32_t x_begin = std::max( static_cast<int32_t>( std::floor( first.x ) ), 0 );
+            const int32_t y_begin = std::max( static_cast<int32_t>( std::floor( first.y ) ), 0 );
+            const int32_t x_end   = std::min( static_cast<int32_t>( std::floor( last.x ) ) + 1, columns );
+            const int32_t y_end   = std::min( static_cast<int32_t>( std::floor( last.y ) ) + 1, rows );
+
+            for ( int32_t y = y_begin; y < y_end; ++y ) {
+                for ( int32_t x = x_begin; x < x_end; ++x ) {
+                    SDL_GPUBuffer* buffer = gpu_tilemap.Chunks[ y * columns + x ];
+                    if ( buffer == nullptr )
+                        continue;
+
+                    ChunkDraw& draw              = m_Draws.emplace_back();
+                    draw.Buffer                  = buffer;
+                    draw.TextureIndex            = command.TextureIndex;
+                    draw.Uniforms.TilesetRect    = specs.TilesetRect;
+                    draw.Uniforms.Color          = command.Color;
+                    draw.Uniforms.ChunkPosition  = command.Position + chunk_size * DXSM::Vector2( static_cast<float>( x ), static_cast<float>( y ) );
+                    draw.Uniforms.TileSize       = specs.TileSize;
+                    draw.Uniforms.TilesetColumns = specs.TilesetColumns;
+                    draw.Uniforms.TilesetRows    = specs.TilesetRows;
+                    draw.Uniforms.CameraIndex    = command.ContextIndex;
+                    draw.Uniforms.Depth          = command.Depth;
+                }
+            }
+        }
+
+        return static_cast<uint32_t>( m_Draws.size() );
+    }
+
+    uint32_t Tilemap2DPipeline::swapchain_render( const RenderContextFrameData& render_ctx_data,
+                                                  const TextureList&            texture_list,
+                                                  SDL_GPUCommandBuffer*         gpu_cmd_buf,
+                                                  SDL_GPURenderPass*            render_pass )
+    {
+        IE_ASSERT( render_pass != nullptr );
+
+        if ( m_Draws.empty() )
+            return 0;
+
+        SDL_BindGPUGraphicsPipeline( render_pass, m_Pipeline );
+        SDL_BindGPUVertexBuffers( render_pass, 0, nullptr, 0 );
+        SDL_SetGPUViewport( render_pass, &render_ctx_data.Viewport );
+
+        RenderCommandBufferIndexType current_texture = InvalidRenderCommandBufferIndex;
+
+        for ( const ChunkDraw& draw : m_Draws ) {
+            if ( draw.TextureIndex != current_texture ) {
+                SDL_GPUTextureSamplerBinding texture_sampler_binding = {};
+                texture_sampler_binding.sampler                      = m_DefaultSampler;
+                texture_sampler_binding.texture                      = texture_list[ draw.TextureIndex ]->get_sdltexture();
+                SDL_BindGPUFragmentSamplers( render_pass, 0, &texture_sampler_binding, 1 );
+                current_texture = draw.TextureIndex;
+            }
+
+            SDL_BindGPUVertexStorageBuffers( render_pass, 1, &draw.Buffer, 1 );
+            SDL_PushGPUVertexUniformData( gpu_cmd_buf, 0, &draw.Uniforms, sizeof( ChunkUniforms ) );
+            SDL_DrawGPUPrimitives( render_pass, Tilemap::ChunkSize * Tilemap::ChunkSize * 6, 1, 0, 0 );
+        }
+
+        uint32_t draw_calls = static_cast<uint32_t>( m_Draws.size() );
+        m_Draws.clear();
+        return draw_calls;
+    }
+
+    void Tilemap2DPipeline::end_frame()
+    {
+        for ( auto it = m_Tilemaps.begin(); it != m_Tilemaps.end(); ) {
+            GPUTilemap& gpu_tilemap = it->second;
+            if ( gpu_tilemap.Map.expired() || ++gpu_tilemap.UnusedFrames >= TrimFrameCount ) {
+                release_tilemap( gpu_tilemap );
+                it = m_Tilemaps.erase( it );
+            }
+            else {
+                ++it;
+            }
+        }
+    }
+
+    size_t Tilemap2DPipeline::get_gpu_buffer_bytes() const
+    {
+        return m_ChunkCount * ChunkBytes + m_TransferBufferBytes;
+    }
+
+    void Tilemap2DPipeline::upload_chunks( const CommandList& command_list )
+    {
+        if ( command_list.Uploads.empty() )
+            return;
+
+        const uint32_t upload_bytes = static_cast<uint32_t>( command_list.Uploads.size() ) * ChunkBytes;
+        if ( upload_bytes > m_TransferBufferBytes ) {
+            if ( m_TransferBuffer )
+                SDL_ReleaseGPUTransferBuffer( m_Device, m_TransferBuffer );
+
+            SDL_GPUTransferBufferCreateInfo transferbuffer_createinfo = {};
+            transferbuffer_createinfo.usage                           = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
+            transferbuffer_createinfo.size                            = std::bit_ceil( upload_bytes );
+
+            m_TransferBuffer      = SDL_CreateGPUTransferBuffer( m_Device, &transferbuffer_createinfo );
+            m_TransferBufferBytes = m_TransferBuffer ? transferbuffer_createinfo.size : 0;
+            if ( m_TransferBuffer == nullptr ) {
+                IE_LOG_ERROR( "Failed to create GPUTransferBuffer! {}", SDL_GetError() );
+                return;
+            }
+        }
+
+        // copy the tiles first, the transfer buffer has to be unmapped before the copy pass uses it
+        std::byte* transfer_data = static_cast<std::byte*>( SDL_MapGPUTransferBuffer( m_Device, m_TransferBuffer, true ) );
+        if ( transfer_data == nullptr ) {
+            IE_LOG_ERROR( "SDL_MapGPUTransferBuffer failed: {}", SDL_GetError() );
+            return;
+        }
+
+        m_PendingUploads.clear();
+        uint32_t offset = 0;
+
+        for ( const Command& command : command_list.Commands ) {
+            const Ref<Tilemap>& tilemap     = command.Map;
+            GPUTilemap&         gpu_tilemap = m_Tilemaps[ tilemap->get_id() ];
+            if ( gpu_tilemap.Chunks.empty() ) {
+                gpu_tilemap.Map = tilemap;
+                gpu_tilemap.Chunks.resize( tilemap->m_Chunks.size(), nullptr );
+            }
+
+            for ( uint32_t i = command.UploadOffset; i < command.UploadOffset + command.UploadCount; ++i ) {
+                const ChunkUpload& upload = command_list.Uploads[ i ];
+                SDL_GPUBuffer*&    buffer = gpu_tilemap.Chunks[ upload.Chunk ];
+                if ( buffer == nullptr ) {
+                    SDL_GPUBufferCreateInfo buffer_createinfo = {};
+                    buffer_createinfo.usage                   = SDL_GPU_BUFFERUSAGE_GRAPHICS_STORAGE_READ;
+                    buffer_createinfo.size                    = ChunkBytes;
+
+                    buffer = SDL_CreateGPUBuffer( m_Device, &buffer_createinfo );
+                    if ( buffer == nullptr ) {
+                        IE_LOG_ERROR( "SDL_CreateGPUBuffer failed : {0}", SDL_GetError() );
+                        continue;
+                    }
+                    ++m_ChunkCount;
+                }
+
+                std::memcpy( transfer_data + offset, &command_list.TileData[ upload.DataOffset ], ChunkBytes );
+                m_PendingUploads.push_back( { buffer, offset } );
+                offset += ChunkBytes;
+
+                tilemap->m_Chunks[ upload.Chunk ].UploadedRevision.store( upload.Revision, std::memory_order_release );
+            }
+        }
+        SDL_UnmapGPUTransferBuffer( m_Device, m_TransferBuffer );
+
+        SDL_GPUCommandBuffer* gpu_copy_cmd_buf = SDL_AcquireGPUCommandBuffer( m_Device );
+        if ( gpu_copy_cmd_buf == nullptr ) {
+            IE_LOG_ERROR( "AcquireGPUCommandBuffer failed: {}", SDL_GetError() );
+            return;
+        }
+
+        SDL_GPUCopyPass* copy_pass = SDL_BeginGPUCopyPass( gpu_copy_cmd_buf );
+        for ( const auto& [ buffer, transfer_offset ] : m_PendingUploads ) {
+            SDL_GPUTransferBufferLocation transferbuffer_location { .transfer_buffer = m_TransferBuffer, .offset = transfer_offset };
+            SDL_GPUBufferRegion           buffer_region { .buffer = buffer, .offset = 0, .size = ChunkBytes };
+            SDL_UploadToGPUBuffer( copy_pass, &transferbuffer_location, &buffer_region, true );    // cycle, earlier frames may still read the chunk
+        }
+        SDL_EndGPUCopyPass( copy_pass );
+
+        if ( SDL_SubmitGPUCommandBuffer( gpu_copy_cmd_buf ) == false ) {
+            IE_LOG_ERROR( "SDL_SubmitGPUCommandBuffer failed: {}", SDL_GetError() );
+        }
+    }
+
+    void Tilemap2DPipeline::release_tilemap( GPUTilemap& gpu_tilemap )
+    {
+        for ( SDL_GPUBuffer* buffer : gpu_tilemap.Chunks ) {
+            if ( buffer ) {
+                SDL_ReleaseGPUBuffer( m_Device, buffer );
+                --m_ChunkCount;
+            }
+        }
+        gpu_tilemap.Chunks.clear();
+
+        // the next time the tilemap gets drawn all of its chunks have to be uploaded again
+        if ( Ref<Tilemap> tilemap = gpu_tilemap.Map.lock() ) {
+            for ( auto& chunk : tilemap->m_Chunks ) {
+                chunk.UploadedRevision.store( 0, std::memory_order_release );
+            }
+        }
+    }
+}    // namespace InnoEngine
@@ -0,0 +1,116 @@
+#pragma once
+#include "SDL3/SDL_gpu.h"
+
+#include "InnoEngine/BaseTypes.h"
+#include "InnoEngine/graphics/GPUDeviceRef.h"
+
+#include "InnoEngine/graphics/Texture2D.h"
+#include "InnoEngine/graphics/Tilemap.h"
+
+#include "InnoEngine/graphics/RenderContext.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace InnoEngine
+{
+    class AssetManager;
+    class GPURenderer;
+
+    class Tilemap2DPipeline
+    {
+    public:
+        struct ChunkUpload
+        {
+            uint32_t Chunk      = 0;
+            uint32_t Revision   = 0;
+            uint32_t DataOffset = 0;    // first tile inside CommandList::TileData
+        };
+
+        struct Command : RenderCommandBase
+        {
+            Ref<Tilemap>                 Map;
+            RenderCommandBufferIndexType TextureIndex;
+
+            DXSM::Vector2 Position;
+            DXSM::Color   Color;
+            uint32_t      UploadOffset = 0;    // first entry inside CommandList::Uploads
+            uint32_t      UploadCount  = 0;
+        };
+
+        // the tiles of edited chunks get copied while collecting, the render thread never reads the live tilemap data
+        struct CommandList
+        {
+            std::vector<Command>            Commands;
+            std::vector<ChunkUpload>        Uploads;
+            std::vector<Tilemap::TileIndex> TileData;
+
+            size_t size() const;
+            void   clear();
+        };
+
+    public:
+        Tilemap2DPipeline() = default;
+        ~Tilemap2DPipeline();
+
+        Result initialize( GPURenderer* renderer, AssetManager* assetmanager );
+
+        uint32_t prepare_render( const CommandList& command_list, const RenderContextFrameData& render_ctx_data );
+        uint32_t swapchain_render( const RenderContextFrameData& render_ctx_data,
+                                   const TextureList&            texture_list,
+                                   SDL_GPUCommandBuffer*         gpu_cmd_buf,
+                                   SDL_GPURenderPass*            render_pass );
+
+        void   end_frame();    // releases the chunks of tilemaps which were not drawn for a while
+        size_t get_gpu_buffer_bytes() const;
+
+    private:
+        struct ChunkUniforms
+        {
+            DXSM::Vector4 TilesetRect;
+            DXSM::Color   Color;
+            DXSM::Vector2 ChunkPosition;
+            DXSM::Vector2 TileSize;
+            uint32_t      TilesetColumns;
+            uint32_t      TilesetRows;
+            uint32_t      CameraIndex;
+            float         Depth;
+        };
+
+        struct ChunkDraw
+        {
+            SDL_GPUBuffer*               Buffer;
+            RenderCommandBufferIndexType TextureIndex;
+            ChunkUniforms                Uniforms;
+        };
+
+        struct GPUTilemap
+        {
+            std::weak_ptr<Tilemap>      Map;
+            std::vector<SDL_GPUBuffer*> Chunks;    // nullptr until the first upload
+            uint32_t                    UnusedFrames = 0;
+        };
+
+        void upload_chunks( const CommandList& command_list );
+        void release_tilemap( GPUTilemap& gpu_tilemap );
+
+    private:
+        static constexpr uint32_t ChunkBytes     = Tilemap::ChunkSize * Tilemap::ChunkSize * sizeof( Tilemap::TileIndex );
+        static constexpr uint32_t TrimFrameCount = 300;
+
+        bool                     m_Initialized    = false;
+        GPUDeviceRef             m_Device         = nullptr;
+        SDL_GPUGraphicsPipeline* m_Pipeline       = nullptr;
+        SDL_GPUSampler*          m_DefaultSampler = nullptr;
+
+        SDL_GPUTransferBuffer* m_TransferBuffer      = nullptr;
+        uint32_t               m_TransferBufferBytes = 0;
+
+        std::unordered_map<uint32_t, GPUTilemap>         m_Tilemaps;    // by tilemap id
+        std::vector<ChunkDraw>                           m_Draws;
+        std::vector<std::pair<SDL_GPUBuffer*, uint32_t>> m_PendingUploads;    // chunk buffer and offset inside the transfer buffer
+        size_t                                           m_ChunkCount = 0;
+    };
+
+    using TilemapCommandBuffer = Tilemap2DPipeline::CommandList;
+}    // namespace InnoEngine
@@ -3,6 +3,22 @@
 Texture2D<float4> msdf_texture : register(t0, space2);
 SamplerState Sampler : register(s0, space2);
 
+// set per batch, all sizes are in the units of the text size
+cbuffer TextEffects : register(b0, space3)
+{
+    float4 OutlineColor;
+    float4 ShadowColor;
+    float4 GlowColor;
+    float2 ShadowOffset;
+    float OutlineWidth;
+    float ShadowSoftness;
+    float GlowRadius;
+    uint EffectsEnabled;
+    float2 pad;
+};
+
+static const float pxRange = 8.0; // set to distance field's pixel range, MSDFData::Range
+
 float median(float r, float g, float b)
 {
     return max(min(r, g), min(max(r, g), b));
@@ -12,13 +28,14 @@ struct Input
 {
     float2 TexCoord : TEXCOORD0;
     float4 Color : TEXCOORD1;
+    nointerpolation float4 SourceRect : TEXCOORD2;
+    nointerpolation float2 UVPerUnit : TEXCOORD3; // uv change per unit of the text size
 };
 
 // needed for 3d rendering
 
 float screenPxRange(Input input)
 {
-    const float pxRange = 2.0; // set to distance field's pixel range
     float width;
     float height;
     msdf_texture.GetDimensions(width, height);
@@ -27,15 +44,64 @@ float screenPxRange(Input input)
     return max(0.5 * dot(unitRange, screenTexSize), 1.0);
 }
 
+// signed distance in units of the distance range, positive inside the glyph
+// the quad can be larger than the glyph, so the lookup never leaves its rect into a neighbouring glyph
+float sampleDistance(float2 texCoord, float4 sourceRect)
+{
+    float2 uv = clamp(texCoord, min(sourceRect.xy, sourceRect.zw), max(sourceRect.xy, sourceRect.zw));
+    float3 msd = msdf_texture.Sample(Sampler, uv).rgb;
+    return median(msd.r, msd.g, msd.b) - 0.5;
+}
+
+// premultiplied "over", the layers get stacked from the bottom up
+float4 blendOver(float4 below, float4 color, float coverage)
+{
+    float alpha = color.a * coverage;
+    return float4(color.rgb * alpha, alpha) + below * (1.0 - alpha);
+}
 
 float4 main(Input input) : SV_Target0
-{  
-    float3 msd = msdf_texture.Sample(Sampler, input.TexCoord).rgb;
-    float sd = median(msd.r, msd.g, msd.b);
-    float screenPxDistance = screenPxRange(input) * (sd - 0.5);
-    float opacity = clamp(screenPxDistance + 0.5, 0.0, 1.0);
-    if (opacity == 0.0f)
+{
+    float rangePx = screenPxRange(input);
+    float sd = sampleDistance(input.TexCoord, input.SourceRect);
+    float opacity = clamp(rangePx * sd + 0.5, 0.0, 1.0);
+
+    if (EffectsEnabled == 0)
+    {
+        if (opacity == 0.0f)
+            discard;
+
+        return calc_final_color(lerp(float4(input.Color.rgb, 0.0f), input.Color, opacity));
+    }
+
+    // the distance field only reaches half its range out of the glyph, effects beyond that get cut off
+    float width;
+    float height;
+    msdf_texture.GetDimensions(width, height);
+    float unitToDistance = abs(input.UVPerUnit.x) * width / pxRange;
+    float outline = min(OutlineWidth * unitToDistance, 0.49);
+
+    float4 color = float4(0.0, 0.0, 0.0, 0.0);
+
+    if (ShadowColor.a > 0.0)
+    {
+        float shadowDistance = sampleDistance(input.TexCoord - ShadowOffset * input.UVPerUnit, input.SourceRect) + outline;
+        float edge = max(ShadowSoftness * unitToDistance, 1.0 / rangePx);
+        color = blendOver(color, ShadowColor, saturate(shadowDistance / edge + 0.5));
+    }
+
+    if (GlowRadius > 0.0)
+    {
+        float glow = saturate(1.0 + (sd + outline) / max(GlowRadius * unitToDistance, 0.001));
+        color = blendOver(color, GlowColor, glow * glow);
+    }
+
+    if (outline > 0.0)
+        color = blendOver(color, OutlineColor, saturate(rangePx * (sd + outline) + 0.5));
+
+    color = blendOver(color, input.Color, opacity);
+    if (color.a <= 0.0)
         discard;
-    
-    return calc_final_color(lerp(float4(input.Color.rgb, 0.0f), input.Color, opacity));
-}
\ No newline at end of file
+
+    return calc_final_color(float4(color.rgb / color.a, color.a));
+}
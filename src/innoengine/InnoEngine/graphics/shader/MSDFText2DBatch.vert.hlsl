@@ -13,10 +13,18 @@ struct MSDFSpriteData
 
 StructuredBuffer<MSDFSpriteData> DataBuffer : register(t1, space0);
 
+cbuffer BatchData : register(b0, space1)
+{
+    float2 ShadowOffset; // the quads grow by it, so the shadow is not cut off
+    uint BatchOffset; // first glyph of the batch in the shared buffer, SV_VertexID does not include the first vertex on every backend
+};
+
 struct Output
 {
     float2 TexCoord : TEXCOORD0;
     float4 Color : TEXCOORD1;
+    nointerpolation float4 SourceRect : TEXCOORD2;
+    nointerpolation float2 UVPerUnit : TEXCOORD3;
     float4 Position : SV_Position;
 };
 
@@ -26,21 +34,19 @@ Output main(uint id : SV_VertexID)
     uint vert           = QuadIndices[id % 6];
     float2 coord        = QuadVertices[vert];
     
-    MSDFSpriteData sprite = DataBuffer[spriteIndex];    
-    coord *= sprite.Size;
-    float4 coordWithDepth = float4(coord + sprite.Position, sprite.Depth, 1.0f);
-    
-    float2 texcoord[4] =
-    {
-        { sprite.SourceRect.x, sprite.SourceRect.y },
-        { sprite.SourceRect.z, sprite.SourceRect.y },
-        { sprite.SourceRect.x, sprite.SourceRect.w },
-        { sprite.SourceRect.z, sprite.SourceRect.w }
-    };
+    MSDFSpriteData sprite = DataBuffer[BatchOffset + spriteIndex];    
+    float2 padding      = abs(ShadowOffset) / max(abs(sprite.Size), 0.0001);
+    coord               = coord * (1.0 + 2.0 * padding) - padding;
+    float4 coordWithDepth = float4(coord * sprite.Size + sprite.Position, sprite.Depth, 1.0f);
+
+    // the texture coordinates continue past the rect on grown quads
+    float2 uvSize       = sprite.SourceRect.zw - sprite.SourceRect.xy;
             
     Output output;
     output.Position         = transform_coordinates_2D(coordWithDepth, sprite.CameraIndex);
-    output.TexCoord         = texcoord[vert];
+    output.TexCoord         = sprite.SourceRect.xy + coord * uvSize;
     output.Color            = sprite.ForegroundColor;
+    output.SourceRect       = sprite.SourceRect;
+    output.UVPerUnit        = uvSize / sprite.Size;
     return output;
 }
\ No newline at end of file
@@ -0,0 +1,75 @@
+#include "VertexBase.verti.hlsl"
+
+// one quad per glyph, built from the glyph table of the font instead of a full record per glyph
+
+struct GlyphRun
+{
+    float2 Pen; // relative to the position of the text
+    uint GlyphIndex;
+    uint TextIndex; // inside the text batch
+};
+
+struct TextData
+{
+    float2 Position;
+    float Scale; // em to pixels
+    float Depth;
+    float4 ForegroundColor; // text color
+    uint CameraIndex;
+    float3 pad;
+};
+
+struct GlyphMetrics
+{
+    float4 PlaneBounds; // left, bottom, right, top in em
+    float4 SourceRect;
+};
+
+StructuredBuffer<GlyphRun> RunBuffer : register(t1, space0);
+StructuredBuffer<TextData> TextBuffer : register(t2, space0);
+StructuredBuffer<GlyphMetrics> GlyphTable : register(t3, space0);
+
+cbuffer BatchData : register(b0, space1)
+{
+    float2 ShadowOffset; // the quads grow by it, so the shadow is not cut off
+    uint TextOffset; // first text of the batch in the shared buffer
+    uint RunOffset; // first glyph of the batch, SV_VertexID does not include the first vertex on every backend
+};
+
+struct Output
+{
+    float2 TexCoord : TEXCOORD0;
+    float4 Color : TEXCOORD1;
+    nointerpolation float4 SourceRect : TEXCOORD2;
+    nointerpolation float2 UVPerUnit : TEXCOORD3;
+    float4 Position : SV_Position;
+};
+
+Output main(uint id : SV_VertexID)
+{
+    uint glyphIndex     = id / 6;
+    uint vert           = QuadIndices[id % 6];
+    float2 coord        = QuadVertices[vert];
+
+    GlyphRun run        = RunBuffer[RunOffset + glyphIndex];
+    TextData text       = TextBuffer[TextOffset + run.TextIndex];
+    GlyphMetrics glyph  = GlyphTable[run.GlyphIndex];
+
+    // same quad as TextLayout::build produces, the top of the plane bounds is the origin
+    float2 offset       = run.Pen + glyph.PlaneBounds.xw * text.Scale;
+    float2 size         = (glyph.PlaneBounds.zy - glyph.PlaneBounds.xw) * text.Scale;
+    float2 padding      = abs(ShadowOffset) / max(abs(size), 0.0001);
+    coord               = coord * (1.0 + 2.0 * padding) - padding;
+    float4 coordWithDepth = float4(coord * size + offset + text.Position, text.Depth, 1.0f);
+
+    // the texture coordinates continue past the rect on grown quads
+    float2 uvSize       = glyph.SourceRect.zw - glyph.SourceRect.xy;
+
+    Output output;
+    output.Position         = transform_coordinates_2D(coordWithDepth, text.CameraIndex);
+    output.TexCoord         = glyph.SourceRect.xy + coord * uvSize;
+    output.Color            = text.ForegroundColor;
+    output.SourceRect       = glyph.SourceRect;
+    output.UVPerUnit        = uvSize / size;
+    return output;
+}
@@ -0,0 +1,59 @@
+#include "VertexBase.verti.hlsl"
+
+// x == left; y == bottom; z == right; w == top
+struct NineSliceData
+{
+    float4 SourceRect;
+    float4 SourceBorder; // normalized texture coordinates
+    float4 Border;       // world units
+    float4 Color;
+    float2 Position;
+    float2 Size;
+    float Depth;
+    uint CameraIndex;
+    float2 pad;
+};
+
+StructuredBuffer<NineSliceData> DataBuffer : register(t1, space0);
+
+cbuffer BatchData : register(b0, space1)
+{
+    uint BatchOffset; // first element of the batch in the shared buffer
+};
+
+
+struct Output
+{
+    float2 TexCoord : TEXCOORD0;
+    float4 Color : TEXCOORD1;
+    float4 Position : SV_Position;
+};
+
+// every element expands to nine quads, 54 vertices
+Output main(uint id : SV_VertexID)
+{
+    uint sliceIndex = id / 54;
+    uint local = id % 54;
+    uint cell = local / 6;
+    uint vert = QuadIndices[local % 6];
+    NineSliceData slice = DataBuffer[BatchOffset + sliceIndex];
+
+    // grid lines of the 3x3 cells, bottom to top
+    float xs[4] = { 0.0f, slice.Border.x, slice.Size.x - slice.Border.z, slice.Size.x };
+    float ys[4] = { 0.0f, slice.Border.y, slice.Size.y - slice.Border.w, slice.Size.y };
+
+    // texture v grows downwards
+    float us[4] = { slice.SourceRect.x, slice.SourceRect.x + slice.SourceBorder.x, slice.SourceRect.z - slice.SourceBorder.z, slice.SourceRect.z };
+    float vs[4] = { slice.SourceRect.w, slice.SourceRect.w - slice.SourceBorder.y, slice.SourceRect.y + slice.SourceBorder.w, slice.SourceRect.y };
+
+    uint2 corner = (uint2)QuadVertices[vert] + uint2(cell % 3, cell / 3);
+
+    float2 coord = float2(xs[corner.x], ys[corner.y]);
+    float4 coord_with_depth = float4(coord + slice.Position, slice.Depth, 1.0f);
+
+    Output output;
+    output.Position = transform_coordinates_2D(coord_with_depth, slice.CameraIndex);
+    output.TexCoord = float2(us[corner.x], vs[corner.y]);
+    output.Color = slice.Color;
+    return output;
+}
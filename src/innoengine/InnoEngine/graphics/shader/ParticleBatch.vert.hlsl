@@ -0,0 +1,46 @@
+#include "VertexBase.verti.hlsl"
+
+// shared by the cpu simulated batches and the output of ParticleSimulate.comp
+struct ParticleData
+{
+    float2 Position; // center
+    float Size;      // diameter, 0 for dead particles
+    uint Color;      // rgba8
+};
+
+StructuredBuffer<ParticleData> DataBuffer : register(t1, space0);
+
+cbuffer BatchData : register(b0, space1)
+{
+    uint CameraIndex;
+    float Depth;
+    uint BatchOffset; // first particle of the batch in the shared buffer
+};
+
+struct Output
+{
+    float4 Position : SV_Position;
+    float4 Color : TEXCOORD1;
+    float2 Local : TEXCOORD2;
+    float Thickness : TEXCOORD3;
+    float Fade : TEXCOORD4;
+};
+
+Output main(uint id : SV_VertexID)
+{
+    const uint particle_index = id / 6;
+    const uint vert = QuadIndices[id % 6];
+    const ParticleData particle = DataBuffer[BatchOffset + particle_index];
+    const float2 vertex_base_coords = QuadVertices[vert];
+
+    // dead particles collapse into a point and produce no fragments
+    float2 coords = (vertex_base_coords - 0.5f) * particle.Size + particle.Position;
+
+    Output output;
+    output.Position = transform_coordinates_2D(float4(coords, Depth, 1.0f), CameraIndex);
+    output.Color = float4(particle.Color & 0xFF, (particle.Color >> 8) & 0xFF, (particle.Color >> 16) & 0xFF, particle.Color >> 24) / 255.0f;
+    output.Local = vertex_base_coords * 2 - 1.0f;
+    output.Thickness = 1.0f; // filled, Circle.frag only fades the outer edge
+    output.Fade = 0.5f;
+    return output;
+}
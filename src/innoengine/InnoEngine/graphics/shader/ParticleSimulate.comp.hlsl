@@ -0,0 +1,65 @@
+// Advances every particle of a gpu simulated particle system and writes the render data for
+// ParticleBatch.vert. New particles get copied into their ring buffer slot before the dispatch.
+
+struct Particle
+{
+    float2 Position;
+    float2 Velocity;
+    float Age;
+    float Lifetime;
+    float SizeStart;
+    float SizeEnd;
+    float4 ColorStart;
+    float4 ColorEnd;
+};
+
+struct ParticleData
+{
+    float2 Position;
+    float Size;
+    uint Color;
+};
+
+RWStructuredBuffer<Particle> ParticleBuffer : register(u0, space1);
+RWStructuredBuffer<ParticleData> OutputBuffer : register(u1, space1);
+
+cbuffer SimulationParameters : register(b0, space2)
+{
+    float2 Gravity;
+    float Drag;
+    float DeltaTime;
+    uint ParticleCount;
+};
+
+static const uint GroupSize = 64;
+
+uint pack_color(float4 color)
+{
+    uint4 bytes = (uint4)round(saturate(color) * 255.0f);
+    return bytes.x | (bytes.y << 8) | (bytes.z << 16) | (bytes.w << 24);
+}
+
+[numthreads(GroupSize, 1, 1)]
+void main(uint3 dispatch_id : SV_DispatchThreadID)
+{
+    uint index = dispatch_id.x;
+    if (index >= ParticleCount)
+        return;
+
+    Particle particle = ParticleBuffer[index];
+
+    ParticleData output = (ParticleData)0;
+    if (particle.Age < particle.Lifetime)
+    {
+        particle.Velocity = (particle.Velocity + Gravity * DeltaTime) * max(1.0f - Drag * DeltaTime, 0.0f);
+        particle.Position += particle.Velocity * DeltaTime;
+        particle.Age += DeltaTime;
+        ParticleBuffer[index] = particle;
+
+        float progress = saturate(particle.Age / particle.Lifetime);
+        output.Position = particle.Position;
+        output.Size = particle.Age < particle.Lifetime ? lerp(particle.SizeStart, particle.SizeEnd, progress) : 0.0f;
+        output.Color = pack_color(lerp(particle.ColorStart, particle.ColorEnd, progress));
+    }
+    OutputBuffer[index] = output;
+}
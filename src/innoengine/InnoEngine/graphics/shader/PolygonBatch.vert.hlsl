@@ -0,0 +1,49 @@
+#include "VertexBase.verti.hlsl"
+
+// convex polygons are triangulated as a fan around their first vertex,
+// every triangle of the batch expands to 3 vertices
+
+struct PolygonData
+{
+    float4 Color;
+    uint FirstVertex;   // inside the vertex batch
+    uint VertexCount;
+    uint FirstTriangle; // inside the triangle batch
+    float Depth;
+    uint CameraIndex;
+    float pad[3];
+};
+
+StructuredBuffer<PolygonData> PolygonBuffer : register(t1, space0);
+StructuredBuffer<float2> VertexBuffer : register(t2, space0);
+StructuredBuffer<uint> TriangleBuffer : register(t3, space0); // polygon of every triangle
+
+cbuffer BatchData : register(b0, space1)
+{
+    uint PolygonOffset;
+    uint VertexOffset;
+    uint TriangleOffset;
+};
+
+struct Output
+{
+    float4 Color : TEXCOORD1;
+    float4 Position : SV_Position;
+};
+
+Output main(uint id : SV_VertexID)
+{
+    const uint triangle_id = id / 3;
+    const uint corner = id % 3;
+
+    const PolygonData polygon = PolygonBuffer[PolygonOffset + TriangleBuffer[TriangleOffset + triangle_id]];
+    const uint fan_triangle = triangle_id - polygon.FirstTriangle;
+    const uint vertex = corner == 0 ? 0 : fan_triangle + corner;
+
+    const float2 position = VertexBuffer[VertexOffset + polygon.FirstVertex + vertex];
+
+    Output output;
+    output.Position = transform_coordinates_2D(float4(position, polygon.Depth, 1.0f), polygon.CameraIndex);
+    output.Color = polygon.Color;
+    return output;
+}
@@ -0,0 +1,26 @@
+#include "FragmentBase.fragi.hlsl"
+
+struct Input
+{
+    float4 Color : TEXCOORD0;
+    float LocalDistance : TEXCOORD1;
+    float Fade : TEXCOORD2;
+    float2 RoundLocal : TEXCOORD3;
+    float Round : TEXCOORD4;
+};
+
+float4 main(Input input) : SV_Target0
+{
+    float distance = abs(input.LocalDistance);
+    if (input.Round > 0.5f)
+    {
+        float radius = length(input.RoundLocal);
+        if (radius > 1.0f)
+            discard;
+        distance = max(distance, radius);
+    }
+
+    float4 color = input.Color;
+    color.a *= 1 - smoothstep(1 - input.Fade, 1, distance);
+    return calc_final_color(color);
+}
@@ -0,0 +1,151 @@
+#include "VertexBase.verti.hlsl"
+
+// every segment of a polyline expands to 18 vertices:
+//   0..5   the segment itself
+//   6..11  the join towards the next segment, or the end cap of the last segment
+//   12..17 the start cap of the first segment
+// unused parts collapse into a point and produce no fragments
+
+struct PolylineData
+{
+    float4 Color;
+    uint FirstPoint;   // inside the point batch
+    uint PointCount;
+    uint FirstSegment; // inside the segment batch
+    uint Flags;        // join | cap << 2 | closed << 4
+    float Thickness;
+    float Fade;
+    float Depth;
+    uint CameraIndex;
+};
+
+StructuredBuffer<PolylineData> PolylineBuffer : register(t1, space0);
+StructuredBuffer<float2> PointBuffer : register(t2, space0);
+StructuredBuffer<uint> SegmentBuffer : register(t3, space0); // polyline of every segment
+
+cbuffer BatchData : register(b0, space1)
+{
+    uint PolylineOffset;
+    uint PointOffset;
+    uint SegmentOffset;
+};
+
+static const uint JoinMiter = 0;
+static const uint JoinRound = 2;
+static const uint CapButt = 0;
+static const uint CapRound = 2;
+static const float MiterLimit = 4.0f;
+
+struct Output
+{
+    float4 Position : SV_Position;
+    float4 Color : TEXCOORD0;
+    float LocalDistance : TEXCOORD1;
+    float Fade : TEXCOORD2;
+    float2 RoundLocal : TEXCOORD3; // relative to the center of a round join or cap, in half thicknesses
+    float Round : TEXCOORD4;
+};
+
+float2 get_point(PolylineData polyline, uint index)
+{
+    return PointBuffer[PointOffset + polyline.FirstPoint + index % polyline.PointCount];
+}
+
+float2 get_direction(float2 from, float2 to)
+{
+    float2 delta = to - from;
+    float len = length(delta);
+    return len > 1e-6f ? delta / len : float2(1.0f, 0.0f);
+}
+
+float2 left_normal(float2 direction)
+{
+    return float2(-direction.y, direction.x);
+}
+
+void expand_cap(inout Output output, inout float2 position, float2 center, float2 outward, float2 normal, float half_thickness, uint cap, uint vert)
+{
+    if (cap == CapButt)
+        return;
+
+    float2 corner = QuadVertices[vert];
+    position = center + outward * half_thickness * corner.x + normal * half_thickness * (corner.y * 2.0f - 1.0f);
+    output.LocalDistance = corner.y * 2.0f - 1.0f;
+    output.RoundLocal = (position - center) / half_thickness;
+    output.Round = cap == CapRound ? 1.0f : 0.0f;
+}
+
+Output main(uint id : SV_VertexID)
+{
+    const uint segment_id = id / 18;
+    const uint part = (id % 18) / 6;
+    const uint part_vertex = id % 6;
+    const uint vert = QuadIndices[part_vertex];
+
+    const PolylineData polyline = PolylineBuffer[PolylineOffset + SegmentBuffer[SegmentOffset + segment_id]];
+    const uint segment = segment_id - polyline.FirstSegment;
+    const uint join = polyline.Flags & 3;
+    const uint cap = (polyline.Flags >> 2) & 3;
+    const bool closed = ((polyline.Flags >> 4) & 1) != 0;
+
+    const float2 p0 = get_point(polyline, segment);
+    const float2 p1 = get_point(polyline, segment + 1);
+    const float2 d0 = get_direction(p0, p1);
+    const float2 n0 = left_normal(d0);
+    const float half_thickness = polyline.Thickness * 0.5f;
+
+    Output output;
+    output.Color = polyline.Color;
+    output.Fade = polyline.Fade;
+    output.LocalDistance = 0.0f;
+    output.RoundLocal = float2(0.0f, 0.0f);
+    output.Round = 0.0f;
+
+    float2 position = p0;
+
+    if (part == 0)
+    {
+        float2 corner = QuadVertices[vert];
+        position = lerp(p0, p1, corner.x) + n0 * half_thickness * (corner.y * 2.0f - 1.0f);
+        output.LocalDistance = corner.y * 2.0f - 1.0f;
+    }
+    else if (part == 1)
+    {
+        if (closed || segment + 2 < polyline.PointCount)
+        {
+            const float2 d1 = get_direction(p1, get_point(polyline, segment + 2));
+            const float2 n1 = left_normal(d1);
+
+            // the join fills the gap on the outer side of the turn
+            const float side = (d0.x * d1.y - d0.y * d1.x) > 0.0f ? -1.0f : 1.0f;
+            const float2 a = p1 + n0 * half_thickness * side;
+            const float2 b = p1 + n1 * half_thickness * side;
+
+            const float2 bisector = n0 + n1;
+            const float2 tip_direction = length(bisector) > 1e-4f ? normalize(bisector) * side : d0;
+            const float miter_length = 1.0f / max(dot(tip_direction, n0 * side), 0.05f);
+
+            float2 tip = (a + b) * 0.5f; // bevel
+            if (join == JoinRound || (join == JoinMiter && miter_length <= MiterLimit))
+                tip = p1 + tip_direction * half_thickness * miter_length;
+
+            // triangles (p1, a, tip) and (p1, tip, b)
+            const float2 corners[6] = { p1, a, tip, p1, tip, b };
+            position = corners[part_vertex];
+            output.LocalDistance = (part_vertex == 0 || part_vertex == 3) ? 0.0f : 1.0f;
+            output.RoundLocal = (position - p1) / half_thickness;
+            output.Round = join == JoinRound ? 1.0f : 0.0f;
+        }
+        else
+        {
+            expand_cap(output, position, p1, d0, n0, half_thickness, cap, vert);
+        }
+    }
+    else if (closed == false && segment == 0)
+    {
+        expand_cap(output, position, p0, -d0, n0, half_thickness, cap, vert);
+    }
+
+    output.Position = transform_coordinates_2D(float4(position, polyline.Depth, 1.0f), polyline.CameraIndex);
+    return output;
+}
@@ -0,0 +1,60 @@
+#include "FragmentBase.fragi.hlsl"
+
+// has to match Primitive2DPipeline::ShapeType
+static const uint ShapeQuad = 0;
+static const uint ShapeLine = 1;
+static const uint ShapeCircle = 2;
+static const uint ShapeRoundedRect = 3;
+
+struct Input
+{
+    float4 Color : TEXCOORD0;
+    float2 Local : TEXCOORD1;
+    nointerpolation float2 HalfSize : TEXCOORD2;
+    nointerpolation float4 Parameters : TEXCOORD3;
+    nointerpolation uint Type : TEXCOORD4;
+};
+
+float rounded_rect_distance(float2 position, float2 half_size, float radius)
+{
+    float2 q = abs(position) - half_size + radius;
+    return length(max(q, 0.0f)) + min(max(q.x, q.y), 0.0f) - radius;
+}
+
+float4 main(Input input) : SV_Target0
+{
+    const float thickness = input.Parameters.x;
+    const float fade = input.Parameters.y;
+
+    float4 color = input.Color;
+    float alpha = 1.0f;
+
+    if (input.Type == ShapeLine)
+    {
+        // faded across the line, in half thicknesses
+        alpha = 1 - smoothstep(1 - fade, 1, abs(input.Local.y));
+    }
+    else if (input.Type == ShapeCircle)
+    {
+        // thickness and fade are fractions of the radius like Circle.frag
+        float distance = 1 - length(input.Local);
+        alpha = smoothstep(0, fade, distance);
+        alpha *= smoothstep(thickness + fade, thickness, distance);
+    }
+    else if (input.Type == ShapeRoundedRect)
+    {
+        // in world units, negative inside
+        const float radius = min(input.Parameters.z, min(input.HalfSize.x, input.HalfSize.y));
+        float distance = rounded_rect_distance(input.Local * input.HalfSize, input.HalfSize, radius);
+        float edge = max(fade, fwidth(distance));
+        alpha = 1 - smoothstep(-edge, 0, distance);
+        if (thickness > 0.0f)
+            alpha *= smoothstep(-thickness - edge, -thickness, distance);
+    }
+
+    if (alpha == 0.0f)
+        discard;
+
+    color.a *= alpha;
+    return calc_final_color(color);
+}
@@ -0,0 +1,63 @@
+#include "VertexBase.verti.hlsl"
+
+// quads, lines, circles and rounded rects share one layout,
+// every shape is a rotated quad around its center, Shape.frag evaluates the type
+
+struct ShapeData
+{
+    float4 Color;
+    float2 Center;
+    float2 HalfSize;
+    float Rotation;
+    float Thickness;
+    float Fade;
+    float CornerRadius;
+    float Depth;
+    uint CameraIndex;
+    uint Type;
+    float pad;
+};
+
+StructuredBuffer<ShapeData> DataBuffer : register(t1, space0);
+
+cbuffer BatchData : register(b0, space1)
+{
+    uint BatchOffset; // first element of the batch in the shared buffer
+};
+
+struct Output
+{
+    float4 Position : SV_Position;
+    float4 Color : TEXCOORD0;
+    float2 Local : TEXCOORD1; // -1 to 1 across the shape
+    nointerpolation float2 HalfSize : TEXCOORD2;
+    nointerpolation float4 Parameters : TEXCOORD3; // thickness, fade, corner radius
+    nointerpolation uint Type : TEXCOORD4;
+};
+
+Output main(uint id : SV_VertexID)
+{
+    const uint shape_index = id / 6;
+    const uint vert = QuadIndices[id % 6];
+    const ShapeData shape = DataBuffer[BatchOffset + shape_index];
+
+    const float2 local = QuadVertices[vert] * 2.0f - 1.0f;
+    float2 offset = local * shape.HalfSize;
+    if (shape.Rotation != 0.0f)
+    {
+        float c = cos(shape.Rotation);
+        float s = sin(shape.Rotation);
+
+        float2x2 rotation = { c, s, -s, c };
+        offset = mul(offset, rotation);
+    }
+
+    Output output;
+    output.Position = transform_coordinates_2D(float4(shape.Center + offset, shape.Depth, 1.0f), shape.CameraIndex);
+    output.Color = shape.Color;
+    output.Local = local;
+    output.HalfSize = shape.HalfSize;
+    output.Parameters = float4(shape.Thickness, shape.Fade, shape.CornerRadius, 0.0f);
+    output.Type = shape.Type;
+    return output;
+}
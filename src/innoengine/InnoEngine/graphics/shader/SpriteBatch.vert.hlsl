@@ -10,11 +10,36 @@ struct SpriteData
     float Rotation;    
     float Depth;
     uint CameraIndex;
-    float3 pad;
+    uint Animation; // columns 8 bit | rows 8 bit | frame count 15 bit | loop 1 bit, 0 when not animated
+    float FrameRate;
+    float AnimationStart;
 };
 
 StructuredBuffer<SpriteData> DataBuffer : register(t1, space0);
 
+cbuffer BatchData : register(b0, space1)
+{
+    uint BatchOffset; // first element of the batch in the shared buffer, SV_VertexID does not include the first vertex on every backend
+    float Time; // seconds, drives the animations
+};
+
+
+// the source rect covers the whole flipbook, returns the area of the current frame
+float4 animate_source_rect(SpriteData sprite)
+{
+    uint columns = sprite.Animation & 0xFF;
+    uint rows = (sprite.Animation >> 8) & 0xFF;
+    uint frame_count = (sprite.Animation >> 16) & 0x7FFF;
+    bool loop = (sprite.Animation >> 31) != 0;
+
+    float elapsed = max(Time - sprite.AnimationStart, 0.0f);
+    uint frame = (uint)(elapsed * sprite.FrameRate);
+    frame = loop ? frame % frame_count : min(frame, frame_count - 1);
+
+    float2 frame_size = (sprite.SourceRect.zw - sprite.SourceRect.xy) / float2(columns, rows);
+    float2 frame_min = sprite.SourceRect.xy + float2(frame % columns, frame / columns) * frame_size;
+    return float4(frame_min, frame_min + frame_size);
+}
 
 struct Output
 {
@@ -27,7 +52,7 @@ Output main(uint id : SV_VertexID)
 {
     uint spriteIndex = id / 6;
     uint vert = QuadIndices[id % 6];
-    SpriteData sprite = DataBuffer[spriteIndex];
+    SpriteData sprite = DataBuffer[BatchOffset + spriteIndex];
     float2 coord = QuadVertices[vert];
       
     coord *= sprite.Size;
@@ -47,12 +72,14 @@ Output main(uint id : SV_VertexID)
     float4 coord_with_depth = float4(coord + sprite.Position,sprite.Depth, 1.0f);
     
     
+    float4 source_rect = sprite.Animation != 0 ? animate_source_rect(sprite) : sprite.SourceRect;
+    
     float2 texcoord[4] =
     {
-        { sprite.SourceRect.x, sprite.SourceRect.w },
-        { sprite.SourceRect.z, sprite.SourceRect.w },
-        { sprite.SourceRect.x, sprite.SourceRect.y },
-        { sprite.SourceRect.z, sprite.SourceRect.y }
+        { source_rect.x, source_rect.w },
+        { source_rect.z, source_rect.w },
+        { source_rect.x, source_rect.y },
+        { source_rect.z, source_rect.y }
     };
             
     Output output;
@@ -0,0 +1,155 @@
+// Culls a batch of sprites against the view of their render context and compacts the visible ones
+// in submission order. Runs in three phases (separate dispatches):
+//   0: count the visible sprites of every thread group
+//   1: prefix sum over the group counts (single group), writes the indirect draw arguments
+//   2: scatter the visible sprites into the output buffer
+
+struct SpriteData
+{
+    float4 SourceRect;
+    float4 Color;
+    float2 Position;
+    float2 Size;
+    float2 RotationOrigin;
+    float Rotation;
+    float Depth;
+    uint CameraIndex;
+    uint Animation;
+    float FrameRate;
+    float AnimationStart;
+};
+
+struct CameraData
+{
+    float4x4 ViewProjectionMatrix;
+};
+
+StructuredBuffer<SpriteData> InputBuffer : register(t0, space0);
+StructuredBuffer<CameraData> CameraDataBuffer : register(t1, space0);
+
+RWStructuredBuffer<SpriteData> OutputBuffer : register(u0, space1);
+// [0..3] SDL_GPUIndirectDrawCommand, followed by one counter/offset per thread group
+RWStructuredBuffer<uint> CullData : register(u1, space1);
+
+cbuffer CullParameters : register(b0, space2)
+{
+    uint SpriteCount;
+    uint Phase;
+    uint InputOffset; // the batch starts at this sprite of the shared input buffer
+};
+
+static const uint GroupSize = 64;
+static const uint GroupDataOffset = 4;
+
+groupshared uint gs_Visible[GroupSize];
+groupshared uint gs_Sum[GroupSize];
+
+bool is_visible(SpriteData sprite)
+{
+    float2 bounds_min = sprite.Position;
+    float2 bounds_max = sprite.Position + sprite.Size;
+
+    if (sprite.Rotation != 0.0f)
+    {
+        // the quad rotates around RotationOrigin, so use the circle enclosing all rotations
+        float2 pivot = sprite.Position + sprite.RotationOrigin;
+        float radius = length(max(abs(sprite.RotationOrigin), abs(sprite.Size - sprite.RotationOrigin)));
+        bounds_min = pivot - radius;
+        bounds_max = pivot + radius;
+    }
+
+    float2 corners[4] =
+    {
+        bounds_min,
+        float2(bounds_max.x, bounds_min.y),
+        float2(bounds_min.x, bounds_max.y),
+        bounds_max
+    };
+
+    float4x4 view_projection = CameraDataBuffer[sprite.CameraIndex].ViewProjectionMatrix;
+    float2 clip_min = float2(1e30f, 1e30f);
+    float2 clip_max = float2(-1e30f, -1e30f);
+
+    for (uint i = 0; i < 4; ++i)
+    {
+        float4 clip = mul(view_projection, float4(corners[i], 0.0f, 1.0f));
+        float2 ndc = clip.xy / clip.w;
+        clip_min = min(clip_min, ndc);
+        clip_max = max(clip_max, ndc);
+    }
+
+    return clip_max.x >= -1.0f && clip_min.x <= 1.0f && clip_max.y >= -1.0f && clip_min.y <= 1.0f;
+}
+
+[numthreads(GroupSize, 1, 1)]
+void main(uint3 group_id : SV_GroupID, uint3 thread_id : SV_GroupThreadID, uint3 dispatch_id : SV_DispatchThreadID)
+{
+    uint local_index = thread_id.x;
+
+    if (Phase == 1)
+    {
+        // exclusive prefix sum over the group counts, every thread handles a contiguous chunk
+        uint group_count = (SpriteCount + GroupSize - 1) / GroupSize;
+        uint chunk_size = (group_count + GroupSize - 1) / GroupSize;
+        uint chunk_begin = min(local_index * chunk_size, group_count);
+        uint chunk_end = min(chunk_begin + chunk_size, group_count);
+
+        uint chunk_sum = 0;
+        for (uint i = chunk_begin; i < chunk_end; ++i)
+            chunk_sum += CullData[GroupDataOffset + i];
+
+        gs_Sum[local_index] = chunk_sum;
+        GroupMemoryBarrierWithGroupSync();
+
+        uint running = 0;
+        for (uint t = 0; t < local_index; ++t)
+            running += gs_Sum[t];
+
+        for (uint j = chunk_begin; j < chunk_end; ++j)
+        {
+            uint count = CullData[GroupDataOffset + j];
+            CullData[GroupDataOffset + j] = running;
+            running += count;
+        }
+
+        if (local_index == GroupSize - 1)
+        {
+            CullData[0] = running * 6; // num_vertices
+            CullData[1] = 1;           // num_instances
+            CullData[2] = 0;           // first_vertex
+            CullData[3] = 0;           // first_instance
+        }
+        return;
+    }
+
+    bool visible = false;
+    SpriteData sprite = (SpriteData)0;
+    if (dispatch_id.x < SpriteCount)
+    {
+        sprite = InputBuffer[InputOffset + dispatch_id.x];
+        visible = is_visible(sprite);
+    }
+
+    gs_Visible[local_index] = visible ? 1 : 0;
+    GroupMemoryBarrierWithGroupSync();
+
+    if (Phase == 0)
+    {
+        if (local_index == 0)
+        {
+            uint count = 0;
+            for (uint i = 0; i < GroupSize; ++i)
+                count += gs_Visible[i];
+            CullData[GroupDataOffset + group_id.x] = count;
+        }
+        return;
+    }
+
+    if (visible)
+    {
+        uint slot = CullData[GroupDataOffset + group_id.x];
+        for (uint i = 0; i < local_index; ++i)
+            slot += gs_Visible[i];
+        OutputBuffer[slot] = sprite;
+    }
+}
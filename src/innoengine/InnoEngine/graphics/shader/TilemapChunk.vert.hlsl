@@ -0,0 +1,58 @@
+#include "VertexBase.verti.hlsl"
+
+// one draw per chunk, every tile of the chunk expands to a quad
+static const uint ChunkSize = 32; // has to match Tilemap::ChunkSize
+static const uint EmptyTile = 0xFFFF;
+
+// two 16 bit tile indices per element, row by row from the bottom left tile
+StructuredBuffer<uint> TileBuffer : register(t1, space0);
+
+cbuffer ChunkData : register(b0, space1)
+{
+    float4 TilesetRect;   // area of the tileset inside the texture
+    float4 Color;
+    float2 ChunkPosition; // bottom left corner of the chunk
+    float2 TileSize;
+    uint TilesetColumns;
+    uint TilesetRows;
+    uint CameraIndex;
+    float Depth;
+};
+
+struct Output
+{
+    float2 TexCoord : TEXCOORD0;
+    float4 Color : TEXCOORD1;
+    float4 Position : SV_Position;
+};
+
+Output main(uint id : SV_VertexID)
+{
+    uint tileIndex = id / 6;
+    uint vert = QuadIndices[id % 6];
+    uint tile = (TileBuffer[tileIndex / 2] >> ((tileIndex % 2) * 16)) & 0xFFFF;
+
+    Output output;
+    output.Color = Color;
+
+    if (tile == EmptyTile)
+    {
+        // degenerate triangles get discarded before rasterization
+        output.Position = float4(0.0f, 0.0f, 0.0f, 1.0f);
+        output.TexCoord = float2(0.0f, 0.0f);
+        return output;
+    }
+
+    float2 corner = QuadVertices[vert];
+    float2 coord = (float2(tileIndex % ChunkSize, tileIndex / ChunkSize) + corner) * TileSize + ChunkPosition;
+    float4 coord_with_depth = float4(coord, Depth, 1.0f);
+
+    // tiles of the tileset are counted row by row from the top left, texture v grows downwards
+    float2 cell_size = (TilesetRect.zw - TilesetRect.xy) / float2(TilesetColumns, TilesetRows);
+    float2 cell = float2(tile % TilesetColumns, tile / TilesetColumns);
+    float2 texcoord = TilesetRect.xy + (cell + float2(corner.x, 1.0f - corner.y)) * cell_size;
+
+    output.Position = transform_coordinates_2D(coord_with_depth, CameraIndex);
+    output.TexCoord = texcoord;
+    return output;
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include <type_traits>
+
+namespace InnoEngine
+{
+    // 64 bit FNV-1a, good enough to detect changed files and parameters
+    constexpr uint64_t FNV1aOffsetBasis = 0xcbf29ce484222325ull;
+    constexpr uint64_t FNV1aPrime       = 0x00000100000001b3ull;
+
+    inline uint64_t fnv1a( std::span<const std::byte> data, uint64_t hash = FNV1aOffsetBasis )
+    {
+        for ( std::byte value : data ) {
+            hash ^= static_cast<uint64_t>( value );
+            hash *= FNV1aPrime;
+        }
+        return hash;
+    }
+
+    constexpr uint64_t fnv1a( std::string_view data, uint64_t hash = FNV1aOffsetBasis )
+    {
+        for ( char value : data ) {
+            hash ^= static_cast<uint64_t>( static_cast<unsigned char>( value ) );
+            hash *= FNV1aPrime;
+        }
+        return hash;
+    }
+
+    template <typename T>
+    inline uint64_t fnv1a_value( const T& value, uint64_t hash = FNV1aOffsetBasis )
+    {
+        static_assert( std::is_trivially_copyable_v<T> );
+        return fnv1a( std::as_bytes( std::span<const T, 1>( &value, 1 ) ), hash );
+    }
+}    // namespace InnoEngine
@@ -0,0 +1,86 @@
+#include "InnoEngine/iepch.h"
+#include "InnoEngine/utility/JobSystem.h"
+
+namespace InnoEngine
+{
+    JobSystem::~JobSystem()
+    {
+        {
+            std::lock_guard lguard( m_Mutex );
+            m_Stop = true;
+            m_Jobs.clear();    // queued jobs are dropped, running ones finish
+        }
+        m_JobAvailable.notify_all();
+
+        for ( std::thread& worker : m_Workers )
+            worker.join();
+    }
+
+    auto JobSystem::create( uint32_t thread_count ) -> std::optional<Own<JobSystem>>
+    {
+        if ( thread_count == 0 )
+            thread_count = std::max( std::thread::hardware_concurrency(), 4u ) - 3;
+
+        Own<JobSystem> job_system = Own<JobSystem>( new JobSystem );
+
+        job_system->m_Workers.reserve( thread_count );
+        for ( uint32_t i = 0; i < thread_count; ++i )
+            job_system->m_Workers.emplace_back( &JobSystem::worker_loop, job_system.get() );
+
+        IE_LOG_DEBUG( "JobSystem: Started {} worker threads", thread_count );
+        return job_system;
+    }
+
+    void JobSystem::submit( Job job )
+    {
+        IE_ASSERT( job != nullptr );
+        {
+            std::lock_guard lguard( m_Mutex );
+            m_Jobs.push_back( std::move( job ) );
+        }
+        m_JobAvailable.notify_one();
+    }
+
+    void JobSystem::wait_idle()
+    {
+        std::unique_lock<std::mutex> ulock( m_Mutex );
+        m_Idle.wait( ulock, [ this ] { return m_Jobs.empty() && m_RunningJobs == 0; } );
+    }
+
+    uint32_t JobSystem::get_thread_count() const
+    {
+        return static_cast<uint32_t>( m_Workers.size() );
+    }
+
+    size_t JobSystem::get_pending_count() const
+    {
+        std::lock_guard lguard( m_Mutex );
+        return m_Jobs.size() + m_RunningJobs;
+    }
+
+    void JobSystem::worker_loop()
+    {
+        while ( true ) {
+            Job job;
+            {
+                std::unique_lock<std::mutex> ulock( m_Mutex );
+                m_JobAvailable.wait( ulock, [ this ] { return m_Stop || m_Jobs.empty() == false; } );
+                if ( m_Stop )
+                    return;
+
+                job = std::move( m_Jobs.front() );
+                m_Jobs.pop_front();
+                ++m_RunningJobs;
+            }
+
+            job();
+
+            {
+                std::lock_guard lguard( m_Mutex );
+                --m_RunningJobs;
+                if ( m_Jobs.empty() && m_RunningJobs == 0 )
+                    m_Idle.notify_all();
+            }
+        }
+    }
+}    // namespace InnoEngine
@@ -0,0 +1,49 @@
+#pragma once
+#include "InnoEngine/BaseTypes.h"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace InnoEngine
+{
+    using Job = std::function<void()>;
+
+    // a small pool of worker threads for background work which must never stall a frame
+    // jobs run in submission order, but may finish in any order
+    class JobSystem
+    {
+        JobSystem() = default;
+
+    public:
+        ~JobSystem();
+
+        // 0 uses all hardware threads except the main, update and render thread
+        static auto create( uint32_t thread_count = 0 ) -> std::optional<Own<JobSystem>>;
+
+        void submit( Job job );
+
+        // blocks until all submitted jobs are done
+        void wait_idle();
+
+        uint32_t get_thread_count() const;
+        size_t   get_pending_count() const;
+
+    private:
+        void worker_loop();
+
+    private:
+        std::vector<std::thread> m_Workers;
+
+        mutable std::mutex      m_Mutex;
+        std::condition_variable m_JobAvailable;
+        std::condition_variable m_Idle;
+        std::deque<Job>         m_Jobs;
+        uint32_t                m_RunningJobs = 0;
+        bool                    m_Stop        = false;
+    };
+}    // namespace InnoEngine
@@ -0,0 +1,90 @@
+#include "InnoEngine/iepch.h"
+#include "InnoEngine/utility/MappedFile.h"
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace InnoEngine
+{
+    MappedFile::~MappedFile()
+    {
+#ifdef _WIN32
+        if ( m_Data != nullptr )
+            UnmapViewOfFile( m_Data );
+        if ( m_Mapping != nullptr )
+            CloseHandle( m_Mapping );
+        if ( m_File != nullptr )
+            CloseHandle( m_File );
+#else
+        if ( m_Data != nullptr )
+            munmap( const_cast<std::byte*>( m_Data ), m_Size );
+        if ( m_FileDescriptor >= 0 )
+            close( m_FileDescriptor );
+#endif
+    }
+
+    auto MappedFile::create( const std::filesystem::path& path ) -> std::optional<Own<MappedFile>>
+    {
+        Own<MappedFile> file = Own<MappedFile>( new MappedFile );
+
+#ifdef _WIN32
+        HANDLE handle = CreateFileW( path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr );
+        if ( handle == INVALID_HANDLE_VALUE )
+            return std::nullopt;
+        file->m_File = handle;
+
+        LARGE_INTEGER size = {};
+        if ( GetFileSizeEx( handle, &size ) == false || size.QuadPart == 0 )
+            return std::nullopt;
+        file->m_Size = static_cast<size_t>( size.QuadPart );
+
+        file->m_Mapping = CreateFileMappingW( handle, nullptr, PAGE_READONLY, 0, 0, nullptr );
+        if ( file->m_Mapping == nullptr )
+            return std::nullopt;
+
+        file->m_Data = static_cast<const std::byte*>( MapViewOfFile( file->m_Mapping, FILE_MAP_READ, 0, 0, 0 ) );
+#else
+        file->m_FileDescriptor = open( path.c_str(), O_RDONLY );
+        if ( file->m_FileDescriptor < 0 )
+            return std::nullopt;
+
+        struct stat stats = {};
+        if ( fstat( file->m_FileDescriptor, &stats ) != 0 || stats.st_size == 0 )
+            return std::nullopt;
+        file->m_Size = static_cast<size_t>( stats.st_size );
+
+        void* data = mmap( nullptr, file->m_Size, PROT_READ, MAP_PRIVATE, file->m_FileDescriptor, 0 );
+        if ( data != MAP_FAILED )
+            file->m_Data = static_cast<const std::byte*>( data );
+#endif
+
+        if ( file->m_Data == nullptr ) {
+            IE_LOG_ERROR( "Mapping file \"{}\" failed", path.string() );
+            return std::nullopt;
+        }
+        return file;
+    }
+
+    const std::byte* MappedFile::data() const
+    {
+        return m_Data;
+    }
+
+    size_t MappedFile::size() const
+    {
+        return m_Size;
+    }
+
+    std::span<const std::byte> MappedFile::view() const
+    {
+        return { m_Data, m_Size };
+    }
+}    // namespace InnoEngine
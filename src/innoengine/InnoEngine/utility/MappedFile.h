@@ -0,0 +1,38 @@
+#pragma once
+#include "InnoEngine/BaseTypes.h"
+
+#include <filesystem>
+#include <optional>
+#include <span>
+
+namespace InnoEngine
+{
+    // read only memory mapping of a whole file, the view stays valid as long as the object lives
+    class MappedFile
+    {
+        MappedFile() = default;
+
+    public:
+        ~MappedFile();
+
+        MappedFile( const MappedFile& )            = delete;
+        MappedFile& operator=( const MappedFile& ) = delete;
+
+        static auto create( const std::filesystem::path& path ) -> std::optional<Own<MappedFile>>;
+
+        const std::byte*           data() const;
+        size_t                     size() const;
+        std::span<const std::byte> view() const;
+
+    private:
+        const std::byte* m_Data = nullptr;
+        size_t           m_Size = 0;
+
+#ifdef _WIN32
+        void* m_File    = nullptr;
+        void* m_Mapping = nullptr;
+#else
+        int m_FileDescriptor = -1;
+#endif
+    };
+}    // namespace InnoEngine
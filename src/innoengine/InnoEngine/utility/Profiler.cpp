@@ -3,6 +3,17 @@
 
 namespace InnoEngine
 {
+    namespace
+    {
+        struct RunningTiming
+        {
+            uint64_t Start  = 0;
+            bool     Active = false;
+        };
+
+        thread_local std::array<RunningTiming, static_cast<size_t>( ProfilePoint::Count )> t_RunningTimings;
+    }    // namespace
+
     auto Profiler::create() -> std::optional<Own<Profiler>>
     {
         Own<Profiler> profiler = Own<Profiler>( new Profiler() );
@@ -16,30 +27,33 @@ namespace InnoEngine
 
     void Profiler::update()
     {
+        std::unique_lock<std::mutex> ulock( m_AverageMutex );
         for ( size_t i = 0; i < m_timings.size(); i++ ) {
-            m_timings[ i ].AverageCalc.update( m_timings[ i ].TotalFrame );
-            m_timings[ i ].TotalFrame = 0;
+            m_timings[ i ].AverageCalc.update( m_timings[ i ].TotalFrame.exchange( 0, std::memory_order_relaxed ) );
         }
     }
 
     void Profiler::start( ProfilePoint ppoint )
     {
-        IE_ASSERT( m_timings[ static_cast<uint32_t>( ppoint ) ].Active == false );
-        m_timings[ static_cast<uint32_t>( ppoint ) ].Current = get_tick_count();
-        m_timings[static_cast<uint32_t>(ppoint)].Active = true;
+        RunningTiming& running = t_RunningTimings[ static_cast<uint32_t>( ppoint ) ];
+        IE_ASSERT( running.Active == false );
+        running.Start  = get_tick_count();
+        running.Active = true;
     }
 
     void Profiler::stop( ProfilePoint ppoint )
     {
-        if ( m_timings[ static_cast<uint32_t>( ppoint ) ].Active ) {
-            uint64_t deltaTime = get_tick_count() - m_timings[ static_cast<uint32_t>( ppoint ) ].Current;
-            m_timings[ static_cast<uint32_t>( ppoint ) ].TotalFrame += deltaTime;
-            m_timings[ static_cast<uint32_t>( ppoint ) ].Active = false;
+        RunningTiming& running = t_RunningTimings[ static_cast<uint32_t>( ppoint ) ];
+        if ( running.Active ) {
+            uint64_t deltaTime = get_tick_count() - running.Start;
+            m_timings[ static_cast<uint32_t>( ppoint ) ].TotalFrame.fetch_add( deltaTime, std::memory_order_relaxed );
+            running.Active = false;
         }
     }
 
     uint64_t Profiler::get_average( ProfilePoint ppoint )
     {
+        std::unique_lock<std::mutex> ulock( m_AverageMutex );
         return m_timings[ static_cast<uint32_t>( ppoint ) ].AverageCalc.get_average();
     }
 
@@ -3,6 +3,8 @@
 
 #include <string>
 #include <array>
+#include <atomic>
+#include <mutex>
 
 namespace InnoEngine
 {
@@ -10,7 +12,8 @@ namespace InnoEngine
     {
         MainThreadTotal = 0,
         UpdateThreadTotal,
-        WaitAndSynchronize,
+        RenderThreadStall,    // render thread waits for a new frame
+        UpdateThreadStall,    // update thread waits to take over input and events
 
         LayerUpdate,
         LayerRender,
@@ -30,6 +33,10 @@ namespace InnoEngine
             return "MainThreadTotal";
         case ProfilePoint::UpdateThreadTotal:
             return "UpdateThreadTotal";
+        case ProfilePoint::RenderThreadStall:
+            return "Render Thread Stall";
+        case ProfilePoint::UpdateThreadStall:
+            return "Update Thread Stall";
         case ProfilePoint::LayerUpdate:
             return "Layer Update";
         case ProfilePoint::LayerRender:
@@ -46,6 +53,7 @@ namespace InnoEngine
         return "Unknown";
     };
 
+    // start and stop may be called from any thread, the running measurements are kept per thread
     class Profiler
 
     {
@@ -54,10 +62,8 @@ namespace InnoEngine
 
         struct alignas( std::hardware_destructive_interference_size ) Timing
         {
-            uint64_t              Current;
-            uint64_t              TotalFrame;
-            AverageCalc<uint64_t> AverageCalc;
-            bool                  Active;
+            std::atomic<uint64_t> TotalFrame = 0;
+            AverageCalc<uint64_t> AverageCalc;    // guarded by m_AverageMutex
         };
 
 #pragma warning( pop )
@@ -78,6 +84,7 @@ namespace InnoEngine
 
     private:
         std::array<Timing, static_cast<size_t>( ProfilePoint::Count )> m_timings;
+        std::mutex                                                     m_AverageMutex;
     };
 
     class ProfileScoped
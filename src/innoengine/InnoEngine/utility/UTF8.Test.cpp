@@ -0,0 +1,49 @@
+#include "InnoEngine/utility/UTF8.h"
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace InnoEngine
+{
+    namespace
+    {
+        std::vector<char32_t> decode_all( std::string_view text )
+        {
+            std::vector<char32_t> codepoints;
+            for ( size_t offset = 0; offset < text.size(); )
+                codepoints.push_back( decode_utf8( text, offset ) );
+            return codepoints;
+        }
+    }    // namespace
+
+    TEST( UTF8Test, ascii )
+    {
+        EXPECT_EQ( decode_all( "Ab 1" ), ( std::vector<char32_t>{ 'A', 'b', ' ', '1' } ) );
+    }
+
+    TEST( UTF8Test, multibyte )
+    {
+        // a umlaut, euro sign, cjk character and an emoji
+        EXPECT_EQ( decode_all( "\xC3\xA4\xE2\x82\xAC\xE4\xB8\xAD\xF0\x9F\x98\x80" ), ( std::vector<char32_t>{ 0xE4, 0x20AC, 0x4E2D, 0x1F600 } ) );
+    }
+
+    TEST( UTF8Test, invalidSequences )
+    {
+        // lone continuation byte, overlong encoding, surrogate and a cut off sequence
+        EXPECT_EQ( decode_all( "\x80" ), ( std::vector<char32_t>{ ReplacementCodepoint } ) );
+        EXPECT_EQ( decode_all( "\xC0\xAF" ), ( std::vector<char32_t>{ ReplacementCodepoint, ReplacementCodepoint } ) );
+        EXPECT_EQ( decode_all( "\xED\xA0\x80" ), ( std::vector<char32_t>{ ReplacementCodepoint, ReplacementCodepoint, ReplacementCodepoint } ) );
+        EXPECT_EQ( decode_all( "\xE2\x82" ), ( std::vector<char32_t>{ ReplacementCodepoint, ReplacementCodepoint } ) );
+    }
+
+    TEST( UTF8Test, recoversAfterInvalidByte )
+    {
+        EXPECT_EQ( decode_all( "\xFFok" ), ( std::vector<char32_t>{ ReplacementCodepoint, 'o', 'k' } ) );
+    }
+
+    TEST( UTF8Test, codepointCount )
+    {
+        EXPECT_EQ( utf8_codepoint_count( "" ), 0u );
+        EXPECT_EQ( utf8_codepoint_count( "h\xC3\xA4llo" ), 5u );
+    }
+}    // namespace InnoEngine
@@ -0,0 +1,74 @@
+#pragma once
+#include <cstdint>
+#include <string_view>
+
+namespace InnoEngine
+{
+    constexpr char32_t ReplacementCodepoint = 0xFFFD;
+
+    // decodes the codepoint starting at offset and advances offset behind it
+    // malformed, overlong or surrogate sequences decode to ReplacementCodepoint and skip one byte
+    constexpr char32_t decode_utf8( std::string_view text, size_t& offset )
+    {
+        const auto byte_at = [ & ]( size_t index ) { return static_cast<uint8_t>( text[ index ] ); };
+
+        const uint8_t lead = byte_at( offset );
+        if ( lead < 0x80 ) {
+            ++offset;
+            return lead;
+        }
+
+        size_t   length    = 0;
+        char32_t minimum   = 0;
+        char32_t codepoint = 0;
+        if ( ( lead & 0xE0 ) == 0xC0 ) {
+            length    = 2;
+            minimum   = 0x80;
+            codepoint = lead & 0x1F;
+        }
+        else if ( ( lead & 0xF0 ) == 0xE0 ) {
+            length    = 3;
+            minimum   = 0x800;
+            codepoint = lead & 0x0F;
+        }
+        else if ( ( lead & 0xF8 ) == 0xF0 ) {
+            length    = 4;
+            minimum   = 0x10000;
+            codepoint = lead & 0x07;
+        }
+        else {
+            ++offset;
+            return ReplacementCodepoint;
+        }
+
+        if ( offset + length > text.size() ) {
+            ++offset;
+            return ReplacementCodepoint;
+        }
+
+        for ( size_t i = 1; i < length; ++i ) {
+            const uint8_t continuation = byte_at( offset + i );
+            if ( ( continuation & 0xC0 ) != 0x80 ) {
+                ++offset;
+                return ReplacementCodepoint;
+            }
+            codepoint = codepoint << 6 | ( continuation & 0x3F );
+        }
+
+        if ( codepoint < minimum || codepoint > 0x10FFFF || ( codepoint >= 0xD800 && codepoint <= 0xDFFF ) ) {
+            ++offset;
+            return ReplacementCodepoint;
+        }
+
+        offset += length;
+        return codepoint;
+    }
+
+    constexpr size_t utf8_codepoint_count( std::string_view text )
+    {
+        size_t count = 0;
+        for ( size_t offset = 0; offset < text.size(); ++count )
+            decode_utf8( text, offset );
+        return count;
+    }
+}    // namespace InnoEngine
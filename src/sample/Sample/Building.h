@@ -2,6 +2,8 @@
 #include "InnoEngine/BaseTypes.h"
 #include "InnoEngine/graphics/Texture2D.h"
 
+#include "Structs.h"
+
 class AAATurret;
 class World;
 
@@ -24,9 +26,9 @@ private:
     void render_turretslots( const InnoEngine::RenderContext* render_ctx );
 
 private:
-    World*                                 m_World = nullptr;
-    DXSM::Vector2                          m_Position;
-    InnoEngine::Ref<InnoEngine::Texture2D> m_Texture;
+    World*        m_World = nullptr;
+    DXSM::Vector2 m_Position;
+    SpriteRegion  m_Sprite;
 
     struct TurretSlot
     {
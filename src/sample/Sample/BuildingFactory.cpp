@@ -1,8 +1,5 @@
 #include "BuildingFactory.h"
 
-#include "InnoEngine/CoreAPI.h"
-#include "InnoEngine/AssetManager.h"
-
 #include "Building.h"
 
 InnoEngine::Ref<DefenseTower> BuildingFactory::create_basic_defense_tower( World* world, DXSM::Vector2 position )
@@ -15,9 +12,6 @@ InnoEngine::Ref<DefenseTower> BuildingFactory::create_basic_defense_tower( World
         nullptr
     } );
 
-    if ( auto opt = InnoEngine::CoreAPI::get_assetmanager()->require_asset<InnoEngine::Texture2D>( "Bullet_MG.png" ) ) {
-
-        building->m_Texture = opt.value().get();
-    }
+    building->m_Sprite = SpriteRegion::from_atlas( "Bullet_MG.png" );
     return building;
 }
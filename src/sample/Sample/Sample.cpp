@@ -2,6 +2,7 @@
 
 #include "InnoEngine/graphics/Renderer.h"
 #include "InnoEngine/graphics/Texture2D.h"
+#include "InnoEngine/graphics/SpriteAtlas.h"
 #include "InnoEngine/graphics/Shader.h"
 
 #include "InnoEngine/AssetManager.h"
@@ -9,6 +10,7 @@
 void SampleProject::on_init_assets( IE::AssetManager* assetmanager )
 {
     assetmanager->add_repository<IE::Texture2D>( "images" );
+    assetmanager->add_repository<IE::SpriteAtlas>( "images" );
     assetmanager->add_repository<IE::Shader>( "shaders" );
     assetmanager->add_repository<IE::Font>( "fonts" );
 }
@@ -0,0 +1,22 @@
+#include "Structs.h"
+
+#include "InnoEngine/CoreAPI.h"
+#include "InnoEngine/AssetManager.h"
+#include "InnoEngine/graphics/SpriteAtlas.h"
+
+SpriteRegion SpriteRegion::from_atlas( std::string_view name )
+{
+    SpriteRegion sprite_region;
+
+    auto atlas = InnoEngine::CoreAPI::get_assetmanager()->require_asset<InnoEngine::SpriteAtlas>( "Weapons.atlas.json", true );
+    if ( atlas.has_value() == false )
+        return sprite_region;
+
+    const InnoEngine::SpriteAtlasRegion* region = atlas.value().get()->find_region( name );
+    IE_ASSERT( region != nullptr );
+
+    sprite_region.Texture    = atlas.value().get()->get_page( region->Page );
+    sprite_region.SourceRect = region->SourceRect;
+    sprite_region.Size       = { static_cast<float>( region->Width ), static_cast<float>( region->Height ) };
+    return sprite_region;
+}
@@ -6,6 +6,18 @@
 
 #include "Enums.h"
 
+#include <string_view>
+
+// region of a page of Weapons.atlas.json, all sample sprites share its pages and batch together
+struct SpriteRegion
+{
+    InnoEngine::Ref<InnoEngine::Texture2D> Texture    = nullptr;
+    DXSM::Vector4                          SourceRect = { 0.0f, 0.0f, 1.0f, 1.0f };
+    DXSM::Vector2                          Size       = { 0.0f, 0.0f };    // in pixels
+
+    static SpriteRegion from_atlas( std::string_view name );
+};
+
 struct PhysicsBodyUserData
 {
     ShapeCategory Catergory;
@@ -13,7 +25,7 @@ struct PhysicsBodyUserData
 
 struct Projectile : PhysicsBodyUserData
 {
-    InnoEngine::Ref<InnoEngine::Texture2D> Texture;
+    SpriteRegion                           Sprite;
     DXSM::Vector2                          Position;
     DXSM::Vector2                          PositionNext;
     DXSM::Vector2                          Velocity;
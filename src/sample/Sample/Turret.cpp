@@ -7,6 +7,7 @@
 #include "InnoEngine/graphics/Renderer.h"
 #include "InnoEngine/InputSystem.h"
 #include "InnoEngine/Application.h"
+#include "InnoEngine/graphics/DebugDraw.h"
 
 void AAATurret::set_target( DXSM::Vector2 target )
 {
@@ -16,7 +17,7 @@ void AAATurret::set_target( DXSM::Vector2 target )
         float cos_elevation = cosf( m_CurrentElevation );
         float sin_elevation = sinf( m_CurrentElevation );
 
-        DXSM::Vector2 tex_size = { static_cast<float>( m_Texture->get_specs().Width ), static_cast<float>( m_Texture->get_specs().Height ) };
+        DXSM::Vector2 tex_size = m_Weapon.Size;
         tex_size *= m_WeaponScale;
 
         DXSM::Vector2 muzzle_offset = m_WeaponMuzzleOrigin - m_WeaponRotationOrigin;
@@ -71,7 +72,7 @@ void AAATurret::update( double delta_time )
 
         float         cos_elevation = cosf( m_CurrentElevation );
         float         sin_elevation = sinf( m_CurrentElevation );
-        DXSM::Vector2 tex_size      = { static_cast<float>( m_Texture->get_specs().Width ), static_cast<float>( m_Texture->get_specs().Height ) };
+        DXSM::Vector2 tex_size      = m_Weapon.Size;
         tex_size *= m_WeaponScale;
 
         DXSM::Vector2 muzzle_offset = m_WeaponMuzzleOrigin - m_WeaponRotationOrigin;
@@ -89,12 +90,14 @@ void AAATurret::update( double delta_time )
 
     if ( m_ReloadProgress <= 1.0f )
         m_ReloadProgress += 1.0f / m_ReloadTime * delta_time;
+
+    IE_DEBUG_LINE( app->get_fullscreen_rch(), m_WeaponMuzzlePosition, m_WeaponMuzzlePosition + m_WeaponMuzzleDirection * 10.0f, { 1.0f, 0.0f, 1.0f, 1.0f } );
 }
 
 void AAATurret::render( const InnoEngine::RenderContext* render_ctx )
 {
-    render_ctx->add_textured_quad( m_Texture,
-                                   { 0.0f, 0.0f, 1.0f, 1.0f },
+    render_ctx->add_textured_quad( m_Weapon.Texture,
+                                   m_Weapon.SourceRect,
                                    m_Position,
                                    InnoEngine::Origin::RotationOrigin,
                                    m_WeaponScale,
@@ -123,7 +126,7 @@ void AAATurret::fire()
         Projectile* new_projectile    = m_World->add_projectile();
         new_projectile->PositionNext  = m_WeaponMuzzlePosition;
         new_projectile->Position      = m_WeaponMuzzlePosition;
-        new_projectile->Texture       = m_ProjectileTexture;
+        new_projectile->Sprite        = m_Projectile;
         new_projectile->LifeTime      = m_ProjectileMaxLifeTime + SDL_randf() * 0.1f;
         new_projectile->DamageKinetic = m_ProjectileDamage;
 
@@ -2,6 +2,8 @@
 #include "InnoEngine/graphics/RenderContext.h"
 #include "InnoEngine/graphics/Texture2D.h"
 
+#include "Structs.h"
+
 class World;
 
 class AAATurret
@@ -51,6 +53,6 @@ protected:
 
     DXSM::Vector2 m_ManualTarget = {};
 
-    InnoEngine::Ref<InnoEngine::Texture2D> m_Texture;
-    InnoEngine::Ref<InnoEngine::Texture2D> m_ProjectileTexture;
+    SpriteRegion m_Weapon;
+    SpriteRegion m_Projectile;
 };
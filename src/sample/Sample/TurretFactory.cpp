@@ -1,6 +1,4 @@
 #include "TurretFactory.h"
-#include "InnoEngine/CoreAPI.h"
-#include "InnoEngine/AssetManager.h"
 
 #include "Turret.h"
 
@@ -19,15 +17,10 @@ InnoEngine::Ref<AAATurret> TurretFactory::create_mg_turret()
     turret->m_ProjectileDamage        = 0.02f;
     turret->m_Accuracy                = 80;
 
-    if ( auto opt = InnoEngine::CoreAPI::get_assetmanager()->require_asset<InnoEngine::Texture2D>( "MG.png" ) ) {
-        turret->m_Texture = opt.value().get();
-    }
+    turret->m_Weapon     = SpriteRegion::from_atlas( "MG.png" );
+    turret->m_Projectile = SpriteRegion::from_atlas( "Bullet_MG.png" );
 
-    if ( auto opt = InnoEngine::CoreAPI::get_assetmanager()->require_asset<InnoEngine::Texture2D>( "Bullet_MG.png" ) ) {
-        turret->m_ProjectileTexture = opt.value().get();
-    }
-
-    DXSM::Vector2 tex_size      = { static_cast<float>( turret->m_Texture->get_specs().Width ), static_cast<float>( turret->m_Texture->get_specs().Height ) };
+    DXSM::Vector2 tex_size      = turret->m_Weapon.Size;
     DXSM::Vector2 muzzle_offset = turret->m_WeaponMuzzleOrigin - turret->m_WeaponRotationOrigin;
     muzzle_offset *= tex_size * turret->m_WeaponScale;
     turret->m_MuzzleRotationOriginDistance = muzzle_offset.Length();
@@ -3,6 +3,7 @@
 #include "InnoEngine/CoreAPI.h"
 #include "InnoEngine/Application.h"
 #include "InnoEngine/InputSystem.h"
+#include "InnoEngine/graphics/DebugDraw.h"
 
 #include "Ground.h"
 #include "BuildingFactory.h"
@@ -29,6 +30,22 @@ InnoEngine::Ref<World> World::create( DXSM::Vector2 dimensions )
     world->m_Asteroids.build_pool( 1000 );
     world->m_Projectiles.build_pool( 50000 );
 
+    // sparks of projectile hits, cheap enough to not need physics bodies
+    InnoEngine::ParticleSystemSpecifications particle_specs = {};
+    particle_specs.MaxParticles                             = 20000;
+    particle_specs.Gravity                                  = { 0.0f, -300.0f };
+    particle_specs.Drag                                     = 1.5f;
+    world->m_ImpactParticles                                = InnoEngine::ParticleSystem::create( particle_specs ).value();
+
+    world->m_ImpactEmitter.LifetimeMin = 0.2f;
+    world->m_ImpactEmitter.LifetimeMax = 0.6f;
+    world->m_ImpactEmitter.SpeedMin    = 50.0f;
+    world->m_ImpactEmitter.SpeedMax    = 250.0f;
+    world->m_ImpactEmitter.SizeStart   = 4.0f;
+    world->m_ImpactEmitter.SizeEnd     = 1.0f;
+    world->m_ImpactEmitter.ColorStart  = { 1.0f, 0.8f, 0.3f, 1.0f };
+    world->m_ImpactEmitter.ColorEnd    = { 1.0f, 0.2f, 0.0f, 0.0f };
+
     auto t1 = BuildingFactory::create_basic_defense_tower( world.get(), { 1500.0f, 50 } );
     t1->insert_turret( TurretFactory::create_mg_turret() );
     world->m_Buildings.push_back( t1 );
@@ -127,7 +144,7 @@ void World::update( double delta_time )
 
         if ( projectileIt->LifeTime <= 0.0f ) {
             b2DestroyBody( projectileIt->PhysicsBodyId );
-            projectileIt->Texture.reset();
+            projectileIt->Sprite = {};
             projectileIt = m_Projectiles.erase( projectileIt );
             continue;
         }
@@ -139,6 +156,8 @@ void World::update( double delta_time )
     for ( auto& building : m_Buildings ) {
         building->update( delta_time );
     }
+
+    m_ImpactParticles->update( static_cast<float>( delta_time ) );
 }
 
 void World::render( float interp_factor, const InnoEngine::RenderContext* render_ctx )
@@ -158,8 +177,8 @@ void World::render( float interp_factor, const InnoEngine::RenderContext* render
 
         b2Rot rotation = b2Body_GetRotation( projectile.PhysicsBodyId );
 
-        render_ctx->add_textured_quad( projectile.Texture,
-                                       { 0.0f, 0.0f, 1.0f, 1.0f },
+        render_ctx->add_textured_quad( projectile.Sprite.Texture,
+                                       projectile.Sprite.SourceRect,
                                        { pos_x, pos_y },
                                        InnoEngine::Origin::Middle,
                                        { 0.1f, 0.1f },
@@ -169,6 +188,8 @@ void World::render( float interp_factor, const InnoEngine::RenderContext* render
     for ( auto& building : m_Buildings ) {
         building->render( render_ctx );
     }
+
+    render_ctx->add_particles( m_ImpactParticles );
 }
 
 Projectile* World::add_projectile()
@@ -192,6 +213,15 @@ void World::resolve_collision_asteroid_projectile( b2ContactHitEvent* hit_event,
 {
     asteroid->Hitpoints -= projectile->DamageKinetic * hit_event->approachSpeed;
     projectile->LifeTime = 0.0f;
+
+    m_ImpactEmitter.Position = { hit_event->point.x, hit_event->point.y };
+    m_ImpactParticles->emit( m_ImpactEmitter, 8 );
+
+    IE_DEBUG_ARROW( InnoEngine::CoreAPI::get_application()->get_fullscreen_rch(),
+                    { hit_event->point.x, hit_event->point.y },
+                    DXSM::Vector2( hit_event->point.x, hit_event->point.y ) + DXSM::Vector2( hit_event->normal.x, hit_event->normal.y ) * 20.0f,
+                    { 1.0f, 0.3f, 0.0f, 1.0f },
+                    InnoEngine::DebugLifetime::seconds( 0.5f ) );
 }
 
 void World::resolve_collision_asteroid_ground( b2ContactHitEvent* hit_event, Asteroid* asteroid, Ground* ground )
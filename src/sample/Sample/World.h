@@ -1,6 +1,7 @@
 #pragma once
 #include "InnoEngine/BaseTypes.h"
 #include "InnoEngine/graphics/Texture2D.h"
+#include "InnoEngine/graphics/ParticleSystem.h"
 #include "InnoEngine/utility/ObjectPool.h"
 
 #include "box2d/box2d.h"
@@ -45,5 +46,8 @@ private:
     InnoEngine::ObjectPool<Asteroid, uint16_t, InnoEngine::ObjectPoolType::RestoreSequence>   m_Asteroids;
     InnoEngine::ObjectPool<Projectile, uint32_t, InnoEngine::ObjectPoolType::RestoreSequence> m_Projectiles;
 
+    InnoEngine::Ref<InnoEngine::ParticleSystem> m_ImpactParticles;
+    InnoEngine::ParticleEmitter                 m_ImpactEmitter;
+
     b2WorldId m_PhysicsWorldId = {};
 };
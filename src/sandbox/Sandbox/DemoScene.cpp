@@ -22,9 +22,40 @@ Demoscene::Demoscene( Sandbox* parent ) :
     auto fontOpt = IE::CoreAPI::get_assetmanager()->require_asset<IE::Font>( "Calibri.ttf", true );
     m_testFont   = fontOpt.value().get();
 
-    auto textureOpt = IE::CoreAPI::get_assetmanager()->require_asset<IE::Texture2D>( "tile.png", true );
-    m_testTexture   = textureOpt.value().get();
-    m_testSprite.set_texture( m_testTexture );
+    auto atlasOpt = IE::CoreAPI::get_assetmanager()->require_asset<IE::SpriteAtlas>( "Weapons.atlas.json", true );
+    m_weaponAtlas = atlasOpt.value().get();
+
+    const char* weapons[] = { "Cannon.png", "Cannon2.png", "Cannon3.png", "MG.png", "MG2.png", "MG3.png", "Missile_Launcher.png", "Missile_Launcher2.png", "Missile_Launcher3.png" };
+    float       weapon_x  = 50.0f;
+    for ( const char* weapon : weapons ) {
+        const IE::SpriteAtlasRegion* region = m_weaponAtlas->find_region( weapon );
+        if ( region == nullptr )
+            continue;
+
+        IE::Sprite& sprite = m_weaponSprites.emplace_back();
+        sprite.set_region( *m_weaponAtlas, weapon );
+        sprite.set_scale( { 0.5f, 0.5f } );
+        sprite.set_position( { weapon_x, 50.0f } );
+        weapon_x += region->Width * 0.5f + 20.0f;
+    }
+
+    auto tileOpt = IE::CoreAPI::get_assetmanager()->require_asset<IE::Texture2D>( "tile.png", true );
+
+    IE::TilemapSpecifications tilemap_spec = {};
+    tilemap_spec.Width                     = 48;
+    tilemap_spec.Height                    = 27;
+    tilemap_spec.TileSize                  = { 40.0f, 40.0f };
+    tilemap_spec.Tileset                   = tileOpt.value().get();
+    m_tilemap                              = IE::Tilemap::create( tilemap_spec ).value();
+
+    // checkerboard behind the weapons, empty cells stay clear
+    for ( uint32_t y = 0; y < tilemap_spec.Height; ++y ) {
+        for ( uint32_t x = 0; x < tilemap_spec.Width; ++x ) {
+            if ( ( x + y ) % 2 == 0 )
+                m_tilemap->set_tile( x, y, 0 );
+        }
+    }
+    m_tilemap->set_color( { 0.3f, 0.3f, 0.3f, 1.0f } );
 
     m_positions.resize( sprite_count );
     m_rotations.resize( sprite_count );
@@ -90,6 +121,11 @@ void Demoscene::render( float interp_factor, IE::GPURenderer* renderer )
 
     const IE::RenderContext* fullscreen_ctx = renderer->acquire_rendercontext( m_Parent->get_fullscreen_rch() );
     if ( fullscreen_ctx ) {
+        fullscreen_ctx->add_tilemap( m_tilemap );
+
+        for ( const IE::Sprite& sprite : m_weaponSprites )
+            fullscreen_ctx->add_sprite( sprite );
+
         //fullscreen_ctx->add_text_centered( m_testFont, { 1920 / 2.0f, 50.0f }, 40, "InnoEngine Demoscene", m_textColor );
 
         //fullscreen_ctx->add_quad(IE::Origin::TopLeft, {1920 / 2.0f - 1280 / 2.0f, 200}, {1280, 720}, 0.0f, {0.0f, 1.0f, 0.0f, 1.0f});
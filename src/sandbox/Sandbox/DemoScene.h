@@ -6,6 +6,8 @@
 #include "InnoEngine/graphics/Font.h"
 #include "InnoEngine/graphics/Texture2D.h"
 #include "InnoEngine/graphics/Sprite.h"
+#include "InnoEngine/graphics/SpriteAtlas.h"
+#include "InnoEngine/graphics/Tilemap.h"
 #include "InnoEngine/graphics/Camera.h"
 
 #include "InnoEngine/graphics/Viewport.h"
@@ -29,9 +31,10 @@ public:
     bool handle_event( const SDL_Event& pEvent ) override;
 
 private:
-    IE::Ref<IE::Font>      m_testFont;
-    IE::Ref<IE::Texture2D> m_testTexture;
-    IE::Sprite             m_testSprite;
+    IE::Ref<IE::Font>        m_testFont;
+    IE::Ref<IE::SpriteAtlas> m_weaponAtlas;
+    std::vector<IE::Sprite>  m_weaponSprites;    // all on the pages of m_weaponAtlas
+    IE::Ref<IE::Tilemap>     m_tilemap;
 
     std::vector<DXSM::Vector2> m_positions;
     std::vector<float>         m_rotations;